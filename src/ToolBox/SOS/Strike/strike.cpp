@@ -7540,6 +7540,9 @@ DECLARE_API(ThreadPool)
                     "Stabilizing",
                     "Starvation",
                     "ThreadTimedOut",
+                    "QueueLatency",
+                    "BlockedWorkers",
+                    "Idle",
                     "Undefined"
                 };
 
@@ -121,6 +121,14 @@ CORINFO_METHOD_HANDLE resolveVirtualMethod(CORINFO_METHOD_HANDLE  virtualMethod,
                                            CORINFO_CLASS_HANDLE   implementingClass,
                                            CORINFO_CONTEXT_HANDLE ownerType);
 
+// Get the class most likely to be seen as 'this' by the virtual call at
+// ilOffset in method, as observed by tier0 code, or the class profile cell
+// to instrument the call with when pCell is non-null.
+CORINFO_CLASS_HANDLE getLikelyClass(CORINFO_METHOD_HANDLE method,
+                                    unsigned              ilOffset,
+                                    unsigned*             pLikelihood /* OUT */,
+                                    void**                pCell /* OUT */);
+
 // Get the unboxed entry point for a method, if possible.
 CORINFO_METHOD_HANDLE getUnboxedEntry(
     CORINFO_METHOD_HANDLE ftn,
@@ -326,6 +334,11 @@ size_t getClassModuleIdForStatics(CORINFO_CLASS_HANDLE cls, CORINFO_MODULE_HANDL
 // return the number of bytes needed by an instance of the class
 unsigned getClassSize(CORINFO_CLASS_HANDLE cls);
 
+// return the number of bytes needed by an instance of a reference class
+// allocated on the heap, including the method table pointer but not the
+// object header
+unsigned getHeapClassSize(CORINFO_CLASS_HANDLE cls);
+
 unsigned getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint = FALSE);
 
 // This is only called for Value classes.  It returns a boolean array
@@ -1751,6 +1751,28 @@ unsigned MethodContext::repGetClassSize(CORINFO_CLASS_HANDLE cls)
     return result;
 }
 
+void MethodContext::recGetHeapClassSize(CORINFO_CLASS_HANDLE cls, unsigned result)
+{
+    if (GetHeapClassSize == nullptr)
+        GetHeapClassSize = new LightWeightMap<DWORDLONG, DWORD>();
+
+    GetHeapClassSize->Add((DWORDLONG)cls, (DWORD)result);
+    DEBUG_REC(dmpGetHeapClassSize((DWORDLONG)cls, (DWORD)result));
+}
+void MethodContext::dmpGetHeapClassSize(DWORDLONG key, DWORD val)
+{
+    printf("GetHeapClassSize key %016llX, value %u", key, val);
+}
+unsigned MethodContext::repGetHeapClassSize(CORINFO_CLASS_HANDLE cls)
+{
+    AssertCodeMsg(GetHeapClassSize != nullptr, EXCEPTIONCODE_MC, "Didn't find %016llX", (DWORDLONG)cls);
+    AssertCodeMsg(GetHeapClassSize->GetIndex((DWORDLONG)cls) != -1, EXCEPTIONCODE_MC, "Didn't find %016llX",
+                  (DWORDLONG)cls);
+    unsigned result = (unsigned)GetHeapClassSize->Get((DWORDLONG)cls);
+    DEBUG_REP(dmpGetHeapClassSize((DWORDLONG)cls, (DWORD)result));
+    return result;
+}
+
 void MethodContext::recGetClassNumInstanceFields(CORINFO_CLASS_HANDLE cls, unsigned result)
 {
     if (GetClassNumInstanceFields == nullptr)
@@ -3052,6 +3074,66 @@ CORINFO_METHOD_HANDLE MethodContext::repResolveVirtualMethod(CORINFO_METHOD_HAND
     return (CORINFO_METHOD_HANDLE)result;
 }
 
+void MethodContext::recGetLikelyClass(CORINFO_METHOD_HANDLE method,
+                                      unsigned              ilOffset,
+                                      unsigned*             pLikelihood,
+                                      void**                pCell,
+                                      CORINFO_CLASS_HANDLE  result)
+{
+    if (GetLikelyClass == nullptr)
+    {
+        GetLikelyClass = new LightWeightMap<DLDD, DLDL>();
+    }
+
+    DLDD key;
+    ZeroMemory(&key, sizeof(DLDD)); // We use the input structs as a key and use memcmp to compare.. so we need to zero
+                                    // out padding too
+    key.A = (DWORDLONG)method;
+    key.B = (DWORD)ilOffset;
+    key.C = (pCell != nullptr) ? 1 : 0;
+
+    // When the cell is requested it is returned in place of the class
+    DLDL value;
+    value.A = (pCell != nullptr) ? (DWORDLONG)*pCell : (DWORDLONG)result;
+    value.B = (DWORDLONG)*pLikelihood;
+
+    GetLikelyClass->Add(key, value);
+    DEBUG_REC(dmpGetLikelyClass(key, value));
+}
+
+void MethodContext::dmpGetLikelyClass(DLDD key, DLDL value)
+{
+    printf("GetLikelyClass method-%016llX il-%u cell-%u, result-%016llX likelihood-%llu", key.A, key.B, key.C, value.A,
+           value.B);
+}
+
+CORINFO_CLASS_HANDLE MethodContext::repGetLikelyClass(CORINFO_METHOD_HANDLE method,
+                                                      unsigned              ilOffset,
+                                                      unsigned*             pLikelihood,
+                                                      void**                pCell)
+{
+    DLDD key;
+    ZeroMemory(&key, sizeof(DLDD)); // We use the input structs as a key and use memcmp to compare.. so we need to zero
+                                    // out padding too
+    key.A = (DWORDLONG)method;
+    key.B = (DWORD)ilOffset;
+    key.C = (pCell != nullptr) ? 1 : 0;
+
+    AssertCodeMsg(GetLikelyClass != nullptr, EXCEPTIONCODE_MC, "No GetLikelyClass map for %016llX", key.A);
+    AssertCodeMsg(GetLikelyClass->GetIndex(key) != -1, EXCEPTIONCODE_MC, "Didn't find %016llX", key.A);
+    DLDL value = GetLikelyClass->Get(key);
+
+    DEBUG_REP(dmpGetLikelyClass(key, value));
+
+    *pLikelihood = (unsigned)value.B;
+    if (pCell != nullptr)
+    {
+        *pCell = (void*)value.A;
+        return nullptr;
+    }
+    return (CORINFO_CLASS_HANDLE)value.A;
+}
+
 void MethodContext::recGetUnboxedEntry(CORINFO_METHOD_HANDLE ftn,
                                        bool*                 requiresInstMethodTableArg,
                                        CORINFO_METHOD_HANDLE result)
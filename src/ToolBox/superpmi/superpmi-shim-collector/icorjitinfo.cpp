@@ -242,6 +242,20 @@ CORINFO_METHOD_HANDLE interceptor_ICJI::resolveVirtualMethod(CORINFO_METHOD_HAND
     return result;
 }
 
+// Get the class most likely to be seen as 'this' by the virtual call at
+// ilOffset in method, as observed by tier0 code, or the class profile cell
+// to instrument the call with when pCell is non-null.
+CORINFO_CLASS_HANDLE interceptor_ICJI::getLikelyClass(CORINFO_METHOD_HANDLE method,
+                                                      unsigned              ilOffset,
+                                                      unsigned*             pLikelihood,
+                                                      void**                pCell)
+{
+    mc->cr->AddCall("getLikelyClass");
+    CORINFO_CLASS_HANDLE result = original_ICorJitInfo->getLikelyClass(method, ilOffset, pLikelihood, pCell);
+    mc->recGetLikelyClass(method, ilOffset, pLikelihood, pCell, result);
+    return result;
+}
+
 // Get the unboxed entry point for a method, if possible.
 CORINFO_METHOD_HANDLE interceptor_ICJI::getUnboxedEntry(CORINFO_METHOD_HANDLE ftn, bool* requiresInstMethodTableArg)
 {
@@ -683,6 +697,17 @@ unsigned interceptor_ICJI::getClassSize(CORINFO_CLASS_HANDLE cls)
     return temp;
 }
 
+// return the number of bytes needed by an instance of a reference class
+// allocated on the heap, including the method table pointer but not the
+// object header
+unsigned interceptor_ICJI::getHeapClassSize(CORINFO_CLASS_HANDLE cls)
+{
+    mc->cr->AddCall("getHeapClassSize");
+    unsigned temp = original_ICorJitInfo->getHeapClassSize(cls);
+    mc->recGetHeapClassSize(cls, temp);
+    return temp;
+}
+
 unsigned interceptor_ICJI::getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint)
 {
     mc->cr->AddCall("getClassAlignmentRequirement");
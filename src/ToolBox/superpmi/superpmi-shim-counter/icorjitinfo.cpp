@@ -163,6 +163,18 @@ CORINFO_METHOD_HANDLE interceptor_ICJI::resolveVirtualMethod(CORINFO_METHOD_HAND
     return original_ICorJitInfo->resolveVirtualMethod(virtualMethod, implementingClass, ownerType);
 }
 
+// Get the class most likely to be seen as 'this' by the virtual call at
+// ilOffset in method, as observed by tier0 code, or the class profile cell
+// to instrument the call with when pCell is non-null.
+CORINFO_CLASS_HANDLE interceptor_ICJI::getLikelyClass(CORINFO_METHOD_HANDLE method,
+                                                      unsigned              ilOffset,
+                                                      unsigned*             pLikelihood,
+                                                      void**                pCell)
+{
+    mcs->AddCall("getLikelyClass");
+    return original_ICorJitInfo->getLikelyClass(method, ilOffset, pLikelihood, pCell);
+}
+
 // Get the unboxed entry point for a method, if possible.
 CORINFO_METHOD_HANDLE interceptor_ICJI::getUnboxedEntry(CORINFO_METHOD_HANDLE ftn, bool* requiresInstMethodTableArg)
 {
@@ -519,6 +531,15 @@ unsigned interceptor_ICJI::getClassSize(CORINFO_CLASS_HANDLE cls)
     return original_ICorJitInfo->getClassSize(cls);
 }
 
+// return the number of bytes needed by an instance of a reference class
+// allocated on the heap, including the method table pointer but not the
+// object header
+unsigned interceptor_ICJI::getHeapClassSize(CORINFO_CLASS_HANDLE cls)
+{
+    mcs->AddCall("getHeapClassSize");
+    return original_ICorJitInfo->getHeapClassSize(cls);
+}
+
 unsigned interceptor_ICJI::getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint)
 {
     mcs->AddCall("getClassAlignmentRequirement");
@@ -141,6 +141,17 @@ void interceptor_ICJI::getMethodVTableOffset(CORINFO_METHOD_HANDLE method,
     original_ICorJitInfo->getMethodVTableOffset(method, offsetOfIndirection, offsetAfterIndirection, isRelative);
 }
 
+// Get the class most likely to be seen as 'this' by the virtual call at
+// ilOffset in method, as observed by tier0 code, or the class profile cell
+// to instrument the call with when pCell is non-null.
+CORINFO_CLASS_HANDLE interceptor_ICJI::getLikelyClass(CORINFO_METHOD_HANDLE method,
+                                                      unsigned              ilOffset,
+                                                      unsigned*             pLikelihood,
+                                                      void**                pCell)
+{
+    return original_ICorJitInfo->getLikelyClass(method, ilOffset, pLikelihood, pCell);
+}
+
 // Get the unboxed entry point for a method, if possible.
 CORINFO_METHOD_HANDLE interceptor_ICJI::getUnboxedEntry(CORINFO_METHOD_HANDLE ftn, bool* requiresInstMethodTableArg)
 {
@@ -464,6 +475,14 @@ unsigned interceptor_ICJI::getClassSize(CORINFO_CLASS_HANDLE cls)
     return original_ICorJitInfo->getClassSize(cls);
 }
 
+// return the number of bytes needed by an instance of a reference class
+// allocated on the heap, including the method table pointer but not the
+// object header
+unsigned interceptor_ICJI::getHeapClassSize(CORINFO_CLASS_HANDLE cls)
+{
+    return original_ICorJitInfo->getHeapClassSize(cls);
+}
+
 unsigned interceptor_ICJI::getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint)
 {
     return original_ICorJitInfo->getClassAlignmentRequirement(cls, fDoubleAlignHint);
@@ -185,6 +185,18 @@ CORINFO_METHOD_HANDLE MyICJI::resolveVirtualMethod(CORINFO_METHOD_HANDLE  virtua
     return result;
 }
 
+// Get the class most likely to be seen as 'this' by the virtual call at
+// ilOffset in method, as observed by tier0 code, or the class profile cell
+// to instrument the call with when pCell is non-null.
+CORINFO_CLASS_HANDLE MyICJI::getLikelyClass(CORINFO_METHOD_HANDLE method,
+                                            unsigned              ilOffset,
+                                            unsigned*             pLikelihood,
+                                            void**                pCell)
+{
+    jitInstance->mc->cr->AddCall("getLikelyClass");
+    return jitInstance->mc->repGetLikelyClass(method, ilOffset, pLikelihood, pCell);
+}
+
 // Get the unboxed entry point for a method, if possible.
 CORINFO_METHOD_HANDLE MyICJI::getUnboxedEntry(CORINFO_METHOD_HANDLE ftn, bool* requiresInstMethodTableArg)
 {
@@ -577,6 +589,15 @@ unsigned MyICJI::getClassSize(CORINFO_CLASS_HANDLE cls)
     return jitInstance->mc->repGetClassSize(cls);
 }
 
+// return the number of bytes needed by an instance of a reference class
+// allocated on the heap, including the method table pointer but not the
+// object header
+unsigned MyICJI::getHeapClassSize(CORINFO_CLASS_HANDLE cls)
+{
+    jitInstance->mc->cr->AddCall("getHeapClassSize");
+    return jitInstance->mc->repGetHeapClassSize(cls);
+}
+
 unsigned MyICJI::getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint)
 {
     jitInstance->mc->cr->AddCall("getClassAlignmentRequirement");
@@ -11,6 +11,7 @@
 #define FireEtwGCRestartEEEnd_V1(ClrInstanceID) 0
 #define FireEtwGCHeapStats(GenerationSize0, TotalPromotedSize0, GenerationSize1, TotalPromotedSize1, GenerationSize2, TotalPromotedSize2, GenerationSize3, TotalPromotedSize3, FinalizationPromotedSize, FinalizationPromotedCount, PinnedObjectCount, SinkBlockCount, GCHandleCount) 0
 #define FireEtwGCHeapStats_V1(GenerationSize0, TotalPromotedSize0, GenerationSize1, TotalPromotedSize1, GenerationSize2, TotalPromotedSize2, GenerationSize3, TotalPromotedSize3, FinalizationPromotedSize, FinalizationPromotedCount, PinnedObjectCount, SinkBlockCount, GCHandleCount, ClrInstanceID) 0
+#define FireEtwGCSyncBlockStats(SyncBlockCount, InflationCount, DeflationCount, ClrInstanceID) 0
 #define FireEtwGCCreateSegment(Address, Size, Type) 0
 #define FireEtwGCCreateSegment_V1(Address, Size, Type, ClrInstanceID) 0
 #define FireEtwGCFreeSegment(Address) 0
@@ -97,6 +98,7 @@
 #define FireEtwContention() 0
 #define FireEtwContentionStart_V1(ContentionFlags, ClrInstanceID) 0
 #define FireEtwContentionStop(ContentionFlags, ClrInstanceID) 0
+#define FireEtwContentionStop_V1(ContentionFlags, ClrInstanceID, DurationNs) 0
 #define FireEtwCLRStackWalk(ClrInstanceID, Reserved1, Reserved2, FrameCount, Stack) 0
 #define FireEtwAppDomainMemAllocated(AppDomainID, Allocated, ClrInstanceID) 0
 #define FireEtwAppDomainMemSurvived(AppDomainID, Survived, ProcessSurvived, ClrInstanceID) 0
@@ -169,6 +171,7 @@
 #define FireEtwDebugExceptionProcessingStart() 0
 #define FireEtwDebugExceptionProcessingEnd() 0
 #define FireEtwCodeSymbols(ModuleId, TotalChunks, ChunkNumber, ChunkLength, Chunk, ClrInstanceID) 0
+#define FireEtwTieredCompilationBacklog(BacklogDepth, WorkerThreadCount, MethodsOptimized, ClrInstanceID) 0
 #define FireEtwCLRStackWalkDCStart(ClrInstanceID, Reserved1, Reserved2, FrameCount, Stack) 0
 #define FireEtwMethodDCStart(MethodID, ModuleID, MethodStartAddress, MethodSize, MethodToken, MethodFlags) 0
 #define FireEtwMethodDCStart_V1(MethodID, ModuleID, MethodStartAddress, MethodSize, MethodToken, MethodFlags, ClrInstanceID) 0
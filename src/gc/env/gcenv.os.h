@@ -345,7 +345,9 @@ public:
     // Remarks:
     //  If a process runs with a restricted memory limit, it returns the limit. If there's no limit 
     //  specified, it returns amount of actual physical memory.
-    static uint64_t GetPhysicalMemoryLimit();
+    //  If is_restricted is not NULL it is set to whether the limit came from a restriction
+    //  (job object or cgroup) rather than the amount of physical memory.
+    static uint64_t GetPhysicalMemoryLimit(bool* is_restricted = nullptr);
 
     // Get memory status
     // Parameters:
@@ -20,6 +20,12 @@
 #include "gcpriv.h"
 #include "softwarewritewatch.h"
 
+#if defined(_TARGET_AMD64_)
+// SSE2 is part of the amd64 baseline so it can be used without checking for it.
+#include <emmintrin.h>
+#define VECTORIZED_CARD_SCAN
+#endif //_TARGET_AMD64_
+
 #define USE_INTROSORT
 
 #if defined(BACKGROUND_GC) && defined(FEATURE_EVENT_TRACE)
@@ -411,6 +417,13 @@ void c_write (uint32_t& place, uint32_t value)
 // If every heap's gen2 or gen3 size is less than this threshold we will do a blocking GC.
 const size_t bgc_min_per_heap = 4*1024*1024;
 
+#ifdef MULTIPLE_HEAPS
+// The most mark stack entries a BGC thread hands to idle BGC threads at a time
+// and how deep its mark stack needs to be before it does.
+const size_t bgc_steal_length = 256;
+const size_t bgc_steal_min_depth = 16;
+#endif //MULTIPLE_HEAPS
+
 int gc_heap::gchist_index = 0;
 gc_mechanisms_store gc_heap::gchist[max_history_count];
 
@@ -2208,6 +2221,10 @@ uint8_t* gc_heap::pad_for_alignment_large (uint8_t* newAlloc, int requiredAlignm
 
 #endif //SERVER_GC
 
+// With a heap hard limit segments are sized from the limit, but are never
+// smaller than this.
+const size_t min_segment_size_hard_limit = 1024*1024*16;
+
 //amount in bytes of the etw allocation tick
 const size_t etw_allocation_tick = 100*1024;
 
@@ -2423,6 +2440,22 @@ bool        gc_heap::gc_thread_no_affinitize_p = false;
 
 int         gc_heap::n_heaps;
 
+int         gc_heap::n_active_heaps;
+
+bool        gc_heap::dynamic_heap_count_p;
+
+uint64_t    gc_heap::heap_count_gc_start_ts;
+
+uint64_t    gc_heap::heap_count_last_gc_end_ts;
+
+size_t      gc_heap::heap_count_allocated;
+
+size_t      gc_heap::heap_count_sample_gc_index;
+
+int         gc_heap::heap_count_samples[heap_count_samples_count];
+
+int         gc_heap::heap_count_sample_index;
+
 gc_heap**   gc_heap::g_heaps;
 
 size_t*     gc_heap::g_promoted;
@@ -2434,6 +2467,12 @@ int*        gc_heap::g_mark_stack_busy;
 
 #ifdef BACKGROUND_GC
 size_t*     gc_heap::g_bpromoted;
+
+VOLATILE(int32_t) gc_heap::bgc_mark_steal_idle = 0;
+
+VOLATILE(BOOL) gc_heap::bgc_mark_steal_active_p = FALSE;
+
+BOOL        gc_heap::bgc_mark_steal_p = FALSE;
 #endif //BACKGROUND_GC
 
 #else  //MULTIPLE_HEAPS
@@ -2462,6 +2501,8 @@ size_t      gc_heap::gc_last_ephemeral_decommit_time = 0;
 
 size_t      gc_heap::gc_gen0_desired_high;
 
+size_t      gc_heap::region_size = 0;
+
 #ifdef SHORT_PLUGS
 double       gc_heap::short_plugs_pad_ratio = 0;
 #endif //SHORT_PLUGS
@@ -2483,6 +2524,12 @@ uint32_t    gc_heap::high_memory_load_th;
 
 uint64_t    gc_heap::total_physical_mem;
 
+size_t      gc_heap::heap_hard_limit = 0;
+
+size_t      gc_heap::current_total_committed = 0;
+
+CLRCriticalSection gc_heap::check_commit_cs;
+
 uint64_t    gc_heap::entry_available_physical_mem;
 
 #ifdef BACKGROUND_GC
@@ -2550,6 +2597,10 @@ BOOL        gc_heap::ro_segments_in_range;
 
 size_t      gc_heap::gen0_big_free_spaces = 0;
 
+size_t      gc_heap::ephemeral_desired_high = 0;
+
+size_t      gc_heap::ephemeral_decommit_time = 0;
+
 uint8_t*    gc_heap::ephemeral_low;
 
 uint8_t*    gc_heap::ephemeral_high;
@@ -4539,6 +4590,24 @@ static size_t get_valid_segment_size (BOOL large_seg=FALSE)
     return (seg_size);
 }
 
+// Each heap gets an equal share of the hard limit for its segments, so that
+// what the heaps start out reserving is in proportion to what they may commit.
+size_t gc_heap::get_segment_size_hard_limit (uint32_t nhp)
+{
+    assert (heap_hard_limit);
+    size_t seg_size = max ((heap_hard_limit / nhp), min_segment_size_hard_limit);
+
+#ifdef SEG_MAPPING_TABLE
+#ifdef BIT64
+    seg_size = round_up_power2 (seg_size);
+#else
+    seg_size = round_down_power2 (seg_size);
+#endif // BIT64
+#endif //SEG_MAPPING_TABLE
+
+    return seg_size;
+}
+
 void
 gc_heap::compute_new_ephemeral_size()
 {
@@ -4809,6 +4878,7 @@ gc_heap::get_segment (size_t size, BOOL loh_p)
 
             if (gc_heap::grow_brick_card_tables (start, end, size, result, __this, loh_p) != 0)
             {
+                release_committed (heap_segment_committed (result) - (uint8_t*)mem);
                 virtual_free (mem, size);
                 return 0;
             }
@@ -4847,6 +4917,7 @@ void release_segment (heap_segment* sg)
 {
     ptrdiff_t delta = 0;
     FireEtwGCFreeSegment_V1((size_t)heap_segment_mem(sg), GetClrInstanceId());
+    gc_heap::release_committed ((uint8_t*)heap_segment_committed (sg) - (uint8_t*)sg);
     virtual_free (sg, (uint8_t*)heap_segment_reserved (sg)-(uint8_t*)sg);
 }
 
@@ -5038,6 +5109,7 @@ class heap_select
     static uint16_t heap_no_to_cpu_group[MAX_SUPPORTED_CPUS];
     static uint16_t heap_no_to_group_proc[MAX_SUPPORTED_CPUS];
     static uint16_t numa_node_to_heap_map[MAX_SUPPORTED_CPUS+4];
+    static uint16_t heap_no_in_numa_order[MAX_SUPPORTED_CPUS];
 
     static int access_time(uint8_t *sniff_buffer, int heap_number, unsigned sniff_index, unsigned n_sniff_buffers)
     {
@@ -5110,7 +5182,7 @@ public:
         UNREFERENCED_PARAMETER(acontext); // only referenced by dprintf
 
         if (GCToOSInterface::CanGetCurrentProcessorNumber())
-            return proc_no_to_heap_no[GCToOSInterface::GetCurrentProcessorNumber() % gc_heap::n_heaps];
+            return get_active_heap_no (proc_no_to_heap_no[GCToOSInterface::GetCurrentProcessorNumber() % gc_heap::n_heaps]);
 
         unsigned sniff_index = Interlocked::Increment(&cur_sniff_index);
         sniff_index %= n_sniff_buffers;
@@ -5121,7 +5193,8 @@ public:
 
         uint8_t *l_sniff_buffer = sniff_buffer;
         unsigned l_n_sniff_buffers = n_sniff_buffers;
-        for (int heap_number = 0; heap_number < gc_heap::n_heaps; heap_number++)
+        int n_active_heaps = VolatileLoad (&gc_heap::n_active_heaps);
+        for (int heap_number = 0; heap_number < n_active_heaps; heap_number++)
         {
             int this_access_time = access_time(l_sniff_buffer, heap_number, sniff_index, l_n_sniff_buffers);
             if (this_access_time < best_access_time)
@@ -5199,24 +5272,83 @@ public:
     {   // called right after GCHeap::Init() for each heap is finished
         // when numa is not enabled, heap_no_to_numa_node[] are all filled
         // with 0s during initialization, and will be treated as one node
-        numa_node_to_heap_map[0] = 0;
-        int node_index = 1;
+        //
+        // Heaps of the same node are not necessarily numbered contiguously
+        // (processors commonly alternate between nodes on Linux), so heaps are
+        // listed in heap_no_in_numa_order[] grouped by node, and the heaps of
+        // node n are at [numa_node_to_heap_map[n], numa_node_to_heap_map[n+1]).
+        int highest_node = 0;
+        for (int i = 0; i < nheaps; i++)
+        {
+            // node numbers index numa_node_to_heap_map; anything beyond it is
+            // treated as the last node we can represent.
+            if (heap_no_to_numa_node[i] > MAX_SUPPORTED_CPUS)
+                heap_no_to_numa_node[i] = MAX_SUPPORTED_CPUS;
+            highest_node = max (highest_node, (int)heap_no_to_numa_node[i]);
+        }
+
+        memset (numa_node_to_heap_map, 0, sizeof (numa_node_to_heap_map));
+        for (int i = 0; i < nheaps; i++)
+        {
+            numa_node_to_heap_map[heap_no_to_numa_node[i] + 1]++;
+        }
+        for (int node = 0; node <= highest_node; node++)
+        {
+            numa_node_to_heap_map[node + 1] += numa_node_to_heap_map[node];
+        }
+        assert (numa_node_to_heap_map[highest_node + 1] == nheaps);
+
+        // stable counting sort so heaps of a node stay in heap number order
+        uint16_t next_index[MAX_SUPPORTED_CPUS+1];
+        memcpy (next_index, numa_node_to_heap_map, sizeof (next_index));
+        for (int i = 0; i < nheaps; i++)
+        {
+            heap_no_in_numa_order[next_index[heap_no_to_numa_node[i]]++] = (uint16_t)i;
+        }
 
-        for (int i=1; i < nheaps; i++)
+        for (int node = 0; node <= highest_node; node++)
         {
-            if (heap_no_to_numa_node[i] != heap_no_to_numa_node[i-1])
-                numa_node_to_heap_map[node_index++] = (uint16_t)i;
+            dprintf (3, ("numa node %d has heaps [%d, %d) in numa order", node,
+                numa_node_to_heap_map[node], numa_node_to_heap_map[node + 1]));
         }
-        numa_node_to_heap_map[node_index] = (uint16_t)nheaps; //mark the end with nheaps
     }
 
     static void get_heap_range_for_heap(int hn, int* start, int* end)
     {   // 1-tier/no numa case: heap_no_to_numa_node[] all zeros, 
         // and treated as in one node. thus: start=0, end=n_heaps
+        // The range is in numa order, use heap_no_at_numa_order to get the heap numbers.
         uint16_t numa_node = heap_no_to_numa_node[hn];
         *start = (int)numa_node_to_heap_map[numa_node];
         *end   = (int)(numa_node_to_heap_map[numa_node+1]);
     }
+
+    static int heap_no_at_numa_order(int index)
+    {
+        return (int)heap_no_in_numa_order[index];
+    }
+
+    // Returns heap_number if it is allocated on, otherwise an active heap on
+    // the same numa node if there is one. Active heaps are the lowest numbered
+    // ones so they are at the start of each node's range.
+    static int get_active_heap_no(int heap_number)
+    {
+        int n_active_heaps = VolatileLoad (&gc_heap::n_active_heaps);
+        if (heap_number < n_active_heaps)
+            return heap_number;
+
+        int start, end;
+        get_heap_range_for_heap (heap_number, &start, &end);
+        int active_end = start;
+        while ((active_end < end) && (heap_no_at_numa_order (active_end) < n_active_heaps))
+        {
+            active_end++;
+        }
+
+        if (active_end == start)
+            return (heap_number % n_active_heaps);
+
+        return heap_no_at_numa_order (start + (heap_number % (active_end - start)));
+    }
 };
 uint8_t* heap_select::sniff_buffer;
 unsigned heap_select::n_sniff_buffers;
@@ -5227,6 +5359,7 @@ uint16_t heap_select::heap_no_to_numa_node[MAX_SUPPORTED_CPUS];
 uint16_t heap_select::heap_no_to_cpu_group[MAX_SUPPORTED_CPUS];
 uint16_t heap_select::heap_no_to_group_proc[MAX_SUPPORTED_CPUS];
 uint16_t heap_select::numa_node_to_heap_map[MAX_SUPPORTED_CPUS+4];
+uint16_t heap_select::heap_no_in_numa_order[MAX_SUPPORTED_CPUS];
 
 BOOL gc_heap::create_thread_support (unsigned number_of_heaps)
 {
@@ -5469,7 +5602,7 @@ void gc_heap::gc_thread_function ()
 
 bool virtual_alloc_commit_for_heap(void* addr, size_t size, int h_number)
 {
-#if defined(MULTIPLE_HEAPS) && !defined(FEATURE_REDHAWK) && !defined(FEATURE_PAL)
+#if defined(MULTIPLE_HEAPS) && !defined(FEATURE_REDHAWK)
     // Currently there is no way for us to specific the numa node to allocate on via hosting interfaces to
     // a host. This will need to be added later.
 #if !defined(FEATURE_CORECLR)
@@ -5493,6 +5626,59 @@ bool virtual_alloc_commit_for_heap(void* addr, size_t size, int h_number)
     return GCToOSInterface::VirtualCommit(addr, size);
 }
 
+bool gc_heap::virtual_commit (void* address, size_t size, int h_number)
+{
+    if (heap_hard_limit)
+    {
+        check_commit_cs.Enter();
+        bool exceeded_p = (size > (heap_hard_limit - current_total_committed));
+        if (!exceeded_p)
+        {
+            current_total_committed += size;
+        }
+        check_commit_cs.Leave();
+
+        if (exceeded_p)
+        {
+            dprintf (1, ("h%d: committing %Id would exceed the hard limit (%Id committed, limit %Id)",
+                h_number, size, current_total_committed, heap_hard_limit));
+            return false;
+        }
+    }
+
+    bool commit_succeeded_p = virtual_alloc_commit_for_heap (address, size, h_number);
+
+    if (!commit_succeeded_p)
+    {
+        release_committed (size);
+    }
+
+    return commit_succeeded_p;
+}
+
+bool gc_heap::virtual_decommit (void* address, size_t size)
+{
+    bool decommit_succeeded_p = GCToOSInterface::VirtualDecommit (address, size);
+
+    if (decommit_succeeded_p)
+    {
+        release_committed (size);
+    }
+
+    return decommit_succeeded_p;
+}
+
+void gc_heap::release_committed (size_t size)
+{
+    if (heap_hard_limit)
+    {
+        check_commit_cs.Enter();
+        assert (current_total_committed >= size);
+        current_total_committed -= size;
+        check_commit_cs.Leave();
+    }
+}
+
 #ifndef SEG_MAPPING_TABLE
 inline
 heap_segment* gc_heap::segment_of (uint8_t* add, ptrdiff_t& delta, BOOL verify_p)
@@ -6502,6 +6688,27 @@ BOOL gc_heap::card_bundle_set_p (size_t cardb)
     return (card_bundle_table[card_bundle_word(cardb)] & (1 << card_bundle_bit (cardb)));
 }
 
+// Returns the first set card bundle between cardb and end_cardb, or end_cardb
+// if there is none. Card bundle words that are clear are skipped a whole word,
+// ie, card_bundle_word_width bundles, at a time.
+size_t gc_heap::find_card_bundle (size_t cardb, size_t end_cardb)
+{
+    while (cardb < end_cardb)
+    {
+        uint32_t bits = card_bundle_table[card_bundle_word (cardb)] >> card_bundle_bit (cardb);
+        if (bits)
+        {
+            DWORD bit_index;
+            BitScanForward (&bit_index, bits);
+            return min ((cardb + bit_index), end_cardb);
+        }
+
+        cardb = (card_bundle_word (cardb) + 1) * card_bundle_word_width;
+    }
+
+    return end_cardb;
+}
+
 // Returns the size (in bytes) of a card bundle representing the region from 'from' to 'end'
 size_t size_card_bundle_of (uint8_t* from, uint8_t* end)
 {
@@ -9186,7 +9393,7 @@ heap_segment* gc_heap::make_heap_segment (uint8_t* new_pages, size_t size, int h
     size_t initial_commit = SEGMENT_INITIAL_COMMIT;
 
     //Commit the first page
-    if (!virtual_alloc_commit_for_heap (new_pages, initial_commit, h_number))
+    if (!virtual_commit (new_pages, initial_commit, h_number))
     {
         return 0;
     }
@@ -9216,6 +9423,11 @@ void gc_heap::init_heap_segment (heap_segment* seg)
 #endif //BACKGROUND_GC
 }
 
+BOOL gc_heap::hoard_segments_p()
+{
+    return (GCConfig::GetRetainVM() || (region_size != 0));
+}
+
 //Releases the segment to the OS.
 // this is always called on one thread only so calling seg_table->remove is fine.
 void gc_heap::delete_heap_segment (heap_segment* seg, BOOL consider_hoarding)
@@ -9230,8 +9442,9 @@ void gc_heap::delete_heap_segment (heap_segment* seg, BOOL consider_hoarding)
     {
         assert ((heap_segment_mem (seg) - (uint8_t*)seg) <= ptrdiff_t(2*OS_PAGE_SIZE));
         size_t ss = (size_t) (heap_segment_reserved (seg) - (uint8_t*)seg);
-        //Don't keep the big ones.
-        if (ss <= INITIAL_ALLOC)
+        //Don't keep the big ones, unless with regions where segments are
+        //kept so their reservations can be reused.
+        if ((ss <= INITIAL_ALLOC) || region_size)
         {
             dprintf (2, ("Hoarding segment %Ix", (size_t)seg));
 #ifdef BACKGROUND_GC
@@ -9297,7 +9510,7 @@ void gc_heap::decommit_heap_segment_pages (heap_segment* seg,
         page_start += max(extra_space, 32*OS_PAGE_SIZE);
         size -= max (extra_space, 32*OS_PAGE_SIZE);
 
-        GCToOSInterface::VirtualDecommit (page_start, size);
+        virtual_decommit (page_start, size);
         dprintf (3, ("Decommitting heap segment [%Ix, %Ix[(%d)", 
             (size_t)page_start, 
             (size_t)(page_start + size),
@@ -9322,7 +9535,7 @@ void gc_heap::decommit_heap_segment (heap_segment* seg)
 #endif //BACKGROUND_GC
 
     size_t size = heap_segment_committed (seg) - page_start;
-    GCToOSInterface::VirtualDecommit (page_start, size);
+    virtual_decommit (page_start, size);
 
     //re-init the segment object
     heap_segment_committed (seg) = page_start;
@@ -9355,8 +9568,7 @@ void gc_heap::rearrange_small_heap_segments()
     while (seg)
     {
         heap_segment* next_seg = heap_segment_next (seg);
-        // TODO: we need to consider hoarding here.
-        delete_heap_segment (seg, FALSE);
+        delete_heap_segment (seg, (region_size != 0));
         seg = next_seg;
     }
     freeable_small_heap_segment = 0;
@@ -9370,7 +9582,7 @@ void gc_heap::rearrange_large_heap_segments()
     while (seg)
     {
         heap_segment* next_seg = heap_segment_next (seg);
-        delete_heap_segment (seg, GCConfig::GetRetainVM());
+        delete_heap_segment (seg, hoard_segments_p());
         seg = next_seg;
     }
     freeable_large_heap_segment = 0;
@@ -9413,7 +9625,7 @@ void gc_heap::rearrange_heap_segments(BOOL compacting)
                 assert (prev_seg);
                 assert (seg != ephemeral_heap_segment);
                 heap_segment_next (prev_seg) = next_seg;
-                delete_heap_segment (seg, GCConfig::GetRetainVM());
+                delete_heap_segment (seg, hoard_segments_p());
 
                 dprintf (2, ("Deleting heap segment %Ix", (size_t)seg));
             }
@@ -9998,6 +10210,8 @@ HRESULT gc_heap::initialize_gc (size_t segment_size,
 
 #ifdef MULTIPLE_HEAPS
     n_heaps = number_of_heaps;
+    n_active_heaps = number_of_heaps;
+    dynamic_heap_count_p = GCConfig::GetDynamicHeapCount() && (number_of_heaps > 1);
 
     g_heaps = new (nothrow) gc_heap* [number_of_heaps];
     if (!g_heaps)
@@ -10018,6 +10232,10 @@ HRESULT gc_heap::initialize_gc (size_t segment_size,
     if (!g_promoted || !g_bpromoted)
         return E_OUTOFMEMORY;
 
+#ifdef BACKGROUND_GC
+    bgc_mark_steal_p = GCConfig::GetBGCMarkSteal() && (number_of_heaps > 1);
+#endif //BACKGROUND_GC
+
 #ifdef MH_SC_MARK
     if (!g_mark_stack_busy)
         return E_OUTOFMEMORY;
@@ -10403,6 +10621,10 @@ gc_heap::init_gc_heap (int  h_number)
 
     gen0_must_clear_bricks = 0;
 
+    ephemeral_desired_high = 0;
+
+    ephemeral_decommit_time = 0;
+
     allocation_quantum = CLR_SIZE;
 
     more_space_lock = gc_lock;
@@ -10426,6 +10648,19 @@ gc_heap::init_gc_heap (int  h_number)
     }
 
     heap_number = h_number;
+
+    // Work out which processor and numa node this heap's GC thread will be
+    // affinitized to before committing any memory for the heap, so its
+    // initial segments are committed on that node. The GC thread recomputes
+    // the same affinity when it starts.
+    if (!gc_thread_no_affinitize_p)
+    {
+        GCThreadAffinity affinity;
+        if (CPUGroupInfo::CanEnableGCCPUGroups())
+            set_thread_group_affinity_for_heap(heap_number, &affinity);
+        else
+            set_thread_affinity_mask_for_heap(heap_number, &affinity);
+    }
 #endif //MULTIPLE_HEAPS
 
     memset (&oom_info, 0, sizeof (oom_info));
@@ -10599,6 +10834,20 @@ gc_heap::init_gc_heap (int  h_number)
         return 0;
 
     make_background_mark_stack (b_arr);
+
+#ifdef MULTIPLE_HEAPS
+    bgc_steal_array = new (nothrow) (uint8_t* [bgc_steal_length]);
+    if (!bgc_steal_array)
+        return 0;
+
+    bgc_stolen_array = new (nothrow) (uint8_t* [bgc_steal_length]);
+    if (!bgc_stolen_array)
+        return 0;
+
+    bgc_steal_count = 0;
+    bgc_stolen_count = 0;
+    bgc_steal_lock = -1;
+#endif //MULTIPLE_HEAPS
 #endif //BACKGROUND_GC
 
     ephemeral_low = generation_allocation_start(generation_of(max_generation - 1));
@@ -10901,7 +11150,7 @@ BOOL gc_heap::grow_heap_segment (heap_segment* seg, uint8_t* high_address)
 
     dprintf(3, ("Growing segment allocation %Ix %Ix", (size_t)heap_segment_committed(seg),c_size));
     
-    if (!virtual_alloc_commit_for_heap(heap_segment_committed (seg), c_size, heap_number))
+    if (!virtual_commit (heap_segment_committed (seg), c_size, heap_number))
     {
         dprintf(3, ("Cannot grow heap segment"));
         return FALSE;
@@ -13269,6 +13518,8 @@ void gc_heap::balance_heaps (alloc_context* acontext)
         BOOL set_home_heap = FALSE;
         int hint = 0;
 
+        int n_active = VolatileLoad (&n_active_heaps);
+
         if (heap_select::can_find_heap_fast())
         {
             if (acontext->get_home_heap() != NULL)
@@ -13285,6 +13536,10 @@ void gc_heap::balance_heaps (alloc_context* acontext)
                 set_home_heap = TRUE;
         }
 
+        // The heap this context allocates on was retired, move it to an active one.
+        if (acontext->get_alloc_heap()->pGenGCHeap->heap_number >= n_active)
+            set_home_heap = TRUE;
+
         if (set_home_heap)
         {
 /*
@@ -13309,15 +13564,25 @@ void gc_heap::balance_heaps (alloc_context* acontext)
                 ptrdiff_t max_size;
                 size_t delta = dd_min_size (dd)/4;
 
+                // Look for a heap on the node the thread is running on first, which
+                // is the node of its home heap. That is not necessarily the node of
+                // the heap it is currently allocating on if the thread has moved.
+                acontext->set_home_heap(GCHeap::GetHeap( heap_select::select_heap(acontext, hint) ));
+                int home_hp_num = acontext->get_home_heap()->pGenGCHeap->heap_number;
+                uint16_t home_node = heap_select::find_numa_node_from_heap_no (home_hp_num);
+                BOOL org_hp_on_home_node = (heap_select::find_numa_node_from_heap_no (org_hp->heap_number) == home_node);
+
                 int start, end, finish;
-                heap_select::get_heap_range_for_heap(org_hp->heap_number, &start, &end);
+                heap_select::get_heap_range_for_heap(home_hp_num, &start, &end);
                 finish = start + n_heaps;
 
 try_again:
                 do
                 {
                     max_hp = org_hp;
-                    max_size = org_size + delta;
+                    // Only prefer staying on the current heap if it is local to the thread,
+                    // otherwise let a heap on the home node with as much budget win.
+                    max_size = org_size + (org_hp_on_home_node ? delta : 0);
                     acontext->set_home_heap(GCHeap::GetHeap( heap_select::select_heap(acontext, hint) ));
 
                     if (org_hp == acontext->get_home_heap()->pGenGCHeap)
@@ -13330,7 +13595,9 @@ try_again:
 
                     for (int i = start; i < end; i++)
                     {
-                        gc_heap* hp = GCHeap::GetHeap(i%n_heaps)->pGenGCHeap;
+                        gc_heap* hp = GCHeap::GetHeap(heap_select::heap_no_at_numa_order (i%n_heaps))->pGenGCHeap;
+                        if (hp->heap_number >= n_active)
+                            continue;
                         dd = hp->dynamic_data_of (0);
                         ptrdiff_t size = dd_new_allocation (dd);
                         if (hp == acontext->get_home_heap()->pGenGCHeap)
@@ -13338,7 +13605,8 @@ try_again:
                         int hp_alloc_context_count = hp->alloc_context_count;
                         if (hp_alloc_context_count > 0)
                             size /= (hp_alloc_context_count + 1);
-                        if (size > max_size)
+                        // any active heap is better than a retired one
+                        if ((size > max_size) || (max_hp->heap_number >= n_active))
                         {
                             max_hp = hp;
                             max_size = size;
@@ -13353,6 +13621,7 @@ try_again:
                 {   
                     start = end; end = finish; 
                     delta = dd_min_size(dd)/2; // Make it twice as hard to balance to remote nodes on NUMA.
+                    org_hp_on_home_node = TRUE;
                     goto try_again;
                 }
 
@@ -13401,10 +13670,11 @@ try_again:
                                  org_hp->heap_number,
                                  org_size,
                                  org_alloc_context_count));
-                    dprintf (3, (" to heap %d (%Id free bytes, %d contexts)\n", 
+                    dprintf (3, (" to heap %d (%Id free bytes, %d contexts, %s node)\n", 
                                  max_hp->heap_number,
                                  dd_new_allocation(max_hp->dynamic_data_of(0)),
-                                                   max_alloc_context_count));
+                                                   max_alloc_context_count,
+                                 ((heap_select::find_numa_node_from_heap_no (max_hp->heap_number) == home_node) ? "home" : "remote")));
                 }
             }
         }
@@ -13426,6 +13696,7 @@ gc_heap* gc_heap::balance_heaps_loh (alloc_context* acontext, size_t /*size*/)
         gc_heap* max_hp;
         ptrdiff_t max_size;
         size_t delta = dd_min_size (dd) * 4;
+        int n_active = VolatileLoad (&n_active_heaps);
 
         int start, end, finish;
         heap_select::get_heap_range_for_heap(org_hp->heap_number, &start, &end);
@@ -13441,13 +13712,16 @@ try_again:
 
             for (int i = start; i < end; i++)
             {
-                gc_heap* hp = GCHeap::GetHeap(i%n_heaps)->pGenGCHeap;
+                gc_heap* hp = GCHeap::GetHeap(heap_select::heap_no_at_numa_order (i%n_heaps))->pGenGCHeap;
+                if (hp->heap_number >= n_active)
+                    continue;
                 dd = hp->dynamic_data_of (max_generation + 1);
                 ptrdiff_t size = dd_new_allocation (dd);
                 dprintf (3, ("hp: %d, size: %d",
                     hp->heap_number,
                     size));
-                if (size > max_size)
+                // any active heap is better than a retired one
+                if ((size > max_size) || (max_hp->heap_number >= n_active))
                 {
                     max_hp = hp;
                     max_size = size;
@@ -13479,6 +13753,108 @@ try_again:
         return org_hp;
     }
 }
+
+// Called by one thread once the heaps have joined at the start of a GC.
+void gc_heap::record_heap_count_sample_start()
+{
+    if (!dynamic_heap_count_p)
+        return;
+
+    heap_count_gc_start_ts = GCToOSInterface::QueryPerformanceCounter();
+    heap_count_sample_gc_index = settings.gc_index;
+
+    size_t allocated = 0;
+    for (int i = 0; i < n_heaps; i++)
+    {
+        dynamic_data* dd = g_heaps[i]->dynamic_data_of (0);
+        allocated += (size_t)((ptrdiff_t)dd_desired_allocation (dd) - dd_new_allocation (dd));
+    }
+    heap_count_allocated = allocated;
+}
+
+// Called by one thread once the heaps have joined at the end of a blocking GC,
+// before the gen0 and LOH budgets are spread over the active heaps.
+//
+// Every active heap gets the same gen0 budget, so with k heaps allocating a GC
+// happens every k*budget/allocation_rate seconds. Given the pause this GC took
+// the smallest k that keeps the time spent in GC under the target is
+//
+//   k = pause * (1 - target) / target * allocation_rate / budget
+//
+// More heaps mean fewer GCs but more memory held by gen0 budgets; fewer heaps
+// mean the reverse. The estimate is smoothed over the last few GCs, heaps are
+// added as soon as they are needed and retired at most a quarter at a time.
+void gc_heap::adjust_active_heap_count()
+{
+    if (!dynamic_heap_count_p)
+        return;
+
+    uint64_t now = GCToOSInterface::QueryPerformanceCounter();
+    uint64_t last_gc_end = heap_count_last_gc_end_ts;
+    heap_count_last_gc_end_ts = now;
+
+    // Only GCs triggered by running out of gen0 budget tell us how often the
+    // budget is used up.
+    if ((last_gc_end == 0) ||
+        (heap_count_sample_gc_index != settings.gc_index) ||
+        (settings.reason != reason_alloc_soh))
+    {
+        return;
+    }
+
+    double pause = (double)(now - heap_count_gc_start_ts) / (double)qpf;
+    double elapsed = (double)(now - last_gc_end) / (double)qpf;
+    double mutator_time = elapsed - pause;
+    if ((mutator_time <= 0.0) || (pause <= 0.0))
+        return;
+
+    size_t total_budget = 0;
+    for (int i = 0; i < n_active_heaps; i++)
+    {
+        total_budget += dd_desired_allocation (g_heaps[i]->dynamic_data_of (0));
+    }
+    double budget_per_heap = (double)total_budget / (double)n_active_heaps;
+    if (budget_per_heap <= 0.0)
+        return;
+
+    double allocation_rate = (double)heap_count_allocated / mutator_time;
+    double target = (double)max (1, min (50, (int)GCConfig::GetDynamicHeapCountPauseTarget())) / 100.0;
+    double desired = pause * (1.0 - target) / target * allocation_rate / budget_per_heap;
+    int desired_heaps = (int)min ((double)n_heaps, max (1.0, desired + 0.99));
+
+    heap_count_samples[heap_count_sample_index] = desired_heaps;
+    heap_count_sample_index = (heap_count_sample_index + 1) % heap_count_samples_count;
+
+    dprintf (1, ("heap count: pause %dus, %dus since last GC, %Id bytes allocated, %d heaps desired",
+        (int)(pause * 1000000), (int)(elapsed * 1000000), heap_count_allocated, desired_heaps));
+
+    // the median of the last few samples, samples not taken yet are 0
+    int sorted[heap_count_samples_count];
+    memcpy (sorted, heap_count_samples, sizeof (sorted));
+    for (int i = 1; i < heap_count_samples_count; i++)
+    {
+        for (int j = i; (j > 0) && (sorted[j - 1] > sorted[j]); j--)
+        {
+            int temp = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = temp;
+        }
+    }
+    int new_n_active_heaps = sorted[heap_count_samples_count / 2];
+    if (new_n_active_heaps == 0)
+        return;
+
+    if (new_n_active_heaps < n_active_heaps)
+    {
+        new_n_active_heaps = max (new_n_active_heaps, n_active_heaps - max (1, n_active_heaps / 4));
+    }
+
+    if (new_n_active_heaps != n_active_heaps)
+    {
+        dprintf (1, ("heap count: %d -> %d active heaps", n_active_heaps, new_n_active_heaps));
+        VolatileStore (&n_active_heaps, new_n_active_heaps);
+    }
+}
 #endif //MULTIPLE_HEAPS
 
 BOOL gc_heap::allocate_more_space(alloc_context* acontext, size_t size,
@@ -15712,6 +16088,8 @@ void gc_heap::gc1()
         {
             gc_heap::internal_gc_done = false;
 
+            adjust_active_heap_count();
+
             //equalize the new desired size of the generations
             int limit = settings.condemned_generation;
             if (limit == max_generation)
@@ -15722,7 +16100,12 @@ void gc_heap::gc1()
             {
                 size_t total_desired = 0;
 
-                for (int i = 0; i < gc_heap::n_heaps; i++)
+                // Only the active heaps are allocated on in gen0 and LOH, so
+                // their budgets come from those heaps alone.
+                bool allocation_gen_p = ((gen == 0) || (gen == (max_generation + 1)));
+                int n_budget_heaps = (allocation_gen_p ? gc_heap::n_active_heaps : gc_heap::n_heaps);
+
+                for (int i = 0; i < n_budget_heaps; i++)
                 {
                     gc_heap* hp = gc_heap::g_heaps[i];
                     dynamic_data* dd = hp->dynamic_data_of (gen);
@@ -15736,7 +16119,7 @@ void gc_heap::gc1()
                     total_desired = temp_total_desired;
                 }
 
-                size_t desired_per_heap = Align (total_desired/gc_heap::n_heaps,
+                size_t desired_per_heap = Align (total_desired/n_budget_heaps,
                                                     get_alignment_constant ((gen != (max_generation+1))));
 
                 if (gen == 0)
@@ -15791,13 +16174,22 @@ void gc_heap::gc1()
                 {
                     gc_heap* hp = gc_heap::g_heaps[i];
                     dynamic_data* dd = hp->dynamic_data_of (gen);
-                    dd_desired_allocation (dd) = desired_per_heap;
-                    dd_gc_new_allocation (dd) = desired_per_heap;
-                    dd_new_allocation (dd) = desired_per_heap;
+                    size_t heap_desired = desired_per_heap;
+
+                    // Retired heaps keep a minimal budget so that their ephemeral
+                    // pages get decommitted.
+                    if (allocation_gen_p && (i >= gc_heap::n_active_heaps))
+                    {
+                        heap_desired = min (desired_per_heap, dd_min_gc_size (dd));
+                    }
+
+                    dd_desired_allocation (dd) = heap_desired;
+                    dd_gc_new_allocation (dd) = heap_desired;
+                    dd_new_allocation (dd) = heap_desired;
 
                     if (gen == 0)
                     {
-                        hp->fgn_last_alloc = desired_per_heap;
+                        hp->fgn_last_alloc = heap_desired;
                     }
                 }
             }
@@ -16763,6 +17155,10 @@ int gc_heap::garbage_collect (int n)
 
         settings.gc_index = (uint32_t)dd_collection_count (dynamic_data_of (0)) + 1;
 
+#ifdef MULTIPLE_HEAPS
+        record_heap_count_sample_start();
+#endif //MULTIPLE_HEAPS
+
         // Call the EE for start of GC work
         // just one thread for MP GC
         GCToEEInterface::GcStartWork (settings.condemned_generation,
@@ -18523,6 +18919,18 @@ void gc_heap::background_mark_simple1 (uint8_t* oo THREAD_NUMBER_DCL)
 
         allow_fgc();
 
+#ifdef MULTIPLE_HEAPS
+        if (bgc_mark_steal_p && VolatileLoad (&bgc_mark_steal_active_p) &&
+            (VolatileLoad (&bgc_mark_steal_idle) > 0) && (bgc_steal_count == 0) &&
+            ((size_t)(background_mark_stack_tos - background_mark_stack_array) >= bgc_steal_min_depth))
+        {
+            background_donate_mark_work();
+#ifdef SORT_MARK_STACK
+            sorted_tos = background_mark_stack_array;
+#endif //SORT_MARK_STACK
+        }
+#endif //MULTIPLE_HEAPS
+
         if (!(background_mark_stack_tos == background_mark_stack_array))
         {
             oo = *(--background_mark_stack_tos);
@@ -18540,6 +18948,165 @@ void gc_heap::background_mark_simple1 (uint8_t* oo THREAD_NUMBER_DCL)
 
 }
 
+#ifdef MULTIPLE_HEAPS
+// Moves plain entries from the bottom of the mark stack, which are the oldest
+// and tend to lead to the largest unmarked subgraphs, to bgc_steal_array for
+// idle BGC threads to take. Partially marked objects stay on the stack since
+// their (start, object | 1) pairs are resumed by this thread.
+void gc_heap::background_donate_mark_work()
+{
+    if (!try_enter_spin_lock_noinstru (&bgc_steal_lock))
+    {
+        return;
+    }
+
+    if (bgc_steal_count == 0)
+    {
+        uint8_t** tos = background_mark_stack_tos;
+        uint8_t** limit = background_mark_stack_array + (tos - background_mark_stack_array) / 2;
+        uint8_t** src = background_mark_stack_array;
+        uint8_t** dst = background_mark_stack_array;
+        size_t count = 0;
+
+        while ((src < limit) && (count < bgc_steal_length))
+        {
+            if (((src + 1) < tos) && ((size_t)*(src + 1) & 1))
+            {
+                *(dst++) = *(src++);
+                *(dst++) = *(src++);
+            }
+            else
+            {
+                if (*src)
+                {
+                    bgc_steal_array[count++] = *src;
+                }
+                src++;
+            }
+        }
+
+        while (src < tos)
+        {
+            *(dst++) = *(src++);
+        }
+
+        background_mark_stack_tos = dst;
+        bgc_steal_count = count;
+
+        dprintf (3, ("h%d: donated %Id mark stack entries, %Id left", 
+            heap_number, count, (size_t)(dst - background_mark_stack_array)));
+    }
+
+    leave_spin_lock_noinstru (&bgc_steal_lock);
+}
+
+// Moves hp's donated marking work to bgc_stolen_array, which is empty.
+// Returns TRUE if any was taken.
+BOOL gc_heap::background_take_mark_work (gc_heap* hp)
+{
+    BOOL taken_p = FALSE;
+
+    assert (bgc_stolen_count == 0);
+
+    if (try_enter_spin_lock_noinstru (&hp->bgc_steal_lock))
+    {
+        size_t n = hp->bgc_steal_count;
+
+        if (n > 0)
+        {
+            memcpy (bgc_stolen_array, hp->bgc_steal_array, n * sizeof (uint8_t*));
+            bgc_stolen_count = n;
+            hp->bgc_steal_count = 0;
+            taken_p = TRUE;
+
+            dprintf (3, ("h%d: took %Id mark stack entries from h%d", heap_number, n, hp->heap_number));
+        }
+
+        leave_spin_lock_noinstru (&hp->bgc_steal_lock);
+    }
+
+    return taken_p;
+}
+
+// Called by a BGC thread once it has run out of its own marking work in a
+// marking phase. Marks from work the other BGC threads donate until all of them
+// have run out, so a heap holding most of the live object graph does not keep
+// the other BGC threads waiting at the next join.
+//
+// A thread leaves the idle count before taking work, and only donates work
+// while it is not idle, so every thread seeing all threads idle means no
+// thread has work left to donate. Work donated just before that by a thread
+// that then went idle is found by that thread when it looks for work itself.
+// The first thread to see that ends the steal phase, and the others stop once
+// they have looked for work again, so no thread stops with work left in its
+// own bgc_steal_array. Nothing donates marking work after the steal phase.
+void gc_heap::background_mark_steal()
+{
+    if (!bgc_mark_steal_p)
+    {
+        return;
+    }
+
+    THREAD_FROM_HEAP;
+    Interlocked::Increment (&bgc_mark_steal_idle);
+
+    int idle_loop_count = 0;
+
+    while (1)
+    {
+        allow_fgc();
+
+        BOOL stolen_p = FALSE;
+        for (int i = 0; i < n_heaps; i++)
+        {
+            gc_heap* hp = g_heaps [(heap_number + i) % n_heaps];
+            if (VolatileLoad (&hp->bgc_steal_count) == 0)
+            {
+                continue;
+            }
+
+            Interlocked::Decrement (&bgc_mark_steal_idle);
+            stolen_p = background_take_mark_work (hp);
+            while (bgc_stolen_count > 0)
+            {
+                uint8_t* o = bgc_stolen_array[--bgc_stolen_count];
+                background_mark_simple1 (o THREAD_NUMBER_ARG);
+            }
+            Interlocked::Increment (&bgc_mark_steal_idle);
+
+            if (stolen_p)
+            {
+                break;
+            }
+        }
+
+        if (stolen_p)
+        {
+            idle_loop_count = 0;
+        }
+        else if (!VolatileLoad (&bgc_mark_steal_active_p))
+        {
+            break;
+        }
+        else if (VolatileLoad (&bgc_mark_steal_idle) == n_heaps)
+        {
+            bgc_mark_steal_active_p = FALSE;
+            break;
+        }
+        else if ((++idle_loop_count % 32) == 0)
+        {
+            GCToOSInterface::YieldThread (0);
+        }
+        else
+        {
+            YieldProcessor();
+        }
+    }
+
+    Interlocked::Decrement (&bgc_mark_steal_idle);
+}
+#endif //MULTIPLE_HEAPS
+
 //this version is different than the foreground GC because
 //it can't keep pointers to the inside of an object
 //while calling background_mark_simple1. The object could be moved
@@ -18748,6 +19315,22 @@ gc_heap::scan_background_roots (promote_func* fn, int hn, ScanContext *pSC)
         (*fn) ((Object**)finger, pSC, 0);
         finger++;
     }
+
+#ifdef MULTIPLE_HEAPS
+    //scan the marking work donated to other BGC threads
+    for (size_t i = 0; i < bgc_steal_count; i++)
+    {
+        dprintf(3,("background root %Ix", (size_t)bgc_steal_array[i]));
+        (*fn) ((Object**)&bgc_steal_array[i], pSC, 0);
+    }
+
+    //scan the marking work taken from other BGC threads
+    for (size_t i = 0; i < bgc_stolen_count; i++)
+    {
+        dprintf(3,("background root %Ix", (size_t)bgc_stolen_array[i]));
+        (*fn) ((Object**)&bgc_stolen_array[i], pSC, 0);
+    }
+#endif //MULTIPLE_HEAPS
 }
 
 inline
@@ -19162,6 +19745,26 @@ void gc_heap::get_memory_info (uint32_t* memory_load,
                                uint64_t* available_page_file)
 {
     GCToOSInterface::GetMemoryStatus(memory_load, available_physical, available_page_file);
+
+    // With a hard limit the heap can run out of memory well before the machine
+    // or container does, so also report the load relative to the limit. This
+    // lets the usual high memory load tuning compact before the limit is hit.
+    if (heap_hard_limit)
+    {
+        size_t committed = current_total_committed;
+        size_t available = (committed < heap_hard_limit) ? (heap_hard_limit - committed) : 0;
+
+        if (memory_load)
+        {
+            uint32_t hard_limit_load = (uint32_t)(((float)committed * 100) / (float)heap_hard_limit);
+            *memory_load = max (*memory_load, hard_limit_load);
+        }
+
+        if (available_physical)
+        {
+            *available_physical = min (*available_physical, (uint64_t)available);
+        }
+    }
 }
 
 void fire_mark_event (int heap_num, int root_type, size_t bytes_marked)
@@ -25764,6 +26367,8 @@ void gc_heap::background_mark_phase ()
             for (int i = 0; i < n_heaps; i++)
             {
                 g_heaps[i]->current_bgc_state = bgc_mark_handles;
+                g_heaps[i]->bgc_steal_count = 0;
+                g_heaps[i]->bgc_stolen_count = 0;
             }
 #else
             current_bgc_state = bgc_mark_handles;
@@ -25771,6 +26376,11 @@ void gc_heap::background_mark_phase ()
 
             current_c_gc_state = c_gc_state_marking;
 
+#ifdef MULTIPLE_HEAPS
+            bgc_mark_steal_idle = 0;
+            bgc_mark_steal_active_p = TRUE;
+#endif //MULTIPLE_HEAPS
+
             enable_preemptive (current_thread);
 
 #ifdef MULTIPLE_HEAPS
@@ -25818,6 +26428,11 @@ void gc_heap::background_mark_phase ()
         //concurrent_print_time_delta ("concurrent marking dirtied pages on LOH");
         concurrent_print_time_delta ("CRre");
 
+#ifdef MULTIPLE_HEAPS
+        background_mark_steal();
+        concurrent_print_time_delta ("CRsteal");
+#endif //MULTIPLE_HEAPS
+
         enable_preemptive (current_thread);
 
 #ifdef MULTIPLE_HEAPS
@@ -25870,6 +26485,8 @@ void gc_heap::background_mark_phase ()
         if (bgc_t_join.joined())
         {
             bgc_threads_sync_event.Reset();
+            bgc_mark_steal_idle = 0;
+            bgc_mark_steal_active_p = TRUE;
 
             dprintf(3, ("Joining BGC threads for non concurrent final marking"));
             bgc_t_join.restart();
@@ -25954,6 +26571,11 @@ void gc_heap::background_mark_phase ()
         //concurrent_print_time_delta ("nonconcurrent revisit dirtied pages on LOH");
         concurrent_print_time_delta ("NRre LOH");
 
+#ifdef MULTIPLE_HEAPS
+        background_mark_steal();
+        concurrent_print_time_delta ("NRsteal");
+#endif //MULTIPLE_HEAPS
+
 #ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
 #ifdef MULTIPLE_HEAPS
         bgc_t_join.join(this, gc_join_disable_software_write_watch);
@@ -27381,6 +28003,61 @@ uint8_t* gc_heap::find_first_object (uint8_t* start, uint8_t* first_object)
     return o;
 }
 
+// Returns the first non-zero card word between card_word and card_word_end, or
+// card_word_end if they are all zero. On large heaps most card words are zero, so
+// they are tested many at a time - 16 with SSE2, otherwise as many as fit in a
+// size_t.
+inline
+uint32_t* find_non_zero_card_word (uint32_t* card_word, uint32_t* card_word_end)
+{
+#ifdef VECTORIZED_CARD_SCAN
+    const size_t block_words = (4 * sizeof (__m128i)) / sizeof (uint32_t);
+    const size_t block_align = sizeof (__m128i) - 1;
+#else //VECTORIZED_CARD_SCAN
+    const size_t block_words = sizeof (size_t) / sizeof (uint32_t);
+    const size_t block_align = sizeof (size_t) - 1;
+#endif //VECTORIZED_CARD_SCAN
+
+    while ((card_word < card_word_end) && ((size_t)card_word & block_align))
+    {
+        if (*card_word)
+        {
+            return card_word;
+        }
+        card_word++;
+    }
+
+#ifdef VECTORIZED_CARD_SCAN
+    const __m128i zero = _mm_setzero_si128();
+#endif //VECTORIZED_CARD_SCAN
+
+    while ((size_t)(card_word_end - card_word) >= block_words)
+    {
+#ifdef VECTORIZED_CARD_SCAN
+        const __m128i* block = (const __m128i*)card_word;
+        __m128i bits = _mm_or_si128 (_mm_or_si128 (_mm_load_si128 (block), _mm_load_si128 (block + 1)),
+                                     _mm_or_si128 (_mm_load_si128 (block + 2), _mm_load_si128 (block + 3)));
+        if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (bits, zero)) != 0xFFFF)
+        {
+            break;
+        }
+#else //VECTORIZED_CARD_SCAN
+        if (*(size_t*)card_word)
+        {
+            break;
+        }
+#endif //VECTORIZED_CARD_SCAN
+        card_word += block_words;
+    }
+
+    while ((card_word < card_word_end) && !(*card_word))
+    {
+        card_word++;
+    }
+
+    return card_word;
+}
+
 #ifdef CARD_BUNDLE
 
 // Find the first non-zero card word between cardw and cardw_end.
@@ -27397,10 +28074,7 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
         while (1)
         {
             // Find a non-zero bundle
-            while ((cardb < end_cardb) && (card_bundle_set_p (cardb) == 0))
-            {
-                cardb++;
-            }
+            cardb = find_card_bundle (cardb, end_cardb);
 
             if (cardb == end_cardb)
                 return FALSE;
@@ -27408,10 +28082,7 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
             // We found a bundle, so go through its words and find a non-zero card word
             uint32_t* card_word = &card_table[max(card_bundle_cardw (cardb),cardw)];
             uint32_t* card_word_end = &card_table[min(card_bundle_cardw (cardb+1),cardw_end)];
-            while ((card_word < card_word_end) && !(*card_word))
-            {
-                card_word++;
-            }
+            card_word = find_non_zero_card_word (card_word, card_word_end);
 
             if (card_word != card_word_end)
             {
@@ -27437,15 +28108,11 @@ BOOL gc_heap::find_card_dword (size_t& cardw, size_t cardw_end)
         uint32_t* card_word = &card_table[cardw];
         uint32_t* card_word_end = &card_table [cardw_end];
 
-        while (card_word < card_word_end)
+        card_word = find_non_zero_card_word (card_word, card_word_end);
+        if (card_word != card_word_end)
         {
-            if (*card_word != 0)
-            {
-                cardw = (card_word - &card_table [0]);
-                return TRUE;
-            }
-
-            card_word++;
+            cardw = (card_word - &card_table [0]);
+            return TRUE;
         }
 
         return FALSE;
@@ -27494,11 +28161,7 @@ BOOL gc_heap::find_card(uint32_t* card_table,
 #else //CARD_BUNDLE
         // Go through the remaining card words between here and card_word_end until we find
         // one that is non-zero.
-        do
-        {
-            ++last_card_word;
-        }
-        while ((last_card_word < &card_table [card_word_end]) && !(*last_card_word));
+        last_card_word = find_non_zero_card_word ((last_card_word + 1), &card_table [card_word_end]);
 
         if (last_card_word < &card_table [card_word_end])
         {
@@ -27515,11 +28178,10 @@ BOOL gc_heap::find_card(uint32_t* card_table,
     // Look for the lowest bit set
     if (card_word_value)
     {
-        while (!(card_word_value & 1))
-        {
-            bit_position++;
-            card_word_value = card_word_value / 2;
-        }
+        DWORD bit_index;
+        BitScanForward (&bit_index, card_word_value);
+        bit_position += bit_index;
+        card_word_value >>= bit_index;
     }
     
     // card is the card word index * card size + the bit index within the card
@@ -29553,6 +30215,10 @@ bool gc_heap::init_dynamic_data()
                     6*1024*1024 :
                     max (6*1024*1024,  min ( Align(soh_segment_size/2), 200*1024*1024)));
 #endif //MULTIPLE_HEAPS
+    if (heap_hard_limit)
+    {
+        dd->max_size = min (dd->max_size, Align (soh_segment_size / 4));
+    }
     dd->new_allocation = dd->min_gc_size;
     dd->gc_new_allocation = dd->new_allocation;
     dd->desired_allocation = dd->new_allocation;
@@ -30137,6 +30803,12 @@ void gc_heap::decommit_ephemeral_segment_pages()
         return;
     }
 
+    if (region_size)
+    {
+        decommit_ephemeral_segment_regions();
+        return;
+    }
+
     size_t slack_space = heap_segment_committed (ephemeral_heap_segment) - heap_segment_allocated (ephemeral_heap_segment);
     dynamic_data* dd = dynamic_data_of (0);
 
@@ -30181,6 +30853,49 @@ void gc_heap::decommit_ephemeral_segment_pages()
     current_gc_data_per_heap->extra_gen0_committed = heap_segment_committed (ephemeral_heap_segment) - heap_segment_allocated (ephemeral_heap_segment);
 }
 
+// Keeps committed, beyond what is allocated in the ephemeral segment, enough
+// whole regions for the largest gen0 budget seen in the last
+// GC_EPHEMERAL_DECOMMIT_TIMEOUT ms and decommits the rest. Memory committed for
+// a burst of allocations is given back once the burst has passed rather than
+// for as long as the budget computed from it stays high.
+void gc_heap::decommit_ephemeral_segment_regions()
+{
+    heap_segment* seg = ephemeral_heap_segment;
+    dynamic_data* dd = dynamic_data_of (0);
+    size_t desired = dd_desired_allocation (dd);
+    size_t now = dd_time_clock (dd);
+
+    if (g_low_memory_status || ((now - ephemeral_decommit_time) >= GC_EPHEMERAL_DECOMMIT_TIMEOUT))
+    {
+        ephemeral_desired_high = desired;
+        ephemeral_decommit_time = now;
+    }
+    else
+    {
+        ephemeral_desired_high = max (ephemeral_desired_high, desired);
+    }
+
+    uint8_t* allocated = heap_segment_allocated (seg);
+    uint8_t* committed = heap_segment_committed (seg);
+    uint8_t* keep_end = (uint8_t*)(((size_t)(allocated + ephemeral_desired_high) + (region_size - 1)) & ~(region_size - 1));
+
+    if (keep_end < committed)
+    {
+        dprintf (3, ("h%d: decommitting ephemeral regions [%Ix, %Ix[, gen0 high %Id",
+            heap_number, (size_t)keep_end, (size_t)committed, ephemeral_desired_high));
+
+        virtual_decommit (keep_end, (committed - keep_end));
+        heap_segment_committed (seg) = keep_end;
+        if (heap_segment_used (seg) > heap_segment_committed (seg))
+        {
+            heap_segment_used (seg) = heap_segment_committed (seg);
+        }
+    }
+
+    gc_history_per_heap* current_gc_data_per_heap = get_gc_data_per_heap();
+    current_gc_data_per_heap->extra_gen0_committed = heap_segment_committed (seg) - heap_segment_allocated (seg);
+}
+
 size_t gc_heap::new_allocation_limit (size_t size, size_t free_size, int gen_number)
 {
     dynamic_data* dd        = dynamic_data_of (gen_number);
@@ -33516,14 +34231,31 @@ HRESULT GCHeap::Initialize ()
     CreatedObjectCount = 0;
 #endif //TRACE_GC
 
-    size_t seg_size = get_valid_segment_size();
-    gc_heap::soh_segment_size = seg_size;
-    size_t large_seg_size = get_valid_segment_size(TRUE);
-    gc_heap::min_loh_segment_size = large_seg_size;
-    gc_heap::min_segment_size = min (seg_size, large_seg_size);
-#ifdef SEG_MAPPING_TABLE
-    gc_heap::min_segment_size_shr = index_of_set_bit (gc_heap::min_segment_size);
-#endif //SEG_MAPPING_TABLE
+    bool is_restricted;
+    gc_heap::total_physical_mem = GCToOSInterface::GetPhysicalMemoryLimit (&is_restricted);
+
+    // The hard limit caps how much the heaps may commit. It is either given in
+    // bytes, as a percentage of the physical memory limit (which honors cgroup
+    // and job object limits), or when running under such a restriction defaults
+    // to 75% of it so the process is not killed for exceeding it.
+    gc_heap::heap_hard_limit = static_cast<size_t>(GCConfig::GetHeapHardLimit());
+    if (!gc_heap::heap_hard_limit)
+    {
+        uint32_t percent_of_mem = static_cast<uint32_t>(GCConfig::GetHeapHardLimitPercent());
+        if ((percent_of_mem > 0) && (percent_of_mem < 100))
+        {
+            gc_heap::heap_hard_limit = (size_t)(gc_heap::total_physical_mem * (uint64_t)percent_of_mem / (uint64_t)100);
+        }
+        else if (is_restricted)
+        {
+            gc_heap::heap_hard_limit = (size_t)max (((uint64_t)20 * 1024 * 1024), (gc_heap::total_physical_mem / 4 * 3));
+        }
+    }
+
+    if (gc_heap::heap_hard_limit)
+    {
+        gc_heap::check_commit_cs.Initialize();
+    }
 
 #ifdef MULTIPLE_HEAPS
     if (GCConfig::GetNoAffinitize())
@@ -33540,6 +34272,46 @@ HRESULT GCHeap::Initialize ()
 
     nhp = min (nhp, MAX_SUPPORTED_CPUS);
 
+    if (gc_heap::heap_hard_limit)
+    {
+        // Don't split the limit so finely that each heap can barely grow.
+        uint32_t nhp_from_limit = (uint32_t)max ((size_t)1, (gc_heap::heap_hard_limit / min_segment_size_hard_limit));
+        nhp = min (nhp, nhp_from_limit);
+    }
+#endif //MULTIPLE_HEAPS
+
+    size_t seg_size;
+    size_t large_seg_size;
+    if (gc_heap::heap_hard_limit)
+    {
+#ifdef MULTIPLE_HEAPS
+        seg_size = gc_heap::get_segment_size_hard_limit (nhp);
+#else
+        seg_size = gc_heap::get_segment_size_hard_limit (1);
+#endif //MULTIPLE_HEAPS
+        large_seg_size = seg_size;
+    }
+    else
+    {
+        seg_size = get_valid_segment_size();
+        large_seg_size = get_valid_segment_size(TRUE);
+    }
+
+    gc_heap::soh_segment_size = seg_size;
+    gc_heap::min_loh_segment_size = large_seg_size;
+    gc_heap::min_segment_size = min (seg_size, large_seg_size);
+#ifdef SEG_MAPPING_TABLE
+    gc_heap::min_segment_size_shr = index_of_set_bit (gc_heap::min_segment_size);
+#endif //SEG_MAPPING_TABLE
+
+    // Regions are only used if they evenly divide segments.
+    size_t region_size = static_cast<size_t>(GCConfig::GetRegionSize());
+    if ((region_size >= (1024 * 1024)) && power_of_two_p (region_size) && (region_size <= gc_heap::min_segment_size))
+    {
+        gc_heap::region_size = region_size;
+    }
+
+#ifdef MULTIPLE_HEAPS
     hr = gc_heap::initialize_gc (seg_size, large_seg_size /*LHEAP_ALLOC*/, nhp);
 #else
     hr = gc_heap::initialize_gc (seg_size, large_seg_size /*LHEAP_ALLOC*/);
@@ -33548,7 +34320,12 @@ HRESULT GCHeap::Initialize ()
     if (hr != S_OK)
         return hr;
 
-    gc_heap::total_physical_mem = GCToOSInterface::GetPhysicalMemoryLimit();
+    // Memory load and budgets are relative to what the heap is allowed to use.
+    if (gc_heap::heap_hard_limit)
+    {
+        dprintf (1, ("hard limit %Id, segment size %Id", gc_heap::heap_hard_limit, seg_size));
+        gc_heap::total_physical_mem = (uint64_t)gc_heap::heap_hard_limit;
+    }
 
     gc_heap::mem_one_percent = gc_heap::total_physical_mem / 100;
 #ifndef MULTIPLE_HEAPS
@@ -35514,6 +36291,11 @@ HRESULT GCHeap::GetGcCounters(int gen, gc_counters* counters)
 // Get the segment size to use, making sure it conforms.
 size_t GCHeap::GetValidSegmentSize(bool large_seg)
 {
+    if (gc_heap::heap_hard_limit)
+    {
+        return (large_seg ? gc_heap::min_loh_segment_size : gc_heap::soh_segment_size);
+    }
+
     return get_valid_segment_size (large_seg);
 }
 
@@ -35557,6 +36339,15 @@ size_t GCHeap::GetValidGen0MaxSize(size_t seg_size)
     if (gen0size >= (seg_size / 2))
         gen0size = seg_size / 2;
 
+    // With a hard limit segments are sized to the limit, so keep gen0 to a
+    // small part of them.
+    if (gc_heap::heap_hard_limit)
+    {
+        size_t gen0size_seg = seg_size / 8;
+        if (gen0size >= gen0size_seg)
+            gen0size = gen0size_seg;
+    }
+
     return (gen0size);
 }
 
@@ -68,6 +68,10 @@ public:
       "Does a DebugBreak at the soonest time we detect an OOM")                                \
   BOOL_CONFIG(NoAffinitize, "GCNoAffinitize", false,                                           \
       "If set, do not affinitize server GC threads")                                           \
+  BOOL_CONFIG(DynamicHeapCount, "GCDynamicHeapCount", false,                                   \
+      "If set, adapt the number of server GC heaps allocated on to the GC pause cost")         \
+  BOOL_CONFIG(BGCMarkSteal, "GCBGCMarkSteal", true,                                            \
+      "Specifies whether server background GC threads steal marking work from each other")     \
   BOOL_CONFIG(LogEnabled,   "GCLogEnabled", false,                                             \
       "Specifies if you want to turn on logging in GC")                                        \
   BOOL_CONFIG(ConfigLogEnabled, "GCConfigLogEnabled", false,                                   \
@@ -78,12 +82,20 @@ public:
   INT_CONFIG(BGCSpinCount,  "BGCSpinCount", 140, "Specifies the bgc spin count")               \
   INT_CONFIG(BGCSpin,       "BGCSpin",      2,   "Specifies the bgc spin time")                \
   INT_CONFIG(HeapCount,     "GCHeapCount",  0,   "Specifies the number of server GC heaps")    \
+  INT_CONFIG(DynamicHeapCountPauseTarget, "GCDynamicHeapCountPauseTarget", 5,                 \
+      "Percentage of time GCDynamicHeapCount aims to spend in GC pauses")                      \
   INT_CONFIG(Gen0Size,      "GCgen0size",   0, "Specifies the smallest gen0 size")             \
   INT_CONFIG(SegmentSize,   "GCSegmentSize", 0, "Specifies the managed heap segment size")     \
+  INT_CONFIG(RegionSize,    "GCRegionSize", 0,                                                 \
+      "Experimental: manage free ephemeral and segment memory in regions of this size")        \
   INT_CONFIG(LatencyMode,   "GCLatencyMode", -1,                                               \
       "Specifies the GC latency mode - batch, interactive or low latency (note that the same " \
       "thing can be specified via API which is the supported way")                             \
   INT_CONFIG(LogFileSize,   "GCLogFileSize", 0, "Specifies the GC log file size")              \
+  INT_CONFIG(HeapHardLimit, "GCHeapHardLimit", 0,                                             \
+      "Specifies the maximum number of bytes the GC heap may commit")                          \
+  INT_CONFIG(HeapHardLimitPercent, "GCHeapHardLimitPercent", 0,                                \
+      "Specifies the GC heap commit limit as a percentage of the physical memory limit")       \
   INT_CONFIG(CompactRatio,  "GCCompactRatio", 0,                                               \
       "Specifies the ratio compacting GCs vs sweeping")                                        \
   STRING_CONFIG(LogFile,    "GCLogFile",    "Specifies the name of the GC log file")           \
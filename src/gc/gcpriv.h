@@ -1128,6 +1128,21 @@ public:
     static
     l_heap* make_large_heap (uint8_t* new_pages, size_t size, BOOL managed);
 
+    // Commits memory for a heap's segments. Fails if that would take the
+    // total committed over heap_hard_limit.
+    PER_HEAP_ISOLATED
+    bool virtual_commit (void* address, size_t size, int h_number);
+
+    PER_HEAP_ISOLATED
+    bool virtual_decommit (void* address, size_t size);
+
+    // Accounts for committed memory given back by releasing its reservation.
+    PER_HEAP_ISOLATED
+    void release_committed (size_t size);
+
+    PER_HEAP_ISOLATED
+    size_t get_segment_size_hard_limit (uint32_t nhp);
+
     static
     gc_heap* make_gc_heap(
 #if defined (MULTIPLE_HEAPS)
@@ -1159,6 +1174,10 @@ public:
     static 
     gc_heap* balance_heaps_loh (alloc_context* acontext, size_t size);
     static
+    void record_heap_count_sample_start();
+    static
+    void adjust_active_heap_count();
+    static
     void gc_thread_stub (void* arg);
 #endif //MULTIPLE_HEAPS
 
@@ -1659,6 +1678,8 @@ protected:
     PER_HEAP
     BOOL card_bundle_set_p (size_t cardb);
     PER_HEAP
+    size_t find_card_bundle (size_t cardb, size_t end_cardb);
+    PER_HEAP
     BOOL find_card_dword (size_t& cardw, size_t cardw_end);
     PER_HEAP
     void enable_card_bundles();
@@ -1918,6 +1939,14 @@ protected:
     void background_mark_simple (uint8_t* o THREAD_NUMBER_DCL);
     PER_HEAP
     void background_mark_simple1 (uint8_t* o THREAD_NUMBER_DCL);
+#ifdef MULTIPLE_HEAPS
+    PER_HEAP
+    void background_donate_mark_work();
+    PER_HEAP
+    BOOL background_take_mark_work (gc_heap* hp);
+    PER_HEAP
+    void background_mark_steal();
+#endif //MULTIPLE_HEAPS
     PER_HEAP_ISOLATED
     void background_promote (Object**, ScanContext* , uint32_t);
     PER_HEAP
@@ -2420,6 +2449,12 @@ protected:
     PER_HEAP
     void decommit_ephemeral_segment_pages();
 
+    PER_HEAP
+    void decommit_ephemeral_segment_regions();
+
+    PER_HEAP_ISOLATED
+    BOOL hoard_segments_p();
+
 #ifdef BIT64
     PER_HEAP_ISOLATED
     size_t trim_youngest_desired (uint32_t memory_load,
@@ -2905,6 +2940,21 @@ public:
     PER_HEAP_ISOLATED
     size_t gc_gen0_desired_high;
 
+    // Experimental, 0 unless GCRegionSize is set. Free memory at the end of
+    // the ephemeral segment is then decommitted in regions of this size, and
+    // emptied segments are kept decommitted on the standby list so any heap
+    // can reuse them for either SOH or LOH.
+    PER_HEAP_ISOLATED
+    size_t region_size;
+
+    // The largest gen0 budget of this heap since ephemeral_decommit_time,
+    // only used with regions.
+    PER_HEAP
+    size_t ephemeral_desired_high;
+
+    PER_HEAP
+    size_t ephemeral_decommit_time;
+
     PER_HEAP
     size_t gen0_big_free_spaces;
 
@@ -2927,6 +2977,18 @@ public:
     PER_HEAP_ISOLATED
     uint64_t total_physical_mem;
 
+    // The most the heaps may commit in total, or 0 if there is no limit.
+    PER_HEAP_ISOLATED
+    size_t heap_hard_limit;
+
+    // Bytes committed for segments, only maintained when heap_hard_limit is
+    // set. Updated under check_commit_cs.
+    PER_HEAP_ISOLATED
+    size_t current_total_committed;
+
+    PER_HEAP_ISOLATED
+    CLRCriticalSection check_commit_cs;
+
     PER_HEAP_ISOLATED
     uint64_t entry_available_physical_mem;
 
@@ -3191,6 +3253,43 @@ protected:
     PER_HEAP
     size_t    background_mark_stack_array_length;
 
+#ifdef MULTIPLE_HEAPS
+    // Marking work this heap's BGC thread has moved off its mark stack for
+    // BGC threads that have run out of their own to take, protected by
+    // bgc_steal_lock. Scanned as background roots like the mark stack.
+    PER_HEAP
+    uint8_t**  bgc_steal_array;
+
+    PER_HEAP
+    VOLATILE(size_t) bgc_steal_count;
+
+    PER_HEAP
+    VOLATILE(int32_t) bgc_steal_lock;
+
+    // Marking work this heap's BGC thread has taken from another heap and not
+    // marked from yet. Scanned as background roots like the mark stack.
+    PER_HEAP
+    uint8_t**  bgc_stolen_array;
+
+    PER_HEAP
+    size_t     bgc_stolen_count;
+
+    // Number of BGC threads in background_mark_steal that have run out of
+    // marking work. A thread leaves the count when it stops stealing, so it is
+    // back to 0 once every thread has.
+    PER_HEAP_ISOLATED
+    VOLATILE(int32_t) bgc_mark_steal_idle;
+
+    // TRUE from the start of a marking phase until the first BGC thread finds
+    // every thread idle in background_mark_steal. Marking work is only donated
+    // while this is set, since nothing takes it afterwards.
+    PER_HEAP_ISOLATED
+    VOLATILE(BOOL) bgc_mark_steal_active_p;
+
+    PER_HEAP_ISOLATED
+    BOOL bgc_mark_steal_p;
+#endif //MULTIPLE_HEAPS
+
     PER_HEAP
     uint8_t*  background_min_overflow_address;
 
@@ -3585,6 +3684,37 @@ public:
     static
     int n_heaps;
 
+    // Heaps [0, n_active_heaps) are the ones threads allocate on. This is
+    // n_heaps unless GCDynamicHeapCount lets it adapt to the GC pause cost;
+    // the other heaps are still collected but only hold what survived on
+    // them before they were retired.
+    static
+    int n_active_heaps;
+
+    static
+    bool dynamic_heap_count_p;
+
+    // Measurements for adjust_active_heap_count, in QueryPerformanceCounter ticks.
+    static
+    uint64_t heap_count_gc_start_ts;
+
+    static
+    uint64_t heap_count_last_gc_end_ts;
+
+    // Bytes allocated in gen0 between the last GC and this one.
+    static
+    size_t heap_count_allocated;
+
+    static
+    size_t heap_count_sample_gc_index;
+
+    static const int heap_count_samples_count = 3;
+    static
+    int heap_count_samples[heap_count_samples_count];
+
+    static
+    int heap_count_sample_index;
+
     static
     gc_heap** g_heaps;
 
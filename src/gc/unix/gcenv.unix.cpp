@@ -576,9 +576,12 @@ size_t GCToOSInterface::GetVirtualMemoryLimit()
 // Remarks:
 //  If a process runs with a restricted memory limit, it returns the limit. If there's no limit 
 //  specified, it returns amount of actual physical memory.
-uint64_t GCToOSInterface::GetPhysicalMemoryLimit()
+uint64_t GCToOSInterface::GetPhysicalMemoryLimit(bool* is_restricted)
 {
     size_t restricted_limit;
+    if (is_restricted)
+        *is_restricted = false;
+
     // The limit was not cached
     if (g_RestrictedPhysicalMemoryLimit == 0)
     {
@@ -587,22 +590,21 @@ uint64_t GCToOSInterface::GetPhysicalMemoryLimit()
     }
     restricted_limit = g_RestrictedPhysicalMemoryLimit;
 
-    if (restricted_limit != 0 && restricted_limit != SIZE_T_MAX)
-        return restricted_limit;
-
     long pages = sysconf(_SC_PHYS_PAGES);
-    if (pages == -1) 
-    {
-        return 0;
-    }
-
     long pageSize = sysconf(_SC_PAGE_SIZE);
-    if (pageSize == -1)
+    uint64_t physical_memory = ((pages == -1) || (pageSize == -1)) ? 0 : (uint64_t)pages * pageSize;
+
+    if (restricted_limit != 0 && restricted_limit != SIZE_T_MAX)
     {
-        return 0;
+        // GetRestrictedPhysicalMemoryLimit caps the limit at the amount of
+        // physical memory, so it is only a restriction if it is lower.
+        if (is_restricted)
+            *is_restricted = (restricted_limit < physical_memory);
+
+        return restricted_limit;
     }
 
-    return pages * pageSize;
+    return physical_memory;
 }
 
 // Get memory status
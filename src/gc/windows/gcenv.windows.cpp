@@ -476,19 +476,27 @@ size_t GCToOSInterface::GetVirtualMemoryLimit()
 // Remarks:
 //  If a process runs with a restricted memory limit, it returns the limit. If there's no limit 
 //  specified, it returns amount of actual physical memory.
-uint64_t GCToOSInterface::GetPhysicalMemoryLimit()
+uint64_t GCToOSInterface::GetPhysicalMemoryLimit(bool* is_restricted)
 {
-    size_t restricted_limit = GetRestrictedPhysicalMemoryLimit();
-    if (restricted_limit != 0)
-        return restricted_limit;
+    if (is_restricted)
+        *is_restricted = false;
 
     MEMORYSTATUSEX memStatus;
-    if (::GlobalMemoryStatusEx(&memStatus))
+    memStatus.dwLength = sizeof(memStatus);
+    uint64_t total_physical = ::GlobalMemoryStatusEx(&memStatus) ? memStatus.ullTotalPhys : 0;
+
+    // The job limit is capped at the amount of physical memory, so it is only
+    // a restriction if it is lower.
+    size_t restricted_limit = GetRestrictedPhysicalMemoryLimit();
+    if (restricted_limit != 0)
     {
-        return memStatus.ullTotalPhys;
+        if (is_restricted)
+            *is_restricted = (restricted_limit < total_physical);
+
+        return restricted_limit;
     }
 
-    return 0;
+    return total_physical;
 }
 
 // Get memory status
@@ -320,6 +320,7 @@ RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(EXTERNAL_GCPollType, W("GCPollType"), "")
 RETAIL_CONFIG_STRING_INFO_EX(EXTERNAL_NewGCCalc, W("NewGCCalc"), "", CLRConfig::REGUTIL_default)
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCRetainVM, W("GCRetainVM"), 0, "When set we put the segments that should be deleted on a standby list (instead of releasing them back to the OS) which will be considered to satisfy new segment requests (note that the same thing can be specified via API which is the supported way)")
 RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(UNSUPPORTED_GCSegmentSize, W("GCSegmentSize"), "Specifies the managed heap segment size")
+RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(UNSUPPORTED_GCRegionSize, W("GCRegionSize"), "Experimental: manage free ephemeral and segment memory in regions of this size")
 RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(UNSUPPORTED_GCLOHCompact, W("GCLOHCompact"), "Specifies the LOH compaction mode")
 RETAIL_CONFIG_DWORD_INFO(EXTERNAL_gcAllowVeryLargeObjects, W("gcAllowVeryLargeObjects"), 1, "allow allocation of 2GB+ objects on GC heap")
 RETAIL_CONFIG_DWORD_INFO_EX(EXTERNAL_GCStress, W("GCStress"), 0, "trigger GCs at regular intervals", CLRConfig::REGUTIL_default)
@@ -335,6 +336,11 @@ RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCNumaAware, W("GCNumaAware"), 1, "Specifie
 RETAIL_CONFIG_DWORD_INFO(EXTERNAL_GCCpuGroup, W("GCCpuGroup"), 0, "Specifies if to enable GC to support CPU groups")
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCHeapCount, W("GCHeapCount"), 0, "")
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCNoAffinitize, W("GCNoAffinitize"), 0, "")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCDynamicHeapCount, W("GCDynamicHeapCount"), 0, "If set, adapt the number of server GC heaps allocated on to the GC pause cost")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCBGCMarkSteal, W("GCBGCMarkSteal"), 1, "Specifies whether server background GC threads steal marking work from each other")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCDynamicHeapCountPauseTarget, W("GCDynamicHeapCountPauseTarget"), 5, "Percentage of time GCDynamicHeapCount aims to spend in GC pauses")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCHeapHardLimit, W("GCHeapHardLimit"), 0, "Specifies the maximum number of bytes the GC heap may commit")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCHeapHardLimitPercent, W("GCHeapHardLimitPercent"), 0, "Specifies the GC heap commit limit as a percentage of the physical memory limit")
 RETAIL_CONFIG_STRING_INFO(EXTERNAL_GCName, W("GCName"), "")
 
 //
@@ -864,6 +870,11 @@ RETAIL_CONFIG_DWORD_INFO(INTERNAL_HillClimbing_MaxSampleErrorPercent,
 RETAIL_CONFIG_DWORD_INFO(INTERNAL_HillClimbing_SampleIntervalLow,                   W("HillClimbing_SampleIntervalLow"),                  10, "");
 RETAIL_CONFIG_DWORD_INFO(INTERNAL_HillClimbing_SampleIntervalHigh,                  W("HillClimbing_SampleIntervalHigh"),                 200, "");
 RETAIL_CONFIG_DWORD_INFO(INTERNAL_HillClimbing_GainExponent,                        W("HillClimbing_GainExponent"),                       200, "The exponent to apply to the gain, times 100.  100 means to use linear gain, higher values will enhance large moves and damp small ones.");
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_EnableLatencyInjection,               W("ThreadPool_EnableLatencyInjection"),               0, "Sizes the worker pool from queue latency and blocked workers instead of hill climbing");
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_InjectionTargetLatency,                W("ThreadPool_InjectionTargetLatency"),               50, "Milliseconds pending work may go without a dequeue before the latency injection policy adds threads");
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_InjectionIdleDelay,                    W("ThreadPool_InjectionIdleDelay"),                   1000, "Milliseconds the pool must stay idle before the latency injection policy gives threads back");
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_InjectionMaxChangePerSample,           W("ThreadPool_InjectionMaxChangePerSample"),          16, "Maximum number of threads the latency injection policy adds in one sample");
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_InjectionThreadsPerProcessor,          W("ThreadPool_InjectionThreadsPerProcessor"),         4, "Threads per processor the latency injection policy may add quickly, beyond that it adds one thread at a time and backs off");
 
 
 //
@@ -871,6 +882,7 @@ RETAIL_CONFIG_DWORD_INFO(INTERNAL_HillClimbing_GainExponent,
 //
 #ifdef FEATURE_TIERED_COMPILATION
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_TieredCompilation, W("EXPERIMENTAL_TieredCompilation"), 0, "Enables tiered compilation")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_TC_BackgroundWorkerMax, W("TieredCompilation_BackgroundWorkerMax"), 0, "Maximum number of threads compiling tier1 code in the background. 0 uses one less than the number of processors.")
 #endif
 
 
@@ -878,6 +890,8 @@ RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_TieredCompilation, W("EXPERIMENTAL_TieredCo
 // TypeLoader
 // 
 CONFIG_DWORD_INFO(INTERNAL_TypeLoader_InjectInterfaceDuplicates, W("INTERNAL_TypeLoader_InjectInterfaceDuplicates"), 0, "Injects duplicates in interface map for all types.")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_CastCacheSize, W("CastCacheSize"), 4096, "Number of entries in the cache of cast results used by the casting helpers, rounded down to a power of 2. Values below 2 disable the cache.")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_CastCacheTrackStats, W("CastCacheTrackStats"), 0, "If non-zero, count cast cache hits, misses and insertions and write them to the stress log at shutdown.")
 
 // 
 // Virtual call stubs
@@ -888,6 +902,7 @@ CONFIG_DWORD_INFO_EX(INTERNAL_VirtualCallStubDumpLogCounter, W("VirtualCallStubD
 CONFIG_DWORD_INFO_EX(INTERNAL_VirtualCallStubDumpLogIncr, W("VirtualCallStubDumpLogIncr"), 0, "Used only when STUB_LOGGING is defined, which by default is not.", CLRConfig::REGUTIL_default)
 RETAIL_CONFIG_DWORD_INFO_EX(EXTERNAL_VirtualCallStubLogging, W("VirtualCallStubLogging"), 0, "Worth keeping, but should be moved into \"#ifdef STUB_LOGGING\" blocks. This goes for most (or all) of the stub logging infrastructure.", CLRConfig::REGUTIL_default)
 CONFIG_DWORD_INFO_EX(INTERNAL_VirtualCallStubMissCount, W("VirtualCallStubMissCount"), 100, "Used only when STUB_LOGGING is defined, which by default is not.", CLRConfig::REGUTIL_default)
+CONFIG_DWORD_INFO(INTERNAL_VirtualCallStubPolyInlineCacheSize, W("VirtualCallStubPolyInlineCacheSize"), 4, "Maximum number of dispatch stubs chained at a single interface call site before it falls back to the shared resolve stub. Values below 2 disable per-call-site polymorphic inline caches.")
 CONFIG_DWORD_INFO_EX(INTERNAL_VirtualCallStubResetCacheCounter, W("VirtualCallStubResetCacheCounter"), 0, "Used only when STUB_LOGGING is defined, which by default is not.", CLRConfig::REGUTIL_default)
 CONFIG_DWORD_INFO_EX(INTERNAL_VirtualCallStubResetCacheIncr, W("VirtualCallStubResetCacheIncr"), 0, "Used only when STUB_LOGGING is defined, which by default is not.", CLRConfig::REGUTIL_default)
 
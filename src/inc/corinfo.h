@@ -213,11 +213,11 @@ TODO: Talk about initializing strutures before use
     #define SELECTANY extern __declspec(selectany)
 #endif
 
-SELECTANY const GUID JITEEVersionIdentifier = { /* a6860f80-01cb-4f87-82c2-a8e5a744f2fa */
-    0xa6860f80,
-    0x01cb,
-    0x4f87,
-    {0x82, 0xc2, 0xa8, 0xe5, 0xa7, 0x44, 0xf2, 0xfa}
+SELECTANY const GUID JITEEVersionIdentifier = { /* 784ad8e9-b704-4567-a048-1d9f7791f8e0 */
+    0x784ad8e9,
+    0xb704,
+    0x4567,
+    {0xa0, 0x48, 0x1d, 0x9f, 0x77, 0x91, 0xf8, 0xe0}
 };
 
 
@@ -653,6 +653,9 @@ enum CorInfoHelpFunc
 
     CORINFO_HELP_GVMLOOKUP_FOR_SLOT,        // Resolve a generic virtual method target from this pointer and runtime method handle 
 
+    CORINFO_HELP_LOOP_BACKEDGE_THRESHOLD,   // Tier0 code has taken enough loop back-edges to be worth optimizing, method handle is the first argument
+    CORINFO_HELP_CLASSPROFILE,              // Record the class of the 'this' object (first argument) of a virtual call in a class profile cell (second argument)
+
     CORINFO_HELP_COUNT,
 };
 
@@ -2099,6 +2102,20 @@ public:
             CORINFO_CONTEXT_HANDLE      ownerType = NULL        /* IN */
             ) = 0;
 
+    // Get the class most likely to be seen as 'this' by the virtual call at
+    // ilOffset in method, as observed by tier0 code, along with the percentage
+    // of calls made on that class. Returns NULL if there is no useful profile.
+    //
+    // When pCell is non-NULL the JIT is instrumenting the call instead. pCell
+    // receives the cell to pass to CORINFO_HELP_CLASSPROFILE, or NULL if the
+    // call site should not be profiled, and no class is returned.
+    virtual CORINFO_CLASS_HANDLE getLikelyClass(
+            CORINFO_METHOD_HANDLE       method,                 /* IN */
+            unsigned                    ilOffset,               /* IN */
+            unsigned*                   pLikelihood,            /* OUT */
+            void**                      pCell                   /* OUT */
+            ) = 0;
+
     // Get the unboxed entry point for a method, if possible.
     virtual CORINFO_METHOD_HANDLE getUnboxedEntry(
         CORINFO_METHOD_HANDLE ftn,
@@ -2367,6 +2384,13 @@ public:
             CORINFO_CLASS_HANDLE        cls
             ) = 0;
 
+    // return the number of bytes needed by an instance of a reference class
+    // allocated on the heap, including the method table pointer but not the
+    // object header, or 0 if instances must not be allocated on the stack
+    virtual unsigned getHeapClassSize (
+            CORINFO_CLASS_HANDLE        cls
+            ) = 0;
+
     virtual unsigned getClassAlignmentRequirement (
             CORINFO_CLASS_HANDLE        cls,
             BOOL                        fDoubleAlignHint = FALSE
@@ -356,6 +356,18 @@
 
     JITHELPER(CORINFO_HELP_GVMLOOKUP_FOR_SLOT, NULL, CORINFO_HELP_SIG_NO_ALIGN_STUB)
 
+#ifdef FEATURE_TIERED_COMPILATION
+    JITHELPER(CORINFO_HELP_LOOP_BACKEDGE_THRESHOLD, JIT_LoopBackEdgeThreshold, CORINFO_HELP_SIG_REG_ONLY)
+#else
+    JITHELPER(CORINFO_HELP_LOOP_BACKEDGE_THRESHOLD, NULL, CORINFO_HELP_SIG_UNDEF)
+#endif
+
+#ifdef FEATURE_TIERED_COMPILATION
+    JITHELPER(CORINFO_HELP_CLASSPROFILE, JIT_ClassProfile, CORINFO_HELP_SIG_REG_ONLY)
+#else
+    JITHELPER(CORINFO_HELP_CLASSPROFILE, NULL, CORINFO_HELP_SIG_UNDEF)
+#endif
+
 #undef JITHELPER
 #undef DYNAMICJITHELPER
 #undef JITHELPER
@@ -51,6 +51,7 @@ DEF_CLR_API(LongLifetimeMalloc)
 DEF_CLR_API(LongLifetimeFree)
 DEF_CLR_API(getClassModuleIdForStatics)
 DEF_CLR_API(getClassSize)
+DEF_CLR_API(getHeapClassSize)
 DEF_CLR_API(getClassAlignmentRequirement)
 DEF_CLR_API(getClassGClayout)
 DEF_CLR_API(getClassNumInstanceFields)
@@ -173,5 +174,6 @@ DEF_CLR_API(resolveVirtualMethod)
 DEF_CLR_API(expandRawHandleIntrinsic)
 DEF_CLR_API(getDefaultEqualityComparerClass)
 DEF_CLR_API(getUnboxedEntry)
+DEF_CLR_API(getLikelyClass)
 
 #undef DEF_CLR_API
@@ -481,6 +481,14 @@ unsigned WrapICorJitInfo::getClassSize(CORINFO_CLASS_HANDLE        cls)
     return temp;
 }
 
+unsigned WrapICorJitInfo::getHeapClassSize(CORINFO_CLASS_HANDLE        cls)
+{
+    API_ENTER(getHeapClassSize);
+    unsigned temp = wrapHnd->getHeapClassSize(cls);
+    API_LEAVE(getHeapClassSize);
+    return temp;
+}
+
 unsigned WrapICorJitInfo::getClassAlignmentRequirement(
             CORINFO_CLASS_HANDLE        cls,
             BOOL                        fDoubleAlignHint)
@@ -1656,6 +1664,19 @@ CORINFO_METHOD_HANDLE WrapICorJitInfo::getUnboxedEntry(
     return result;
 }
 
+CORINFO_CLASS_HANDLE WrapICorJitInfo::getLikelyClass(
+    CORINFO_METHOD_HANDLE       method,       /* IN */
+    unsigned                    ilOffset,     /* IN */
+    unsigned*                   pLikelihood,  /* OUT */
+    void**                      pCell         /* OUT */
+)
+{
+    API_ENTER(getLikelyClass);
+    CORINFO_CLASS_HANDLE result = wrapHnd->getLikelyClass(method, ilOffset, pLikelihood, pCell);
+    API_LEAVE(getLikelyClass);
+    return result;
+}
+
 CORINFO_CLASS_HANDLE WrapICorJitInfo::getDefaultEqualityComparerClass(
     CORINFO_CLASS_HANDLE elemType)
 {
@@ -10,10 +10,19 @@
 
 //------------------------------------------------------------------------
 // PooledAllocator:
-//    This subclass of `ArenaAllocator` is a singleton that always keeps
-//    a single default-sized page allocated. We try to use the singleton
-//    allocator as often as possible (i.e. for all non-concurrent
-//    method compilations).
+//    This subclass of `ArenaAllocator` is kept in a small pool of
+//    allocators that hold on to their pages between method compilations.
+//    We try to use a pooled allocator as often as possible, so that
+//    compilations on several threads at once can all avoid going back
+//    to the host for every page.
+//
+//    A thread starts its search of the pool at a slot chosen by its
+//    thread id, so a thread that compiles repeatedly tends to get the
+//    same allocator (and the same, cache-warm, pages) back each time.
+//
+//    Each pooled allocator tracks the memory used by its recent
+//    compilations and retains about that many pages when it is
+//    returned to the pool.
 class PooledAllocator : public ArenaAllocator
 {
 private:
@@ -25,10 +34,21 @@ private:
         POOLED_ALLOCATOR_SHUTDOWN       = 3,
     };
 
-    static PooledAllocator s_pooledAllocator;
-    static LONG            s_pooledAllocatorState;
+    enum
+    {
+        POOLED_ALLOCATOR_COUNT = 8,
+
+        // The most memory a pooled allocator will hold on to between
+        // compilations, as a multiple of the default page size.
+        MAX_RETAINED_PAGES = 16,
+    };
+
+    static PooledAllocator s_pooledAllocators[POOLED_ALLOCATOR_COUNT];
+
+    LONG   m_state;
+    size_t m_recentBytesAllocated; // Running average of bytes allocated per compilation
 
-    PooledAllocator() : ArenaAllocator()
+    PooledAllocator() : ArenaAllocator(), m_state(POOLED_ALLOCATOR_NOTINITIALIZED), m_recentBytesAllocated(0)
     {
     }
     PooledAllocator(IEEMemoryManager* memoryManager);
@@ -36,6 +56,9 @@ private:
     PooledAllocator(const PooledAllocator& other) = delete;
     PooledAllocator& operator=(const PooledAllocator& other) = delete;
 
+    ArenaAllocator* tryGet(IEEMemoryManager* memoryManager);
+    void tryShutdown();
+
 public:
     PooledAllocator& operator=(PooledAllocator&& other);
 
@@ -86,8 +109,13 @@ ArenaAllocator::ArenaAllocator()
     : m_memoryManager(nullptr)
     , m_firstPage(nullptr)
     , m_lastPage(nullptr)
+    , m_sparePages(nullptr)
     , m_nextFreeByte(nullptr)
     , m_lastFreeByte(nullptr)
+#ifdef FEATURE_JIT_METHOD_PERF
+    , m_hostAllocCount(0)
+    , m_hostAllocCycles(0)
+#endif // FEATURE_JIT_METHOD_PERF
 {
 }
 
@@ -102,8 +130,13 @@ ArenaAllocator::ArenaAllocator(IEEMemoryManager* memoryManager)
     : m_memoryManager(memoryManager)
     , m_firstPage(nullptr)
     , m_lastPage(nullptr)
+    , m_sparePages(nullptr)
     , m_nextFreeByte(nullptr)
     , m_lastFreeByte(nullptr)
+#ifdef FEATURE_JIT_METHOD_PERF
+    , m_hostAllocCount(0)
+    , m_hostAllocCycles(0)
+#endif // FEATURE_JIT_METHOD_PERF
 {
     assert(getDefaultPageSize() != 0);
     assert(isInitialized());
@@ -119,12 +152,18 @@ ArenaAllocator& ArenaAllocator::operator=(ArenaAllocator&& other)
     m_memoryManager = other.m_memoryManager;
     m_firstPage     = other.m_firstPage;
     m_lastPage      = other.m_lastPage;
+    m_sparePages    = other.m_sparePages;
     m_nextFreeByte  = other.m_nextFreeByte;
     m_lastFreeByte  = other.m_lastFreeByte;
+#ifdef FEATURE_JIT_METHOD_PERF
+    m_hostAllocCount  = other.m_hostAllocCount;
+    m_hostAllocCycles = other.m_hostAllocCycles;
+#endif // FEATURE_JIT_METHOD_PERF
 
     other.m_memoryManager = nullptr;
     other.m_firstPage     = nullptr;
     other.m_lastPage      = nullptr;
+    other.m_sparePages    = nullptr;
     other.m_nextFreeByte  = nullptr;
     other.m_lastFreeByte  = nullptr;
 
@@ -185,16 +224,43 @@ void* ArenaAllocator::allocateNewPage(size_t size, bool canThrow)
         pageSize = roundUp(pageSize, DEFAULT_PAGE_SIZE);
     }
 
-    // Allocate the new page
-    PageDescriptor* newPage = (PageDescriptor*)allocateHostMemory(pageSize);
-    if (newPage == nullptr)
+    PageDescriptor* newPage;
+
+    if ((m_sparePages != nullptr) && (m_sparePages->m_pageBytes >= pageSize))
     {
-        if (canThrow)
+        // Reuse a page kept from an earlier compilation
+        newPage      = m_sparePages;
+        m_sparePages = newPage->m_next;
+        pageSize     = newPage->m_pageBytes;
+    }
+    else
+    {
+        // Allocate the new page
+#ifdef FEATURE_JIT_METHOD_PERF
+        unsigned __int64 startCycles = 0;
+        unsigned __int64 endCycles   = 0;
+        bool             timed       = CycleTimer::GetThreadCyclesS(&startCycles);
+#endif // FEATURE_JIT_METHOD_PERF
+
+        newPage = (PageDescriptor*)allocateHostMemory(pageSize);
+
+#ifdef FEATURE_JIT_METHOD_PERF
+        if (timed && CycleTimer::GetThreadCyclesS(&endCycles))
         {
-            NOMEM();
+            m_hostAllocCycles += endCycles - startCycles;
         }
+        m_hostAllocCount++;
+#endif // FEATURE_JIT_METHOD_PERF
 
-        return nullptr;
+        if (newPage == nullptr)
+        {
+            if (canThrow)
+            {
+                NOMEM();
+            }
+
+            return nullptr;
+        }
     }
 
     // Append the new page to the end of the list
@@ -238,10 +304,17 @@ void ArenaAllocator::destroy()
         freeHostMemory(page);
     }
 
+    for (PageDescriptor *page = m_sparePages, *next; page != nullptr; page = next)
+    {
+        next = page->m_next;
+        freeHostMemory(page);
+    }
+
     // Clear out the allocator's fields
     m_memoryManager = nullptr;
     m_firstPage     = nullptr;
     m_lastPage      = nullptr;
+    m_sparePages    = nullptr;
     m_nextFreeByte  = nullptr;
     m_lastFreeByte  = nullptr;
 }
@@ -378,19 +451,20 @@ void ArenaAllocator::shutdown()
     PooledAllocator::shutdown();
 }
 
-PooledAllocator PooledAllocator::s_pooledAllocator;
-LONG            PooledAllocator::s_pooledAllocatorState = POOLED_ALLOCATOR_NOTINITIALIZED;
+PooledAllocator PooledAllocator::s_pooledAllocators[POOLED_ALLOCATOR_COUNT];
 
 //------------------------------------------------------------------------
 // PooledAllocator::PooledAllocator:
 //    Constructs a `PooledAllocator`.
-PooledAllocator::PooledAllocator(IEEMemoryManager* memoryManager) : ArenaAllocator(memoryManager)
+PooledAllocator::PooledAllocator(IEEMemoryManager* memoryManager)
+    : ArenaAllocator(memoryManager), m_state(POOLED_ALLOCATOR_NOTINITIALIZED), m_recentBytesAllocated(0)
 {
 }
 
 //------------------------------------------------------------------------
 // PooledAllocator::operator=:
-//    Move-assigns a `PooledAllocator`.
+//    Move-assigns a `PooledAllocator`. The pool state of this allocator
+//    is left as is.
 PooledAllocator& PooledAllocator::operator=(PooledAllocator&& other)
 {
     *((ArenaAllocator*)this) = std::move((ArenaAllocator &&)other);
@@ -399,15 +473,27 @@ PooledAllocator& PooledAllocator::operator=(PooledAllocator&& other)
 
 //------------------------------------------------------------------------
 // PooledAllocator::shutdown:
-//    Performs any necessary teardown for the pooled allocator.
+//    Performs any necessary teardown for the pooled allocators.
 //
 // Notes:
-//    If the allocator has been initialized and is in use when this method is called,
+//    If an allocator has been initialized and is in use when this method is called,
 //    it is up to whatever is using the pooled allocator to call `destroy` in order
 //    to free its memory.
 void PooledAllocator::shutdown()
 {
-    LONG oldState = InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_SHUTDOWN);
+    for (unsigned i = 0; i < POOLED_ALLOCATOR_COUNT; i++)
+    {
+        s_pooledAllocators[i].tryShutdown();
+    }
+}
+
+//------------------------------------------------------------------------
+// PooledAllocator::tryShutdown:
+//    Shuts down this pooled allocator, freeing its memory if it is not
+//    in use.
+void PooledAllocator::tryShutdown()
+{
+    LONG oldState = InterlockedExchange(&m_state, POOLED_ALLOCATOR_SHUTDOWN);
     switch (oldState)
     {
         case POOLED_ALLOCATOR_NOTINITIALIZED:
@@ -417,46 +503,87 @@ void PooledAllocator::shutdown()
 
         case POOLED_ALLOCATOR_AVAILABLE:
             // The pooled allocator was initialized and not in use; we must destroy it.
-            s_pooledAllocator.destroy();
+            ArenaAllocator::destroy();
             break;
     }
 }
 
 //------------------------------------------------------------------------
 // PooledAllocator::getPooledAllocator:
-//    Returns the pooled allocator if it is not already in use.
+//    Returns a pooled allocator if one is not already in use.
 //
 // Arguments:
 //    memoryManager: The `IEEMemoryManager` instance in use by the caller.
 //
 // Return Value:
-//    A pointer to the pooled allocator if it is available or `nullptr`
-//    if it is already in use.
+//    A pointer to a pooled allocator if one is available or `nullptr`
+//    if they are all in use.
 //
 // Notes:
 //    Calling `destroy` on the returned allocator will return it to the
 //    pool.
 ArenaAllocator* PooledAllocator::getPooledAllocator(IEEMemoryManager* memoryManager)
 {
-    LONG oldState = InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_IN_USE);
+    const unsigned start = GetCurrentThreadId() % POOLED_ALLOCATOR_COUNT;
+
+    for (unsigned i = 0; i < POOLED_ALLOCATOR_COUNT; i++)
+    {
+        ArenaAllocator* allocator =
+            s_pooledAllocators[(start + i) % POOLED_ALLOCATOR_COUNT].tryGet(memoryManager);
+
+        if (allocator != nullptr)
+        {
+            return allocator;
+        }
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------
+// PooledAllocator::tryGet:
+//    Returns this pooled allocator if it is not already in use.
+//
+// Arguments:
+//    memoryManager: The `IEEMemoryManager` instance in use by the caller.
+//
+// Return Value:
+//    A pointer to this allocator if it is available or `nullptr`
+//    if it is already in use.
+ArenaAllocator* PooledAllocator::tryGet(IEEMemoryManager* memoryManager)
+{
+    // Avoid the interlocked operation when the allocator is obviously busy
+    if (m_state == POOLED_ALLOCATOR_IN_USE)
+    {
+        return nullptr;
+    }
+
+    LONG oldState = InterlockedExchange(&m_state, POOLED_ALLOCATOR_IN_USE);
     switch (oldState)
     {
         case POOLED_ALLOCATOR_IN_USE:
+            return nullptr;
+
         case POOLED_ALLOCATOR_SHUTDOWN:
-            // Either the allocator is in use or this call raced with a call to `shutdown`.
-            // Return `nullptr`.
+            // This call raced with a call to `shutdown`. Restore the state and return `nullptr`.
+            InterlockedExchange(&m_state, POOLED_ALLOCATOR_SHUTDOWN);
             return nullptr;
 
         case POOLED_ALLOCATOR_AVAILABLE:
-            if (s_pooledAllocator.m_memoryManager != memoryManager)
+            if (m_memoryManager != memoryManager)
             {
                 // The allocator is available, but it was initialized with a different
                 // memory manager. Release it and return `nullptr`.
-                InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_AVAILABLE);
+                InterlockedExchange(&m_state, POOLED_ALLOCATOR_AVAILABLE);
                 return nullptr;
             }
 
-            return &s_pooledAllocator;
+#ifdef FEATURE_JIT_METHOD_PERF
+            m_hostAllocCount  = 0;
+            m_hostAllocCycles = 0;
+#endif // FEATURE_JIT_METHOD_PERF
+
+            return this;
 
         case POOLED_ALLOCATOR_NOTINITIALIZED:
         {
@@ -464,14 +591,14 @@ ArenaAllocator* PooledAllocator::getPooledAllocator(IEEMemoryManager* memoryMana
             if (allocator.allocateNewPage(0, false) == nullptr)
             {
                 // Failed to grab the initial memory page.
-                InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_NOTINITIALIZED);
+                InterlockedExchange(&m_state, POOLED_ALLOCATOR_NOTINITIALIZED);
                 return nullptr;
             }
 
-            s_pooledAllocator = std::move(allocator);
+            *this = std::move(allocator);
         }
 
-            return &s_pooledAllocator;
+            return this;
 
         default:
             assert(!"Unknown pooled allocator state");
@@ -483,18 +610,47 @@ ArenaAllocator* PooledAllocator::getPooledAllocator(IEEMemoryManager* memoryMana
 // PooledAllocator::destroy:
 //    Performs any necessary teardown for an `PooledAllocator` and returns the allocator
 //    to the pool.
+//
+// Notes:
+//    The first page is always kept. Further default-sized pages are kept
+//    as spares, up to about the average memory use of recent compilations
+//    with this allocator, so that the next compilation of similar size does
+//    not have to go back to the host.
 void PooledAllocator::destroy()
 {
     assert(isInitialized());
-    assert(this == &s_pooledAllocator);
-    assert(s_pooledAllocatorState == POOLED_ALLOCATOR_IN_USE || s_pooledAllocatorState == POOLED_ALLOCATOR_SHUTDOWN);
+    assert((this >= &s_pooledAllocators[0]) && (this < &s_pooledAllocators[POOLED_ALLOCATOR_COUNT]));
+    assert(m_state == POOLED_ALLOCATOR_IN_USE || m_state == POOLED_ALLOCATOR_SHUTDOWN);
     assert(m_firstPage != nullptr);
 
-    // Free all but the first allocated page
+    // Update the running average of memory use, weighting recent compilations most heavily.
+    const size_t bytesAllocated = getTotalBytesAllocated();
+    m_recentBytesAllocated      = (m_recentBytesAllocated * 3 + bytesAllocated) / 4;
+
+    size_t retainedBytes = s_defaultPageSize;
+    for (PageDescriptor* page = m_sparePages; page != nullptr; page = page->m_next)
+    {
+        retainedBytes += page->m_pageBytes;
+    }
+
+    const size_t retainLimit = min(m_recentBytesAllocated, (size_t)(MAX_RETAINED_PAGES * s_defaultPageSize));
+
+    // Keep default-sized pages beyond the first page as spares while under the limit; free the rest.
     for (PageDescriptor *page = m_firstPage->m_next, *next; page != nullptr; page = next)
     {
         next = page->m_next;
-        freeHostMemory(page);
+
+        if ((page->m_pageBytes == s_defaultPageSize) && (retainedBytes + page->m_pageBytes <= retainLimit))
+        {
+            retainedBytes += page->m_pageBytes;
+            page->m_next     = m_sparePages;
+            page->m_previous = nullptr;
+            m_sparePages     = page;
+        }
+        else
+        {
+            freeHostMemory(page);
+        }
     }
 
     // Reset the relevant state to point back to the first byte of the first page
@@ -505,27 +661,27 @@ void PooledAllocator::destroy()
 
     assert(getTotalBytesAllocated() == s_defaultPageSize);
 
-    // If we've already been shut down, free the first page. Otherwise, return the allocator to the pool.
-    if (s_pooledAllocatorState == POOLED_ALLOCATOR_SHUTDOWN)
+    // If we've already been shut down, free the retained pages. Otherwise, return the allocator to the pool.
+    if (m_state == POOLED_ALLOCATOR_SHUTDOWN)
     {
         ArenaAllocator::destroy();
     }
     else
     {
-        InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_AVAILABLE);
+        InterlockedExchange(&m_state, POOLED_ALLOCATOR_AVAILABLE);
     }
 }
 
 //------------------------------------------------------------------------
 // ArenaAllocator::getPooledAllocator:
-//    Returns the pooled allocator if it is not already in use.
+//    Returns a pooled allocator if one is not already in use.
 //
 // Arguments:
 //    memoryManager: The `IEEMemoryManager` instance in use by the caller.
 //
 // Return Value:
-//    A pointer to the pooled allocator if it is available or `nullptr`
-//    if it is already in use.
+//    A pointer to a pooled allocator if one is available or `nullptr`
+//    if they are all in use.
 //
 // Notes:
 //    Calling `destroy` on the returned allocator will return it to the
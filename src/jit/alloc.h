@@ -43,10 +43,21 @@ protected:
     PageDescriptor* m_firstPage;
     PageDescriptor* m_lastPage;
 
+    // Pages kept from an earlier use of this allocator (see PooledAllocator::destroy)
+    // that are handed out before asking the host for more memory. Linked by 'm_next'.
+    PageDescriptor* m_sparePages;
+
     // These two pointers (when non-null) will always point into 'm_lastPage'.
     BYTE* m_nextFreeByte;
     BYTE* m_lastFreeByte;
 
+#ifdef FEATURE_JIT_METHOD_PERF
+    // Number of pages obtained from the host, and the cycles spent doing so,
+    // since the allocator was last handed out.
+    unsigned         m_hostAllocCount;
+    unsigned __int64 m_hostAllocCycles;
+#endif // FEATURE_JIT_METHOD_PERF
+
     bool isInitialized();
 
     void* allocateNewPage(size_t size, bool canThrow);
@@ -72,6 +83,18 @@ public:
     size_t getTotalBytesAllocated();
     size_t getTotalBytesUsed();
 
+#ifdef FEATURE_JIT_METHOD_PERF
+    unsigned getHostAllocCount()
+    {
+        return m_hostAllocCount;
+    }
+
+    unsigned __int64 getHostAllocCycles()
+    {
+        return m_hostAllocCycles;
+    }
+#endif // FEATURE_JIT_METHOD_PERF
+
     static bool   bypassHostAllocator();
     static size_t getDefaultPageSize();
 
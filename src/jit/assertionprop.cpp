@@ -3420,6 +3420,7 @@ GenTreePtr Compiler::optAssertionProp_Comma(ASSERT_VALARG_TP assertions, const G
         ((tree->gtGetOp1()->gtFlags & GTF_ARR_BOUND_INBND) != 0))
     {
         optRemoveRangeCheck(tree, stmt);
+        INDEBUG(optBndsChksRemovedByAssertionProp++);
         return optAssertionProp_Update(tree, tree, stmt);
     }
     return nullptr;
@@ -1058,6 +1058,14 @@ void CodeGen::genUnspillRegIfNeeded(GenTree* tree)
             unspillTree->gtFlags &= ~GTF_SPILLED;
         }
 #endif
+        else if (unspillTree->IsRematerializableConst())
+        {
+            // This constant was not stored when it was spilled (see genProduceReg); just
+            // recreate it in the target register.
+            genSetRegToConst(dstReg, unspillTree->TypeGet(), unspillTree);
+
+            unspillTree->gtFlags &= ~GTF_SPILLED;
+        }
         else
         {
             TempDsc* t = regSet.rsUnspillInPlace(unspillTree, unspillTree->gtRegNum);
@@ -1696,6 +1704,11 @@ void CodeGen::genProduceReg(GenTree* tree)
                 }
             }
 #endif // _TARGET_ARM_
+            else if (tree->IsRematerializableConst() && ((tree->gtFlags & GTF_NOREG_AT_USE) == 0))
+            {
+                // The constant will be rematerialized at its use (see genUnspillRegIfNeeded),
+                // so there is nothing to store.
+            }
             else
             {
                 regSet.rsSpillTree(tree->gtRegNum, tree);
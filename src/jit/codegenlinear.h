@@ -116,6 +116,11 @@ void genPutArgStkSIMD12(GenTree* treeNode);
 
 #if FEATURE_HW_INTRINSICS && defined(_TARGET_XARCH_)
 void genHWIntrinsic(GenTreeHWIntrinsic* node);
+void genHWIntrinsicSimdUnaryOp(GenTreeHWIntrinsic* node, instruction ins);
+void genHWIntrinsicSimdBinaryOp(GenTreeHWIntrinsic* node, instruction ins, bool reverseOperands = false);
+void genHWIntrinsicSimdCompareOp(GenTreeHWIntrinsic* node, instruction ins, int predicate, bool reverseOperands);
+void genHWIntrinsicSimdImmOp(GenTreeHWIntrinsic* node, instruction ins);
+void genHWIntrinsicJumpTable(GenTreeHWIntrinsic* node, regNumber indexReg, BasicBlock** labels, unsigned labelCount);
 void genSSEIntrinsic(GenTreeHWIntrinsic* node);
 void genSSE2Intrinsic(GenTreeHWIntrinsic* node);
 void genSSE3Intrinsic(GenTreeHWIntrinsic* node);
@@ -25,6 +25,7 @@ XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 #endif // !LEGACY_BACKEND
 
 #include "jittelemetry.h"
+#include "inlinepolicy.h"
 
 #if defined(DEBUG)
 // Column settings for COMPlus_JitDumpIR.  We could(should) make these programmable.
@@ -1395,6 +1396,9 @@ void Compiler::compStartup()
     // Static vars of ValueNumStore
     ValueNumStore::InitValueNumStoreStatics();
 
+    // Load any offline-fitted inline model
+    ModelPolicy::LoadModel();
+
     compDisplayStaticSizes(jitstdout);
 }
 
@@ -1999,6 +2003,12 @@ void Compiler::compInit(ArenaAllocator* pAlloc, InlineInfo* inlineInfo)
 
         optLoopsCloned = 0;
 
+#ifdef DEBUG
+        optBndsChksRemovedByCloning       = 0;
+        optBndsChksRemovedByAssertionProp = 0;
+        optBndsChksRemovedByRangeCheck    = 0;
+#endif
+
 #if MEASURE_MEM_ALLOC
         genMemStats.Init();
 #endif // MEASURE_MEM_ALLOC
@@ -2642,14 +2652,16 @@ void Compiler::compSetProcessor()
             }
             if (jitFlags.IsSet(JitFlags::JIT_FLAG_USE_BMI2))
             {
-                if (configEnableISA(InstructionSet_BMI2))
+                // BMI2 instructions are VEX-encoded, so they are only usable along with AVX.
+                if (configEnableISA(InstructionSet_BMI2) && compSupports(InstructionSet_AVX))
                 {
                     opts.setSupportedISA(InstructionSet_BMI2);
                 }
             }
             if (jitFlags.IsSet(JitFlags::JIT_FLAG_USE_FMA))
             {
-                if (configEnableISA(InstructionSet_FMA))
+                // FMA instructions are VEX-encoded, so they are only usable along with AVX.
+                if (configEnableISA(InstructionSet_FMA) && compSupports(InstructionSet_AVX))
                 {
                     opts.setSupportedISA(InstructionSet_FMA);
                 }
@@ -2725,8 +2737,10 @@ void Compiler::compSetProcessor()
             codeGen->getEmitter()->SetContainsAVX(false);
             codeGen->getEmitter()->SetContains256bitAVX(false);
         }
-        else if (CanUseSSE4())
+        else if (CanUseSSE4() || compSupports(InstructionSet_SSSE3) || compSupports(InstructionSet_AES) ||
+                 compSupports(InstructionSet_PCLMULQDQ))
         {
+            // pshufb, aes* and pclmulqdq share the 4-byte 0F38/0F3A opcode encodings with SSE4.
             codeGen->getEmitter()->SetUseSSE4(true);
         }
     }
@@ -4562,6 +4576,11 @@ void Compiler::compCompile(void** methodCodePtr, ULONG* methodCodeSize, JitFlags
         fgTransformFatCalli();
     }
 
+    if (doesMethodHaveGuardedDevirtualization())
+    {
+        fgTransformGuardedDevirtualizationCalls();
+    }
+
     EndPhase(PHASE_IMPORTATION);
 
     if (compIsForInlining())
@@ -4610,6 +4629,11 @@ void Compiler::compCompile(void** methodCodePtr, ULONG* methodCodeSize, JitFlags
         fgInstrumentMethod();
     }
 
+    if (compileFlags->IsSet(JitFlags::JIT_FLAG_TIER0))
+    {
+        fgInsertLoopBackEdgeCounters();
+    }
+
     // We could allow ESP frames. Just need to reserve space for
     // pushing EBP if the method becomes an EBP-frame after an edit.
     // Note that requiring a EBP Frame disallows double alignment.  Thus if we change this
@@ -4711,6 +4735,14 @@ void Compiler::compCompile(void** methodCodePtr, ULONG* methodCodeSize, JitFlags
     // Transform each GT_ALLOCOBJ node into either an allocation helper call or
     // local variable allocation on the stack.
     ObjectAllocator objectAllocator(this);
+
+    // Stack allocation relies on the reachability sets to avoid allocating
+    // in loops, so it is only done when optimizing.
+    if ((JitConfig.JitObjectStackAllocation() != 0) && !opts.MinOpts() && !opts.compDbgCode)
+    {
+        objectAllocator.EnableObjectStackAllocation();
+    }
+
     objectAllocator.Run();
 
     if (!opts.MinOpts() && !opts.compDbgCode)
@@ -4729,6 +4761,13 @@ void Compiler::compCompile(void** methodCodePtr, ULONG* methodCodeSize, JitFlags
         optCloneLoops();
         EndPhase(PHASE_CLONE_LOOPS);
 
+#ifdef FEATURE_SIMD
+        // Rewrite simple loops over arrays, whose bounds checks were
+        // removed by cloning, to use SIMD vectors.
+        optVectorizeLoops();
+        EndPhase(PHASE_VECTORIZE_LOOPS);
+#endif // FEATURE_SIMD
+
         /* Unroll loops */
         optUnrollLoops();
         EndPhase(PHASE_UNROLL_LOOPS);
@@ -4870,6 +4909,10 @@ void Compiler::compCompile(void** methodCodePtr, ULONG* methodCodeSize, JitFlags
             }
 #endif // ASSERTION_PROP
 
+#ifdef DEBUG
+            optDumpBndsChkReport();
+#endif
+
             /* update the flowgraph if we modified it during the optimization phase*/
             if (fgModified)
             {
@@ -7646,6 +7689,8 @@ CompTimeInfo::CompTimeInfo(unsigned byteCodeBytes)
     , m_totalCycles(0)
     , m_parentPhaseEndSlop(0)
     , m_timerFailure(false)
+    , m_hostAllocCount(0)
+    , m_hostAllocCycles(0)
 #if MEASURE_CLRAPI_CALLS
     , m_allClrAPIcalls(0)
     , m_allClrAPIcycles(0)
@@ -7711,6 +7756,10 @@ void CompTimeSummaryInfo::AddInfo(CompTimeInfo& info, bool includePhases)
         m_maximum.m_byteCodeBytes = max(m_maximum.m_byteCodeBytes, info.m_byteCodeBytes);
         m_total.m_totalCycles += info.m_totalCycles;
         m_maximum.m_totalCycles = max(m_maximum.m_totalCycles, info.m_totalCycles);
+        m_total.m_hostAllocCount += info.m_hostAllocCount;
+        m_maximum.m_hostAllocCount = max(m_maximum.m_hostAllocCount, info.m_hostAllocCount);
+        m_total.m_hostAllocCycles += info.m_hostAllocCycles;
+        m_maximum.m_hostAllocCycles = max(m_maximum.m_hostAllocCycles, info.m_hostAllocCycles);
 
 #if MEASURE_CLRAPI_CALLS
         // Update the CLR-API values.
@@ -7823,6 +7872,14 @@ void CompTimeSummaryInfo::Print(FILE* f)
         fprintf(f, "          avg: %10.3f Mcycles/%10.3f ms\n",
                 ((double)m_total.m_totalCycles) / 1000000.0 / (double)m_numMethods, totTime_ms / (double)m_numMethods);
 
+        // Time spent getting arena pages from the host is spread across the phases; report it separately.
+        double allocTime_ms = ((double)m_total.m_hostAllocCycles / countsPerSec) * 1000.0;
+        fprintf(f, "  Arena pages from host: %u total (%u max, %8.2f avg)\n", m_total.m_hostAllocCount,
+                m_maximum.m_hostAllocCount, (double)m_total.m_hostAllocCount / (double)m_numMethods);
+        fprintf(f, "  Arena allocation time: %10.3f Mcycles/%10.3f ms (%4.1f%% of total, %8.3f ms max)\n",
+                ((double)m_total.m_hostAllocCycles / 1000000.0), allocTime_ms, allocTime_ms * 100.0 / totTime_ms,
+                ((double)m_maximum.m_hostAllocCycles / countsPerSec) * 1000.0);
+
         const char* extraHdr1 = "";
         const char* extraHdr2 = "";
 #if MEASURE_CLRAPI_CALLS
@@ -8240,6 +8297,8 @@ void JitTimer::PrintCsvHeader()
             fprintf(fp, "\"Executable Code Bytes\",");
             fprintf(fp, "\"GC Info Bytes\",");
             fprintf(fp, "\"Total Bytes Allocated\",");
+            fprintf(fp, "\"Host Alloc Pages\",");
+            fprintf(fp, "\"Host Alloc Cycles\",");
             fprintf(fp, "\"Total Cycles\",");
             fprintf(fp, "\"CPS\"\n");
         }
@@ -8307,6 +8366,8 @@ void JitTimer::PrintCsvMethodStats(Compiler* comp)
     fprintf(fp, "%Iu,", comp->info.compNativeCodeSize);
     fprintf(fp, "%Iu,", comp->compInfoBlkSize);
     fprintf(fp, "%Iu,", comp->compGetAllocator()->getTotalBytesAllocated());
+    fprintf(fp, "%u,", m_info.m_hostAllocCount);
+    fprintf(fp, "%I64u,", m_info.m_hostAllocCycles);
     fprintf(fp, "%I64u,", m_info.m_totalCycles);
     fprintf(fp, "%f\n", CycleTimer::CyclesPerSecond());
     fclose(fp);
@@ -8317,6 +8378,10 @@ void JitTimer::Terminate(Compiler* comp, CompTimeSummaryInfo& sum, bool includeP
 {
     if (includePhases)
     {
+        // Inlinee compilers share the root's allocator, so only the root reports it.
+        m_info.m_hostAllocCount  = comp->compGetAllocator()->getHostAllocCount();
+        m_info.m_hostAllocCycles = comp->compGetAllocator()->getHostAllocCycles();
+
         PrintCsvMethodStats(comp);
     }
 
@@ -1002,6 +1002,11 @@ struct CompTimeInfo
     unsigned __int64 m_parentPhaseEndSlop;
     bool             m_timerFailure;
 
+    // Arena pages obtained from the host during the compilation, and the cycles spent
+    // obtaining them. These cycles are also included in the phases that needed the memory.
+    unsigned         m_hostAllocCount;
+    unsigned __int64 m_hostAllocCycles;
+
 #if MEASURE_CLRAPI_CALLS
     // The following measures the time spent inside each individual CLR API call.
     unsigned         m_allClrAPIcalls;
@@ -2971,7 +2976,16 @@ protected:
                              CORINFO_METHOD_HANDLE*  method,
                              unsigned*               methodFlags,
                              CORINFO_CONTEXT_HANDLE* contextHandle,
-                             CORINFO_CONTEXT_HANDLE* exactContextHandle);
+                             CORINFO_CONTEXT_HANDLE* exactContextHandle,
+                             IL_OFFSET               ilOffset = BAD_IL_OFFSET);
+
+    void impConsiderGuardedDevirtualization(GenTreeCall*           call,
+                                            CORINFO_METHOD_HANDLE  baseMethod,
+                                            unsigned               baseMethodAttribs,
+                                            CORINFO_CONTEXT_HANDLE ownerType,
+                                            IL_OFFSET              ilOffset);
+
+    void impInsertClassProfile(GenTreeCall* call, IL_OFFSET ilOffset);
 
     CORINFO_CLASS_HANDLE impGetSpecialIntrinsicExactReturnType(CORINFO_METHOD_HANDLE specialIntrinsicHandle);
 
@@ -3044,8 +3058,15 @@ protected:
     GenTree* impLZCNTIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig);
     GenTree* impPCLMULQDQIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig);
     GenTree* impPOPCNTIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig);
+    var_types impHWIntrinsicArgBaseType(CORINFO_SIG_INFO* sig, unsigned argNum);
+    GenTree* impSimdUnaryHWIntrinsic(NamedIntrinsic intrinsic, CORINFO_SIG_INFO* sig, var_types simdType);
+    GenTree* impSimdBinaryHWIntrinsic(NamedIntrinsic intrinsic, CORINFO_SIG_INFO* sig, var_types simdType);
+    GenTree* impSimdImmHWIntrinsic(NamedIntrinsic intrinsic, CORINFO_SIG_INFO* sig, var_types simdType);
+    GenTree* impHWIntrinsicLoad(CORINFO_SIG_INFO* sig);
+    GenTree* impHWIntrinsicStore(CORINFO_SIG_INFO* sig, var_types simdType);
     bool compSupportsHWIntrinsic(InstructionSet isa);
     bool isScalarISA(InstructionSet isa);
+    GenTree* immOperandOfHWIntrinsic(GenTreeHWIntrinsic* node);
 #endif // _TARGET_XARCH_
 #endif // FEATURE_HW_INTRINSICS
     GenTreePtr impArrayAccessIntrinsic(CORINFO_CLASS_HANDLE clsHnd,
@@ -3713,6 +3734,8 @@ public:
 
     void fgTransformFatCalli();
 
+    void fgTransformGuardedDevirtualizationCalls();
+
     void fgInline();
 
     void fgRemoveEmptyTry();
@@ -4683,6 +4706,8 @@ protected:
     bool fgGetProfileWeightForBasicBlock(IL_OFFSET offset, unsigned* weight);
     void fgInstrumentMethod();
 
+    void fgInsertLoopBackEdgeCounters();
+
 public:
     // fgIsUsingProfileWeights - returns true if we have real profile data for this method
     //                           or if we have some fake profile data for the stress mode
@@ -5099,6 +5124,9 @@ protected:
         // Value numbers of expressions that have been hoisted in the current (or most recent) loop in the nest.
         // Previous decisions on loop-invariance of value numbers in the current loop.
         VNToBoolMap m_curLoopVnInvariantCache;
+        // Value numbers of object references that are dereferenced in the head of the current loop, and so
+        // are known to be non-null whenever the loop body executes.
+        VNSet m_curLoopNonNullVNs;
 
         VNSet* GetHoistedInCurLoop(Compiler* comp)
         {
@@ -5120,6 +5148,7 @@ protected:
             : m_pHoistedInCurLoop(nullptr)
             , m_hoistedInParentLoops(comp->getAllocatorLoopHoist())
             , m_curLoopVnInvariantCache(comp->getAllocatorLoopHoist())
+            , m_curLoopNonNullVNs(comp->getAllocatorLoopHoist())
         {
         }
     };
@@ -5157,6 +5186,13 @@ protected:
                                   bool*             pHoistable,
                                   bool*             pCctorDependent);
 
+    // If the only exception "tree" can raise is a null reference from dereferencing an object (an array length or
+    // a field load at a small offset), returns the node for that object reference; otherwise returns nullptr.
+    GenTreePtr optHoistNullCheckedRef(GenTreePtr tree);
+
+    // Record in "m_curLoopNonNullVNs" the value numbers of the object references that are dereferenced in "blk".
+    void optHoistRecordNonNullRefs(BasicBlock* blk, LoopHoistContext* hoistCtxt);
+
     // Performs the hoisting 'tree' into the PreHeader for loop 'lnum'
     void optHoistCandidate(GenTreePtr tree, unsigned lnum, LoopHoistContext* hoistCtxt);
 
@@ -5220,6 +5256,20 @@ public:
 
     void optUnrollLoops(); // Unrolls loops (needs to have cost info)
 
+    // Returns true if loop "lnum" is a single block counted loop, "do { ... } while (i < limit)".
+    bool optIsSingleBlockCountedLoop(unsigned lnum);
+
+    // Partially unrolls loop "lnum" if it is a counted loop with a trip count that isn't known at compile time.
+    bool optPartialUnrollLoop(unsigned lnum, int unrollLimitSz);
+
+#ifdef FEATURE_SIMD
+    // Rewrites simple loops over primitive arrays to process Vector<T>::Count elements per iteration.
+    void optVectorizeLoops();
+    bool optVectorizeLoop(unsigned lnum);
+    GenTreePtr optVectorizeArrElem(GenTreePtr tree, unsigned ivLcl, unsigned* pArrLcl);
+    GenTreePtr optVectorizeTree(unsigned lnum, GenTreePtr tree, var_types baseType, BasicBlock* preBlock);
+#endif // FEATURE_SIMD
+
 protected:
     // This enumeration describes what is killed by a call.
 
@@ -5281,7 +5331,7 @@ public:
 
 #define LPFLG_VAR_LIMIT 0x0100    // iterator is compared with a local var (var # found in lpVarLimit)
 #define LPFLG_CONST_LIMIT 0x0200  // iterator is compared with a constant (found in lpConstLimit)
-#define LPFLG_ARRLEN_LIMIT 0x0400 // iterator is compared with a.len or a[i].len (found in lpArrLenLimit)
+#define LPFLG_ARRLEN_LIMIT 0x0400 // iterator is compared with a.len, a[i].len or a.len - cns (found in lpArrLenLimit)
 #define LPFLG_SIMD_LIMIT 0x0080   // iterator is compared with Vector<T>.Count (found in lpConstLimit)
 
 #define LPFLG_HAS_PREHEAD 0x0800 // lpHead is known to be a preHead for this loop
@@ -5362,6 +5412,9 @@ public:
         bool lpArrLenLimit(Compiler* comp, ArrIndex* index); // The array length in the loop condition ( "i RELOP
                                                              // arr.len" or "i RELOP arr[i][j].len" )  : Valid if
                                                              // LPFLG_ARRLEN_LIMIT
+        int lpArrLenLimitConst(); // the constant in the loop condition ( "i RELOP arr.len - const" ), zero if none
+                                  //                                                                   : Valid if
+                                  // LPFLG_ARRLEN_LIMIT
 
         // Returns "true" iff "*this" contains the blk.
         bool lpContains(BasicBlock* blk)
@@ -5437,6 +5490,15 @@ protected:
     unsigned optNativeCallCount;   // number of Pinvoke/Native calls made in the method
     unsigned optLoopsCloned;       // number of loops cloned in the current method.
 
+#ifdef DEBUG
+    // Number of bounds checks removed in the current method, by the phase that removed them.
+    unsigned optBndsChksRemovedByCloning;
+    unsigned optBndsChksRemovedByAssertionProp;
+    unsigned optBndsChksRemovedByRangeCheck;
+
+    void optDumpBndsChkReport();
+#endif
+
 #ifdef DEBUG
     unsigned optFindLoopNumberFromBeginBlock(BasicBlock* begBlk);
     void optPrintLoopInfo(unsigned      loopNum,
@@ -5794,6 +5856,7 @@ public:
 #define OMF_HAS_VTABLEREF 0x00000008  // Method contains method table reference.
 #define OMF_HAS_NULLCHECK 0x00000010  // Method contains null check.
 #define OMF_HAS_FATPOINTER 0x00000020 // Method contains call, that needs fat pointer transformation.
+#define OMF_HAS_GUARDEDDEVIRT 0x00000040 // Method contains guarded devirtualization candidate
 
     bool doesMethodHaveFatPointer()
     {
@@ -5812,6 +5875,26 @@ public:
 
     void addFatPointerCandidate(GenTreeCall* call);
 
+    bool doesMethodHaveGuardedDevirtualization()
+    {
+        return (optMethodFlags & OMF_HAS_GUARDEDDEVIRT) != 0;
+    }
+
+    void setMethodHasGuardedDevirtualization()
+    {
+        optMethodFlags |= OMF_HAS_GUARDEDDEVIRT;
+    }
+
+    void clearMethodHasGuardedDevirtualization()
+    {
+        optMethodFlags &= ~OMF_HAS_GUARDEDDEVIRT;
+    }
+
+    void addGuardedDevirtualizationCandidate(GenTreeCall*          call,
+                                             CORINFO_METHOD_HANDLE methodHandle,
+                                             CORINFO_CLASS_HANDLE  classHandle,
+                                             unsigned              likelihood);
+
     unsigned optMethodFlags;
 
     // Recursion bound controls how far we can go backwards tracking for a SSA value.
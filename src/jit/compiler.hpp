@@ -3895,6 +3895,12 @@ inline void Compiler::LoopDsc::VERIFY_lpTestTree()
     }
     if (lpFlags & LPFLG_ARRLEN_LIMIT)
     {
+        // Either "a.len" or "a.len - cns", which morph has turned into "a.len + (-cns)".
+        if (limit->OperGet() == GT_ADD)
+        {
+            assert(limit->gtGetOp2()->IsCnsIntOrI());
+            limit = limit->gtGetOp1();
+        }
         assert(limit->OperGet() == GT_ARR_LENGTH);
     }
 #endif
@@ -3968,6 +3974,12 @@ inline bool Compiler::LoopDsc::lpArrLenLimit(Compiler* comp, ArrIndex* index)
     assert(lpFlags & LPFLG_ARRLEN_LIMIT);
 
     GenTreePtr limit = lpLimit();
+
+    // Look through the constant of an "a.length - cns" limit, see lpArrLenLimitConst.
+    if (limit->OperGet() == GT_ADD)
+    {
+        limit = limit->gtGetOp1();
+    }
     assert(limit->OperGet() == GT_ARR_LENGTH);
 
     // Check if we have a.length or a[i][j].length
@@ -3985,6 +3997,24 @@ inline bool Compiler::LoopDsc::lpArrLenLimit(Compiler* comp, ArrIndex* index)
     return false;
 }
 
+//-----------------------------------------------------------------------------
+
+inline int Compiler::LoopDsc::lpArrLenLimitConst()
+{
+    VERIFY_lpTestTree();
+    assert(lpFlags & LPFLG_ARRLEN_LIMIT);
+
+    GenTreePtr limit = lpLimit();
+    if (limit->OperGet() != GT_ADD)
+    {
+        assert(limit->OperGet() == GT_ARR_LENGTH);
+        return 0;
+    }
+
+    assert(limit->gtGetOp2()->IsCnsIntOrI());
+    return (int)limit->gtGetOp2()->gtIntCon.gtIconVal;
+}
+
 /*****************************************************************************
  *  Is "var" assigned in the loop "lnum" ?
  */
@@ -80,8 +80,20 @@ extern "C" void __stdcall jitStartup(ICorJitHost* jitHost)
     assert(!JitConfig.isInitialized());
     JitConfig.initialize(jitHost);
 
+    // If requested, send the jit's own output (dumps, disassembly, LSRA stats, ...) to a file
+    // rather than to the process' stdout. It is closed in jitShutdown.
+    LPCWSTR jitStdOutFile = JitConfig.JitStdOutFile();
+    if (jitStdOutFile != nullptr)
+    {
+        jitstdout = _wfopen(jitStdOutFile, W("a"));
+        assert(jitstdout != nullptr);
+    }
+
 #if defined(_HOST_UNIX_)
-    jitstdout = procstdout();
+    if (jitstdout == nullptr)
+    {
+        jitstdout = procstdout();
+    }
 #else  // !_HOST_UNIX_
     if (jitstdout == nullptr)
     {
@@ -95,7 +95,13 @@ bool emitter::IsDstDstSrcAVXInstruction(instruction ins)
             ins == INS_pmaxuw || ins == INS_pmaxud || ins == INS_vinserti128 || ins == INS_punpckhbw ||
             ins == INS_punpcklbw || ins == INS_punpckhqdq || ins == INS_punpcklqdq || ins == INS_punpckhwd ||
             ins == INS_punpcklwd || ins == INS_punpckhdq || ins == INS_packssdw || ins == INS_packsswb ||
-            ins == INS_packuswb || ins == INS_packusdw || ins == INS_vperm2i128);
+            ins == INS_packuswb || ins == INS_packusdw || ins == INS_vperm2i128 || ins == INS_unpcklps ||
+            ins == INS_unpckhps || ins == INS_unpcklpd || ins == INS_unpckhpd || ins == INS_haddps ||
+            ins == INS_pshufb || ins == INS_blendps || ins == INS_blendpd || ins == INS_pblendw ||
+            ins == INS_vpblendd || ins == INS_aesdec || ins == INS_aesdeclast || ins == INS_aesenc ||
+            ins == INS_aesenclast || ins == INS_pclmulqdq || ins == INS_vfmadd213ps || ins == INS_vfmadd213pd ||
+            ins == INS_vfmadd231ps || ins == INS_vfmadd231pd || ins == INS_vfmsub213ps || ins == INS_vfmsub213pd ||
+            ins == INS_vfmsub231ps || ins == INS_vfmsub231pd || ins == INS_pdep || ins == INS_pext);
 }
 
 // Returns true if the AVX instruction requires 3 operands that duplicate the source
@@ -212,7 +218,8 @@ bool TakesRexWPrefix(instruction ins, emitAttr attr)
     // size specification (128 vs. 256 bits) and the operand size specification (32 vs. 64 bits), where both are
     // required, the instruction must be created with the register size attribute (EA_16BYTE or EA_32BYTE),
     // and here we must special case these by the opcode.
-    if (ins == INS_vpermq)
+    if ((ins == INS_vpermq) || (ins == INS_vfmadd213pd) || (ins == INS_vfmadd231pd) || (ins == INS_vfmsub213pd) ||
+        (ins == INS_vfmsub231pd))
     {
         return true;
     }
@@ -238,7 +245,11 @@ bool TakesRexWPrefix(instruction ins, emitAttr attr)
     if (IsSSEOrAVXInstruction(ins))
     {
         if (ins == INS_cvttsd2si || ins == INS_cvttss2si || ins == INS_cvtsd2si || ins == INS_cvtss2si ||
-            ins == INS_cvtsi2sd || ins == INS_cvtsi2ss || ins == INS_mov_xmm2i || ins == INS_mov_i2xmm)
+            ins == INS_cvtsi2sd || ins == INS_cvtsi2ss || ins == INS_mov_xmm2i || ins == INS_mov_i2xmm
+#if FEATURE_HW_INTRINSICS
+            || ins == INS_pdep || ins == INS_pext
+#endif // FEATURE_HW_INTRINSICS
+            )
         {
             return true;
         }
@@ -901,7 +912,7 @@ bool emitter::emitInsCanOnlyWriteSSE2OrAVXReg(instrDesc* id)
     if (!IsSSEOrAVXInstruction(ins) || ins == INS_mov_xmm2i || ins == INS_cvttsd2si
 #ifndef LEGACY_BACKEND
         || ins == INS_cvttss2si || ins == INS_cvtsd2si || ins == INS_cvtss2si || ins == INS_pmovmskb ||
-        ins == INS_pextrw
+        ins == INS_pextrw || ins == INS_movmskps || ins == INS_movmskpd || ins == INS_pdep || ins == INS_pext
 #endif // !LEGACY_BACKEND
         )
     {
@@ -1308,8 +1319,9 @@ inline unsigned emitter::insEncodeRegSIB(instruction ins, regNumber reg, code_t*
 inline emitter::code_t emitter::insEncodeMRreg(instruction ins, code_t code)
 {
     // If Byte 4 (which is 0xFF00) is 0, that's where the RM encoding goes.
-    // Otherwise, it will be placed after the 4 byte encoding.
-    if ((code & 0xFF00) == 0)
+    // Otherwise, it will be placed after the 4 byte encoding. Note that a 4 byte
+    // encoding may itself end in a zero opcode byte (e.g. pshufb, vpermq).
+    if (((code & 0xFF00) == 0) && !EncodedBySSE38orSSE3A(ins))
     {
         assert((code & 0xC000) == 0);
         code |= 0xC000;
@@ -1326,8 +1338,9 @@ inline emitter::code_t emitter::insEncodeMRreg(instruction ins, code_t code)
 inline emitter::code_t emitter::insEncodeRMreg(instruction ins, code_t code)
 {
     // If Byte 4 (which is 0xFF00) is 0, that's where the RM encoding goes.
-    // Otherwise, it will be placed after the 4 byte encoding.
-    if ((code & 0xFF00) == 0)
+    // Otherwise, it will be placed after the 4 byte encoding. Note that a 4 byte
+    // encoding may itself end in a zero opcode byte (e.g. pshufb, vpermq).
+    if (((code & 0xFF00) == 0) && !EncodedBySSE38orSSE3A(ins))
     {
         assert((code & 0xC000) == 0);
         code |= 0xC000;
@@ -1547,7 +1560,7 @@ inline UNATIVE_OFFSET emitter::emitInsSizeRR(instruction ins, regNumber reg1, re
     // This would probably be better expressed as a different format or something?
     code_t code = insCodeRM(ins);
 
-    if ((code & 0xFF00) != 0)
+    if (((code & 0xFF00) != 0) || EncodedBySSE38orSSE3A(ins))
     {
         sz = 5;
     }
@@ -4812,6 +4825,23 @@ void emitter::emitIns_SIMD_R_R_R(instruction ins, regNumber reg, regNumber reg1,
         emitIns_R_R(ins, emitTypeSize(simdtype), reg, reg2);
     }
 }
+
+void emitter::emitIns_SIMD_R_R_R_I(
+    instruction ins, regNumber reg, regNumber reg1, regNumber reg2, int ival, var_types simdtype)
+{
+    if (UseVEXEncoding() && reg1 != reg)
+    {
+        emitIns_R_R_R_I(ins, emitTypeSize(simdtype), reg, reg1, reg2, ival);
+    }
+    else
+    {
+        if (reg1 != reg)
+        {
+            emitIns_R_R(INS_movaps, emitTypeSize(simdtype), reg, reg1);
+        }
+        emitIns_R_R_I(ins, emitTypeSize(simdtype), reg, reg2, ival);
+    }
+}
 #endif
 
 /*****************************************************************************
@@ -6981,7 +7011,7 @@ void emitter::emitDispIns(
             {
                 printf("%s, %s", emitRegName(id->idReg2(), attr), emitRegName(id->idReg1(), EA_16BYTE));
             }
-            else if (ins == INS_pmovmskb)
+            else if ((ins == INS_pmovmskb) || (ins == INS_movmskps) || (ins == INS_movmskpd))
             {
                 printf("%s, %s", emitRegName(id->idReg1(), EA_4BYTE), emitRegName(id->idReg2(), attr));
             }
@@ -9130,7 +9160,7 @@ BYTE* emitter::emitOutputRR(BYTE* dst, instrDesc* id)
 #endif // _TARGET_AMD64_
     }
 #if FEATURE_HW_INTRINSICS
-    else if ((ins == INS_crc32) || (ins == INS_lzcnt) || (ins == INS_popcnt))
+    else if ((ins == INS_crc32) || (ins == INS_lzcnt) || (ins == INS_popcnt) || (ins == INS_tzcnt))
     {
         code = insEncodeRMreg(ins, code);
         if ((ins == INS_crc32) && (size > EA_1BYTE))
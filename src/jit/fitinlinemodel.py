@@ -0,0 +1,255 @@
+#!/usr/bin/env python
+#
+# Licensed to the .NET Foundation under one or more agreements.
+# The .NET Foundation licenses this file to you under the MIT license.
+# See the LICENSE file in the project root for more information.
+#
+# fitinlinemodel.py -- fit a ModelPolicy inline model to inline data
+#
+# Usage:
+#
+#   fitinlinemodel.py [options] -o model.txt inlines-0.xml inlines-1.xml ...
+#
+# Gathering the data:
+#
+#   The inline xml comes from a jit built with DEBUG or INLINE_DATA,
+#   run over the workload once per value of JitInlineLimit (0, 1, 2, ...)
+#   with
+#
+#     COMPlus_JitInlineDumpXml=1
+#     COMPlus_JitInlineDumpData=1
+#     COMPlus_JitInlineDumpXmlFile=inlines-<limit>.xml
+#     COMPlus_JitInlinePolicyModel=1
+#
+#   With JitInlineDumpData=1 the last inline done in each method
+#   carries the observations the policy made about it, along with the
+#   method's code size. Comparing each method's code size to its size
+#   with one fewer inline gives the code size impact of that inline.
+#
+#   Optionally, --perf names a CSV file of measured per-call
+#   instruction counts for methods, with columns Method,Version,
+#   Instructions. Method is the token as printed in the inline data
+#   (hex) and Version is the JitInlineLimit the measurement was made
+#   with. The jit cannot measure this itself; it has to come from the
+#   workload, eg via hardware counters. Comparing to the count with
+#   one fewer inline gives the per call impact of the inline. Without
+#   --perf the built-in per call model is kept.
+#
+# Using the model:
+#
+#   COMPlus_JitInlineModelFile=model.txt
+#
+#   The file is loaded at jit startup by ModelPolicy::LoadModel, which
+#   also describes the file format. Features are the columns in the
+#   data schema that are listed in inlinefeature.def.
+
+from __future__ import print_function
+
+import argparse
+import csv
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+try:
+    import numpy as np
+except ImportError:
+    sys.exit("fitinlinemodel.py requires numpy")
+
+# Must match the MAX_TERMS limit in LinearInlineModel
+MAX_TERMS = 128
+
+# Features that describe categories rather than quantities. These are
+# fitted as one indicator term per commonly seen value.
+CATEGORICAL = re.compile(r"^(CallsiteFrequency|Arg\dType|ReturnType)$")
+
+# Built-in per call model (see DiscretionaryPolicy::EstimatePerformanceImpact),
+# kept when there is no per call data to fit.
+DEFAULT_PER_CALL_INTERCEPT = -7.35
+DEFAULT_PER_CALL_TERMS = [
+    (("CallsiteFrequency", 2), 0.76),  # BORING
+    (("CallsiteFrequency", 4), -2.02),  # LOOP
+    (("Arg0Type", 20), 3.51),  # CORINFO_TYPE_CLASS
+    (("Arg3Type", 2), 20.7),  # CORINFO_TYPE_BOOL
+    (("Arg4Type", 20), 0.38),  # CORINFO_TYPE_CLASS
+    (("ReturnType", 20), 2.32),  # CORINFO_TYPE_CLASS
+]
+
+
+def read_features(def_path):
+    features = []
+    with open(def_path) as f:
+        for line in f:
+            m = re.match(r"^INLINE_FEATURE\((\w+),", line)
+            if m:
+                features.append(m.group(1))
+    return features
+
+
+def read_inline_xml(paths):
+    schema = None
+    sizes = {}
+    rows = []
+
+    for path in paths:
+        root = ET.parse(path).getroot()
+        schema_text = root.findtext("DataSchema")
+        if schema_text is None:
+            sys.exit("%s: no DataSchema; was JitInlineDumpData=1 set?" % path)
+        file_schema = schema_text.strip().split(",")
+        if schema is None:
+            schema = file_schema
+        elif schema != file_schema:
+            sys.exit("%s: data schema does not match earlier files" % path)
+
+        for method in root.iter("Method"):
+            token = int(method.findtext("Token"))
+            count = int(method.findtext("InlineCount"))
+            sizes[(token, count)] = int(method.findtext("HotSize"))
+
+        for data in root.iter("Data"):
+            values = data.text.strip().split(",")
+            if len(values) != len(schema):
+                continue
+            row = dict(zip(schema, values))
+            row["Method"] = int(row["Method"], 16)
+            rows.append(row)
+
+    return schema, sizes, rows
+
+
+def read_perf(path):
+    perf = {}
+    with open(path) as f:
+        for r in csv.DictReader(f):
+            perf[(int(r["Method"], 16), int(r["Version"]))] = float(r["Instructions"])
+    return perf
+
+
+def build_terms(columns, rows, min_count):
+    terms = []
+    for name in columns:
+        values = [int(r[name]) for r in rows]
+        if CATEGORICAL.match(name):
+            for v in sorted(set(values)):
+                if values.count(v) >= min_count:
+                    terms.append((name, v))
+        elif len(set(values)) > 1:
+            terms.append((name, None))
+    return terms
+
+
+def term_name(term):
+    name, value = term
+    return name if value is None else "%s==%d" % (name, value)
+
+
+def design_matrix(terms, rows):
+    x = np.zeros((len(rows), len(terms)))
+    for j, (name, value) in enumerate(terms):
+        column = np.array([float(r[name]) for r in rows])
+        x[:, j] = column if value is None else (column == value)
+    return x
+
+
+def fit_ridge(terms, rows, y, ridge):
+    # Fit on standardized columns, then drop the least important terms
+    # until the model fits in the jit.
+    x = design_matrix(terms, rows)
+    mean = x.mean(axis=0)
+    scale = x.std(axis=0)
+    scale[scale == 0] = 1
+    z = (x - mean) / scale
+    ym = y.mean()
+
+    while True:
+        n = z.shape[1]
+        beta = np.linalg.solve(z.T.dot(z) + ridge * len(y) * np.eye(n), z.T.dot(y - ym))
+        if n < MAX_TERMS:
+            break
+        keep = np.argsort(-np.abs(beta))[:MAX_TERMS - 1]
+        keep.sort()
+        terms = [terms[k] for k in keep]
+        z, mean, scale = z[:, keep], mean[keep], scale[keep]
+
+    coef = beta / scale
+    intercept = ym - coef.dot(mean)
+    residual = y - (intercept + design_matrix(terms, rows).dot(coef))
+    r2 = 1 - residual.var() / y.var() if y.var() > 0 else 0
+    return intercept, list(zip(terms, coef)), r2
+
+
+def deltas(rows, before, after):
+    # Pair each inline's row with the method measurement from one
+    # fewer inline; drop inlines without a matching measurement.
+    kept = []
+    y = []
+    for r in rows:
+        version = int(r["Version"])
+        base = before(r["Method"], version - 1)
+        value = after(r, version)
+        if base is not None and value is not None:
+            kept.append(r)
+            y.append(value - base)
+    return kept, np.array(y)
+
+
+def write_model(out, args, size_fit, per_call_fit):
+    def emit(section, fit):
+        intercept, coefs, r2 = fit
+        out.write("\n%s\n" % section)
+        if r2 is not None:
+            out.write("# R^2 %.3f\n" % r2)
+        out.write("Intercept %.6g\n" % intercept)
+        for term, c in coefs:
+            if c != 0:
+                out.write("%s %.6g\n" % (term_name(term), c))
+
+    out.write("# Inline model fitted by fitinlinemodel.py\n")
+    out.write("MaxILSize %d\n" % args.max_il_size)
+    out.write("Threshold %g\n" % args.threshold)
+    emit("SizeModel", size_fit)
+    emit("PerCallModel", per_call_fit)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fit a ModelPolicy inline model to inline xml data")
+    parser.add_argument("xml", nargs="+", help="inline xml files, one per JitInlineLimit")
+    parser.add_argument("-o", "--output", required=True, help="model file to write")
+    parser.add_argument("--perf", help="CSV of measured per call instructions (Method,Version,Instructions)")
+    parser.add_argument("--features", default=__file__.replace("fitinlinemodel.py", "inlinefeature.def"),
+                        help="path to inlinefeature.def")
+    parser.add_argument("--ridge", type=float, default=0.01, help="ridge penalty (default 0.01)")
+    parser.add_argument("--min-count", type=int, default=20,
+                        help="minimum occurrences of a category value to get its own term (default 20)")
+    parser.add_argument("--threshold", type=float, default=0.20, help="size/speed threshold (default 0.20)")
+    parser.add_argument("--max-il-size", type=int, default=120, help="callee IL size to fail fast (default 120)")
+    args = parser.parse_args()
+
+    features = read_features(args.features)
+    schema, sizes, rows = read_inline_xml(args.xml)
+    columns = [c for c in schema if c in features]
+
+    size_rows, size_y = deltas(rows, lambda m, v: sizes.get((m, v)), lambda r, v: float(r["HotSize"]))
+    if len(size_rows) == 0:
+        sys.exit("no inlines with a matching method size from one fewer inline")
+
+    size_fit = fit_ridge(build_terms(columns, size_rows, args.min_count), size_rows, size_y, args.ridge)
+    print("size model: %d inlines, %d terms, R^2 %.3f" % (len(size_rows), len(size_fit[1]), size_fit[2]))
+
+    per_call_fit = (DEFAULT_PER_CALL_INTERCEPT, DEFAULT_PER_CALL_TERMS, None)
+    if args.perf:
+        perf = read_perf(args.perf)
+        perf_rows, perf_y = deltas(rows, lambda m, v: perf.get((m, v)), lambda r, v: perf.get((r["Method"], v)))
+        if len(perf_rows) == 0:
+            sys.exit("no inlines with per call measurements for both versions of the method")
+        per_call_fit = fit_ridge(build_terms(columns, perf_rows, args.min_count), perf_rows, perf_y, args.ridge)
+        print("per call model: %d inlines, %d terms, R^2 %.3f" %
+              (len(perf_rows), len(per_call_fit[1]), per_call_fit[2]))
+
+    with open(args.output, "w") as out:
+        write_model(out, args, size_fit, per_call_fit)
+
+
+if __name__ == "__main__":
+    main()
@@ -377,6 +377,125 @@ void Compiler::fgInstrumentMethod()
     fgInsertStmtAtEnd(fgFirstBB, stmt);
 }
 
+//------------------------------------------------------------------------
+// fgInsertLoopBackEdgeCounters: count the loop back-edges taken by tier0 code.
+//
+// Notes:
+//    The runtime promotes tier0 code to tier1 once the method has been called
+//    enough times. A method that is called rarely but runs a long loop would never
+//    be promoted, so each invocation of tier0 code counts down the backward
+//    branches it takes in a local. When the count reaches zero the method is
+//    reported through CORINFO_HELP_LOOP_BACKEDGE_THRESHOLD, so the next invocation
+//    runs optimized code, and the count starts over.
+//
+//    The count is decremented at the end of every block with a backward branch
+//    successor, whichever successor is taken. This slightly overcounts blocks
+//    ending in conditional branches but keeps the instrumentation to a single
+//    statement per block. A loop left through a finally, e.g. a 'continue' inside a
+//    try/finally, is counted at the end of the BBJ_CALLFINALLY block, as the paired
+//    BBJ_ALWAYS block that jumps back must not contain any code.
+//
+void Compiler::fgInsertLoopBackEdgeCounters()
+{
+    noway_assert(!compIsForInlining());
+    assert(opts.jitFlags->IsSet(JitFlags::JIT_FLAG_TIER0));
+
+    const int threshold = JitConfig.TC_LoopBackEdgeThreshold();
+    if (threshold <= 0)
+    {
+        return;
+    }
+
+    unsigned counterLclNum = BAD_VAR_NUM;
+
+    for (BasicBlock* block = fgFirstBB; block != nullptr; block = block->bbNext)
+    {
+        if ((block->bbFlags & BBF_IMPORTED) == 0)
+        {
+            continue;
+        }
+
+        bool hasBackEdge = false;
+        switch (block->bbJumpKind)
+        {
+            case BBJ_ALWAYS:
+                // The BBJ_ALWAYS paired with a BBJ_CALLFINALLY must stay empty; its back-edge
+                // is counted at the end of the BBJ_CALLFINALLY instead.
+                if ((block->bbFlags & BBF_KEEP_BBJ_ALWAYS) == 0)
+                {
+                    hasBackEdge = (block->bbJumpDest->bbNum <= block->bbNum);
+                }
+                break;
+
+            case BBJ_COND:
+                hasBackEdge = (block->bbJumpDest->bbNum <= block->bbNum);
+                break;
+
+            case BBJ_CALLFINALLY:
+                if (block->isBBCallAlwaysPair())
+                {
+                    hasBackEdge = (block->bbNext->bbJumpDest->bbNum <= block->bbNum);
+                }
+                break;
+
+            case BBJ_SWITCH:
+            {
+                unsigned     jumpCnt = block->bbJumpSwt->bbsCount;
+                BasicBlock** jumpTab = block->bbJumpSwt->bbsDstTab;
+                for (unsigned i = 0; i < jumpCnt; i++)
+                {
+                    if (jumpTab[i]->bbNum <= block->bbNum)
+                    {
+                        hasBackEdge = true;
+                        break;
+                    }
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (!hasBackEdge)
+        {
+            continue;
+        }
+
+        if (counterLclNum == BAD_VAR_NUM)
+        {
+            counterLclNum = lvaGrabTemp(false DEBUGARG("loop back-edge counter"));
+            lvaTable[counterLclNum].lvType = TYP_INT;
+        }
+
+        // counter = counter - 1;
+        GenTreePtr decrement = gtNewOperNode(GT_SUB, TYP_INT, gtNewLclvNode(counterLclNum, TYP_INT), gtNewIconNode(1));
+        fgInsertStmtNearEnd(block, gtNewTempAssign(counterLclNum, decrement));
+
+        // (counter <= 0) ? (helper(method), counter = threshold) : nop;
+        GenTreeArgList* args  = gtNewArgList(gtNewIconEmbMethHndNode(info.compMethodHnd));
+        GenTreePtr      call  = gtNewHelperCallNode(CORINFO_HELP_LOOP_BACKEDGE_THRESHOLD, TYP_VOID, args);
+        GenTreePtr      reset = gtNewTempAssign(counterLclNum, gtNewIconNode(threshold));
+        GenTreePtr      then  = gtNewOperNode(GT_COMMA, TYP_VOID, call, reset);
+
+        GenTreePtr relop = gtNewOperNode(GT_LE, TYP_INT, gtNewLclvNode(counterLclNum, TYP_INT), gtNewIconNode(0));
+        relop->gtFlags |= GTF_RELOP_QMARK;
+        GenTreePtr colon = new (this, GT_COLON) GenTreeColon(TYP_VOID, then, gtNewNothingNode());
+        GenTreePtr qmark = gtNewQmarkNode(TYP_VOID, relop, colon);
+        fgInsertStmtNearEnd(block, qmark);
+
+        JITDUMP("Counting loop back-edges at the end of BB%02u\n", block->bbNum);
+    }
+
+    if (counterLclNum == BAD_VAR_NUM)
+    {
+        return;
+    }
+
+    fgEnsureFirstBBisScratch();
+    fgInsertStmtAtEnd(fgFirstBB, gtNewTempAssign(counterLclNum, gtNewIconNode(threshold)));
+}
+
 /*****************************************************************************
  *
  *  Create a basic block and append it to the current BB list.
@@ -25814,6 +25933,326 @@ void Compiler::fgTransformFatCalli()
 #endif
 }
 
+//------------------------------------------------------------------------
+// GuardedDevirtualizationTransformer: split guarded devirtualization
+//   candidates into a class test, a direct call and the original call.
+//
+// The candidate must be in a statement of the form call() or lclVar = call(),
+// with 'this' in a local (see addGuardedDevirtualizationCandidate).
+//
+// Before:
+//   current block
+//   {
+//     previous statements
+//     [lclVar =] call(this, args) (virtual)
+//     subsequent statements
+//   }
+//
+// After:
+//   current block
+//   {
+//     previous statements
+//   } BBJ_NONE null check block
+//   null check block
+//   {
+//     jump to else if this == null
+//   } BBJ_COND class check block, else block
+//   class check block
+//   {
+//     jump to else if this->methodTable != likely class
+//   } BBJ_COND then block, else block
+//   then block
+//   {
+//     [lclVar =] call(this, args) (direct call to the method of the likely class)
+//   } BBJ_ALWAYS remainder block
+//   else block
+//   {
+//     [lclVar =] call(this, args) (virtual)
+//   } BBJ_NONE remainder block
+//   remainder block
+//   {
+//     subsequent statements
+//   }
+//
+// A null 'this' takes the original call so the exception is raised after
+// the arguments are evaluated, as it would have been without the guard.
+//
+class GuardedDevirtualizationTransformer
+{
+public:
+    GuardedDevirtualizationTransformer(Compiler* compiler) : compiler(compiler)
+    {
+    }
+
+    //------------------------------------------------------------------------
+    // Run: run transformation for each block.
+    //
+    void Run()
+    {
+        for (BasicBlock* block = compiler->fgFirstBB; block != nullptr; block = block->bbNext)
+        {
+            TransformBlock(block);
+        }
+    }
+
+private:
+    //------------------------------------------------------------------------
+    // TransformBlock: look through statements and transform statements with candidates.
+    //
+    void TransformBlock(BasicBlock* block)
+    {
+        for (GenTreeStmt* stmt = block->firstStmt(); stmt != nullptr; stmt = stmt->gtNextStmt)
+        {
+            if (ContainsCandidate(stmt))
+            {
+                StatementTransformer stmtTransformer(compiler, block, stmt);
+                stmtTransformer.Run();
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // ContainsCandidate: check does this statement contain a guarded devirtualization candidate.
+    //
+    // Checks the candidate in form of call() or lclVar = call().
+    //
+    // Return Value:
+    //    true if contains, false otherwise.
+    //
+    bool ContainsCandidate(GenTreeStmt* stmt)
+    {
+        GenTreePtr candidate = stmt->gtStmtExpr;
+        if (candidate->OperIsAssignment())
+        {
+            candidate = candidate->gtGetOp2();
+        }
+        return candidate->IsCall() && candidate->AsCall()->IsGuardedDevirtualizationCandidate();
+    }
+
+    class StatementTransformer
+    {
+    public:
+        StatementTransformer(Compiler* compiler, BasicBlock* block, GenTreeStmt* stmt)
+            : compiler(compiler), currBlock(block), stmt(stmt)
+        {
+            remainderBlock  = nullptr;
+            nullCheckBlock  = nullptr;
+            classCheckBlock = nullptr;
+            thenBlock       = nullptr;
+            elseBlock       = nullptr;
+            doesReturnValue = stmt->gtStmtExpr->OperIsAssignment();
+            origCall        = GetCall(stmt);
+            candidateInfo   = origCall->gtGuardedDevirtualizationCandidateInfo;
+        }
+
+        //------------------------------------------------------------------------
+        // Run: transform the statement as described above.
+        //
+        void Run()
+        {
+            ClearCandidate();
+            CreateRemainder();
+            CreateNullCheck();
+            CreateClassCheck();
+            CreateThen();
+            CreateElse();
+
+            RemoveOldStatement();
+            SetWeights();
+            ChainFlow();
+        }
+
+    private:
+        //------------------------------------------------------------------------
+        // GetCall: find a call in a statement.
+        //
+        // Arguments:
+        //    callStmt - the statement with the call inside.
+        //
+        // Return Value:
+        //    call tree node pointer.
+        GenTreeCall* GetCall(GenTreeStmt* callStmt)
+        {
+            GenTreePtr   tree = callStmt->gtStmtExpr;
+            GenTreeCall* call = nullptr;
+            if (doesReturnValue)
+            {
+                assert(tree->OperIsAssignment());
+                call = tree->gtGetOp2()->AsCall();
+            }
+            else
+            {
+                call = tree->AsCall(); // call with void return type.
+            }
+            return call;
+        }
+
+        //------------------------------------------------------------------------
+        // ClearCandidate: clear the candidate flag from the original call and
+        // restore the field the candidate info was stored in.
+        //
+        void ClearCandidate()
+        {
+            origCall->ClearGuardedDevirtualizationCandidate();
+            if (origCall->IsVirtualStub())
+            {
+                origCall->gtStubCallStubAddr = candidateInfo->stubAddr;
+            }
+            else
+            {
+                origCall->gtInlineCandidateInfo = nullptr;
+            }
+        }
+
+        //------------------------------------------------------------------------
+        // CreateRemainder: split current block at the call stmt and
+        // insert statements after the call into remainderBlock.
+        //
+        void CreateRemainder()
+        {
+            remainderBlock          = compiler->fgSplitBlockAfterStatement(currBlock, stmt);
+            unsigned propagateFlags = currBlock->bbFlags & BBF_GC_SAFE_POINT;
+            remainderBlock->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL | propagateFlags;
+        }
+
+        //------------------------------------------------------------------------
+        // CreateNullCheck: create the block that sends a null 'this' to the original call.
+        //
+        void CreateNullCheck()
+        {
+            nullCheckBlock      = CreateAndInsertBasicBlock(BBJ_COND, currBlock);
+            GenTreePtr thisTree = compiler->gtCloneExpr(origCall->gtCallObjp);
+            GenTreePtr nullTree = compiler->gtNewIconNode(0, TYP_REF);
+            GenTreePtr nullCmp  = compiler->gtNewOperNode(GT_EQ, TYP_INT, thisTree, nullTree);
+            GenTreePtr jmpTree  = compiler->gtNewOperNode(GT_JTRUE, TYP_VOID, nullCmp);
+            GenTreePtr jmpStmt  = compiler->fgNewStmtFromTree(jmpTree, stmt->gtStmt.gtStmtILoffsx);
+            compiler->fgInsertStmtAtEnd(nullCheckBlock, jmpStmt);
+        }
+
+        //------------------------------------------------------------------------
+        // CreateClassCheck: create the block that compares the method table of
+        // 'this' with the likely class.
+        //
+        void CreateClassCheck()
+        {
+            classCheckBlock        = CreateAndInsertBasicBlock(BBJ_COND, nullCheckBlock);
+            GenTreePtr thisTree    = compiler->gtCloneExpr(origCall->gtCallObjp);
+            GenTreePtr methodTable = compiler->gtNewOperNode(GT_IND, TYP_I_IMPL, thisTree);
+            methodTable->gtFlags |= GTF_IND_INVARIANT;
+            GenTreePtr classHandle = compiler->gtNewIconEmbClsHndNode(candidateInfo->guardedClassHandle);
+            GenTreePtr classCmp    = compiler->gtNewOperNode(GT_NE, TYP_INT, methodTable, classHandle);
+            GenTreePtr jmpTree     = compiler->gtNewOperNode(GT_JTRUE, TYP_VOID, classCmp);
+            GenTreePtr jmpStmt     = compiler->fgNewStmtFromTree(jmpTree, stmt->gtStmt.gtStmtILoffsx);
+            compiler->fgInsertStmtAtEnd(classCheckBlock, jmpStmt);
+        }
+
+        //------------------------------------------------------------------------
+        // CreateThen: create then block, that calls the method of the likely class directly.
+        //
+        void CreateThen()
+        {
+            thenBlock               = CreateAndInsertBasicBlock(BBJ_ALWAYS, classCheckBlock);
+            GenTreeStmt* directStmt = compiler->gtCloneExpr(stmt)->AsStmt();
+            GenTreeCall* directCall = GetCall(directStmt);
+            directCall->gtFlags &= ~GTF_CALL_VIRT_VTABLE;
+            directCall->gtFlags &= ~GTF_CALL_VIRT_STUB;
+            directCall->gtCallMethHnd         = candidateInfo->guardedMethodHandle;
+            directCall->gtCallType            = CT_USER_FUNC;
+            directCall->gtInlineCandidateInfo = nullptr;
+            compiler->fgInsertStmtAtEnd(thenBlock, directStmt);
+        }
+
+        //------------------------------------------------------------------------
+        // CreateElse: create else block, that makes the original virtual call.
+        //
+        void CreateElse()
+        {
+            elseBlock = CreateAndInsertBasicBlock(BBJ_NONE, thenBlock);
+            elseBlock->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL;
+            GenTreeStmt* virtualStmt = compiler->gtCloneExpr(stmt)->AsStmt();
+            compiler->fgInsertStmtAtEnd(elseBlock, virtualStmt);
+        }
+
+        //------------------------------------------------------------------------
+        // CreateAndInsertBasicBlock: ask compiler to create new basic block.
+        // and insert in into the basic block list.
+        //
+        // Arguments:
+        //    jumpKind - jump kind for the new basic block
+        //    insertAfter - basic block, after which compiler has to insert the new one.
+        //
+        // Return Value:
+        //    new basic block.
+        BasicBlock* CreateAndInsertBasicBlock(BBjumpKinds jumpKind, BasicBlock* insertAfter)
+        {
+            BasicBlock* block = compiler->fgNewBBafter(jumpKind, insertAfter, true);
+            if ((insertAfter->bbFlags & BBF_INTERNAL) == 0)
+            {
+                block->bbFlags &= ~BBF_INTERNAL;
+                block->bbFlags |= BBF_IMPORTED;
+            }
+            return block;
+        }
+
+        //------------------------------------------------------------------------
+        // RemoveOldStatement: remove original stmt from current block.
+        //
+        void RemoveOldStatement()
+        {
+            compiler->fgRemoveStmt(currBlock, stmt);
+        }
+
+        //------------------------------------------------------------------------
+        // SetWeights: set weights for new blocks from the likelihood of the guard passing.
+        //
+        void SetWeights()
+        {
+            const unsigned thenPercentage = min(candidateInfo->likelihood, 99u);
+            remainderBlock->inheritWeight(currBlock);
+            nullCheckBlock->inheritWeight(currBlock);
+            classCheckBlock->inheritWeight(currBlock);
+            thenBlock->inheritWeightPercentage(currBlock, thenPercentage);
+            elseBlock->inheritWeightPercentage(currBlock, 100 - thenPercentage);
+        }
+
+        //------------------------------------------------------------------------
+        // ChainFlow: link new blocks into correct cfg.
+        //
+        void ChainFlow()
+        {
+            assert(!compiler->fgComputePredsDone);
+            nullCheckBlock->bbJumpDest  = elseBlock;
+            classCheckBlock->bbJumpDest = elseBlock;
+            thenBlock->bbJumpDest       = remainderBlock;
+        }
+
+        Compiler*                             compiler;
+        BasicBlock*                           currBlock;
+        BasicBlock*                           remainderBlock;
+        BasicBlock*                           nullCheckBlock;
+        BasicBlock*                           classCheckBlock;
+        BasicBlock*                           thenBlock;
+        BasicBlock*                           elseBlock;
+        GenTreeStmt*                          stmt;
+        GenTreeCall*                          origCall;
+        GuardedDevirtualizationCandidateInfo* candidateInfo;
+        bool                                  doesReturnValue;
+    };
+
+    Compiler* compiler;
+};
+
+//------------------------------------------------------------------------
+// fgTransformGuardedDevirtualizationCalls: find and transform guarded
+//   devirtualization candidates.
+//
+void Compiler::fgTransformGuardedDevirtualizationCalls()
+{
+    GuardedDevirtualizationTransformer transformer(this);
+    transformer.Run();
+    clearMethodHasGuardedDevirtualization();
+}
+
 //------------------------------------------------------------------------
 // fgMeasureIR: count and return the number of IR nodes in the function.
 //
@@ -150,6 +150,7 @@ enum gtCallTypes : BYTE
 struct BasicBlock;
 
 struct InlineCandidateInfo;
+struct GuardedDevirtualizationCandidateInfo;
 
 typedef unsigned short AssertionIndex;
 
@@ -2064,6 +2065,8 @@ public:
 
     inline bool IsIntegralConst() const;
 
+    inline bool IsRematerializableConst() const;
+
     inline bool IsIntCnsFitsInI32(); // Constant fits in INT32
 
     inline bool IsCnsFltOrDbl() const;
@@ -3632,6 +3635,8 @@ struct GenTreeCall final : public GenTree
                                                     // stubs, because executable code cannot be generated at runtime.
 #define GTF_CALL_M_HELPER_SPECIAL_DCE    0x00020000 // GT_CALL -- this helper call can be removed if it is part of a comma and
                                                     // the comma result is unused.
+#define GTF_CALL_M_GUARDED_DEVIRT        0x00040000 // GT_CALL -- virtual call that will be split into a class test
+                                                    // guarding a direct call, and the original call.
 
     // clang-format on
 
@@ -3853,6 +3858,21 @@ struct GenTreeCall final : public GenTree
         gtCallMoreFlags |= GTF_CALL_M_FAT_POINTER_CHECK;
     }
 
+    bool IsGuardedDevirtualizationCandidate() const
+    {
+        return (gtCallMoreFlags & GTF_CALL_M_GUARDED_DEVIRT) != 0;
+    }
+
+    void ClearGuardedDevirtualizationCandidate()
+    {
+        gtCallMoreFlags &= ~GTF_CALL_M_GUARDED_DEVIRT;
+    }
+
+    void SetGuardedDevirtualizationCandidate()
+    {
+        gtCallMoreFlags |= GTF_CALL_M_GUARDED_DEVIRT;
+    }
+
     unsigned gtCallMoreFlags; // in addition to gtFlags
 
     unsigned char gtCallType : 3;   // value from the gtCallTypes enumeration
@@ -3864,8 +3884,9 @@ struct GenTreeCall final : public GenTree
         // only used for CALLI unmanaged calls (CT_INDIRECT)
         GenTreePtr gtCallCookie;
         // gtInlineCandidateInfo is only used when inlining methods
-        InlineCandidateInfo*   gtInlineCandidateInfo;
-        void*                  gtStubCallStubAddr;              // GTF_CALL_VIRT_STUB - these are never inlined
+        InlineCandidateInfo*                  gtInlineCandidateInfo;
+        void*                                 gtStubCallStubAddr; // GTF_CALL_VIRT_STUB - these are never inlined
+        GuardedDevirtualizationCandidateInfo* gtGuardedDevirtualizationCandidateInfo; // GTF_CALL_M_GUARDED_DEVIRT
         CORINFO_GENERIC_HANDLE compileTimeHelperArgumentHandle; // Used to track type handle argument of dynamic helpers
         void*                  gtDirectCallAddress; // Used to pass direct call address between lower and codegen
     };
@@ -6219,6 +6240,20 @@ inline bool GenTree::IsCnsIntOrI() const
     return (gtOper == GT_CNS_INT);
 }
 
+//------------------------------------------------------------------------
+// IsRematerializableConst: Can codegen recreate this value in a register
+//                          instead of spilling it and reloading it?
+//
+// Notes:
+//    Only non-GC, non-handle integer constants qualify. Zero is excluded
+//    because it is materialized with "xor reg, reg" on xarch, which would
+//    clobber flags that may be live at the point of the reload.
+//
+inline bool GenTree::IsRematerializableConst() const
+{
+    return IsCnsIntOrI() && !IsIconHandle() && !varTypeIsGC(TypeGet()) && (AsIntCon()->gtIconVal != 0);
+}
+
 inline bool GenTree::IsIntegralConst() const
 {
 #ifdef _TARGET_64BIT_
@@ -81,106 +81,578 @@ void CodeGen::genHWIntrinsic(GenTreeHWIntrinsic* node)
     }
 }
 
-void CodeGen::genSSEIntrinsic(GenTreeHWIntrinsic* node)
+//------------------------------------------------------------------------
+// getPackedIns: select the packed instruction that matches the base type of a vector operation
+//
+// Arguments:
+//    baseType  - the base type of the vector operation
+//    insFloat  - the instruction to use for float elements
+//    insDouble - the instruction to use for double elements
+//    insByte   - the instruction to use for byte and sbyte elements
+//    insShort  - the instruction to use for short and ushort elements
+//    insInt    - the instruction to use for int and uint elements
+//    insLong   - the instruction to use for long and ulong elements
+//
+// Return Value:
+//    The instruction for the given base type, INS_none if there is none.
+//
+static instruction getPackedIns(var_types   baseType,
+                                instruction insFloat,
+                                instruction insDouble,
+                                instruction insByte,
+                                instruction insShort,
+                                instruction insInt,
+                                instruction insLong)
 {
-    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
-    GenTree*       op1         = node->gtGetOp1();
-    GenTree*       op2         = node->gtGetOp2();
-    regNumber      targetReg   = node->gtRegNum;
-    var_types      targetType  = node->TypeGet();
-    var_types      baseType    = node->gtSIMDBaseType;
+    switch (baseType)
+    {
+        case TYP_FLOAT:
+            return insFloat;
+        case TYP_DOUBLE:
+            return insDouble;
+        case TYP_BYTE:
+        case TYP_UBYTE:
+            return insByte;
+        case TYP_SHORT:
+        case TYP_USHORT:
+            return insShort;
+        case TYP_INT:
+        case TYP_UINT:
+            return insInt;
+        case TYP_LONG:
+        case TYP_ULONG:
+            return insLong;
+        default:
+            return INS_none;
+    }
+}
+
+//------------------------------------------------------------------------
+// getPackedMinMaxIns: select the packed min or max instruction for a base type
+//
+// Arguments:
+//    baseType  - the base type of the vector operation
+//    isMax     - true for max, false for min
+//
+// Return Value:
+//    The instruction for the given base type.
+//
+static instruction getPackedMinMaxIns(var_types baseType, bool isMax)
+{
+    switch (baseType)
+    {
+        case TYP_FLOAT:
+            return isMax ? INS_maxps : INS_minps;
+        case TYP_DOUBLE:
+            return isMax ? INS_maxpd : INS_minpd;
+        case TYP_BYTE:
+            return isMax ? INS_pmaxsb : INS_pminsb;
+        case TYP_UBYTE:
+            return isMax ? INS_pmaxub : INS_pminub;
+        case TYP_SHORT:
+            return isMax ? INS_pmaxsw : INS_pminsw;
+        case TYP_USHORT:
+            return isMax ? INS_pmaxuw : INS_pminuw;
+        case TYP_INT:
+            return isMax ? INS_pmaxsd : INS_pminsd;
+        case TYP_UINT:
+            return isMax ? INS_pmaxud : INS_pminud;
+        default:
+            unreached();
+    }
+}
+
+//------------------------------------------------------------------------
+// genHWIntrinsicSimdUnaryOp: generate code for a hardware intrinsic with one vector operand
+//
+// Arguments:
+//    node - the hardware intrinsic node
+//    ins  - the instruction to emit
+//
+// Notes:
+//    The target may be a general purpose register, e.g. for MoveMask.
+//
+void CodeGen::genHWIntrinsicSimdUnaryOp(GenTreeHWIntrinsic* node, instruction ins)
+{
+    GenTree*  op1       = node->gtGetOp1();
+    regNumber targetReg = node->gtRegNum;
+    var_types simdType  = compiler->getSIMDTypeForSize(node->gtSIMDSize);
+    assert(targetReg != REG_NA);
+    assert(ins != INS_none);
+
+    genConsumeOperands(node);
+    getEmitter()->emitIns_R_R(ins, emitActualTypeSize(simdType), targetReg, op1->gtRegNum);
+    genProduceReg(node);
+}
+
+//------------------------------------------------------------------------
+// genHWIntrinsicSimdBinaryOp: generate code for a hardware intrinsic with two vector operands
+//
+// Arguments:
+//    node             - the hardware intrinsic node
+//    ins              - the instruction to emit
+//    reverseOperands  - true if the instruction computes "op2 ins op1", e.g. a less than
+//                       comparison done with pcmpgt
+//
+// Notes:
+//    For reversed operands, lowering marks op1 as delay free so that it is not overwritten
+//    when op2 is copied to the target register.
+//
+void CodeGen::genHWIntrinsicSimdBinaryOp(GenTreeHWIntrinsic* node, instruction ins, bool reverseOperands)
+{
+    GenTree*  op1       = node->gtGetOp1();
+    GenTree*  op2       = node->gtGetOp2();
+    regNumber targetReg = node->gtRegNum;
+    var_types simdType  = node->TypeGet();
+    assert(targetReg != REG_NA);
+    assert(ins != INS_none);
+
+    genConsumeOperands(node);
 
     regNumber op1Reg = op1->gtRegNum;
-    regNumber op2Reg = REG_NA;
-    emitter*  emit   = getEmitter();
+    regNumber op2Reg = op2->gtRegNum;
+    if (reverseOperands)
+    {
+        jitstd::swap(op1Reg, op2Reg);
+    }
+
+    getEmitter()->emitIns_SIMD_R_R_R(ins, targetReg, op1Reg, op2Reg, simdType);
+    genProduceReg(node);
+}
+
+//------------------------------------------------------------------------
+// genHWIntrinsicSimdCompareOp: generate code for a cmpps/cmppd based comparison
+//
+// Arguments:
+//    node             - the hardware intrinsic node
+//    ins              - INS_cmpps or INS_cmppd
+//    predicate        - the comparison predicate encoded in the immediate
+//    reverseOperands  - true to compare "op2 predicate op1"
+//
+void CodeGen::genHWIntrinsicSimdCompareOp(GenTreeHWIntrinsic* node,
+                                          instruction         ins,
+                                          int                 predicate,
+                                          bool                reverseOperands)
+{
+    GenTree*  op1       = node->gtGetOp1();
+    GenTree*  op2       = node->gtGetOp2();
+    regNumber targetReg = node->gtRegNum;
+    var_types simdType  = node->TypeGet();
+    assert(targetReg != REG_NA);
 
     genConsumeOperands(node);
 
+    regNumber op1Reg = op1->gtRegNum;
+    regNumber op2Reg = op2->gtRegNum;
+    if (reverseOperands)
+    {
+        jitstd::swap(op1Reg, op2Reg);
+    }
+
+    getEmitter()->emitIns_SIMD_R_R_R_I(ins, targetReg, op1Reg, op2Reg, predicate, simdType);
+    genProduceReg(node);
+}
+
+//------------------------------------------------------------------------
+// genHWIntrinsicSimdImmOp: generate code for a hardware intrinsic whose last operand is an imm8
+//
+// Arguments:
+//    node - the hardware intrinsic node
+//    ins  - the instruction to emit
+//
+// Notes:
+//    The node either has a single vector operand as op1 and the immediate as op2, or a
+//    GT_LIST as op1 holding two vector operands followed by the immediate. When the
+//    immediate is not a constant, the instruction is emitted once for each of its 256
+//    values and a jump table selects the one to execute.
+//
+void CodeGen::genHWIntrinsicSimdImmOp(GenTreeHWIntrinsic* node, instruction ins)
+{
+    GenTree*  op1       = node->gtGetOp1();
+    regNumber targetReg = node->gtRegNum;
+    var_types simdType  = node->TypeGet();
+    emitter*  emit      = getEmitter();
+    assert(targetReg != REG_NA);
+    assert(ins != INS_none);
+
+    GenTree* src1 = op1;
+    GenTree* src2 = nullptr;
+    GenTree* imm  = node->gtGetOp2();
+    if (op1->OperIsList())
+    {
+        GenTreeArgList* list = op1->AsArgList();
+        src1                 = list->Current();
+        src2                 = list->Rest()->Current();
+        imm                  = list->Rest()->Rest()->Current();
+    }
+    assert(imm == compiler->immOperandOfHWIntrinsic(node));
+
+    genConsumeReg(src1);
+    if (src2 != nullptr)
+    {
+        genConsumeReg(src2);
+    }
+
+    int         firstValue = 0;
+    int         lastValue  = 255;
+    BasicBlock* caseLabels[256];
+    BasicBlock* doneLabel = nullptr;
+
+    if (imm->isContainedIntOrIImmed())
+    {
+        firstValue = (int)imm->AsIntConCommon()->IconValue();
+        lastValue  = firstValue;
+    }
+    else
+    {
+        genConsumeReg(imm);
+        doneLabel = genCreateTempLabel();
+        for (int ival = 0; ival <= 255; ival++)
+        {
+            caseLabels[ival] = genCreateTempLabel();
+        }
+        genHWIntrinsicJumpTable(node, imm->gtRegNum, caseLabels, 256);
+    }
+
+    for (int ival = firstValue; ival <= lastValue; ival++)
+    {
+        if (doneLabel != nullptr)
+        {
+            genDefineTempLabel(caseLabels[ival]);
+        }
+
+        if (src2 != nullptr)
+        {
+            emit->emitIns_SIMD_R_R_R_I(ins, targetReg, src1->gtRegNum, src2->gtRegNum, ival, simdType);
+        }
+        else
+        {
+            emit->emitIns_R_R_I(ins, emitActualTypeSize(simdType), targetReg, src1->gtRegNum, ival);
+        }
+
+        if ((doneLabel != nullptr) && (ival != lastValue))
+        {
+            inst_JMP(EJ_jmp, doneLabel);
+        }
+    }
+
+    if (doneLabel != nullptr)
+    {
+        genDefineTempLabel(doneLabel);
+    }
+    genProduceReg(node);
+}
+
+//------------------------------------------------------------------------
+// genHWIntrinsicJumpTable: jump to one of a set of labels according to the value in a register
+//
+// Arguments:
+//    node       - the hardware intrinsic node, which has two internal integer registers
+//    indexReg   - the register holding the index of the label to jump to
+//    labels     - the labels to jump to
+//    labelCount - the number of labels, a power of 2
+//
+// Notes:
+//    As for switches, the table holds the offsets of the labels from the first block. The
+//    index is masked so that the jump always stays within the table. "indexReg" is only read
+//    before the internal registers are written, so it may share a register with one of them.
+//
+void CodeGen::genHWIntrinsicJumpTable(GenTreeHWIntrinsic* node,
+                                      regNumber           indexReg,
+                                      BasicBlock**        labels,
+                                      unsigned            labelCount)
+{
+    assert(isPow2(labelCount));
+    emitter* emit = getEmitter();
+
+    regNumber offsReg = node->ExtractTempReg();
+    regNumber baseReg = node->GetSingleTempReg();
+
+    unsigned jmpTabBase = emit->emitBBTableDataGenBeg(labelCount, true);
+    for (unsigned i = 0; i < labelCount; i++)
+    {
+        emit->emitDataGenData(i, labels[i]);
+    }
+    emit->emitDataGenEnd();
+
+    // mov offsReg, indexReg; and offsReg, labelCount - 1
+    emit->emitIns_R_R(INS_mov, EA_4BYTE, offsReg, indexReg);
+    emit->emitIns_R_I(INS_and, EA_4BYTE, offsReg, labelCount - 1);
+
+    // load the offset of the label (relative to the start of fgFirstBB) and jump to it
+    emit->emitIns_R_C(INS_lea, emitTypeSize(TYP_I_IMPL), baseReg, compiler->eeFindJitDataOffs(jmpTabBase), 0);
+    emit->emitIns_R_ARX(INS_mov, EA_4BYTE, offsReg, baseReg, offsReg, 4, 0);
+    assert((compiler->fgFirstBB->bbFlags & BBF_JMP_TARGET) != 0);
+    emit->emitIns_R_L(INS_lea, EA_PTR_DSP_RELOC, compiler->fgFirstBB, baseReg);
+    emit->emitIns_R_R(INS_add, EA_PTRSIZE, offsReg, baseReg);
+    emit->emitIns_R(INS_i_jmp, emitTypeSize(TYP_I_IMPL), offsReg);
+}
+
+void CodeGen::genSSEIntrinsic(GenTreeHWIntrinsic* node)
+{
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    var_types      baseType    = node->gtSIMDBaseType;
+    assert(baseType == TYP_FLOAT);
+
     switch (intrinsicID)
     {
         case NI_SSE_Add:
-            assert(baseType == TYP_FLOAT);
-            op2Reg = op2->gtRegNum;
-            emit->emitIns_SIMD_R_R_R(INS_addps, targetReg, op1Reg, op2Reg, TYP_SIMD16);
+            genHWIntrinsicSimdBinaryOp(node, INS_addps);
+            break;
+        case NI_SSE_And:
+            genHWIntrinsicSimdBinaryOp(node, INS_andps);
+            break;
+        case NI_SSE_AndNot:
+            genHWIntrinsicSimdBinaryOp(node, INS_andnps);
+            break;
+        case NI_SSE_Divide:
+            genHWIntrinsicSimdBinaryOp(node, INS_divps);
+            break;
+        case NI_SSE_Max:
+            genHWIntrinsicSimdBinaryOp(node, INS_maxps);
+            break;
+        case NI_SSE_Min:
+            genHWIntrinsicSimdBinaryOp(node, INS_minps);
+            break;
+        case NI_SSE_Multiply:
+            genHWIntrinsicSimdBinaryOp(node, INS_mulps);
+            break;
+        case NI_SSE_Or:
+            genHWIntrinsicSimdBinaryOp(node, INS_orps);
+            break;
+        case NI_SSE_Subtract:
+            genHWIntrinsicSimdBinaryOp(node, INS_subps);
+            break;
+        case NI_SSE_UnpackHigh:
+            genHWIntrinsicSimdBinaryOp(node, INS_unpckhps);
+            break;
+        case NI_SSE_UnpackLow:
+            genHWIntrinsicSimdBinaryOp(node, INS_unpcklps);
+            break;
+        case NI_SSE_Xor:
+            genHWIntrinsicSimdBinaryOp(node, INS_xorps);
             break;
+
+        // cmpps predicates: 0 - EQ, 1 - LT, 2 - LE, 4 - NEQ
+        case NI_SSE_CompareEqual:
+            genHWIntrinsicSimdCompareOp(node, INS_cmpps, 0, false);
+            break;
+        case NI_SSE_CompareGreaterThan:
+            genHWIntrinsicSimdCompareOp(node, INS_cmpps, 1, true);
+            break;
+        case NI_SSE_CompareGreaterThanOrEqual:
+            genHWIntrinsicSimdCompareOp(node, INS_cmpps, 2, true);
+            break;
+        case NI_SSE_CompareLessThan:
+            genHWIntrinsicSimdCompareOp(node, INS_cmpps, 1, false);
+            break;
+        case NI_SSE_CompareLessThanOrEqual:
+            genHWIntrinsicSimdCompareOp(node, INS_cmpps, 2, false);
+            break;
+        case NI_SSE_CompareNotEqual:
+            genHWIntrinsicSimdCompareOp(node, INS_cmpps, 4, false);
+            break;
+
+        case NI_SSE_MoveMask:
+            genHWIntrinsicSimdUnaryOp(node, INS_movmskps);
+            break;
+        case NI_SSE_Sqrt:
+            genHWIntrinsicSimdUnaryOp(node, INS_sqrtps);
+            break;
+
+        case NI_SSE_Shuffle:
+            genHWIntrinsicSimdImmOp(node, INS_shufps);
+            break;
+
         default:
             unreached();
             break;
     }
-    genProduceReg(node);
 }
 
 void CodeGen::genSSE2Intrinsic(GenTreeHWIntrinsic* node)
 {
     NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
-    GenTree*       op1         = node->gtGetOp1();
-    GenTree*       op2         = node->gtGetOp2();
-    regNumber      targetReg   = node->gtRegNum;
-    var_types      targetType  = node->TypeGet();
     var_types      baseType    = node->gtSIMDBaseType;
-
-    regNumber op1Reg = op1->gtRegNum;
-    regNumber op2Reg = REG_NA;
-    emitter*  emit   = getEmitter();
-
-    genConsumeOperands(node);
+    bool           isDouble    = (baseType == TYP_DOUBLE);
 
     switch (intrinsicID)
     {
         case NI_SSE2_Add:
-        {
-            op2Reg = op2->gtRegNum;
+            genHWIntrinsicSimdBinaryOp(node,
+                                       getPackedIns(baseType, INS_none, INS_addpd, INS_paddb, INS_paddw, INS_paddd,
+                                                    INS_paddq));
+            break;
+        case NI_SSE2_Subtract:
+            genHWIntrinsicSimdBinaryOp(node,
+                                       getPackedIns(baseType, INS_none, INS_subpd, INS_psubb, INS_psubw, INS_psubd,
+                                                    INS_psubq));
+            break;
+        case NI_SSE2_And:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_andpd : INS_pand);
+            break;
+        case NI_SSE2_AndNot:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_andnpd : INS_pandn);
+            break;
+        case NI_SSE2_Or:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_orpd : INS_por);
+            break;
+        case NI_SSE2_Xor:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_xorpd : INS_pxor);
+            break;
+        case NI_SSE2_Divide:
+            assert(isDouble);
+            genHWIntrinsicSimdBinaryOp(node, INS_divpd);
+            break;
+        case NI_SSE2_Multiply:
+            // Multiply(Vector128<uint>, Vector128<uint>) returns the full 64-bit products of the even elements.
+            assert(isDouble || (baseType == TYP_ULONG));
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_mulpd : INS_pmuludq);
+            break;
+        case NI_SSE2_MultiplyLow:
+            assert(varTypeIsShort(baseType));
+            genHWIntrinsicSimdBinaryOp(node, INS_pmullw);
+            break;
+        case NI_SSE2_Max:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, true));
+            break;
+        case NI_SSE2_Min:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, false));
+            break;
+        case NI_SSE2_UnpackHigh:
+            genHWIntrinsicSimdBinaryOp(node, getPackedIns(baseType, INS_none, INS_unpckhpd, INS_punpckhbw,
+                                                          INS_punpckhwd, INS_punpckhdq, INS_punpckhqdq));
+            break;
+        case NI_SSE2_UnpackLow:
+            genHWIntrinsicSimdBinaryOp(node, getPackedIns(baseType, INS_none, INS_unpcklpd, INS_punpcklbw,
+                                                          INS_punpcklwd, INS_punpckldq, INS_punpcklqdq));
+            break;
 
-            instruction ins;
-            switch (baseType)
+        case NI_SSE2_CompareEqual:
+            if (isDouble)
             {
-                case TYP_DOUBLE:
-                    ins = INS_addpd;
-                    break;
-                case TYP_INT:
-                case TYP_UINT:
-                    ins = INS_paddd;
-                    break;
-                case TYP_LONG:
-                case TYP_ULONG:
-                    ins = INS_paddq;
-                    break;
-                case TYP_BYTE:
-                case TYP_UBYTE:
-                    ins = INS_paddb;
-                    break;
-                case TYP_SHORT:
-                case TYP_USHORT:
-                    ins = INS_paddw;
-                    break;
-                default:
-                    unreached();
-                    break;
+                genHWIntrinsicSimdCompareOp(node, INS_cmppd, 0, false);
+            }
+            else
+            {
+                genHWIntrinsicSimdBinaryOp(node, getPackedIns(baseType, INS_none, INS_none, INS_pcmpeqb,
+                                                              INS_pcmpeqw, INS_pcmpeqd, INS_none));
+            }
+            break;
+        case NI_SSE2_CompareGreaterThan:
+        case NI_SSE2_CompareLessThan:
+        {
+            // There is no packed integer less than compare, so it is done as a greater than
+            // with the operands reversed. cmppd only has a less than predicate.
+            bool isGreaterThan = (intrinsicID == NI_SSE2_CompareGreaterThan);
+            if (isDouble)
+            {
+                genHWIntrinsicSimdCompareOp(node, INS_cmppd, 1, isGreaterThan);
+            }
+            else
+            {
+                genHWIntrinsicSimdBinaryOp(node, getPackedIns(baseType, INS_none, INS_none, INS_pcmpgtb,
+                                                              INS_pcmpgtw, INS_pcmpgtd, INS_none),
+                                           !isGreaterThan);
             }
-
-            emit->emitIns_SIMD_R_R_R(ins, targetReg, op1Reg, op2Reg, TYP_SIMD16);
             break;
         }
+
+        case NI_SSE2_ConvertToVector128Double:
+            // the base type is the one of the source vector
+            genHWIntrinsicSimdUnaryOp(node, (baseType == TYP_FLOAT) ? INS_cvtps2pd : INS_cvtdq2pd);
+            break;
+        case NI_SSE2_ConvertToVector128Int32WithTruncation:
+            genHWIntrinsicSimdUnaryOp(node, (baseType == TYP_FLOAT) ? INS_cvttps2dq : INS_cvttpd2dq);
+            break;
+        case NI_SSE2_ConvertToVector128Single:
+            genHWIntrinsicSimdUnaryOp(node, isDouble ? INS_cvtpd2ps : INS_cvtdq2ps);
+            break;
+        case NI_SSE2_MoveMask:
+            genHWIntrinsicSimdUnaryOp(node, isDouble ? INS_movmskpd : INS_pmovmskb);
+            break;
+        case NI_SSE2_Sqrt:
+            assert(isDouble);
+            genHWIntrinsicSimdUnaryOp(node, INS_sqrtpd);
+            break;
+
+        case NI_SSE2_Shuffle:
+            genHWIntrinsicSimdImmOp(node, isDouble ? INS_shufpd : INS_pshufd);
+            break;
+
         default:
             unreached();
             break;
     }
-    genProduceReg(node);
 }
 
 void CodeGen::genSSE3Intrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement SSE3 intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    var_types      baseType    = node->gtSIMDBaseType;
+
+    switch (intrinsicID)
+    {
+        case NI_SSE3_HorizontalAdd:
+            genHWIntrinsicSimdBinaryOp(node, (baseType == TYP_FLOAT) ? INS_haddps : INS_haddpd);
+            break;
+        default:
+            unreached();
+            break;
+    }
 }
 
 void CodeGen::genSSSE3Intrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement SSSE3 intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    var_types      baseType    = node->gtSIMDBaseType;
+
+    switch (intrinsicID)
+    {
+        case NI_SSSE3_Abs:
+            // the base type is the one of the signed source vector
+            genHWIntrinsicSimdUnaryOp(node,
+                                      getPackedIns(baseType, INS_none, INS_none, INS_pabsb, INS_pabsw, INS_pabsd,
+                                                   INS_none));
+            break;
+        case NI_SSSE3_Shuffle:
+            genHWIntrinsicSimdBinaryOp(node, INS_pshufb);
+            break;
+        default:
+            unreached();
+            break;
+    }
 }
 
 void CodeGen::genSSE41Intrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement SSE41 intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    var_types      baseType    = node->gtSIMDBaseType;
+
+    switch (intrinsicID)
+    {
+        case NI_SSE41_Blend:
+            genHWIntrinsicSimdImmOp(node, getPackedIns(baseType, INS_blendps, INS_blendpd, INS_none, INS_pblendw,
+                                                       INS_none, INS_none));
+            break;
+        case NI_SSE41_CompareEqual:
+            assert(varTypeIsLong(baseType));
+            genHWIntrinsicSimdBinaryOp(node, INS_pcmpeqq);
+            break;
+        case NI_SSE41_Max:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, true));
+            break;
+        case NI_SSE41_Min:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, false));
+            break;
+        case NI_SSE41_MultiplyLow:
+            assert(genTypeSize(baseType) == 4);
+            genHWIntrinsicSimdBinaryOp(node, INS_pmulld);
+            break;
+        default:
+            unreached();
+            break;
+    }
 }
 
 void CodeGen::genSSE42Intrinsic(GenTreeHWIntrinsic* node)
@@ -193,6 +665,13 @@ void CodeGen::genSSE42Intrinsic(GenTreeHWIntrinsic* node)
     var_types targetType = node->TypeGet();
     var_types baseType   = node->gtSIMDBaseType;
 
+    if (intrinsicID == NI_SSE42_CompareGreaterThan)
+    {
+        assert(varTypeIsLong(baseType));
+        genHWIntrinsicSimdBinaryOp(node, INS_pcmpgtq);
+        return;
+    }
+
     regNumber op1Reg = op1->gtRegNum;
     regNumber op2Reg = op2->gtRegNum;
     genConsumeOperands(node);
@@ -228,121 +707,272 @@ void CodeGen::genSSE42Intrinsic(GenTreeHWIntrinsic* node)
 void CodeGen::genAVXIntrinsic(GenTreeHWIntrinsic* node)
 {
     NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
-    GenTree*       op1         = node->gtGetOp1();
-    GenTree*       op2         = node->gtGetOp2();
-    regNumber      targetReg   = node->gtRegNum;
-    var_types      targetType  = node->TypeGet();
     var_types      baseType    = node->gtSIMDBaseType;
+    assert(varTypeIsFloating(baseType));
+    bool isDouble = (baseType == TYP_DOUBLE);
 
-    regNumber op1Reg = op1->gtRegNum;
-    regNumber op2Reg = REG_NA;
-
-    genConsumeOperands(node);
-
-    emitter* emit = getEmitter();
     switch (intrinsicID)
     {
         case NI_AVX_Add:
-        {
-            op2Reg = op2->gtRegNum;
-
-            instruction ins;
-            switch (baseType)
-            {
-                case TYP_DOUBLE:
-                    ins = INS_addpd;
-                    break;
-                case TYP_FLOAT:
-                    ins = INS_addps;
-                    break;
-                default:
-                    unreached();
-                    break;
-            }
-
-            emit->emitIns_R_R_R(ins, emitTypeSize(TYP_SIMD32), targetReg, op1Reg, op2Reg);
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_addpd : INS_addps);
+            break;
+        case NI_AVX_And:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_andpd : INS_andps);
+            break;
+        case NI_AVX_AndNot:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_andnpd : INS_andnps);
+            break;
+        case NI_AVX_Divide:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_divpd : INS_divps);
+            break;
+        case NI_AVX_Max:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, true));
+            break;
+        case NI_AVX_Min:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, false));
+            break;
+        case NI_AVX_Multiply:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_mulpd : INS_mulps);
+            break;
+        case NI_AVX_Or:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_orpd : INS_orps);
+            break;
+        case NI_AVX_Subtract:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_subpd : INS_subps);
+            break;
+        case NI_AVX_Xor:
+            genHWIntrinsicSimdBinaryOp(node, isDouble ? INS_xorpd : INS_xorps);
+            break;
+        case NI_AVX_Blend:
+            genHWIntrinsicSimdImmOp(node, isDouble ? INS_blendpd : INS_blendps);
+            break;
+        case NI_AVX_Shuffle:
+            genHWIntrinsicSimdImmOp(node, isDouble ? INS_shufpd : INS_shufps);
+            break;
+        case NI_AVX_MoveMask:
+            genHWIntrinsicSimdUnaryOp(node, isDouble ? INS_movmskpd : INS_movmskps);
+            break;
+        case NI_AVX_Sqrt:
+            genHWIntrinsicSimdUnaryOp(node, isDouble ? INS_sqrtpd : INS_sqrtps);
             break;
-        }
         default:
             unreached();
             break;
     }
-    genProduceReg(node);
 }
 
 void CodeGen::genAVX2Intrinsic(GenTreeHWIntrinsic* node)
 {
     NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
-    GenTree*       op1         = node->gtGetOp1();
-    GenTree*       op2         = node->gtGetOp2();
-    regNumber      targetReg   = node->gtRegNum;
-    var_types      targetType  = node->TypeGet();
     var_types      baseType    = node->gtSIMDBaseType;
+    assert(varTypeIsIntegral(baseType));
 
-    regNumber op1Reg = op1->gtRegNum;
-    regNumber op2Reg = REG_NA;
-
-    genConsumeOperands(node);
-
-    emitter* emit = getEmitter();
     switch (intrinsicID)
     {
         case NI_AVX2_Add:
-        {
-            op2Reg = op2->gtRegNum;
-
-            instruction ins;
-            switch (baseType)
+            genHWIntrinsicSimdBinaryOp(node,
+                                       getPackedIns(baseType, INS_none, INS_none, INS_paddb, INS_paddw, INS_paddd,
+                                                    INS_paddq));
+            break;
+        case NI_AVX2_Subtract:
+            genHWIntrinsicSimdBinaryOp(node,
+                                       getPackedIns(baseType, INS_none, INS_none, INS_psubb, INS_psubw, INS_psubd,
+                                                    INS_psubq));
+            break;
+        case NI_AVX2_And:
+            genHWIntrinsicSimdBinaryOp(node, INS_pand);
+            break;
+        case NI_AVX2_AndNot:
+            genHWIntrinsicSimdBinaryOp(node, INS_pandn);
+            break;
+        case NI_AVX2_Or:
+            genHWIntrinsicSimdBinaryOp(node, INS_por);
+            break;
+        case NI_AVX2_Xor:
+            genHWIntrinsicSimdBinaryOp(node, INS_pxor);
+            break;
+        case NI_AVX2_CompareEqual:
+            genHWIntrinsicSimdBinaryOp(node, getPackedIns(baseType, INS_none, INS_none, INS_pcmpeqb, INS_pcmpeqw,
+                                                          INS_pcmpeqd, INS_pcmpeqq));
+            break;
+        case NI_AVX2_CompareGreaterThan:
+            genHWIntrinsicSimdBinaryOp(node, getPackedIns(baseType, INS_none, INS_none, INS_pcmpgtb, INS_pcmpgtw,
+                                                          INS_pcmpgtd, INS_pcmpgtq));
+            break;
+        case NI_AVX2_Max:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, true));
+            break;
+        case NI_AVX2_Min:
+            genHWIntrinsicSimdBinaryOp(node, getPackedMinMaxIns(baseType, false));
+            break;
+        case NI_AVX2_MultiplyLow:
+            genHWIntrinsicSimdBinaryOp(node, varTypeIsShort(baseType) ? INS_pmullw : INS_pmulld);
+            break;
+        case NI_AVX2_MoveMask:
+            genHWIntrinsicSimdUnaryOp(node, INS_pmovmskb);
+            break;
+        case NI_AVX2_Blend:
+            genHWIntrinsicSimdImmOp(node, varTypeIsShort(baseType) ? INS_pblendw : INS_vpblendd);
+            break;
+        case NI_AVX2_Shuffle:
+            if (varTypeIsByte(baseType))
             {
-                case TYP_INT:
-                case TYP_UINT:
-                    ins = INS_paddd;
-                    break;
-                case TYP_LONG:
-                case TYP_ULONG:
-                    ins = INS_paddq;
-                    break;
-                case TYP_BYTE:
-                case TYP_UBYTE:
-                    ins = INS_paddb;
-                    break;
-                case TYP_SHORT:
-                case TYP_USHORT:
-                    ins = INS_paddw;
-                    break;
-                default:
-                    unreached();
-                    break;
+                genHWIntrinsicSimdBinaryOp(node, INS_pshufb);
+            }
+            else
+            {
+                genHWIntrinsicSimdImmOp(node, INS_pshufd);
             }
-
-            emit->emitIns_R_R_R(ins, emitTypeSize(TYP_SIMD32), targetReg, op1Reg, op2Reg);
             break;
-        }
         default:
             unreached();
             break;
     }
-    genProduceReg(node);
 }
 
 void CodeGen::genAESIntrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement AES intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+
+    switch (intrinsicID)
+    {
+        case NI_AES_Decrypt:
+            genHWIntrinsicSimdBinaryOp(node, INS_aesdec);
+            break;
+        case NI_AES_DecryptLast:
+            genHWIntrinsicSimdBinaryOp(node, INS_aesdeclast);
+            break;
+        case NI_AES_Encrypt:
+            genHWIntrinsicSimdBinaryOp(node, INS_aesenc);
+            break;
+        case NI_AES_EncryptLast:
+            genHWIntrinsicSimdBinaryOp(node, INS_aesenclast);
+            break;
+        case NI_AES_InverseMixColumns:
+            genHWIntrinsicSimdUnaryOp(node, INS_aesimc);
+            break;
+        case NI_AES_KeygenAssist:
+            genHWIntrinsicSimdImmOp(node, INS_aeskeygenassist);
+            break;
+        default:
+            unreached();
+            break;
+    }
 }
 
 void CodeGen::genBMI1Intrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement BMI1 intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    GenTree*       op1         = node->gtGetOp1();
+    regNumber      targetReg   = node->gtRegNum;
+    assert(targetReg != REG_NA);
+    var_types targetType = node->TypeGet();
+    regNumber op1Reg     = op1->gtRegNum;
+    genConsumeOperands(node);
+
+    // The other BMI1 intrinsics are expanded into regular IR by the importer.
+    assert(intrinsicID == NI_BMI1_TrailingZeroCount);
+
+    inst_RV_RV(INS_tzcnt, targetReg, op1Reg, targetType, emitTypeSize(targetType));
+
+    genProduceReg(node);
 }
 
 void CodeGen::genBMI2Intrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement BMI2 intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    GenTree*       op1         = node->gtGetOp1();
+    GenTree*       op2         = node->gtGetOp2();
+    regNumber      targetReg   = node->gtRegNum;
+    assert(targetReg != REG_NA);
+    var_types targetType = node->TypeGet();
+    genConsumeOperands(node);
+
+    instruction ins = INS_none;
+    switch (intrinsicID)
+    {
+        case NI_BMI2_ParallelBitDeposit:
+            ins = INS_pdep;
+            break;
+        case NI_BMI2_ParallelBitExtract:
+            ins = INS_pext;
+            break;
+        default:
+            unreached();
+            break;
+    }
+
+    // pdep/pext are VEX-encoded non-destructive instructions: the value goes in VEX.vvvv
+    // and the mask in ModRM.rm.
+    getEmitter()->emitIns_R_R_R(ins, emitTypeSize(targetType), targetReg, op1->gtRegNum, op2->gtRegNum);
+
+    genProduceReg(node);
 }
 
 void CodeGen::genFMAIntrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement FMA intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+    var_types      baseType    = node->gtSIMDBaseType;
+    regNumber      targetReg   = node->gtRegNum;
+    var_types      simdType    = node->TypeGet();
+    emitAttr       attr        = emitActualTypeSize(simdType);
+    emitter*       emit        = getEmitter();
+    assert(targetReg != REG_NA);
+    assert(varTypeIsFloating(baseType));
+
+    GenTreeArgList* list = node->gtGetOp1()->AsArgList();
+    GenTree*        op1  = list->Current();
+    GenTree*        op2  = list->Rest()->Current();
+    GenTree*        op3  = list->Rest()->Rest()->Current();
+    genConsumeReg(op1);
+    genConsumeReg(op2);
+    genConsumeReg(op3);
+
+    regNumber op1Reg = op1->gtRegNum;
+    regNumber op2Reg = op2->gtRegNum;
+    regNumber op3Reg = op3->gtRegNum;
+
+    bool        isDouble = (baseType == TYP_DOUBLE);
+    instruction ins213 = INS_none;
+    instruction ins231 = INS_none;
+    switch (intrinsicID)
+    {
+        case NI_FMA_MultiplyAdd:
+            ins213 = isDouble ? INS_vfmadd213pd : INS_vfmadd213ps;
+            ins231 = isDouble ? INS_vfmadd231pd : INS_vfmadd231ps;
+            break;
+        case NI_FMA_MultiplySubtract:
+            ins213 = isDouble ? INS_vfmsub213pd : INS_vfmsub213ps;
+            ins231 = isDouble ? INS_vfmsub231pd : INS_vfmsub231ps;
+            break;
+        default:
+            unreached();
+            break;
+    }
+
+    // The FMA forms overwrite one of their sources, so pick the one that lives in the target
+    // register: 213 computes "target = vvvv * target +/- rm" and 231 computes
+    // "target = vvvv * rm +/- target". Multiplication being commutative, op1 and op2 are
+    // interchangeable.
+    if (targetReg == op1Reg)
+    {
+        emit->emitIns_R_R_R(ins213, attr, targetReg, op2Reg, op3Reg);
+    }
+    else if (targetReg == op2Reg)
+    {
+        emit->emitIns_R_R_R(ins213, attr, targetReg, op1Reg, op3Reg);
+    }
+    else if (targetReg == op3Reg)
+    {
+        emit->emitIns_R_R_R(ins231, attr, targetReg, op1Reg, op2Reg);
+    }
+    else
+    {
+        emit->emitIns_R_R(INS_movaps, attr, targetReg, op1Reg);
+        emit->emitIns_R_R_R(ins213, attr, targetReg, op2Reg, op3Reg);
+    }
+
+    genProduceReg(node);
 }
 
 void CodeGen::genLZCNTIntrinsic(GenTreeHWIntrinsic* node)
@@ -364,7 +994,17 @@ void CodeGen::genLZCNTIntrinsic(GenTreeHWIntrinsic* node)
 
 void CodeGen::genPCLMULQDQIntrinsic(GenTreeHWIntrinsic* node)
 {
-    NYI("Implement PCLMULQDQ intrinsic code generation");
+    NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
+
+    switch (intrinsicID)
+    {
+        case NI_PCLMULQDQ_CarrylessMultiply:
+            genHWIntrinsicSimdImmOp(node, INS_pclmulqdq);
+            break;
+        default:
+            unreached();
+            break;
+    }
 }
 
 void CodeGen::genPOPCNTIntrinsic(GenTreeHWIntrinsic* node)
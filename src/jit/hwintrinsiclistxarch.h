@@ -15,43 +15,149 @@
 //  SSE Intrinsics          
 HARDWARE_INTRINSIC(SSE_IsSupported,             "get_IsSupported",              SSE)
 HARDWARE_INTRINSIC(SSE_Add,                     "Add",                          SSE)
+HARDWARE_INTRINSIC(SSE_And,                     "And",                          SSE)
+HARDWARE_INTRINSIC(SSE_AndNot,                  "AndNot",                       SSE)
+HARDWARE_INTRINSIC(SSE_CompareEqual,            "CompareEqual",                 SSE)
+HARDWARE_INTRINSIC(SSE_CompareGreaterThan,      "CompareGreaterThan",           SSE)
+HARDWARE_INTRINSIC(SSE_CompareGreaterThanOrEqual, "CompareGreaterThanOrEqual",    SSE)
+HARDWARE_INTRINSIC(SSE_CompareLessThan,         "CompareLessThan",              SSE)
+HARDWARE_INTRINSIC(SSE_CompareLessThanOrEqual,  "CompareLessThanOrEqual",       SSE)
+HARDWARE_INTRINSIC(SSE_CompareNotEqual,         "CompareNotEqual",              SSE)
+HARDWARE_INTRINSIC(SSE_Divide,                  "Divide",                       SSE)
+HARDWARE_INTRINSIC(SSE_LoadAlignedVector128,    "LoadAlignedVector128",         SSE)
+HARDWARE_INTRINSIC(SSE_LoadVector128,           "LoadVector128",                SSE)
+HARDWARE_INTRINSIC(SSE_Max,                     "Max",                          SSE)
+HARDWARE_INTRINSIC(SSE_Min,                     "Min",                          SSE)
+HARDWARE_INTRINSIC(SSE_MoveMask,                "MoveMask",                     SSE)
+HARDWARE_INTRINSIC(SSE_Multiply,                "Multiply",                     SSE)
+HARDWARE_INTRINSIC(SSE_Or,                      "Or",                           SSE)
+HARDWARE_INTRINSIC(SSE_SetZeroVector128,        "SetZeroVector128",             SSE)
+HARDWARE_INTRINSIC(SSE_Shuffle,                 "Shuffle",                      SSE)
+HARDWARE_INTRINSIC(SSE_Sqrt,                    "Sqrt",                         SSE)
+HARDWARE_INTRINSIC(SSE_Store,                   "Store",                        SSE)
+HARDWARE_INTRINSIC(SSE_StoreAligned,            "StoreAligned",                 SSE)
+HARDWARE_INTRINSIC(SSE_Subtract,                "Subtract",                     SSE)
+HARDWARE_INTRINSIC(SSE_UnpackHigh,              "UnpackHigh",                   SSE)
+HARDWARE_INTRINSIC(SSE_UnpackLow,               "UnpackLow",                    SSE)
+HARDWARE_INTRINSIC(SSE_Xor,                     "Xor",                          SSE)
 
 //  SSE2 Intrinsics 
 HARDWARE_INTRINSIC(SSE2_IsSupported,            "get_IsSupported",              SSE2)
 HARDWARE_INTRINSIC(SSE2_Add,                    "Add",                          SSE2)
+HARDWARE_INTRINSIC(SSE2_And,                    "And",                          SSE2)
+HARDWARE_INTRINSIC(SSE2_AndNot,                 "AndNot",                       SSE2)
+HARDWARE_INTRINSIC(SSE2_CompareEqual,           "CompareEqual",                 SSE2)
+HARDWARE_INTRINSIC(SSE2_CompareGreaterThan,     "CompareGreaterThan",           SSE2)
+HARDWARE_INTRINSIC(SSE2_CompareLessThan,        "CompareLessThan",              SSE2)
+HARDWARE_INTRINSIC(SSE2_ConvertToVector128Double, "ConvertToVector128Double",     SSE2)
+HARDWARE_INTRINSIC(SSE2_ConvertToVector128Int32WithTruncation, "ConvertToVector128Int32WithTruncation", SSE2)
+HARDWARE_INTRINSIC(SSE2_ConvertToVector128Single, "ConvertToVector128Single",     SSE2)
+HARDWARE_INTRINSIC(SSE2_Divide,                 "Divide",                       SSE2)
+HARDWARE_INTRINSIC(SSE2_LoadAlignedVector128,   "LoadAlignedVector128",         SSE2)
+HARDWARE_INTRINSIC(SSE2_LoadVector128,          "LoadVector128",                SSE2)
+HARDWARE_INTRINSIC(SSE2_Max,                    "Max",                          SSE2)
+HARDWARE_INTRINSIC(SSE2_Min,                    "Min",                          SSE2)
+HARDWARE_INTRINSIC(SSE2_MoveMask,               "MoveMask",                     SSE2)
+HARDWARE_INTRINSIC(SSE2_Multiply,               "Multiply",                     SSE2)
+HARDWARE_INTRINSIC(SSE2_MultiplyLow,            "MultiplyLow",                  SSE2)
+HARDWARE_INTRINSIC(SSE2_Or,                     "Or",                           SSE2)
+HARDWARE_INTRINSIC(SSE2_SetZeroVector128,       "SetZeroVector128",             SSE2)
+HARDWARE_INTRINSIC(SSE2_Shuffle,                "Shuffle",                      SSE2)
+HARDWARE_INTRINSIC(SSE2_Sqrt,                   "Sqrt",                         SSE2)
+HARDWARE_INTRINSIC(SSE2_Store,                  "Store",                        SSE2)
+HARDWARE_INTRINSIC(SSE2_StoreAligned,           "StoreAligned",                 SSE2)
+HARDWARE_INTRINSIC(SSE2_Subtract,               "Subtract",                     SSE2)
+HARDWARE_INTRINSIC(SSE2_UnpackHigh,             "UnpackHigh",                   SSE2)
+HARDWARE_INTRINSIC(SSE2_UnpackLow,              "UnpackLow",                    SSE2)
+HARDWARE_INTRINSIC(SSE2_Xor,                    "Xor",                          SSE2)
 
 //  SSE3 Intrinsics 
 HARDWARE_INTRINSIC(SSE3_IsSupported,            "get_IsSupported",              SSE3)
+HARDWARE_INTRINSIC(SSE3_HorizontalAdd,          "HorizontalAdd",                SSE3)
 
 //  SSSE3 Intrinsics 
 HARDWARE_INTRINSIC(SSSE3_IsSupported,           "get_IsSupported",              SSSE3)
+HARDWARE_INTRINSIC(SSSE3_Abs,                   "Abs",                          SSSE3)
+HARDWARE_INTRINSIC(SSSE3_Shuffle,               "Shuffle",                      SSSE3)
 
 //  SSE41 Intrinsics 
 HARDWARE_INTRINSIC(SSE41_IsSupported,           "get_IsSupported",              SSE41)
+HARDWARE_INTRINSIC(SSE41_Blend,                 "Blend",                        SSE41)
+HARDWARE_INTRINSIC(SSE41_CompareEqual,          "CompareEqual",                 SSE41)
+HARDWARE_INTRINSIC(SSE41_Max,                   "Max",                          SSE41)
+HARDWARE_INTRINSIC(SSE41_Min,                   "Min",                          SSE41)
+HARDWARE_INTRINSIC(SSE41_MultiplyLow,           "MultiplyLow",                  SSE41)
 
 //  SSE42 Intrinsics 
 HARDWARE_INTRINSIC(SSE42_IsSupported,           "get_IsSupported",              SSE42)
+HARDWARE_INTRINSIC(SSE42_CompareGreaterThan,    "CompareGreaterThan",           SSE42)
 HARDWARE_INTRINSIC(SSE42_Crc32,                 "Crc32",                        SSE42)
 
 //  AVX Intrinsics 
 HARDWARE_INTRINSIC(AVX_IsSupported,             "get_IsSupported",              AVX)
 HARDWARE_INTRINSIC(AVX_Add,                     "Add",                          AVX)
+HARDWARE_INTRINSIC(AVX_And,                     "And",                          AVX)
+HARDWARE_INTRINSIC(AVX_AndNot,                  "AndNot",                       AVX)
+HARDWARE_INTRINSIC(AVX_Blend,                   "Blend",                        AVX)
+HARDWARE_INTRINSIC(AVX_Divide,                  "Divide",                       AVX)
+HARDWARE_INTRINSIC(AVX_LoadAlignedVector256,    "LoadAlignedVector256",         AVX)
+HARDWARE_INTRINSIC(AVX_LoadVector256,           "LoadVector256",                AVX)
+HARDWARE_INTRINSIC(AVX_Max,                     "Max",                          AVX)
+HARDWARE_INTRINSIC(AVX_Min,                     "Min",                          AVX)
+HARDWARE_INTRINSIC(AVX_MoveMask,                "MoveMask",                     AVX)
+HARDWARE_INTRINSIC(AVX_Multiply,                "Multiply",                     AVX)
+HARDWARE_INTRINSIC(AVX_Or,                      "Or",                           AVX)
+HARDWARE_INTRINSIC(AVX_SetZeroVector256,        "SetZeroVector256",             AVX)
+HARDWARE_INTRINSIC(AVX_Shuffle,                 "Shuffle",                      AVX)
+HARDWARE_INTRINSIC(AVX_Sqrt,                    "Sqrt",                         AVX)
+HARDWARE_INTRINSIC(AVX_Store,                   "Store",                        AVX)
+HARDWARE_INTRINSIC(AVX_StoreAligned,            "StoreAligned",                 AVX)
+HARDWARE_INTRINSIC(AVX_Subtract,                "Subtract",                     AVX)
+HARDWARE_INTRINSIC(AVX_Xor,                     "Xor",                          AVX)
 
 //  AVX2 Intrinsics 
 HARDWARE_INTRINSIC(AVX2_IsSupported,            "get_IsSupported",              AVX2)
 HARDWARE_INTRINSIC(AVX2_Add,                    "Add",                          AVX2)
+HARDWARE_INTRINSIC(AVX2_And,                    "And",                          AVX2)
+HARDWARE_INTRINSIC(AVX2_AndNot,                 "AndNot",                       AVX2)
+HARDWARE_INTRINSIC(AVX2_Blend,                  "Blend",                        AVX2)
+HARDWARE_INTRINSIC(AVX2_CompareEqual,           "CompareEqual",                 AVX2)
+HARDWARE_INTRINSIC(AVX2_CompareGreaterThan,     "CompareGreaterThan",           AVX2)
+HARDWARE_INTRINSIC(AVX2_Max,                    "Max",                          AVX2)
+HARDWARE_INTRINSIC(AVX2_Min,                    "Min",                          AVX2)
+HARDWARE_INTRINSIC(AVX2_MoveMask,               "MoveMask",                     AVX2)
+HARDWARE_INTRINSIC(AVX2_MultiplyLow,            "MultiplyLow",                  AVX2)
+HARDWARE_INTRINSIC(AVX2_Or,                     "Or",                           AVX2)
+HARDWARE_INTRINSIC(AVX2_Shuffle,                "Shuffle",                      AVX2)
+HARDWARE_INTRINSIC(AVX2_Subtract,               "Subtract",                     AVX2)
+HARDWARE_INTRINSIC(AVX2_Xor,                    "Xor",                          AVX2)
 
 //  AES Intrinsics 
 HARDWARE_INTRINSIC(AES_IsSupported,             "get_IsSupported",              AES)
+HARDWARE_INTRINSIC(AES_Decrypt,                 "Decrypt",                      AES)
+HARDWARE_INTRINSIC(AES_DecryptLast,             "DecryptLast",                  AES)
+HARDWARE_INTRINSIC(AES_Encrypt,                 "Encrypt",                      AES)
+HARDWARE_INTRINSIC(AES_EncryptLast,             "EncryptLast",                  AES)
+HARDWARE_INTRINSIC(AES_InverseMixColumns,       "InverseMixColumns",            AES)
+HARDWARE_INTRINSIC(AES_KeygenAssist,            "KeygenAssist",                 AES)
 
 //  BMI1 Intrinsics 
 HARDWARE_INTRINSIC(BMI1_IsSupported,            "get_IsSupported",              BMI1)
+HARDWARE_INTRINSIC(BMI1_AndNot,                 "AndNot",                       BMI1)
+HARDWARE_INTRINSIC(BMI1_ExtractLowestSetBit,    "ExtractLowestSetBit",          BMI1)
+HARDWARE_INTRINSIC(BMI1_GetMaskUpToLowestSetBit, "GetMaskUpToLowestSetBit",      BMI1)
+HARDWARE_INTRINSIC(BMI1_ResetLowestSetBit,      "ResetLowestSetBit",            BMI1)
+HARDWARE_INTRINSIC(BMI1_TrailingZeroCount,      "TrailingZeroCount",            BMI1)
 
 //  BMI2 Intrinsics 
 HARDWARE_INTRINSIC(BMI2_IsSupported,            "get_IsSupported",              BMI2)
+HARDWARE_INTRINSIC(BMI2_ParallelBitDeposit,     "ParallelBitDeposit",           BMI2)
+HARDWARE_INTRINSIC(BMI2_ParallelBitExtract,     "ParallelBitExtract",           BMI2)
 
 //  FMA Intrinsics 
 HARDWARE_INTRINSIC(FMA_IsSupported,             "get_IsSupported",              FMA)
+HARDWARE_INTRINSIC(FMA_MultiplyAdd,             "MultiplyAdd",                  FMA)
+HARDWARE_INTRINSIC(FMA_MultiplySubtract,        "MultiplySubtract",             FMA)
 
 //  LZCNT Intrinsics 
 HARDWARE_INTRINSIC(LZCNT_IsSupported,           "get_IsSupported",              LZCNT)
@@ -59,6 +165,7 @@ HARDWARE_INTRINSIC(LZCNT_LeadingZeroCount,      "LeadingZeroCount",
 
 //  PCLMULQDQ Intrinsics 
 HARDWARE_INTRINSIC(PCLMULQDQ_IsSupported,       "get_IsSupported",              PCLMULQDQ)
+HARDWARE_INTRINSIC(PCLMULQDQ_CarrylessMultiply, "CarrylessMultiply",            PCLMULQDQ)
 
 //  POPCNT Intrinsics 
 HARDWARE_INTRINSIC(POPCNT_IsSupported,          "get_IsSupported",              POPCNT)
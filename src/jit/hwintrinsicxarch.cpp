@@ -199,22 +199,22 @@ bool Compiler::isFullyImplmentedISAClass(InstructionSet isa)
 {
     switch (isa)
     {
-        case InstructionSet_SSE:
-        case InstructionSet_SSE2:
         case InstructionSet_SSE3:
         case InstructionSet_SSSE3:
         case InstructionSet_SSE41:
         case InstructionSet_SSE42:
+            return false;
+
+        case InstructionSet_SSE:
+        case InstructionSet_SSE2:
         case InstructionSet_AVX:
         case InstructionSet_AVX2:
         case InstructionSet_AES:
         case InstructionSet_BMI1:
         case InstructionSet_BMI2:
         case InstructionSet_FMA:
-        case InstructionSet_PCLMULQDQ:
-            return false;
-
         case InstructionSet_LZCNT:
+        case InstructionSet_PCLMULQDQ:
         case InstructionSet_POPCNT:
             return true;
 
@@ -265,6 +265,50 @@ bool Compiler::compSupportsHWIntrinsic(InstructionSet isa)
                                                     isFullyImplmentedISAClass(isa));
 }
 
+//------------------------------------------------------------------------
+// immOperandOfHWIntrinsic: get the 8-bit control value operand of a hardware intrinsic
+//
+// Arguments:
+//    node -- the hardware intrinsic node
+//
+// Return Value:
+//    the operand that is encoded as an imm8, or nullptr if the intrinsic does not take one.
+//
+// Notes:
+//    A constant control value is contained. Any other value is left in a register, and
+//    codegen dispatches on it through a jump table with a case for each of the 256 values.
+//
+GenTree* Compiler::immOperandOfHWIntrinsic(GenTreeHWIntrinsic* node)
+{
+    switch (node->gtHWIntrinsicId)
+    {
+        case NI_AVX2_Shuffle:
+            // Shuffle over bytes is vpshufb, which takes a vector operand instead.
+            if (varTypeIsByte(node->gtSIMDBaseType))
+            {
+                return nullptr;
+            }
+            break;
+
+        case NI_SSE_Shuffle:
+        case NI_SSE2_Shuffle:
+        case NI_SSE41_Blend:
+        case NI_AVX_Blend:
+        case NI_AVX_Shuffle:
+        case NI_AVX2_Blend:
+        case NI_AES_KeygenAssist:
+        case NI_PCLMULQDQ_CarrylessMultiply:
+            break;
+
+        default:
+            return nullptr;
+    }
+
+    // The two vector operand forms carry their operands, including the control value, in a GT_LIST.
+    GenTree* op1 = node->gtGetOp1();
+    return op1->OperIsList() ? op1->AsArgList()->Rest()->Rest()->Current() : node->gtGetOp2();
+}
+
 //------------------------------------------------------------------------
 // impX86HWIntrinsic: dispatch hardware intrinsics to their own implementation
 // function
@@ -400,18 +444,200 @@ CORINFO_CLASS_HANDLE Compiler::gtGetStructHandleForHWSIMD(var_types simdType, va
     return NO_CLASS_HANDLE;
 }
 
+//------------------------------------------------------------------------
+// impHWIntrinsicArgBaseType: get the base type of a Vector128/Vector256 argument
+//
+// Arguments:
+//    sig    -- signature of the intrinsic call
+//    argNum -- zero-based position of the argument in the signature
+//
+// Return Value:
+//    the base type of the argument, or TYP_UNKNOWN if it is not a hardware intrinsic vector type.
+//
+var_types Compiler::impHWIntrinsicArgBaseType(CORINFO_SIG_INFO* sig, unsigned argNum)
+{
+    CORINFO_ARG_LIST_HANDLE argLst = sig->args;
+    for (unsigned i = 0; i < argNum; i++)
+    {
+        argLst = info.compCompHnd->getArgNext(argLst);
+    }
+
+    CORINFO_CLASS_HANDLE argClass = info.compCompHnd->getArgClass(sig, argLst);
+    return getBaseTypeOfSIMDType(argClass);
+}
+
+//------------------------------------------------------------------------
+// impSimdUnaryHWIntrinsic: import a hardware intrinsic taking a single vector operand
+//
+// Arguments:
+//    intrinsic -- id of the intrinsic function.
+//    sig       -- signature of the intrinsic call
+//    simdType  -- the SIMD type of the operand
+//
+// Return Value:
+//    the expanded intrinsic.
+//
+// Notes:
+//    The base type recorded on the node is the one of the operand, as the return type
+//    may differ from it (e.g. MoveMask, ConvertToVector128Double).
+//
+GenTree* Compiler::impSimdUnaryHWIntrinsic(NamedIntrinsic intrinsic, CORINFO_SIG_INFO* sig, var_types simdType)
+{
+    assert(sig->numArgs == 1);
+    var_types retType  = (sig->retType == CORINFO_TYPE_VALUECLASS) ? simdType : JITtype2varType(sig->retType);
+    var_types baseType = impHWIntrinsicArgBaseType(sig, 0);
+    GenTree*  op1      = impSIMDPopStack(simdType);
+    return gtNewSimdHWIntrinsicNode(retType, op1, intrinsic, baseType, genTypeSize(simdType));
+}
+
+//------------------------------------------------------------------------
+// impSimdBinaryHWIntrinsic: import a hardware intrinsic taking two vector operands of the return type
+//
+// Arguments:
+//    intrinsic -- id of the intrinsic function.
+//    sig       -- signature of the intrinsic call
+//    simdType  -- the SIMD type of the operands and the result
+//
+// Return Value:
+//    the expanded intrinsic.
+//
+GenTree* Compiler::impSimdBinaryHWIntrinsic(NamedIntrinsic intrinsic, CORINFO_SIG_INFO* sig, var_types simdType)
+{
+    assert(sig->numArgs == 2);
+    GenTree*  op2      = impSIMDPopStack(simdType);
+    GenTree*  op1      = impSIMDPopStack(simdType);
+    var_types baseType = getBaseTypeOfSIMDType(sig->retTypeSigClass);
+    return gtNewSimdHWIntrinsicNode(simdType, op1, op2, intrinsic, baseType, genTypeSize(simdType));
+}
+
+//------------------------------------------------------------------------
+// impSimdImmHWIntrinsic: import a hardware intrinsic whose last operand is an 8-bit control value
+//
+// Arguments:
+//    intrinsic -- id of the intrinsic function.
+//    sig       -- signature of the intrinsic call
+//    simdType  -- the SIMD type of the vector operands and the result
+//
+// Return Value:
+//    the expanded intrinsic.
+//
+// Notes:
+//    The control value is encoded as an imm8. Lowering marks a constant one as contained;
+//    any other value is dispatched on by codegen (see immOperandOfHWIntrinsic). The managed
+//    implementation calls itself, so the intrinsic always has to be expanded. The two vector
+//    operand form carries its operands in a GT_LIST as op1.
+//
+GenTree* Compiler::impSimdImmHWIntrinsic(NamedIntrinsic intrinsic, CORINFO_SIG_INFO* sig, var_types simdType)
+{
+    assert((sig->numArgs == 2) || (sig->numArgs == 3));
+
+    GenTree*  imm      = impPopStack().val;
+    var_types baseType = impHWIntrinsicArgBaseType(sig, 0);
+    unsigned  size     = genTypeSize(simdType);
+
+    if (sig->numArgs == 2)
+    {
+        GenTree* op1 = impSIMDPopStack(simdType);
+        return gtNewSimdHWIntrinsicNode(simdType, op1, imm, intrinsic, baseType, size);
+    }
+
+    GenTree* op2 = impSIMDPopStack(simdType);
+    GenTree* op1 = impSIMDPopStack(simdType);
+    return gtNewSimdHWIntrinsicNode(simdType, gtNewArgList(op1, op2, imm), intrinsic, baseType, size);
+}
+
+//------------------------------------------------------------------------
+// impHWIntrinsicLoad: import a LoadVector128/LoadVector256 style intrinsic
+//
+// Arguments:
+//    sig       -- signature of the intrinsic call
+//
+// Return Value:
+//    an indirection of the vector type off the address operand.
+//
+// Notes:
+//    The load is imported as an OBJ so that it goes through the regular SIMD
+//    indirection path, including addressing mode containment.
+//
+GenTree* Compiler::impHWIntrinsicLoad(CORINFO_SIG_INFO* sig)
+{
+    assert(sig->numArgs == 1);
+    GenTree* addr = impPopStack().val;
+    GenTree* load = gtNewObjNode(sig->retTypeSigClass, addr);
+    load->gtFlags |= GTF_EXCEPT;
+    return load;
+}
+
+//------------------------------------------------------------------------
+// impHWIntrinsicStore: import a Store/StoreAligned intrinsic
+//
+// Arguments:
+//    sig       -- signature of the intrinsic call
+//    simdType  -- the SIMD type of the stored value
+//
+// Return Value:
+//    a struct assignment of the vector operand through the address operand.
+//
+GenTree* Compiler::impHWIntrinsicStore(CORINFO_SIG_INFO* sig, var_types simdType)
+{
+    assert(sig->numArgs == 2);
+    CORINFO_ARG_LIST_HANDLE argLst   = info.compCompHnd->getArgNext(sig->args); // the second argument
+    CORINFO_CLASS_HANDLE    argClass = info.compCompHnd->getArgClass(sig, argLst);
+
+    GenTree* value = impSIMDPopStack(simdType);
+    GenTree* addr  = impPopStack().val;
+    return impAssignStructPtr(addr, value, argClass, (unsigned)CHECK_SPILL_ALL);
+}
+
 GenTree* Compiler::impSSEIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
     GenTree* retNode = nullptr;
-    GenTree* op1     = nullptr;
-    GenTree* op2     = nullptr;
     switch (intrinsic)
     {
         case NI_SSE_Add:
-            assert(sig->numArgs == 2);
-            op2     = impSIMDPopStack(TYP_SIMD16);
-            op1     = impSIMDPopStack(TYP_SIMD16);
-            retNode = gtNewSimdHWIntrinsicNode(TYP_SIMD16, op1, op2, NI_SSE_Add, TYP_FLOAT, 16);
+        case NI_SSE_And:
+        case NI_SSE_AndNot:
+        case NI_SSE_CompareEqual:
+        case NI_SSE_CompareGreaterThan:
+        case NI_SSE_CompareGreaterThanOrEqual:
+        case NI_SSE_CompareLessThan:
+        case NI_SSE_CompareLessThanOrEqual:
+        case NI_SSE_CompareNotEqual:
+        case NI_SSE_Divide:
+        case NI_SSE_Max:
+        case NI_SSE_Min:
+        case NI_SSE_Multiply:
+        case NI_SSE_Or:
+        case NI_SSE_Subtract:
+        case NI_SSE_UnpackHigh:
+        case NI_SSE_UnpackLow:
+        case NI_SSE_Xor:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE_MoveMask:
+        case NI_SSE_Sqrt:
+            retNode = impSimdUnaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE_Shuffle:
+            assert(sig->numArgs == 3);
+            retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE_LoadAlignedVector128:
+        case NI_SSE_LoadVector128:
+            retNode = impHWIntrinsicLoad(sig);
+            break;
+
+        case NI_SSE_Store:
+        case NI_SSE_StoreAligned:
+            retNode = impHWIntrinsicStore(sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE_SetZeroVector128:
+            assert(sig->numArgs == 0);
+            retNode = gtNewSIMDVectorZero(TYP_SIMD16, TYP_FLOAT, 16);
             break;
 
         default:
@@ -424,17 +650,56 @@ GenTree* Compiler::impSSEIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HAND
 GenTree* Compiler::impSSE2Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
     GenTree*  retNode  = nullptr;
-    GenTree*  op1      = nullptr;
-    GenTree*  op2      = nullptr;
     var_types baseType = TYP_UNKNOWN;
     switch (intrinsic)
     {
         case NI_SSE2_Add:
-            assert(sig->numArgs == 2);
-            op2      = impSIMDPopStack(TYP_SIMD16);
-            op1      = impSIMDPopStack(TYP_SIMD16);
+        case NI_SSE2_And:
+        case NI_SSE2_AndNot:
+        case NI_SSE2_CompareEqual:
+        case NI_SSE2_CompareGreaterThan:
+        case NI_SSE2_CompareLessThan:
+        case NI_SSE2_Divide:
+        case NI_SSE2_Max:
+        case NI_SSE2_Min:
+        case NI_SSE2_Multiply:
+        case NI_SSE2_MultiplyLow:
+        case NI_SSE2_Or:
+        case NI_SSE2_Subtract:
+        case NI_SSE2_UnpackHigh:
+        case NI_SSE2_UnpackLow:
+        case NI_SSE2_Xor:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE2_ConvertToVector128Double:
+        case NI_SSE2_ConvertToVector128Int32WithTruncation:
+        case NI_SSE2_ConvertToVector128Single:
+        case NI_SSE2_MoveMask:
+        case NI_SSE2_Sqrt:
+            retNode = impSimdUnaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE2_Shuffle:
+            // Shuffle(Vector128<int>, byte) maps to pshufd, Shuffle(Vector128<double>, Vector128<double>, byte)
+            // maps to shufpd.
+            retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE2_LoadAlignedVector128:
+        case NI_SSE2_LoadVector128:
+            retNode = impHWIntrinsicLoad(sig);
+            break;
+
+        case NI_SSE2_Store:
+        case NI_SSE2_StoreAligned:
+            retNode = impHWIntrinsicStore(sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE2_SetZeroVector128:
+            assert(sig->numArgs == 0);
             baseType = getBaseTypeOfSIMDType(sig->retTypeSigClass);
-            retNode  = gtNewSimdHWIntrinsicNode(TYP_SIMD16, op1, op2, NI_SSE2_Add, baseType, 16);
+            retNode  = gtNewSIMDVectorZero(TYP_SIMD16, baseType, 16);
             break;
 
         default:
@@ -446,17 +711,62 @@ GenTree* Compiler::impSSE2Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HAN
 
 GenTree* Compiler::impSSE3Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree* retNode = nullptr;
+    switch (intrinsic)
+    {
+        case NI_SSE3_HorizontalAdd:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impSSSE3Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree* retNode = nullptr;
+    switch (intrinsic)
+    {
+        case NI_SSSE3_Abs:
+            retNode = impSimdUnaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSSE3_Shuffle:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impSSE41Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree* retNode = nullptr;
+    switch (intrinsic)
+    {
+        case NI_SSE41_CompareEqual:
+        case NI_SSE41_Max:
+        case NI_SSE41_Min:
+        case NI_SSE41_MultiplyLow:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_SSE41_Blend:
+            assert(sig->numArgs == 3);
+            retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impSSE42Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
@@ -471,6 +781,10 @@ GenTree* Compiler::impSSE42Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HA
     CorInfoType             corType;
     switch (intrinsic)
     {
+        case NI_SSE42_CompareGreaterThan:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
         case NI_SSE42_Crc32:
             assert(sig->numArgs == 2);
             op2 = impPopStack().val;
@@ -501,17 +815,47 @@ GenTree* Compiler::impSSE42Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HA
 GenTree* Compiler::impAVXIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
     GenTree*  retNode  = nullptr;
-    GenTree*  op1      = nullptr;
-    GenTree*  op2      = nullptr;
     var_types baseType = TYP_UNKNOWN;
     switch (intrinsic)
     {
         case NI_AVX_Add:
-            assert(sig->numArgs == 2);
-            op2      = impSIMDPopStack(TYP_SIMD32);
-            op1      = impSIMDPopStack(TYP_SIMD32);
+        case NI_AVX_And:
+        case NI_AVX_AndNot:
+        case NI_AVX_Divide:
+        case NI_AVX_Max:
+        case NI_AVX_Min:
+        case NI_AVX_Multiply:
+        case NI_AVX_Or:
+        case NI_AVX_Subtract:
+        case NI_AVX_Xor:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            break;
+
+        case NI_AVX_MoveMask:
+        case NI_AVX_Sqrt:
+            retNode = impSimdUnaryHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            break;
+
+        case NI_AVX_Blend:
+        case NI_AVX_Shuffle:
+            assert(sig->numArgs == 3);
+            retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            break;
+
+        case NI_AVX_LoadAlignedVector256:
+        case NI_AVX_LoadVector256:
+            retNode = impHWIntrinsicLoad(sig);
+            break;
+
+        case NI_AVX_Store:
+        case NI_AVX_StoreAligned:
+            retNode = impHWIntrinsicStore(sig, TYP_SIMD32);
+            break;
+
+        case NI_AVX_SetZeroVector256:
+            assert(sig->numArgs == 0);
             baseType = getBaseTypeOfSIMDType(sig->retTypeSigClass);
-            retNode  = gtNewSimdHWIntrinsicNode(TYP_SIMD32, op1, op2, NI_AVX_Add, baseType, 32);
+            retNode  = gtNewSIMDVectorZero(TYP_SIMD32, baseType, 32);
             break;
 
         default:
@@ -524,17 +868,47 @@ GenTree* Compiler::impAVXIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HAND
 GenTree* Compiler::impAVX2Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
     GenTree*  retNode  = nullptr;
-    GenTree*  op1      = nullptr;
-    GenTree*  op2      = nullptr;
     var_types baseType = TYP_UNKNOWN;
+    unsigned  size     = 0;
     switch (intrinsic)
     {
         case NI_AVX2_Add:
-            assert(sig->numArgs == 2);
-            op2      = impSIMDPopStack(TYP_SIMD32);
-            op1      = impSIMDPopStack(TYP_SIMD32);
+        case NI_AVX2_And:
+        case NI_AVX2_AndNot:
+        case NI_AVX2_CompareEqual:
+        case NI_AVX2_CompareGreaterThan:
+        case NI_AVX2_Max:
+        case NI_AVX2_Min:
+        case NI_AVX2_MultiplyLow:
+        case NI_AVX2_Or:
+        case NI_AVX2_Subtract:
+        case NI_AVX2_Xor:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            break;
+
+        case NI_AVX2_MoveMask:
+            retNode = impSimdUnaryHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            break;
+
+        case NI_AVX2_Blend:
+            // vpblendd also has a 128-bit form, Blend(Vector128<int>, Vector128<int>, byte).
+            assert(sig->numArgs == 3);
+            baseType = getBaseTypeAndSizeOfSIMDType(sig->retTypeSigClass, &size);
+            retNode  = impSimdImmHWIntrinsic(intrinsic, sig, getSIMDTypeForSize(size));
+            break;
+
+        case NI_AVX2_Shuffle:
+            // Shuffle(Vector256<sbyte>, Vector256<sbyte>) maps to vpshufb, Shuffle(Vector256<int>, byte)
+            // maps to vpshufd.
             baseType = getBaseTypeOfSIMDType(sig->retTypeSigClass);
-            retNode  = gtNewSimdHWIntrinsicNode(TYP_SIMD32, op1, op2, NI_AVX2_Add, baseType, 32);
+            if (varTypeIsByte(baseType))
+            {
+                retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            }
+            else
+            {
+                retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD32);
+            }
             break;
 
         default:
@@ -546,22 +920,153 @@ GenTree* Compiler::impAVX2Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HAN
 
 GenTree* Compiler::impAESIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree* retNode = nullptr;
+    switch (intrinsic)
+    {
+        case NI_AES_Decrypt:
+        case NI_AES_DecryptLast:
+        case NI_AES_Encrypt:
+        case NI_AES_EncryptLast:
+            retNode = impSimdBinaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_AES_InverseMixColumns:
+            retNode = impSimdUnaryHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        case NI_AES_KeygenAssist:
+            assert(sig->numArgs == 2);
+            retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impBMI1Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree*  retNode  = nullptr;
+    GenTree*  op1      = nullptr;
+    GenTree*  op2      = nullptr;
+    GenTree*  op1Dup   = nullptr;
+    var_types callType = JITtype2varType(sig->retType);
+    var_types type     = genActualType(callType);
+
+    // AndNot and the lowest set bit manipulations are expanded into plain IR, so they
+    // stay visible to the optimizer and also work for the 64-bit overloads on x86.
+    switch (intrinsic)
+    {
+        case NI_BMI1_AndNot:
+            // ~left & right
+            assert(sig->numArgs == 2);
+            op2     = impPopStack().val;
+            op1     = impPopStack().val;
+            retNode = gtNewOperNode(GT_AND, type, gtNewOperNode(GT_NOT, type, op1), op2);
+            break;
+
+        case NI_BMI1_ExtractLowestSetBit:
+            // value & -value
+            assert(sig->numArgs == 1);
+            op1 = impPopStack().val;
+            op1 = impCloneExpr(op1, &op1Dup, NO_CLASS_HANDLE, (unsigned)CHECK_SPILL_ALL,
+                               nullptr DEBUGARG("BMI1 ExtractLowestSetBit operand"));
+            retNode = gtNewOperNode(GT_AND, type, op1, gtNewOperNode(GT_NEG, type, op1Dup));
+            break;
+
+        case NI_BMI1_GetMaskUpToLowestSetBit:
+            // value ^ (value - 1)
+            assert(sig->numArgs == 1);
+            op1 = impPopStack().val;
+            op1 = impCloneExpr(op1, &op1Dup, NO_CLASS_HANDLE, (unsigned)CHECK_SPILL_ALL,
+                               nullptr DEBUGARG("BMI1 GetMaskUpToLowestSetBit operand"));
+            retNode = gtNewOperNode(GT_XOR, type, op1, gtNewOperNode(GT_SUB, type, op1Dup, gtNewOneConNode(type)));
+            break;
+
+        case NI_BMI1_ResetLowestSetBit:
+            // value & (value - 1)
+            assert(sig->numArgs == 1);
+            op1 = impPopStack().val;
+            op1 = impCloneExpr(op1, &op1Dup, NO_CLASS_HANDLE, (unsigned)CHECK_SPILL_ALL,
+                               nullptr DEBUGARG("BMI1 ResetLowestSetBit operand"));
+            retNode = gtNewOperNode(GT_AND, type, op1, gtNewOperNode(GT_SUB, type, op1Dup, gtNewOneConNode(type)));
+            break;
+
+        case NI_BMI1_TrailingZeroCount:
+            assert(sig->numArgs == 1);
+            op1 = impPopStack().val;
+#ifdef _TARGET_X86_
+            if (varTypeIsLong(callType))
+            {
+                return gtNewMustThrowException(CORINFO_HELP_THROW_PLATFORM_NOT_SUPPORTED, callType, sig->retTypeClass);
+            }
+#endif
+            retNode = gtNewScalarHWIntrinsicNode(callType, op1, NI_BMI1_TrailingZeroCount);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impBMI2Intrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree*  retNode  = nullptr;
+    GenTree*  op1      = nullptr;
+    GenTree*  op2      = nullptr;
+    var_types callType = JITtype2varType(sig->retType);
+    switch (intrinsic)
+    {
+        case NI_BMI2_ParallelBitDeposit:
+        case NI_BMI2_ParallelBitExtract:
+            assert(sig->numArgs == 2);
+            op2 = impPopStack().val;
+            op1 = impPopStack().val;
+#ifdef _TARGET_X86_
+            if (varTypeIsLong(callType))
+            {
+                return gtNewMustThrowException(CORINFO_HELP_THROW_PLATFORM_NOT_SUPPORTED, callType, sig->retTypeClass);
+            }
+#endif
+            retNode = gtNewScalarHWIntrinsicNode(callType, op1, op2, intrinsic);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impFMAIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree*  retNode  = nullptr;
+    var_types baseType = TYP_UNKNOWN;
+    unsigned  size     = 0;
+    switch (intrinsic)
+    {
+        case NI_FMA_MultiplyAdd:
+        case NI_FMA_MultiplySubtract:
+        {
+            assert(sig->numArgs == 3);
+            baseType           = getBaseTypeAndSizeOfSIMDType(sig->retTypeSigClass, &size);
+            var_types simdType = getSIMDTypeForSize(size);
+            GenTree*  op3      = impSIMDPopStack(simdType);
+            GenTree*  op2      = impSIMDPopStack(simdType);
+            GenTree*  op1      = impSIMDPopStack(simdType);
+            retNode = gtNewSimdHWIntrinsicNode(simdType, gtNewArgList(op1, op2, op3), intrinsic, baseType, size);
+            break;
+        }
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impLZCNTIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
@@ -580,7 +1085,19 @@ GenTree* Compiler::impLZCNTIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HA
 
 GenTree* Compiler::impPCLMULQDQIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
 {
-    return nullptr;
+    GenTree* retNode = nullptr;
+    switch (intrinsic)
+    {
+        case NI_PCLMULQDQ_CarrylessMultiply:
+            assert(sig->numArgs == 3);
+            retNode = impSimdImmHWIntrinsic(intrinsic, sig, TYP_SIMD16);
+            break;
+
+        default:
+            JITDUMP("Not implemented hardware intrinsic");
+            break;
+    }
+    return retNode;
 }
 
 GenTree* Compiler::impPOPCNTIntrinsic(NamedIntrinsic intrinsic, CORINFO_METHOD_HANDLE method, CORINFO_SIG_INFO* sig)
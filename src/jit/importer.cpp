@@ -7921,9 +7921,18 @@ var_types Compiler::impImportCall(OPCODE                  opcode,
             // only true object pointers can be virtual
             assert(obj->gtType == TYP_REF);
 
-            // See if we can devirtualize.
+            // Tier0 code records the class of 'this' for guarded devirtualization at tier1
+            if (opts.jitFlags->IsSet(JitFlags::JIT_FLAG_TIER0))
+            {
+                impInsertClassProfile(call->AsCall(), rawILOffset);
+            }
+
+            // See if we can devirtualize. The call and the return that follows can't
+            // be split apart for an explicit tail call, so it can't be guarded.
+            const bool      isExplicitTailCall = (prefixFlags & PREFIX_TAILCALL_EXPLICIT) != 0;
+            const IL_OFFSET guardILOffset      = isExplicitTailCall ? BAD_IL_OFFSET : rawILOffset;
             impDevirtualizeCall(call->AsCall(), &callInfo->hMethod, &callInfo->methodFlags, &callInfo->contextHandle,
-                                &exactContextHnd);
+                                &exactContextHnd, guardILOffset);
         }
 
         if (impIsThis(obj))
@@ -8288,6 +8297,19 @@ DONE_CALL:
                         call           = gtNewLclvNode(calliSlot, type);
                     }
                 }
+                else if (call->AsCall()->IsGuardedDevirtualizationCandidate())
+                {
+                    // Guarded devirtualization candidates are cloned and split apart by
+                    // fgTransformGuardedDevirtualizationCalls, which like fat calli
+                    // candidates expects statements of the form call() or var = call().
+                    assert(!bIntrinsicImported);
+                    assert(!varTypeIsStruct(callRetTyp));
+                    unsigned   guardedSlot = lvaGrabTemp(true DEBUGARG("guarded devirt return value"));
+                    LclVarDsc* varDsc      = &lvaTable[guardedSlot];
+                    varDsc->lvVerTypeInfo  = tiRetVal;
+                    impAssignTempGen(guardedSlot, call, tiRetVal.GetClassHandle(), (unsigned)CHECK_SPILL_ALL);
+                    call = gtNewLclvNode(guardedSlot, genActualType(lvaTable[guardedSlot].TypeGet()));
+                }
 
                 // For non-candidates we must also spill, since we
                 // might have locals live on the eval stack that this
@@ -19197,6 +19219,8 @@ bool Compiler::IsMathIntrinsic(GenTreePtr tree)
 //     methodFlags -- [IN/OUT] flags for the method to call. Updated iff call devirtualized.
 //     contextHandle -- [IN/OUT] context handle for the call. Updated iff call devirtualized.
 //     exactContextHnd -- [OUT] updated context handle iff call devirtualized
+//     ilOffset -- IL offset of the call, or BAD_IL_OFFSET if the call
+//        must not become a guarded devirtualization candidate
 //
 // Notes:
 //     Virtual calls in IL will always "invoke" the base class method.
@@ -19221,11 +19245,16 @@ bool Compiler::IsMathIntrinsic(GenTreePtr tree)
 //     to instead make a local copy. If that is doable, the call is
 //     updated to invoke the unboxed entry on the local copy.
 //
+//     If the type of 'this' isn't known well enough, the class profile
+//     gathered by tier0 code may still show that one class is very
+//     likely; see impConsiderGuardedDevirtualization.
+//
 void Compiler::impDevirtualizeCall(GenTreeCall*            call,
                                    CORINFO_METHOD_HANDLE*  method,
                                    unsigned*               methodFlags,
                                    CORINFO_CONTEXT_HANDLE* contextHandle,
-                                   CORINFO_CONTEXT_HANDLE* exactContextHandle)
+                                   CORINFO_CONTEXT_HANDLE* exactContextHandle,
+                                   IL_OFFSET               ilOffset)
 {
     assert(call != nullptr);
     assert(method != nullptr);
@@ -19346,6 +19375,7 @@ void Compiler::impDevirtualizeCall(GenTreeCall*            call,
     if (objClass == nullptr)
     {
         JITDUMP("\nimpDevirtualizeCall: no type available (op=%s)\n", GenTree::OpName(thisObj->OperGet()));
+        impConsiderGuardedDevirtualization(call, baseMethod, baseMethodAttribs, *contextHandle, ilOffset);
         return;
     }
 
@@ -19403,6 +19433,7 @@ void Compiler::impDevirtualizeCall(GenTreeCall*            call,
     if ((objClassAttribs & CORINFO_FLG_INTERFACE) != 0)
     {
         JITDUMP("--- obj class is interface, sorry\n");
+        impConsiderGuardedDevirtualization(call, baseMethod, baseMethodAttribs, *contextHandle, ilOffset);
         return;
     }
 
@@ -19471,6 +19502,7 @@ void Compiler::impDevirtualizeCall(GenTreeCall*            call,
         // override this method), then perhaps we'd be willing to
         // make a bet...?
         JITDUMP("    Class not final or exact, method not final, no devirtualization\n");
+        impConsiderGuardedDevirtualization(call, baseMethod, baseMethodAttribs, *contextHandle, ilOffset);
         return;
     }
 
@@ -19478,6 +19510,7 @@ void Compiler::impDevirtualizeCall(GenTreeCall*            call,
     if (isInterface && !isExact && !objClassIsFinal)
     {
         JITDUMP("    Class not final or exact for interface, no devirtualization\n");
+        impConsiderGuardedDevirtualization(call, baseMethod, baseMethodAttribs, *contextHandle, ilOffset);
         return;
     }
 
@@ -19618,6 +19651,160 @@ void Compiler::impDevirtualizeCall(GenTreeCall*            call,
 #endif // FEATURE_READYTORUN_COMPILER
 }
 
+//------------------------------------------------------------------------
+// impConsiderGuardedDevirtualization: see if a virtual call that can't be
+//   devirtualized outright is worth guarding with a class test
+//
+// Arguments:
+//     call -- the virtual call to examine
+//     baseMethod -- the method the call invokes in IL
+//     baseMethodAttribs -- attributes of baseMethod
+//     ownerType -- context handle for the call
+//     ilOffset -- IL offset of the call, or BAD_IL_OFFSET if the call
+//        must not be guarded
+//
+// Notes:
+//     Tier0 code records the class of 'this' at virtual call sites (see
+//     impInsertClassProfile). When the method is rejitted at tier1 and
+//     one class accounts for enough of the calls, the call is marked as a
+//     guarded devirtualization candidate. fgTransformGuardedDevirtualizationCalls
+//     later turns it into a test of the method table of 'this' against the
+//     likely class, a direct call to the method that class dispatches to when
+//     the test passes, and the original virtual call otherwise.
+//
+//     The profile is kept per method, so only calls in the root method
+//     are considered.
+//
+void Compiler::impConsiderGuardedDevirtualization(GenTreeCall*           call,
+                                                  CORINFO_METHOD_HANDLE  baseMethod,
+                                                  unsigned               baseMethodAttribs,
+                                                  CORINFO_CONTEXT_HANDLE ownerType,
+                                                  IL_OFFSET              ilOffset)
+{
+    assert(call->IsVirtual());
+    assert((baseMethodAttribs & CORINFO_FLG_VIRTUAL) != 0);
+
+    if ((ilOffset == BAD_IL_OFFSET) || (JitConfig.JitGuardedDevirtualization() == 0))
+    {
+        return;
+    }
+
+    // Only tier1 code has a profile to use
+    if (!opts.jitFlags->IsSet(JitFlags::JIT_FLAG_TIER1) || compIsForInlining() || opts.IsReadyToRun())
+    {
+        return;
+    }
+
+    // Struct returns may be rewritten to use a return buffer, keep them simple
+    if (varTypeIsStruct(call->TypeGet()))
+    {
+        JITDUMP("    struct return, no guarded devirtualization\n");
+        return;
+    }
+
+    unsigned             likelihood  = 0;
+    CORINFO_CLASS_HANDLE likelyClass = info.compCompHnd->getLikelyClass(info.compMethodHnd, ilOffset, &likelihood,
+                                                                        nullptr);
+
+    if (likelyClass == nullptr)
+    {
+        JITDUMP("    no class profile for IL offset 0x%x, no guarded devirtualization\n", ilOffset);
+        return;
+    }
+
+    if (likelihood < (unsigned)JitConfig.JitGuardedDevirtualizationLikelihood())
+    {
+        JITDUMP("    likely class is only seen on %u%% of calls, no guarded devirtualization\n", likelihood);
+        return;
+    }
+
+    // A boxed 'this' would call the boxed entry point, which the existing
+    // devirtualization handles by looking at the box. Leave those alone.
+    const DWORD likelyClassAttribs = info.compCompHnd->getClassAttribs(likelyClass);
+    if ((likelyClassAttribs & CORINFO_FLG_VALUECLASS) != 0)
+    {
+        JITDUMP("    likely class is a value class, no guarded devirtualization\n");
+        return;
+    }
+
+    CORINFO_METHOD_HANDLE likelyMethod = info.compCompHnd->resolveVirtualMethod(baseMethod, likelyClass, ownerType);
+
+    if (likelyMethod == nullptr)
+    {
+        JITDUMP("    no method for the likely class, no guarded devirtualization\n");
+        return;
+    }
+
+#if defined(DEBUG)
+    if (verbose || (JitConfig.JitPrintDevirtualizedMethods() == 1))
+    {
+        const char* likelyClassName = info.compCompHnd->getClassName(likelyClass);
+        printf("Guarded devirtualization of %s call at IL offset 0x%x to %s (%u%% of calls on %s)\n",
+               call->IsVirtualStub() ? "interface" : "virtual", ilOffset, eeGetMethodFullName(likelyMethod),
+               likelihood, likelyClassName);
+    }
+#endif // DEBUG
+
+    addGuardedDevirtualizationCandidate(call, likelyMethod, likelyClass, likelihood);
+}
+
+//------------------------------------------------------------------------
+// impInsertClassProfile: record the class of 'this' at a virtual call in
+//   tier0 code
+//
+// Arguments:
+//     call -- the virtual call being imported
+//     ilOffset -- IL offset of the call
+//
+// Notes:
+//     Tier0 code passes 'this' to CORINFO_HELP_CLASSPROFILE just before the
+//     call. The runtime keeps a profile of the classes seen at each call site
+//     that impConsiderGuardedDevirtualization uses once the method is
+//     rejitted at tier1.
+//
+//     'this' is spilled to a temp if it is not a simple tree, so it is still
+//     evaluated once and ahead of the other arguments.
+//
+void Compiler::impInsertClassProfile(GenTreeCall* call, IL_OFFSET ilOffset)
+{
+    assert(call->IsVirtual());
+    assert(opts.jitFlags->IsSet(JitFlags::JIT_FLAG_TIER0));
+
+    if ((JitConfig.JitGuardedDevirtualization() == 0) || compIsForInlining() || (ilOffset == BAD_IL_OFFSET))
+    {
+        return;
+    }
+
+    // There is nothing to learn about calls that will be devirtualized anyways
+    bool                 isExact   = false;
+    bool                 isNonNull = false;
+    CORINFO_CLASS_HANDLE objClass  = gtGetClassHandle(call->gtCallObjp, &isExact, &isNonNull);
+
+    if ((objClass != nullptr) && (isExact || ((info.compCompHnd->getClassAttribs(objClass) & CORINFO_FLG_FINAL) != 0)))
+    {
+        return;
+    }
+
+    unsigned likelihood = 0;
+    void*    cell       = nullptr;
+    info.compCompHnd->getLikelyClass(info.compMethodHnd, ilOffset, &likelihood, &cell);
+
+    if (cell == nullptr)
+    {
+        return;
+    }
+
+    GenTreePtr thisCopy = nullptr;
+    call->gtCallObjp    = impCloneExpr(call->gtCallObjp, &thisCopy, NO_CLASS_HANDLE, (unsigned)CHECK_SPILL_ALL,
+                                    nullptr DEBUGARG("class profile 'this'"));
+
+    GenTreeArgList* args    = gtNewArgList(thisCopy, gtNewIconHandleNode((size_t)cell, GTF_ICON_BBC_PTR));
+    GenTreePtr      profile = gtNewHelperCallNode(CORINFO_HELP_CLASSPROFILE, TYP_VOID, args);
+    impAppendTree(profile, (unsigned)CHECK_SPILL_ALL, impCurStmtOffs);
+
+    JITDUMP("Recording the class of 'this' for the call at IL offset 0x%x\n", ilOffset);
+}
+
 //------------------------------------------------------------------------
 // impGetSpecialIntrinsicExactReturnType: Look for special cases where a call
 //   to an intrinsic returns an exact type
@@ -19767,3 +19954,41 @@ void Compiler::addFatPointerCandidate(GenTreeCall* call)
     SpillRetExprHelper helper(this);
     helper.StoreRetExprResultsInArgs(call);
 }
+
+//------------------------------------------------------------------------
+// addGuardedDevirtualizationCandidate: mark the call and the method, that
+//   they have a guarded devirtualization candidate.
+//
+// Arguments:
+//    call - virtual call to guard
+//    methodHandle - method the likely class dispatches to
+//    classHandle - likely class of 'this'
+//    likelihood - percentage of calls expected to be made on classHandle
+//
+// Notes:
+//    The transformation tests 'this' before the arguments are evaluated and
+//    clones the call, so 'this' is spilled to a temp and ret_expr in the
+//    arguments are spilled because they can't be cloned.
+//
+void Compiler::addGuardedDevirtualizationCandidate(GenTreeCall*          call,
+                                                   CORINFO_METHOD_HANDLE methodHandle,
+                                                   CORINFO_CLASS_HANDLE  classHandle,
+                                                   unsigned              likelihood)
+{
+    const unsigned thisTempNum = lvaGrabTemp(true DEBUGARG("guarded devirt this"));
+    impAssignTempGen(thisTempNum, call->gtCallObjp, (unsigned)CHECK_SPILL_ALL);
+    call->gtCallObjp = gtNewLclvNode(thisTempNum, TYP_REF);
+
+    SpillRetExprHelper helper(this);
+    helper.StoreRetExprResultsInArgs(call);
+
+    GuardedDevirtualizationCandidateInfo* pInfo = new (this, CMK_Inlining) GuardedDevirtualizationCandidateInfo;
+    pInfo->guardedClassHandle                   = classHandle;
+    pInfo->guardedMethodHandle                  = methodHandle;
+    pInfo->stubAddr                             = call->IsVirtualStub() ? call->gtStubCallStubAddr : nullptr;
+    pInfo->likelihood                           = likelihood;
+
+    call->gtGuardedDevirtualizationCandidateInfo = pInfo;
+    call->SetGuardedDevirtualizationCandidate();
+    setMethodHasGuardedDevirtualization();
+}
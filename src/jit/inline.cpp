@@ -1443,12 +1443,52 @@ void InlineStrategy::DumpDataContents(FILE* file)
     m_LastSuccessfulPolicy->DumpData(file);
 }
 
-// Static to track emission of the xml data header
-// and lock to prevent interleaved file writes
+// Static to track emission of the xml data header,
+// the file being written, and lock to prevent
+// interleaved file writes
 
 bool          InlineStrategy::s_HasDumpedXmlHeader = false;
+FILE*         InlineStrategy::s_XmlFile            = nullptr;
 CritSecObject InlineStrategy::s_XmlWriterLock;
 
+//------------------------------------------------------------------------
+// GetXmlFile: get the file to use for inline xml
+//
+// Return Value:
+//    File named by JitInlineDumpXmlFile, or stderr if that is not
+//    set or cannot be opened.
+//
+// Notes:
+//    Caller must hold s_XmlWriterLock. Writing the xml to a file
+//    keeps it separate from other jit output, so that it can be
+//    replayed via JitInlineReplayFile or used to fit a model for
+//    ModelPolicy (see fitinlinemodel.py).
+
+FILE* InlineStrategy::GetXmlFile()
+{
+    if (s_XmlFile == nullptr)
+    {
+        const wchar_t* xmlFileName = JitConfig.JitInlineDumpXmlFile();
+
+        if (xmlFileName != nullptr)
+        {
+            s_XmlFile = _wfopen(xmlFileName, W("w"));
+
+            if (s_XmlFile == nullptr)
+            {
+                fprintf(stderr, "*** Unable to write inline xml to %ws\n", xmlFileName);
+            }
+        }
+
+        if (s_XmlFile == nullptr)
+        {
+            s_XmlFile = stderr;
+        }
+    }
+
+    return s_XmlFile;
+}
+
 //------------------------------------------------------------------------
 // DumpXml: dump xml-formatted version of the inline tree.
 //
@@ -1466,6 +1506,11 @@ void InlineStrategy::DumpXml(FILE* file, unsigned indent)
     // Lock to prevent interleaving of trees.
     CritSecHolder writeLock(s_XmlWriterLock);
 
+    if (file == nullptr)
+    {
+        file = GetXmlFile();
+    }
+
     // Dump header
     if (!s_HasDumpedXmlHeader)
     {
@@ -1609,6 +1654,13 @@ void InlineStrategy::DumpXml(FILE* file, unsigned indent)
 
 void InlineStrategy::FinalizeXml(FILE* file)
 {
+    CritSecHolder writeLock(s_XmlWriterLock);
+
+    if (file == nullptr)
+    {
+        file = GetXmlFile();
+    }
+
     // If we dumped the header, dump a footer
     if (s_HasDumpedXmlHeader)
     {
@@ -1620,6 +1672,14 @@ void InlineStrategy::FinalizeXml(FILE* file)
         s_HasDumpedXmlHeader = false;
     }
 
+    // Close the xml file if we opened one
+    if ((s_XmlFile != nullptr) && (s_XmlFile != stderr))
+    {
+        fclose(s_XmlFile);
+    }
+
+    s_XmlFile = nullptr;
+
     // Finalize reading inline xml
     ReplayPolicy::FinalizeXml();
 }
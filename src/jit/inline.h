@@ -502,6 +502,19 @@ struct InlineCandidateInfo
     CorInfoInitClassResult initClassResult;
 };
 
+// GuardedDevirtualizationCandidateInfo provides information about
+// a virtual call that will be split into a type test guarding a
+// direct call to the method of the likely class, and the original
+// virtual call as a fallback.
+
+struct GuardedDevirtualizationCandidateInfo
+{
+    CORINFO_CLASS_HANDLE  guardedClassHandle;  // class 'this' is tested against
+    CORINFO_METHOD_HANDLE guardedMethodHandle; // method the guarded class dispatches to
+    void*                 stubAddr;            // saved gtStubCallStubAddr of a virtual stub call
+    unsigned              likelihood;          // percentage of calls expected to pass the guard
+};
+
 // InlArgInfo describes inline candidate argument properties.
 
 struct InlArgInfo
@@ -816,8 +829,9 @@ public:
     void DumpDataContents(FILE* file);
 
     // Dump xml-formatted description of inlines
-    void DumpXml(FILE* file = stderr, unsigned indent = 0);
-    static void FinalizeXml(FILE* file = stderr);
+    // (null file means the JitInlineDumpXmlFile, or stderr if unset)
+    void DumpXml(FILE* file = nullptr, unsigned indent = 0);
+    static void FinalizeXml(FILE* file = nullptr);
 
     // Cache for file position of this method in the inline xml
     long GetMethodXmlFilePosition()
@@ -871,7 +885,10 @@ private:
 #if defined(DEBUG) || defined(INLINE_DATA)
     static bool          s_HasDumpedDataHeader;
     static bool          s_HasDumpedXmlHeader;
+    static FILE*         s_XmlFile;
     static CritSecObject s_XmlWriterLock;
+
+    static FILE* GetXmlFile();
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 
     Compiler*         m_Compiler;
@@ -77,8 +77,9 @@ InlinePolicy* InlinePolicy::GetPolicy(Compiler* compiler, bool isPrejitRoot)
 
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 
-    // Optionally install the ModelPolicy.
-    bool useModelPolicy = JitConfig.JitInlinePolicyModel() != 0;
+    // Optionally install the ModelPolicy. Loading a model file
+    // implies the ModelPolicy should be used.
+    bool useModelPolicy = (JitConfig.JitInlinePolicyModel() != 0) || ModelPolicy::HasLoadedModel();
 
     if (useModelPolicy)
     {
@@ -1754,6 +1755,67 @@ int DiscretionaryPolicy::CodeSizeEstimate()
     return m_ModelCodeSizeEstimate;
 }
 
+// Names of the features, indexed by DiscretionaryPolicy::Feature
+
+// clang-format off
+static const char* const s_InlineFeatureNames[] =
+{
+#define INLINE_FEATURE(name, value) #name,
+#include "inlinefeature.def"
+#undef INLINE_FEATURE
+};
+// clang-format on
+
+//------------------------------------------------------------------------
+// FindFeature: find a feature given its name
+//
+// Arguments:
+//    name    -- name of the feature, as in the data schema
+//    feature -- [out] the feature, if found
+//
+// Return Value:
+//    true if the name describes a feature
+
+bool DiscretionaryPolicy::FindFeature(const char* name, Feature* feature)
+{
+    static_assert_no_msg(_countof(s_InlineFeatureNames) == FEATURE_COUNT);
+
+    for (unsigned i = 0; i < FEATURE_COUNT; i++)
+    {
+        if (strcmp(name, s_InlineFeatureNames[i]) == 0)
+        {
+            *feature = (Feature)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------
+// GetFeature: get the observed value of a feature
+//
+// Arguments:
+//    feature -- the feature of interest
+//
+// Return Value:
+//    Value of the feature for this inline candidate
+
+double DiscretionaryPolicy::GetFeature(Feature feature) const
+{
+    switch (feature)
+    {
+#define INLINE_FEATURE(name, value)                                                                                    \
+    case FEATURE_##name:                                                                                               \
+        return (double)(value);
+#include "inlinefeature.def"
+#undef INLINE_FEATURE
+
+        default:
+            unreached();
+    }
+}
+
 #if defined(DEBUG) || defined(INLINE_DATA)
 
 //------------------------------------------------------------------------
@@ -1895,8 +1957,8 @@ void DiscretionaryPolicy::DumpData(FILE* file) const
     fprintf(file, ",%u", m_StaticFieldLoadCount);
     fprintf(file, ",%u", m_StaticFieldStoreCount);
     fprintf(file, ",%u", m_LoadAddressCount);
-    fprintf(file, ",%u", m_ReturnCount);
     fprintf(file, ",%u", m_ThrowCount);
+    fprintf(file, ",%u", m_ReturnCount);
     fprintf(file, ",%u", m_CallCount);
     fprintf(file, ",%u", m_CallSiteWeight);
     fprintf(file, ",%u", m_IsForceInline ? 1 : 0);
@@ -1922,6 +1984,220 @@ void DiscretionaryPolicy::DumpData(FILE* file) const
 
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 
+//------------------------------------------------------------------------
+// AddTerm: add a term to a linear inline model
+//
+// Arguments:
+//    term        -- "Feature" for a term linear in the feature value,
+//                   "Feature==N" for a term that applies only when the
+//                   feature has value N, or "Intercept"
+//    coefficient -- coefficient of the term
+//
+// Return Value:
+//    true if the term was added, false if the term was not recognized
+//    or the model has too many terms.
+
+bool LinearInlineModel::AddTerm(const char* term, double coefficient)
+{
+    if (strcmp(term, "Intercept") == 0)
+    {
+        m_Intercept += coefficient;
+        return true;
+    }
+
+    if (m_TermCount >= MAX_TERMS)
+    {
+        return false;
+    }
+
+    Term&       newTerm   = m_Terms[m_TermCount];
+    const char* indicator = strstr(term, "==");
+    char        name[64];
+
+    if (indicator != nullptr)
+    {
+        size_t length = indicator - term;
+
+        if ((length >= sizeof(name)) || (indicator[2] == 0))
+        {
+            return false;
+        }
+
+        memcpy(name, term, length);
+        name[length]          = 0;
+        newTerm.m_IsIndicator = true;
+        newTerm.m_Value       = (unsigned)atoi(indicator + 2);
+    }
+    else
+    {
+        if (strlen(term) >= sizeof(name))
+        {
+            return false;
+        }
+
+        strcpy_s(name, sizeof(name), term);
+        newTerm.m_IsIndicator = false;
+        newTerm.m_Value       = 0;
+    }
+
+    if (!DiscretionaryPolicy::FindFeature(name, &newTerm.m_Feature))
+    {
+        return false;
+    }
+
+    newTerm.m_Coefficient = coefficient;
+    m_TermCount++;
+    return true;
+}
+
+//------------------------------------------------------------------------
+// Evaluate: evaluate a linear inline model
+//
+// Arguments:
+//    policy -- policy holding the observations for an inline candidate
+//
+// Return Value:
+//    Model estimate for the candidate
+
+double LinearInlineModel::Evaluate(const DiscretionaryPolicy* policy) const
+{
+    double result = m_Intercept;
+
+    for (unsigned i = 0; i < m_TermCount; i++)
+    {
+        const Term& term  = m_Terms[i];
+        double      value = policy->GetFeature(term.m_Feature);
+
+        if (term.m_IsIndicator)
+        {
+            value = ((unsigned)value == term.m_Value) ? 1.0 : 0.0;
+        }
+
+        result += term.m_Coefficient * value;
+    }
+
+    return result;
+}
+
+// Statics describing the model in use by the ModelPolicy. The
+// defaults describe the model built into DiscretionaryPolicy.
+
+bool              ModelPolicy::s_HasLoadedModel = false;
+unsigned          ModelPolicy::s_MaxILSize      = 120;
+double            ModelPolicy::s_Threshold      = 0.20;
+LinearInlineModel ModelPolicy::s_SizeModel;
+LinearInlineModel ModelPolicy::s_PerCallModel;
+
+//------------------------------------------------------------------------
+// LoadModel: load a model fitted offline
+//
+// Notes:
+//    Called once during jit startup. Reads the file named by
+//    JitInlineModelFile, if set. The file is text, one entry per
+//    line; '#' starts a comment.
+//
+//      MaxILSize <n>         -- fail fast for callees this large
+//      Threshold <x>         -- size/speed tradeoff, as below
+//      SizeModel             -- following terms estimate code size
+//                               change in bytes
+//      PerCallModel          -- following terms estimate instructions
+//                               executed per call (negative is a win)
+//      <term> <coefficient>  -- see LinearInlineModel::AddTerm
+//
+//    The file is written by fitinlinemodel.py from inline
+//    xml gathered with JitInlineDumpXmlFile and JitInlineDumpData.
+//    If the file cannot be read or has an unrecognized entry, the
+//    whole file is ignored and the built-in model is used.
+
+void ModelPolicy::LoadModel()
+{
+    const wchar_t* modelFileName = JitConfig.JitInlineModelFile();
+
+    if (modelFileName == nullptr)
+    {
+        return;
+    }
+
+    FILE* modelFile = _wfopen(modelFileName, W("r"));
+
+    if (modelFile == nullptr)
+    {
+        return;
+    }
+
+    unsigned           maxILSize = s_MaxILSize;
+    double             threshold = s_Threshold;
+    LinearInlineModel  sizeModel;
+    LinearInlineModel  perCallModel;
+    LinearInlineModel* model        = nullptr;
+    bool               sawSize      = false;
+    bool               sawPerCall   = false;
+    bool               isWellFormed = true;
+    char               buffer[256];
+
+    while (isWellFormed && (fgets(buffer, sizeof(buffer), modelFile) != nullptr))
+    {
+        char* comment = strchr(buffer, '#');
+
+        if (comment != nullptr)
+        {
+            *comment = 0;
+        }
+
+        char   key[64];
+        double value = 0.0;
+        int    count = sscanf_s(buffer, "%63s %lf", key, (unsigned)sizeof(key), &value);
+
+        if (count <= 0)
+        {
+            // Blank line
+            continue;
+        }
+
+        if (strcmp(key, "SizeModel") == 0)
+        {
+            model   = &sizeModel;
+            sawSize = true;
+        }
+        else if (strcmp(key, "PerCallModel") == 0)
+        {
+            model      = &perCallModel;
+            sawPerCall = true;
+        }
+        else if (count != 2)
+        {
+            isWellFormed = false;
+        }
+        else if (strcmp(key, "MaxILSize") == 0)
+        {
+            maxILSize = (unsigned)value;
+        }
+        else if (strcmp(key, "Threshold") == 0)
+        {
+            threshold = value;
+        }
+        else
+        {
+            isWellFormed = (model != nullptr) && model->AddTerm(key, value);
+        }
+    }
+
+    fclose(modelFile);
+
+    if (isWellFormed && sawSize && sawPerCall)
+    {
+        s_MaxILSize      = maxILSize;
+        s_Threshold      = threshold;
+        s_SizeModel      = sizeModel;
+        s_PerCallModel   = perCallModel;
+        s_HasLoadedModel = true;
+    }
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+    fprintf(stderr, "*** %s inline model from %ws\n", s_HasLoadedModel ? "Using" : "Unable to use", modelFileName);
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+}
+
 //------------------------------------------------------------------------/
 // ModelPolicy: construct a new ModelPolicy
 //
@@ -1971,6 +2247,8 @@ ModelPolicy::ModelPolicy(Compiler* compiler, bool isPrejitRoot) : DiscretionaryP
 //    means an ILSize of 120 is likely to lead to a size estimate of
 //    at least 1405 at least 50% of the time. So we choose this as the
 //    early rejection threshold.
+//
+//    A model loaded from a file brings its own threshold.
 
 void ModelPolicy::NoteInt(InlineObservation obs, int value)
 {
@@ -1978,8 +2256,8 @@ void ModelPolicy::NoteInt(InlineObservation obs, int value)
     DiscretionaryPolicy::NoteInt(obs, value);
 
     // Fail fast for inlinees that are too large to ever inline.
-    // The value of 120 is model-dependent; see notes above.
-    if (!m_IsForceInline && (obs == InlineObservation::CALLEE_IL_CODE_SIZE) && (value >= 120))
+    // The value is model-dependent; see notes above.
+    if (!m_IsForceInline && (obs == InlineObservation::CALLEE_IL_CODE_SIZE) && ((unsigned)value >= s_MaxILSize))
     {
         // Callee too big, not a candidate
         SetNever(InlineObservation::CALLEE_TOO_MUCH_IL);
@@ -2018,6 +2296,13 @@ void ModelPolicy::DetermineProfitability(CORINFO_METHOD_INFO* methodInfo)
     EstimateCodeSize();
     EstimatePerformanceImpact();
 
+    // Prefer estimates from the loaded model, if any.
+    if (s_HasLoadedModel)
+    {
+        m_ModelCodeSizeEstimate      = (int)(SIZE_SCALE * s_SizeModel.Evaluate(this));
+        m_PerCallInstructionEstimate = (int)(SIZE_SCALE * s_PerCallModel.Evaluate(this));
+    }
+
     // Preliminary inline model.
     //
     // If code size is estimated to increase, look at
@@ -2095,7 +2380,7 @@ void ModelPolicy::DetermineProfitability(CORINFO_METHOD_INFO* methodInfo)
         // the value of 0.2 below indicates we'll allow inlines that
         // grow code by as many as 5 bytes to save 1 instruction
         // execution (per call to the root method).
-        double threshold    = 0.20;
+        double threshold    = s_Threshold;
         bool   shouldInline = (benefit > threshold);
 
         JITLOG_THIS(m_RootCompiler,
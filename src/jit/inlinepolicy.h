@@ -194,6 +194,18 @@ public:
     // Policy estimates
     int CodeSizeEstimate() override;
 
+    // Features that models fitted to the inline data can use
+    enum Feature
+    {
+#define INLINE_FEATURE(name, value) FEATURE_##name,
+#include "inlinefeature.def"
+#undef INLINE_FEATURE
+        FEATURE_COUNT
+    };
+
+    static bool FindFeature(const char* name, Feature* feature);
+    double GetFeature(Feature feature) const;
+
 #if defined(DEBUG) || defined(INLINE_DATA)
 
     // Externalize data
@@ -266,8 +278,51 @@ protected:
     bool        m_CalleeHasGCStruct;
 };
 
+// LinearInlineModel is a linear model over the DiscretionaryPolicy
+// features. Each term multiplies a coefficient by either the value
+// of a feature, or by an indicator of the feature having a given
+// value (for features like argument types, which are categories
+// rather than quantities).
+
+class LinearInlineModel
+{
+public:
+    LinearInlineModel() : m_Intercept(0.0), m_TermCount(0)
+    {
+        // empty
+    }
+
+    // Add a term, given as "Feature" or "Feature==value"
+    bool AddTerm(const char* term, double coefficient);
+
+    // Evaluate the model for the observations made by a policy
+    double Evaluate(const DiscretionaryPolicy* policy) const;
+
+private:
+    enum
+    {
+        MAX_TERMS = 128
+    };
+
+    struct Term
+    {
+        DiscretionaryPolicy::Feature m_Feature;
+        bool                         m_IsIndicator;
+        unsigned                     m_Value;
+        double                       m_Coefficient;
+    };
+
+    double   m_Intercept;
+    unsigned m_TermCount;
+    Term     m_Terms[MAX_TERMS];
+};
+
 // ModelPolicy is an experimental policy that uses the results
 // of data modelling to make estimates.
+//
+// By default the models are the ones built into DiscretionaryPolicy.
+// A model fitted offline to inline data from other workloads can be
+// loaded at jit startup from the file named by JitInlineModelFile.
 
 class ModelPolicy : public DiscretionaryPolicy
 {
@@ -275,6 +330,15 @@ public:
     // Construct a ModelPolicy
     ModelPolicy(Compiler* compiler, bool isPrejitRoot);
 
+    // Load the model file, if any. Called during jit startup.
+    static void LoadModel();
+
+    // True if a model was loaded from a file
+    static bool HasLoadedModel()
+    {
+        return s_HasLoadedModel;
+    }
+
     // Policy observations
     void NoteInt(InlineObservation obs, int value) override;
 
@@ -296,6 +360,13 @@ public:
     }
 
 #endif // defined(DEBUG) || defined(INLINE_DATA)
+
+private:
+    static bool              s_HasLoadedModel;
+    static unsigned          s_MaxILSize;
+    static double            s_Threshold;
+    static LinearInlineModel s_SizeModel;
+    static LinearInlineModel s_PerCallModel;
 };
 
 #if defined(DEBUG) || defined(INLINE_DATA)
@@ -211,6 +211,13 @@ INST3( shufpd,      "shufpd"      , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCK
 
 INST3( punpckhdq,   "punpckhdq"   , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKDBL(0x6A))
 
+INST3( unpcklps,    "unpcklps"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKFLT(0x14)) // Interleave low packed singles
+INST3( unpckhps,    "unpckhps"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKFLT(0x15)) // Interleave high packed singles
+INST3( unpcklpd,    "unpcklpd"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKDBL(0x14)) // Interleave low packed doubles
+INST3( unpckhpd,    "unpckhpd"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKDBL(0x15)) // Interleave high packed doubles
+INST3( movmskps,    "movmskps"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKFLT(0x50)) // Move the sign bits of packed singles to an int reg
+INST3( movmskpd,    "movmskpd"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PCKDBL(0x50)) // Move the sign bits of packed doubles to an int reg
+
 // SSE 2 arith
 INST3( addps,  "addps",  0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, PCKFLT(0x58))    // Add packed singles
 INST3( addss,  "addss",  0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, SSEFLT(0x58))    // Add scalar singles
@@ -248,6 +255,7 @@ INST3( andnpd, "andnpd", 0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, PCKDBL(0x55))    /
 INST3( orps,   "orps",   0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, PCKFLT(0x56))    // Or packed singles
 INST3( orpd,   "orpd",   0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, PCKDBL(0x56))    // Or packed doubles
 INST3( haddpd, "haddpd", 0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, PCKDBL(0x7C))    // Horizontal add packed doubles
+INST3( haddps, "haddps", 0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, SSEDBL(0x7C))    // Horizontal add packed singles
 
 // SSE2 conversions
 INST3( cvtpi2ps,  "cvtpi2ps",   0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, PCKFLT(0x2A))   // cvt packed DWORDs to singles
@@ -363,6 +371,17 @@ INST3( pmovsxbw,     "pmovsxbw"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SS
 INST3( pmovsxwd,     "pmovsxwd"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0x23))   // Packed sign extend short to int
 INST3( pmovsxdq,     "pmovsxdq"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0x25))   // Packed sign extend int to long
 INST3( packusdw,     "packusdw"    , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0x2B))   // Pack (narrow) int to unsigned short with saturation
+INST3( pshufb,       "pshufb"      , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0x00))   // Packed shuffle of bytes
+INST3( blendps,      "blendps"     , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x0C))   // Blend packed singles
+INST3( blendpd,      "blendpd"     , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x0D))   // Blend packed doubles
+INST3( pblendw,      "pblendw"     , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x0E))   // Blend packed 16-bit integers
+INST3( aesdec,       "aesdec"      , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xDE))   // Perform one round of an AES decryption flow
+INST3( aesdeclast,   "aesdeclast"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xDF))   // Perform last round of an AES decryption flow
+INST3( aesenc,       "aesenc"      , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xDC))   // Perform one round of an AES encryption flow
+INST3( aesenclast,   "aesenclast"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xDD))   // Perform last round of an AES encryption flow
+INST3( aesimc,       "aesimc"      , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xDB))   // Perform the AES InvMixColumn transformation
+INST3( aeskeygenassist, "aeskeygenassist", 0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, SSE3A(0xDF)) // AES round key generation assist
+INST3( pclmulqdq,    "pclmulqdq"   , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x44))   // Carry-less multiplication of quadwords
 
 INST3(LAST_SSE4_INSTRUCTION, "LAST_SSE4_INSTRUCTION",  0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, BAD_CODE)
 
@@ -381,6 +400,18 @@ INST3( vinserti128,  "inserti128"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SS
 INST3( vzeroupper,   "zeroupper"   , 0, IUM_WR, 0, 0, 0xC577F8,     BAD_CODE, BAD_CODE)      // Zero upper 128-bits of all YMM regs (includes 2-byte fixed VEX prefix)
 INST3( vperm2i128,   "perm2i128"   , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x46))   // Permute 128-bit halves of input register
 INST3( vpermq,       "permq"       , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x00))   // Permute 64-bit of input register
+INST3( vpblendd,     "pblendd"     , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE3A(0x02))   // Blend packed 32-bit integers
+INST3( vfmadd213ps,  "fmadd213ps"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xA8))   // Fused multiply-add of packed singles (reg1 = reg2 * reg1 + reg3)
+INST3( vfmadd213pd,  "fmadd213pd"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xA8))   // Fused multiply-add of packed doubles (reg1 = reg2 * reg1 + reg3)
+INST3( vfmadd231ps,  "fmadd231ps"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xB8))   // Fused multiply-add of packed singles (reg1 = reg2 * reg3 + reg1)
+INST3( vfmadd231pd,  "fmadd231pd"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xB8))   // Fused multiply-add of packed doubles (reg1 = reg2 * reg3 + reg1)
+INST3( vfmsub213ps,  "fmsub213ps"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xAA))   // Fused multiply-subtract of packed singles (reg1 = reg2 * reg1 - reg3)
+INST3( vfmsub213pd,  "fmsub213pd"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xAA))   // Fused multiply-subtract of packed doubles (reg1 = reg2 * reg1 - reg3)
+INST3( vfmsub231ps,  "fmsub231ps"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xBA))   // Fused multiply-subtract of packed singles (reg1 = reg2 * reg3 - reg1)
+INST3( vfmsub231pd,  "fmsub231pd"  , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSE38(0xBA))   // Fused multiply-subtract of packed doubles (reg1 = reg2 * reg3 - reg1)
+// BMI2 instructions are VEX-encoded general purpose register instructions
+INST3( pdep,         "pdep"        , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PACK4(0xF2, 0x0F, 0x38, 0xF5))   // Parallel bits deposit
+INST3( pext,         "pext"        , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PACK4(0xF3, 0x0F, 0x38, 0xF5))   // Parallel bits extract
 INST3(LAST_AVX_INSTRUCTION, "LAST_AVX_INSTRUCTION",  0, IUM_WR, 0, 0, BAD_CODE, BAD_CODE, BAD_CODE)
 
 // Scalar instructions in SSE4.2
@@ -389,6 +420,9 @@ INST3( crc32,        "crc32"       , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, PA
 // LZCNT
 INST3( lzcnt,        "lzcnt"       , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSEFLT(0xBD))
 
+// TZCNT (BMI1)
+INST3( tzcnt,        "tzcnt"       , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSEFLT(0xBC))
+
 // POPCNT
 INST3( popcnt,       "popcnt"      , 0, IUM_WR, 0, 0, BAD_CODE,     BAD_CODE, SSEFLT(0xB8))
 #endif // !LEGACY_BACKEND
@@ -93,6 +93,7 @@ CONFIG_INTEGER(JitNoMemoryBarriers, W("JitNoMemoryBarriers"), 0) // If 1, don't
 CONFIG_INTEGER(JitNoRegLoc, W("JitNoRegLoc"), 0)
 CONFIG_INTEGER(JitNoStructPromotion, W("JitNoStructPromotion"), 0) // Disables struct promotion in Jit32
 CONFIG_INTEGER(JitNoUnroll, W("JitNoUnroll"), 0)
+CONFIG_INTEGER(JitNoVectorize, W("JitNoVectorize"), 0) // Disables vectorization of loops over arrays
 CONFIG_INTEGER(JitOrder, W("JitOrder"), 0)
 CONFIG_INTEGER(JitReportFastTailCallDecisions, W("JitReportFastTailCallDecisions"), 0)
 CONFIG_INTEGER(JitPInvokeCheckEnabled, W("JITPInvokeCheckEnabled"), 0)
@@ -252,6 +253,19 @@ CONFIG_INTEGER(JitEnableNoWayAssert, W("JitEnableNoWayAssert"), 1)
 #endif
 CONFIG_INTEGER(JitMinOptsTrackGCrefs, W("JitMinOptsTrackGCrefs"), JitMinOptsTrackGCrefs_Default) // Track GC roots
 
+// Allocate objects that don't escape the method on the stack instead of the GC heap.
+CONFIG_INTEGER(JitObjectStackAllocation, W("JitObjectStackAllocation"), 0)
+
+// Number of loop back-edges a single invocation of tier0 code takes before the method is
+// reported to the runtime for promotion to tier1. 0 disables counting back-edges.
+CONFIG_INTEGER(TC_LoopBackEdgeThreshold, W("TC_LoopBackEdgeThreshold"), 10000)
+
+// Record the class of 'this' at virtual call sites in tier0 code, and guard direct calls to the
+// method the most likely class uses in tier1 code. Disabled by default.
+CONFIG_INTEGER(JitGuardedDevirtualization, W("JitGuardedDevirtualization"), 0)
+// Minimum percentage of tier0 calls made on the most likely class for tier1 code to guard a direct call.
+CONFIG_INTEGER(JitGuardedDevirtualizationLikelihood, W("JitGuardedDevirtualizationLikelihood"), 50)
+
 // The following should be wrapped inside "#if MEASURE_MEM_ALLOC / #endif", but
 // some files include this one without bringing in the definitions from "jit.h"
 // so we don't always know what the "true" value of that flag should be. For now
@@ -303,6 +317,7 @@ CONFIG_STRING(JitFuncInfoFile, W("JitFuncInfoLogFile")) // If set, gather JIT fu
 CONFIG_STRING(JitTimeLogCsv, W("JitTimeLogCsv")) // If set, gather JIT throughput data and write to a CSV file. This
                                                  // mode must be used in internal retail builds.
 CONFIG_STRING(TailCallOpt, W("TailCallOpt"))
+CONFIG_STRING(JitStdOutFile, W("JitStdOutFile")) // If set, write jit stdout output (eg JitLsraStats) to this file.
 
 CONFIG_INTEGER(JitMeasureNowayAssert, W("JitMeasureNowayAssert"), 0) // Set to 1 to measure noway_assert usage. Only
                                                                      // valid if MEASURE_NOWAY is defined.
@@ -324,9 +339,12 @@ CONFIG_INTEGER(JitInlinePolicyRandom, W("JitInlinePolicyRandom"), 0) // nozero e
 CONFIG_INTEGER(JitInlinePolicyReplay, W("JitInlinePolicyReplay"), 0)
 CONFIG_STRING(JitNoInlineRange, W("JitNoInlineRange"))
 CONFIG_STRING(JitInlineReplayFile, W("JitInlineReplayFile"))
+CONFIG_STRING(JitInlineDumpXmlFile, W("JitInlineDumpXmlFile")) // If set, write inline xml to this file, not stderr
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 
 CONFIG_INTEGER(JitInlinePolicyModel, W("JitInlinePolicyModel"), 0)
+CONFIG_STRING(JitInlineModelFile, W("JitInlineModelFile")) // If set, ModelPolicy uses the model fitted offline and
+                                                           // saved to this file (see fitinlinemodel.py)
 
 CONFIG_INTEGER(JitEECallTimingInfo, W("JitEECallTimingInfo"), 0)
 
@@ -98,8 +98,8 @@ GenTreePtr LC_Ident::ToGenTree(Compiler* comp)
 //      comp    Compiler instance to allocate trees
 //
 // Return Values:
-//      Returns the gen tree representation for either a constant or a variable or an arrLen operation
-//      defined by the "type" member
+//      Returns the gen tree representation for either a constant or a variable or an arrLen operation,
+//      plus a constant if the "type" member is IdentPlusConst
 //
 GenTreePtr LC_Expr::ToGenTree(Compiler* comp)
 {
@@ -108,6 +108,8 @@ GenTreePtr LC_Expr::ToGenTree(Compiler* comp)
     {
         case Ident:
             return ident.ToGenTree(comp);
+        case IdentPlusConst:
+            return comp->gtNewOperNode(GT_ADD, TYP_INT, ident.ToGenTree(comp), comp->gtNewIconNode(constant));
         default:
             assert(!"Could not convert LC_Expr to GenTree");
             unreached();
@@ -89,10 +89,14 @@ XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 
 class Compiler;
 
+// The largest constant, as in a[i + k], that may be added to an index that loop cloning optimizes.
+#define MAX_ARR_INDEX_OFFSET 0xFFFF
+
 /**
  *
  *  Represents an array access and associated bounds checks.
- *  Array access is required have the array and indices in local variables.
+ *  Array access is required have the array and indices in local variables, although
+ *  an index may have a constant added to it.
  *  This struct is constructed using a GT_INDEX node that is broken into
  *  its sub trees.
  *
@@ -101,11 +105,13 @@ struct ArrIndex
 {
     unsigned                      arrLcl;   // The array base local num
     JitExpandArrayStack<unsigned> indLcls;  // The indices local nums
+    JitExpandArrayStack<int>      indOffs;  // The constant added to the index local along each dimension.
     JitExpandArrayStack<GenTree*> bndsChks; // The bounds checks nodes along each dimension.
     unsigned                      rank;     // Rank of the array
     BasicBlock*                   useBlock; // Block where the [] occurs
 
-    ArrIndex(CompAllocator* alloc) : arrLcl(BAD_VAR_NUM), indLcls(alloc), bndsChks(alloc), rank(0), useBlock(nullptr)
+    ArrIndex(CompAllocator* alloc)
+        : arrLcl(BAD_VAR_NUM), indLcls(alloc), indOffs(alloc), bndsChks(alloc), rank(0), useBlock(nullptr)
     {
     }
 
@@ -115,7 +121,14 @@ struct ArrIndex
         printf("V%02d", arrLcl);
         for (unsigned i = 0; i < ((dim == -1) ? rank : dim); ++i)
         {
-            printf("[V%02d]", indLcls.GetRef(i));
+            if (indOffs.GetRef(i) != 0)
+            {
+                printf("[V%02d+%d]", indLcls.GetRef(i), indOffs.GetRef(i));
+            }
+            else
+            {
+                printf("[V%02d]", indLcls.GetRef(i));
+            }
         }
     }
 #endif
@@ -195,6 +208,7 @@ struct LcMdArrayOptInfo : public LcOptInfo
             for (unsigned i = 0; i < dim; ++i)
             {
                 index->indLcls.Push(arrElem->gtArrInds[i]->gtLclVarCommon.gtLclNum);
+                index->indOffs.Push(0);
             }
             index->arrLcl = arrElem->gtArrObj->gtLclVarCommon.gtLclNum;
         }
@@ -293,7 +307,8 @@ struct LC_Array
         // Check for the indices.
         for (int i = 0; i < rank1; ++i)
         {
-            if (arrIndex->indLcls[i] != that.arrIndex->indLcls[i])
+            if ((arrIndex->indLcls[i] != that.arrIndex->indLcls[i]) ||
+                (arrIndex->indOffs[i] != that.arrIndex->indOffs[i]))
             {
                 return false;
             }
@@ -392,7 +407,7 @@ struct LC_Ident
 
 /**
  *
- *  Symbolic representation of an expr that involves an "LC_Ident"
+ *  Symbolic representation of an expr that involves an "LC_Ident", optionally plus a constant
  */
 struct LC_Expr
 {
@@ -400,9 +415,11 @@ struct LC_Expr
     {
         Invalid,
         Ident,
+        IdentPlusConst,
     };
 
     LC_Ident ident;
+    int      constant; // The constant added to "ident" if the type is "IdentPlusConst"
     ExprType type;
 
     // Equality operator
@@ -417,7 +434,12 @@ struct LC_Expr
         }
 
         // Check if the ident match.
-        return (ident == that.ident);
+        if (!(ident == that.ident))
+        {
+            return false;
+        }
+
+        return (type != IdentPlusConst) || (constant == that.constant);
     }
 
 #ifdef DEBUG
@@ -427,13 +449,22 @@ struct LC_Expr
         {
             ident.Print();
         }
+        else if (type == IdentPlusConst)
+        {
+            ident.Print();
+            printf(" %c %d", (constant < 0) ? '-' : '+', abs(constant));
+        }
     }
 #endif
 
     LC_Expr() : type(Invalid)
     {
     }
-    explicit LC_Expr(const LC_Ident& ident) : ident(ident), type(Ident)
+    explicit LC_Expr(const LC_Ident& ident) : ident(ident), constant(0), type(Ident)
+    {
+    }
+    LC_Expr(const LC_Ident& ident, int constant)
+        : ident(ident), constant(constant), type((constant == 0) ? Ident : IdentPlusConst)
     {
     }
 
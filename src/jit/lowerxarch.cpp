@@ -2301,14 +2301,23 @@ void Lowering::ContainCheckSIMD(GenTreeSIMD* simdNode)
 void Lowering::ContainCheckHWIntrinsic(GenTreeHWIntrinsic* node)
 {
     NamedIntrinsic intrinsicID = node->gtHWIntrinsicId;
-    GenTree*       op1         = node->gtOp.gtOp1;
-    GenTree*       op2         = node->gtOp.gtOp2;
 
-    switch (node->gtHWIntrinsicId)
+    assert((intrinsicID > NI_HW_INTRINSIC_START) && (intrinsicID < NI_HW_INTRINSIC_END));
+
+    // An 8-bit control value is encoded as an immediate when it is a constant.
+    GenTree* imm = comp->immOperandOfHWIntrinsic(node);
+    if (imm != nullptr)
     {
-        default:
-            assert((intrinsicID > NI_HW_INTRINSIC_START) && (intrinsicID < NI_HW_INTRINSIC_END));
-            break;
+        if (imm->IsCnsIntOrI())
+        {
+            MakeSrcContained(node, imm);
+        }
+        else
+        {
+            // Codegen dispatches on the value through a jump table whose entries are offsets
+            // from the first block, so that block needs a label.
+            comp->fgFirstBB->bbFlags |= BBF_JMP_TARGET;
+        }
     }
 }
 #endif // FEATURE_HW_INTRINSICS
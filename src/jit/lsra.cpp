@@ -188,6 +188,12 @@ unsigned LinearScan::getWeight(RefPosition* refPos)
                 weight -= BB_UNITY_WEIGHT;
             }
         }
+        else if (treeNode->IsRematerializableConst())
+        {
+            // A spilled constant is recreated at its use rather than stored and
+            // reloaded, so it is the cheapest thing to spill.
+            weight = blockInfo[refPos->bbNum].weight;
+        }
         else
         {
             // Non-candidate local ref or non-lcl tree node.
@@ -1397,6 +1403,9 @@ void LinearScan::setBlockSequence()
         blockInfo[block->bbNum].copyRegCount       = 0;
         blockInfo[block->bbNum].resolutionMovCount = 0;
         blockInfo[block->bbNum].splitEdgeCount     = 0;
+        blockInfo[block->bbNum].reloadCount        = 0;
+        blockInfo[block->bbNum].rematCount         = 0;
+        blockInfo[block->bbNum].boundarySpillCount = 0;
 #endif // TRACK_LSRA_STATS
 
         if (block->GetUniquePred(compiler) == nullptr)
@@ -6521,7 +6530,24 @@ void LinearScan::spillInterval(Interval* interval, RefPosition* fromRefPosition,
     assert(fromRefPosition->getInterval() == interval && toRefPosition->getInterval() == interval);
     assert(fromRefPosition->nextRefPosition == toRefPosition);
 
-    if (!fromRefPosition->lastUse)
+    // If the value was last used in a hotter block than the current one, don't store it
+    // right after that use. Instead, leave it in its register to the end of that block
+    // and let resolution store it on the edges into this block, where it is marked as
+    // living on the stack below. This only applies to uses; a def has to be stored where
+    // the value is produced.
+    bool spillAtBlockBoundary = false;
+    if (interval->isLocalVar && (fromRefPosition->refType == RefTypeUse) && !fromRefPosition->lastUse &&
+        !fromRefPosition->copyReg && (fromRefPosition->nodeLocation < curBBStartLocation) &&
+        (blockInfo[fromRefPosition->bbNum].weight > blockInfo[curBBNum].weight))
+    {
+        spillAtBlockBoundary = true;
+    }
+
+    if (spillAtBlockBoundary)
+    {
+        INTRACK_STATS(updateLsraStat(LSRA_STAT_BOUNDARY_SPILL, curBBNum));
+    }
+    else if (!fromRefPosition->lastUse)
     {
         // If not allocated a register, Lcl var def/use ref positions even if reg optional
         // should be marked as spillAfter.
@@ -6543,7 +6569,16 @@ void LinearScan::spillInterval(Interval* interval, RefPosition* fromRefPosition,
     }
 #endif // DEBUG
 
-    INTRACK_STATS(updateLsraStat(LSRA_STAT_SPILL, fromRefPosition->bbNum));
+#if TRACK_LSRA_STATS
+    if ((fromRefPosition->treeNode != nullptr) && fromRefPosition->treeNode->IsRematerializableConst())
+    {
+        updateLsraStat(LSRA_STAT_REMAT, fromRefPosition->bbNum);
+    }
+    else if (!spillAtBlockBoundary)
+    {
+        updateLsraStat(LSRA_STAT_SPILL, fromRefPosition->bbNum);
+    }
+#endif // TRACK_LSRA_STATS
 
     interval->isActive = false;
     setIntervalAsSpilled(interval);
@@ -7887,6 +7922,7 @@ void LinearScan::allocateRegisters()
             if (assignedRegister == REG_NA && RefTypeIsUse(refType))
             {
                 currentRefPosition->reload = true;
+                INTRACK_STATS(updateLsraStat(LSRA_STAT_RELOAD, currentRefPosition->bbNum));
                 INDEBUG(dumpLsraAllocationEvent(LSRA_EVENT_RELOAD, currentInterval, assignedRegister));
             }
         }
@@ -8045,6 +8081,7 @@ void LinearScan::allocateRegisters()
                     else
                     {
                         currentRefPosition->reload = true;
+                        INTRACK_STATS(updateLsraStat(LSRA_STAT_RELOAD, currentRefPosition->bbNum));
                     }
                 }
                 INDEBUG(dumpLsraAllocationEvent(LSRA_EVENT_KEPT_ALLOCATION, currentInterval, assignedRegister));
@@ -8513,6 +8550,7 @@ void LinearScan::resolveLocalRef(BasicBlock* block, GenTreePtr treeNode, RefPosi
         {
             assert(inVarToRegMaps[curBBNum][varDsc->lvVarIndex] == REG_STK);
             currentRefPosition->reload = true;
+            INTRACK_STATS(updateLsraStat(LSRA_STAT_RELOAD, currentRefPosition->bbNum));
         }
     }
 
@@ -11048,6 +11086,18 @@ void LinearScan::updateLsraStat(LsraStat stat, unsigned bbNum)
             ++(blockInfo[bbNum].splitEdgeCount);
             break;
 
+        case LSRA_STAT_RELOAD:
+            ++(blockInfo[bbNum].reloadCount);
+            break;
+
+        case LSRA_STAT_REMAT:
+            ++(blockInfo[bbNum].rematCount);
+            break;
+
+        case LSRA_STAT_BOUNDARY_SPILL:
+            ++(blockInfo[bbNum].boundarySpillCount);
+            break;
+
         default:
             break;
     }
@@ -11065,9 +11115,13 @@ void LinearScan::dumpLsraStats(FILE* file)
     unsigned sumCopyRegCount       = 0;
     unsigned sumResolutionMovCount = 0;
     unsigned sumSplitEdgeCount     = 0;
+    unsigned sumReloadCount        = 0;
+    unsigned sumRematCount         = 0;
+    unsigned sumBoundarySpillCount = 0;
     UINT64   wtdSpillCount         = 0;
     UINT64   wtdCopyRegCount       = 0;
     UINT64   wtdResolutionMovCount = 0;
+    UINT64   wtdReloadCount        = 0;
 
     fprintf(file, "----------\n");
     fprintf(file, "LSRA Stats");
@@ -11099,22 +11153,32 @@ void LinearScan::dumpLsraStats(FILE* file)
         unsigned copyRegCount       = blockInfo[block->bbNum].copyRegCount;
         unsigned resolutionMovCount = blockInfo[block->bbNum].resolutionMovCount;
         unsigned splitEdgeCount     = blockInfo[block->bbNum].splitEdgeCount;
+        unsigned reloadCount        = blockInfo[block->bbNum].reloadCount;
+        unsigned rematCount         = blockInfo[block->bbNum].rematCount;
+        unsigned boundarySpillCount = blockInfo[block->bbNum].boundarySpillCount;
 
-        if (spillCount != 0 || copyRegCount != 0 || resolutionMovCount != 0 || splitEdgeCount != 0)
+        if (spillCount != 0 || copyRegCount != 0 || resolutionMovCount != 0 || splitEdgeCount != 0 ||
+            reloadCount != 0 || rematCount != 0 || boundarySpillCount != 0)
         {
             fprintf(file, "BB%02u [%8d]: ", block->bbNum, block->bbWeight);
-            fprintf(file, "SpillCount = %d, ResolutionMovs = %d, SplitEdges = %d, CopyReg = %d\n", spillCount,
+            fprintf(file, "SpillCount = %d, ResolutionMovs = %d, SplitEdges = %d, CopyReg = %d", spillCount,
                     resolutionMovCount, splitEdgeCount, copyRegCount);
+            fprintf(file, ", Reloads = %d, Remats = %d, BoundarySpills = %d\n", reloadCount, rematCount,
+                    boundarySpillCount);
         }
 
         sumSpillCount += spillCount;
         sumCopyRegCount += copyRegCount;
         sumResolutionMovCount += resolutionMovCount;
         sumSplitEdgeCount += splitEdgeCount;
+        sumReloadCount += reloadCount;
+        sumRematCount += rematCount;
+        sumBoundarySpillCount += boundarySpillCount;
 
         wtdSpillCount += (UINT64)spillCount * block->bbWeight;
         wtdCopyRegCount += (UINT64)copyRegCount * block->bbWeight;
         wtdResolutionMovCount += (UINT64)resolutionMovCount * block->bbWeight;
+        wtdReloadCount += (UINT64)reloadCount * block->bbWeight;
     }
 
     fprintf(file, "Total Tracked Vars:  %d\n", compiler->lvaTrackedCount);
@@ -11125,6 +11189,9 @@ void LinearScan::dumpLsraStats(FILE* file)
     fprintf(file, "Total CopyReg Count: %d   Weighted: %I64u\n", sumCopyRegCount, wtdCopyRegCount);
     fprintf(file, "Total ResolutionMov Count: %d    Weighted: %I64u\n", sumResolutionMovCount, wtdResolutionMovCount);
     fprintf(file, "Total number of split edges: %d\n", sumSplitEdgeCount);
+    fprintf(file, "Total Reload Count: %d    Weighted: %I64u\n", sumReloadCount, wtdReloadCount);
+    fprintf(file, "Total Remat Count: %d\n", sumRematCount);
+    fprintf(file, "Total Block Boundary Spill Count: %d\n", sumBoundarySpillCount);
 
     // compute total number of spill temps created
     unsigned numSpillTemps = 0;
@@ -326,6 +326,17 @@ struct LsraBlockInfo
 
     // Number of critical edges from this block that are split.
     unsigned splitEdgeCount;
+
+    // Number of local var or tree temp reloads in this basic block.
+    unsigned reloadCount;
+
+    // Number of constants spilled in this basic block that are rematerialized
+    // at their use instead of being stored and reloaded.
+    unsigned rematCount;
+
+    // Number of local vars live into this basic block that were spilled on its
+    // incoming edges rather than after their last use in a hotter block.
+    unsigned boundarySpillCount;
 #endif // TRACK_LSRA_STATS
 };
 
@@ -1322,7 +1333,8 @@ private:
 
 #if TRACK_LSRA_STATS
     enum LsraStat{
-        LSRA_STAT_SPILL, LSRA_STAT_COPY_REG, LSRA_STAT_RESOLUTION_MOV, LSRA_STAT_SPLIT_EDGE,
+        LSRA_STAT_SPILL,  LSRA_STAT_COPY_REG, LSRA_STAT_RESOLUTION_MOV, LSRA_STAT_SPLIT_EDGE,
+        LSRA_STAT_RELOAD, LSRA_STAT_REMAT,    LSRA_STAT_BOUNDARY_SPILL,
     };
 
     unsigned regCandidateVarCount;
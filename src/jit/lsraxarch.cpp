@@ -2498,14 +2498,94 @@ void LinearScan::TreeNodeInfoInitHWIntrinsic(GenTreeHWIntrinsic* intrinsicTree,
 {
     NamedIntrinsic intrinsicID = intrinsicTree->gtHWIntrinsicId;
     InstructionSet isa         = compiler->isaOfHWIntrinsic(intrinsicID);
+    GenTree*       op1         = intrinsicTree->gtOp.gtOp1;
+    GenTree*       op2         = intrinsicTree->gtGetOp2IfPresent();
     if (isa == InstructionSet_AVX || isa == InstructionSet_AVX2)
     {
         SetContainsAVXFlags(true, 32);
     }
-    info->srcCount += GetOperandInfo(intrinsicTree->gtOp.gtOp1);
-    if (intrinsicTree->gtGetOp2IfPresent() != nullptr)
+    else if (intrinsicTree->isSIMD())
     {
-        info->srcCount += GetOperandInfo(intrinsicTree->gtOp.gtOp2);
+        SetContainsAVXFlags(true, intrinsicTree->gtSIMDSize);
+    }
+
+    if (op1->OperIsList())
+    {
+        // Intrinsics with three operands carry them in a GT_LIST. The last one may be a contained
+        // immediate. Unless this is an FMA intrinsic, whose code generation picks the form that
+        // overwrites whichever source lives in the target register, the first source is copied
+        // to the target when VEX encoding is not available, so the other sources must remain
+        // live until the operation is complete.
+        bool isFMA     = (isa == InstructionSet_FMA);
+        bool isRMWForm = !isFMA && !compiler->canUseVexEncoding();
+        bool first     = true;
+        for (GenTreeArgList* list = op1->AsArgList(); list != nullptr; list = list->Rest())
+        {
+            GenTree* listItem = list->Current();
+            if (listItem->isContained())
+            {
+                continue;
+            }
+
+            LocationInfoListNode* itemInfo = getLocationInfo(listItem);
+            if (first)
+            {
+                itemInfo->info.isTgtPref = !isFMA;
+            }
+            else if (isRMWForm)
+            {
+                itemInfo->info.isDelayFree = true;
+                info->hasDelayFreeSrc      = true;
+            }
+            useList.Append(itemInfo);
+            info->srcCount++;
+            first = false;
+        }
+    }
+    else
+    {
+        info->srcCount += GetOperandInfo(op1);
+        if (op2 != nullptr)
+        {
+            info->srcCount += GetOperandInfo(op2);
+        }
+    }
+
+    // Some comparisons are generated with their operands reversed. Without VEX encoding op2
+    // is then copied to the target register first, so op1 must remain live until the operation
+    // is complete.
+    bool reverseOperands = false;
+    switch (intrinsicID)
+    {
+        case NI_SSE_CompareGreaterThan:
+        case NI_SSE_CompareGreaterThanOrEqual:
+            reverseOperands = true;
+            break;
+
+        case NI_SSE2_CompareGreaterThan:
+            reverseOperands = (intrinsicTree->gtSIMDBaseType == TYP_DOUBLE);
+            break;
+
+        case NI_SSE2_CompareLessThan:
+            reverseOperands = (intrinsicTree->gtSIMDBaseType != TYP_DOUBLE);
+            break;
+
+        default:
+            break;
+    }
+
+    if (reverseOperands && !compiler->canUseVexEncoding())
+    {
+        useList.GetTreeNodeInfo(op1).isDelayFree = true;
+        info->hasDelayFreeSrc                    = true;
+    }
+
+    // A control value that is not a constant is dispatched on through a jump table, which takes
+    // two registers to compute the address of the case to jump to.
+    GenTree* imm = compiler->immOperandOfHWIntrinsic(intrinsicTree);
+    if ((imm != nullptr) && !imm->isContained())
+    {
+        info->internalIntCount = 2;
     }
 
 #ifdef _TARGET_X86_
@@ -36,7 +36,10 @@ void ObjectAllocator::DoPhase()
         DoAnalysis();
     }
 
-    MorphAllocObjNodes();
+    if (MorphAllocObjNodes())
+    {
+        RewriteUses();
+    }
 }
 
 //------------------------------------------------------------------------
@@ -46,22 +49,340 @@ void ObjectAllocator::DoPhase()
 // Assumptions:
 //    Must be run after the dominators have been computed (we need this
 //    information to detect loops).
+//
+// Notes:
+//    The analysis is intraprocedural and flow-insensitive. An object
+//    reference local escapes if its value may be stored to the heap, passed
+//    to a call, returned, or if its address is taken. Assigning a local to
+//    another local adds an edge to the connection graph and the escaping
+//    property is then propagated along those edges.
 void ObjectAllocator::DoAnalysis()
 {
     assert(m_IsObjectStackAllocationEnabled);
     assert(comp->fgDomsComputed);
-    // TODO-ObjectStackAllocation
-    NYI("DoAnalysis");
+    assert(!m_AnalysisDone);
+
+    m_EscapingPointers              = BitVecOps::MakeEmpty(&m_bitVecTraits);
+    m_PossiblyStackPointingPointers = BitVecOps::MakeEmpty(&m_bitVecTraits);
+
+    const unsigned int lclCount = BitVecTraits::GetSize(&m_bitVecTraits);
+
+    if (lclCount > 0)
+    {
+        m_ConnGraphAdjacencyMatrix = new (comp, CMK_ObjectAllocator) BitVec[lclCount];
+        for (unsigned int lclNum = 0; lclNum < lclCount; ++lclNum)
+        {
+            m_ConnGraphAdjacencyMatrix[lclNum] = BitVecOps::UninitVal();
+        }
+
+        MarkEscapingVarsAndBuildConnGraph();
+        ComputeEscapingNodes();
+    }
+
+    m_AnalysisDone = true;
+}
+
+//------------------------------------------------------------------------
+// AddConnGraphEdge: Record that the value of targetLclNum may be copied
+//                   into sourceLclNum.
+void ObjectAllocator::AddConnGraphEdge(unsigned int sourceLclNum, unsigned int targetLclNum)
+{
+    BitVec& row = m_ConnGraphAdjacencyMatrix[sourceLclNum];
+    if (BitVecOps::MayBeUninit(row))
+    {
+        row = BitVecOps::MakeEmpty(&m_bitVecTraits);
+    }
+    BitVecOps::AddElemD(&m_bitVecTraits, row, targetLclNum);
+}
+
+//------------------------------------------------------------------------
+// MarkEscapingVarsAndBuildConnGraph: Walk the trees of the method, mark
+//                                    the object reference locals that
+//                                    escape directly and build the
+//                                    connection graph.
+void ObjectAllocator::MarkEscapingVarsAndBuildConnGraph()
+{
+    class BuildConnGraphVisitor final : public GenTreeVisitor<BuildConnGraphVisitor>
+    {
+        ObjectAllocator* m_allocator;
+
+    public:
+        enum
+        {
+            DoPreOrder    = true,
+            DoLclVarsOnly = true,
+            ComputeStack  = true,
+        };
+
+        BuildConnGraphVisitor(ObjectAllocator* allocator)
+            : GenTreeVisitor<BuildConnGraphVisitor>(allocator->comp), m_allocator(allocator)
+        {
+        }
+
+        Compiler::fgWalkResult PreOrderVisit(GenTree** use, GenTree* user)
+        {
+            GenTree* tree = *use;
+            assert(tree != nullptr);
+            assert(tree->IsLocal() || tree->OperIsLocalAddr());
+
+            const unsigned int lclNum = tree->AsLclVarCommon()->gtLclNum;
+
+            if (!m_allocator->IsTrackedLclVar(lclNum) || m_allocator->IsLclVarEscaping(lclNum))
+            {
+                return Compiler::fgWalkResult::WALK_CONTINUE;
+            }
+
+            // Partial accesses and address-of are not modelled by the connection graph.
+            if ((tree->OperGet() != GT_LCL_VAR) || m_allocator->CanLclVarEscapeViaParentStack(&m_ancestors, lclNum))
+            {
+                JITDUMP("V%02u escapes via [%06u]\n", lclNum, m_compiler->dspTreeID(tree));
+                m_allocator->MarkLclVarAsEscaping(lclNum);
+            }
+
+            return Compiler::fgWalkResult::WALK_CONTINUE;
+        }
+    };
+
+    for (unsigned int lclNum = 0; lclNum < BitVecTraits::GetSize(&m_bitVecTraits); ++lclNum)
+    {
+        if (!IsTrackedLclVar(lclNum))
+        {
+            continue;
+        }
+
+        LclVarDsc* varDsc = comp->lvaTable + lclNum;
+
+        // Parameters can't be retyped to point to the stack, address exposed locals
+        // may be written through an alias, and fields of promoted structs may be
+        // copied along with their parent struct.
+        if (varDsc->lvIsParam || varDsc->lvAddrExposed || varDsc->lvPinned || varDsc->lvIsStructField)
+        {
+            MarkLclVarAsEscaping(lclNum);
+        }
+    }
+
+    BasicBlock* block;
+
+    foreach_block(comp, block)
+    {
+        for (GenTreeStmt* stmt = block->firstStmt(); stmt; stmt = stmt->gtNextStmt)
+        {
+            BuildConnGraphVisitor buildConnGraphVisitor(this);
+            buildConnGraphVisitor.WalkTree(&stmt->gtStmtExpr, nullptr);
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+// CanLclVarEscapeViaParentStack: Check whether the use of a local variable
+//                                at the top of the parent stack may make
+//                                it escape. Copies to other object
+//                                reference locals are not escapes; they
+//                                are recorded in the connection graph.
+//
+// Arguments:
+//    parentStack - parent stack of the GT_LCL_VAR node being checked
+//    lclNum      - local variable number
+//
+// Return Value:
+//    true if the local can escape via the parent stack; false otherwise
+//
+// Notes:
+//    The walk up the parent stack is conservative: any parent that is not
+//    explicitly understood makes the local escape.
+bool ObjectAllocator::CanLclVarEscapeViaParentStack(ArrayStack<GenTree*>* parentStack, unsigned int lclNum)
+{
+    assert(parentStack != nullptr);
+
+    // Set once the value flowing up the stack is an interior pointer into the
+    // object rather than the object reference itself.
+    bool isDerivedPointer = false;
+
+    for (int parentIndex = 1; parentIndex < parentStack->Height(); parentIndex++)
+    {
+        GenTree* tree   = parentStack->Index(parentIndex - 1);
+        GenTree* parent = parentStack->Index(parentIndex);
+
+        switch (parent->OperGet())
+        {
+            case GT_ASG:
+            {
+                GenTree* op1 = parent->gtGetOp1();
+
+                if (op1 == tree)
+                {
+                    // The local is being defined.
+                    return false;
+                }
+
+                assert(parent->gtGetOp2() == tree);
+
+                if (isDerivedPointer || (op1->OperGet() != GT_LCL_VAR) ||
+                    !IsTrackedLclVar(op1->AsLclVarCommon()->gtLclNum))
+                {
+                    return true;
+                }
+
+                AddConnGraphEdge(op1->AsLclVarCommon()->gtLclNum, lclNum);
+                return false;
+            }
+
+            case GT_EQ:
+            case GT_NE:
+            case GT_NULLCHECK:
+            case GT_ARR_LENGTH:
+                return false;
+
+            case GT_COMMA:
+                if (parent->gtGetOp1() == tree)
+                {
+                    // Left child of GT_COMMA, the value is discarded.
+                    return false;
+                }
+                break;
+
+            case GT_COLON:
+            case GT_QMARK:
+                break;
+
+            case GT_ADD:
+                isDerivedPointer = true;
+                break;
+
+            case GT_IND:
+            case GT_OBJ:
+            case GT_BLK:
+                // The object is only dereferenced, unless the address of the
+                // location is taken again.
+                if ((parentIndex + 1 < parentStack->Height()) &&
+                    (parentStack->Index(parentIndex + 1)->OperGet() == GT_ADDR))
+                {
+                    parentIndex++;
+                    isDerivedPointer = true;
+                    break;
+                }
+                return false;
+
+            default:
+                return true;
+        }
+    }
+
+    // The value is not used.
+    return false;
+}
+
+//------------------------------------------------------------------------
+// ComputeEscapingNodes: Propagate the escaping property backwards along
+//                       the connection graph edges: if a local escapes
+//                       then so does every local copied into it.
+void ObjectAllocator::ComputeEscapingNodes()
+{
+    const unsigned int lclCount = BitVecTraits::GetSize(&m_bitVecTraits);
+    bool               changed  = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        for (unsigned int lclNum = 0; lclNum < lclCount; ++lclNum)
+        {
+            BitVec& row = m_ConnGraphAdjacencyMatrix[lclNum];
+
+            if (BitVecOps::MayBeUninit(row) || !IsLclVarEscaping(lclNum))
+            {
+                continue;
+            }
+
+            if (!BitVecOps::IsSubset(&m_bitVecTraits, row, m_EscapingPointers))
+            {
+                BitVecOps::UnionD(&m_bitVecTraits, m_EscapingPointers, row);
+                changed = true;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+// ComputeStackPointingNodes: Propagate the possibly-stack-pointing property
+//                            forwards along the connection graph edges: if
+//                            a local may point to a stack allocated object
+//                            then so does every local it is copied into.
+void ObjectAllocator::ComputeStackPointingNodes()
+{
+    const unsigned int lclCount = BitVecTraits::GetSize(&m_bitVecTraits);
+    bool               changed  = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        for (unsigned int lclNum = 0; lclNum < lclCount; ++lclNum)
+        {
+            BitVec& row = m_ConnGraphAdjacencyMatrix[lclNum];
+
+            if (BitVecOps::MayBeUninit(row) ||
+                BitVecOps::IsMember(&m_bitVecTraits, m_PossiblyStackPointingPointers, lclNum))
+            {
+                continue;
+            }
+
+            if (!BitVecOps::IsEmptyIntersection(&m_bitVecTraits, row, m_PossiblyStackPointingPointers))
+            {
+                // A local that may point to a stack allocated object can not escape,
+                // otherwise the object it points to would have escaped too.
+                assert(!IsLclVarEscaping(lclNum));
+                BitVecOps::AddElemD(&m_bitVecTraits, m_PossiblyStackPointingPointers, lclNum);
+                changed = true;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+// IsBlockInLoop: Returns true iff the block may execute more than once
+//                per invocation of the method.
+//
+// Notes:
+//    A stack allocated object lives in a single frame slot, so allocations
+//    in a cycle of the flow graph would reuse an object that an earlier
+//    iteration may still refer to.
+//
+//    Handler and filter entries have no flow graph predecessors, so the
+//    cycles they are part of can't be found from the preds. Blocks in a
+//    handler or filter region are always treated as being in a loop.
+bool ObjectAllocator::IsBlockInLoop(BasicBlock* block) const
+{
+    assert(comp->fgDomsComputed);
+
+    if (block->hasHndIndex())
+    {
+        return true;
+    }
+
+    for (flowList* pred = block->bbPreds; pred != nullptr; pred = pred->flNext)
+    {
+        if (comp->fgReachable(block, pred->flBlock))
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 //------------------------------------------------------------------------
 // MorphAllocObjNodes: Morph each GT_ALLOCOBJ node either into an
 //                     allocation helper call or stack allocation.
 //
+// Return Value:
+//    true if any object was allocated on the stack.
+//
 // Notes:
 //    Runs only over the blocks having bbFlags BBF_HAS_NEWOBJ set.
-void ObjectAllocator::MorphAllocObjNodes()
+bool ObjectAllocator::MorphAllocObjNodes()
 {
+    bool        didStackAllocate = false;
     BasicBlock* block;
 
     foreach_block(comp, block)
@@ -112,9 +433,14 @@ void ObjectAllocator::MorphAllocObjNodes()
                 GenTreeAllocObj* asAllocObj = op2->AsAllocObj();
                 unsigned int     lclNum     = op1->AsLclVar()->GetLclNum();
 
-                if (IsObjectStackAllocationEnabled() && CanAllocateLclVarOnStack(lclNum))
+                if (IsObjectStackAllocationEnabled() && (asAllocObj->gtNewHelper == CORINFO_HELP_NEWSFAST) &&
+                    !IsBlockInLoop(block) && CanAllocateLclVarOnStack(lclNum, asAllocObj->gtAllocObjClsHnd))
                 {
+                    JITDUMP("Allocating local variable V%02u on the stack\n", lclNum);
+
                     op2 = MorphAllocObjNodeIntoStackAlloc(asAllocObj, block, stmt);
+                    BitVecOps::AddElemD(&m_bitVecTraits, m_PossiblyStackPointingPointers, lclNum);
+                    didStackAllocate = true;
                 }
                 else
                 {
@@ -135,6 +461,8 @@ void ObjectAllocator::MorphAllocObjNodes()
 #endif // DEBUG
         }
     }
+
+    return didStackAllocate;
 }
 
 //------------------------------------------------------------------------
@@ -164,7 +492,7 @@ GenTreePtr ObjectAllocator::MorphAllocObjNodeIntoHelperCall(GenTreeAllocObj* all
 // MorphAllocObjNodeIntoStackAlloc: Morph a GT_ALLOCOBJ node into stack
 //                                  allocation.
 // Arguments:
-//    allocObj - GT_ALLOCOBJ that will be replaced by helper call.
+//    allocObj - GT_ALLOCOBJ that will be replaced by a stack allocation.
 //    block    - a basic block where allocObj is
 //    stmt     - a statement where allocObj is
 //
@@ -174,6 +502,27 @@ GenTreePtr ObjectAllocator::MorphAllocObjNodeIntoHelperCall(GenTreeAllocObj* all
 // Notes:
 //    Must update parents flags after this.
 //    This function can insert additional statements before stmt.
+//
+//    The object is a TYP_BLK local laid out like the heap object, minus the
+//    object header: the method table pointer followed by the fields. The
+//    local is zeroed (the block does not execute more than once per
+//    invocation but locals are not necessarily zero initialized in the
+//    prolog) and the method table pointer is stored into its first slot:
+//
+//    *  GT_STMT   void
+//    \--*  GT_ASG    struct (init)
+//       +--*  GT_BLK    struct
+//       |  \--*  GT_ADDR   byref
+//       |     \--*  GT_LCL_VAR blk
+//       \--*  GT_CNS_INT int    0
+//
+//    *  GT_STMT   void
+//    \--*  GT_ASG    long
+//       +--*  GT_LCL_FLD long   [+0]
+//       \--*  GT_CNS_INT(h) long   (method table)
+//
+//    The returned tree is the address of the local. Locals that may hold that
+//    address are retyped to TYP_BYREF by RewriteUses.
 GenTreePtr ObjectAllocator::MorphAllocObjNodeIntoStackAlloc(GenTreeAllocObj* allocObj,
                                                             BasicBlock*      block,
                                                             GenTreeStmt*     stmt)
@@ -181,10 +530,138 @@ GenTreePtr ObjectAllocator::MorphAllocObjNodeIntoStackAlloc(GenTreeAllocObj* all
     assert(allocObj != nullptr);
     assert(m_AnalysisDone);
 
-    // TODO-StackAllocation
-    NYI("MorphAllocObjIntoStackAlloc");
+    const unsigned int classSize = comp->info.compCompHnd->getHeapClassSize(allocObj->gtAllocObjClsHnd);
+    const unsigned int lclNum    = comp->lvaGrabTemp(false DEBUGARG("MorphAllocObjNodeIntoStackAlloc temp"));
+
+    LclVarDsc* lclDsc   = comp->lvaTable + lclNum;
+    lclDsc->lvType      = TYP_BLK;
+    lclDsc->lvExactSize = (unsigned)roundUp(classSize, TARGET_POINTER_SIZE);
+
+    // The object is only ever accessed through its address.
+    comp->lvaSetVarAddrExposed(lclNum);
+
+    GenTreePtr tree = comp->gtNewOperNode(GT_ADDR, TYP_BYREF, comp->gtNewLclvNode(lclNum, TYP_BLK));
+    tree            = comp->gtNewBlockVal(tree, lclDsc->lvExactSize);
+    tree            = comp->gtNewBlkOpNode(tree, comp->gtNewIconNode(0), lclDsc->lvExactSize, false, false);
+    tree            = comp->fgMorphTree(tree);
+    comp->fgInsertStmtBefore(block, stmt, comp->gtNewStmt(tree, stmt->gtStmtILoffsx));
+
+    // The method table tree has already been morphed along with the GT_ALLOCOBJ.
+    tree = comp->gtNewLclFldNode(lclNum, TYP_I_IMPL, 0);
+    tree = comp->gtNewAssignNode(tree, allocObj->gtGetOp1());
+    comp->fgInsertStmtBefore(block, stmt, comp->gtNewStmt(tree, stmt->gtStmtILoffsx));
+
+    return comp->gtNewOperNode(GT_ADDR, TYP_BYREF, comp->gtNewLclvNode(lclNum, TYP_BLK));
+}
+
+//------------------------------------------------------------------------
+// RewriteUses: Retype the locals that may point to a stack allocated
+//              object, and the trees that produce their values, to
+//              TYP_BYREF.
+//
+// Notes:
+//    A TYP_REF local holding the address of a stack allocated object would
+//    be reported to the GC as an object reference. Byrefs may point anywhere
+//    so these locals remain correctly reported whether they end up holding
+//    the address of a stack allocated object or of a heap object.
+void ObjectAllocator::RewriteUses()
+{
+    class RewriteUsesVisitor final : public GenTreeVisitor<RewriteUsesVisitor>
+    {
+        ObjectAllocator* m_allocator;
+
+    public:
+        enum
+        {
+            DoPreOrder    = true,
+            DoLclVarsOnly = true,
+            ComputeStack  = true,
+        };
+
+        RewriteUsesVisitor(ObjectAllocator* allocator)
+            : GenTreeVisitor<RewriteUsesVisitor>(allocator->comp), m_allocator(allocator)
+        {
+        }
+
+        Compiler::fgWalkResult PreOrderVisit(GenTree** use, GenTree* user)
+        {
+            GenTree* tree = *use;
+            assert(tree != nullptr);
+
+            const unsigned int lclNum = tree->AsLclVarCommon()->gtLclNum;
+
+            if ((lclNum >= BitVecTraits::GetSize(&m_allocator->m_bitVecTraits)) ||
+                !BitVecOps::IsMember(&m_allocator->m_bitVecTraits, m_allocator->m_PossiblyStackPointingPointers,
+                                     lclNum))
+            {
+                return Compiler::fgWalkResult::WALK_CONTINUE;
+            }
+
+            // Locals that may point to the stack don't escape, so they are only
+            // accessed as a whole.
+            assert(tree->OperGet() == GT_LCL_VAR);
+            tree->gtType = TYP_BYREF;
+
+            // Retype the parents the value flows through up to the assignment that
+            // consumes it, if any.
+            for (int parentIndex = 1; parentIndex < m_ancestors.Height(); parentIndex++)
+            {
+                GenTree* parent = m_ancestors.Index(parentIndex);
+
+                if (parent->TypeGet() != TYP_REF)
+                {
+                    break;
+                }
+
+                if (parent->OperGet() == GT_ASG)
+                {
+                    parent->gtType = TYP_BYREF;
+                    break;
+                }
+
+                if ((parent->OperGet() == GT_COMMA) && (parent->gtGetOp1() == m_ancestors.Index(parentIndex - 1)))
+                {
+                    break;
+                }
+
+                if ((parent->OperGet() != GT_COMMA) && (parent->OperGet() != GT_COLON) &&
+                    (parent->OperGet() != GT_QMARK))
+                {
+                    break;
+                }
+
+                parent->gtType = TYP_BYREF;
+            }
+
+            return Compiler::fgWalkResult::WALK_CONTINUE;
+        }
+    };
+
+    ComputeStackPointingNodes();
+
+    for (unsigned int lclNum = 0; lclNum < BitVecTraits::GetSize(&m_bitVecTraits); ++lclNum)
+    {
+        if (BitVecOps::IsMember(&m_bitVecTraits, m_PossiblyStackPointingPointers, lclNum))
+        {
+            JITDUMP("Retyping V%02u to byref, it may point to a stack allocated object\n", lclNum);
+
+            LclVarDsc* lclDsc      = comp->lvaTable + lclNum;
+            lclDsc->lvType         = TYP_BYREF;
+            lclDsc->lvClassHnd     = NO_CLASS_HANDLE;
+            lclDsc->lvClassIsExact = false;
+        }
+    }
+
+    BasicBlock* block;
 
-    return allocObj;
+    foreach_block(comp, block)
+    {
+        for (GenTreeStmt* stmt = block->firstStmt(); stmt; stmt = stmt->gtNextStmt)
+        {
+            RewriteUsesVisitor rewriteUsesVisitor(this);
+            rewriteUsesVisitor.WalkTree(&stmt->gtStmtExpr, nullptr);
+        }
+    }
 }
 
 #ifdef DEBUG
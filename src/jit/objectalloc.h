@@ -23,8 +23,23 @@ class ObjectAllocator final : public Phase
 {
     //===============================================================================
     // Data members
-    bool m_IsObjectStackAllocationEnabled;
-    bool m_AnalysisDone;
+    bool         m_IsObjectStackAllocationEnabled;
+    bool         m_AnalysisDone;
+    BitVecTraits m_bitVecTraits;
+    // Locals whose value may be stored somewhere that outlives the method (the heap,
+    // a callee, the return value) and so can not refer to a stack allocated object.
+    BitVec m_EscapingPointers;
+    // Locals that may refer to a stack allocated object. These are retyped to TYP_BYREF
+    // once allocation is done so that the GC does not treat them as object references.
+    BitVec m_PossiblyStackPointingPointers;
+    // Connection graph: m_ConnGraphAdjacencyMatrix[lclNum] is the set of locals whose
+    // value may be copied into lclNum. Rows are only allocated for locals that have
+    // at least one incoming edge.
+    BitVec* m_ConnGraphAdjacencyMatrix;
+
+    // Largest object (including the method table pointer) that will be allocated on the stack.
+    static const unsigned s_StackAllocMaxSize = 0x100;
+
     //===============================================================================
     // Methods
 public:
@@ -36,9 +51,20 @@ protected:
     virtual void DoPhase() override;
 
 private:
-    bool CanAllocateLclVarOnStack(unsigned int lclNum) const;
+    bool CanAllocateLclVarOnStack(unsigned int lclNum, CORINFO_CLASS_HANDLE clsHnd);
+    bool CanLclVarEscape(unsigned int lclNum);
+    bool IsTrackedLclVar(unsigned int lclNum);
+    bool IsBlockInLoop(BasicBlock* block) const;
     void       DoAnalysis();
-    void       MorphAllocObjNodes();
+    void       MarkLclVarAsEscaping(unsigned int lclNum);
+    bool       IsLclVarEscaping(unsigned int lclNum);
+    void       AddConnGraphEdge(unsigned int sourceLclNum, unsigned int targetLclNum);
+    void       MarkEscapingVarsAndBuildConnGraph();
+    bool       CanLclVarEscapeViaParentStack(ArrayStack<GenTree*>* parentStack, unsigned int lclNum);
+    void       ComputeEscapingNodes();
+    void       ComputeStackPointingNodes();
+    void       RewriteUses();
+    bool       MorphAllocObjNodes();
     GenTreePtr MorphAllocObjNodeIntoHelperCall(GenTreeAllocObj* allocObj);
     GenTreePtr MorphAllocObjNodeIntoStackAlloc(GenTreeAllocObj* allocObj, BasicBlock* block, GenTreeStmt* stmt);
 #ifdef DEBUG
@@ -52,6 +78,10 @@ inline ObjectAllocator::ObjectAllocator(Compiler* comp)
     : Phase(comp, "Allocate Objects", PHASE_ALLOCATE_OBJECTS)
     , m_IsObjectStackAllocationEnabled(false)
     , m_AnalysisDone(false)
+    , m_bitVecTraits(comp->lvaCount, comp)
+    , m_EscapingPointers(BitVecOps::UninitVal())
+    , m_PossiblyStackPointingPointers(BitVecOps::UninitVal())
+    , m_ConnGraphAdjacencyMatrix(nullptr)
 {
 }
 
@@ -69,12 +99,74 @@ inline void ObjectAllocator::EnableObjectStackAllocation()
 // CanAllocateLclVarOnStack: Returns true iff local variable can not
 //                           potentially escape from the method and
 //                           can be allocated on the stack.
-inline bool ObjectAllocator::CanAllocateLclVarOnStack(unsigned int lclNum) const
+//
+// Arguments:
+//    lclNum - local that is assigned the result of the allocation
+//    clsHnd - class of the object being allocated
+//
+// Notes:
+//    Only objects without GC fields are allocated on the stack so the
+//    stack allocated object never has to be reported to the GC. Objects
+//    with finalizers are filtered out by the caller, which only considers
+//    allocations that use CORINFO_HELP_NEWSFAST.
+inline bool ObjectAllocator::CanAllocateLclVarOnStack(unsigned int lclNum, CORINFO_CLASS_HANDLE clsHnd)
+{
+    assert(m_AnalysisDone);
+
+    DWORD classAttribs = comp->info.compCompHnd->getClassAttribs(clsHnd);
+
+    if ((classAttribs & CORINFO_FLG_VALUECLASS) != 0)
+    {
+        // TODO-ObjectStackAllocation: enable stack allocation of boxed structs
+        return false;
+    }
+
+    if ((classAttribs & CORINFO_FLG_CONTAINS_GC_PTR) != 0)
+    {
+        // TODO-ObjectStackAllocation: report GC fields of stack allocated objects
+        return false;
+    }
+
+    const unsigned classSize = comp->info.compCompHnd->getHeapClassSize(clsHnd);
+
+    if ((classSize == 0) || (classSize > s_StackAllocMaxSize))
+    {
+        return false;
+    }
+
+    return !CanLclVarEscape(lclNum);
+}
+
+//------------------------------------------------------------------------
+// CanLclVarEscape: Returns true iff local variable can
+//                  potentially escape from the method
+inline bool ObjectAllocator::CanLclVarEscape(unsigned int lclNum)
 {
     assert(m_AnalysisDone);
-    // TODO-ObjectStackAllocation
-    NYI("CanAllocateLclVarOnStack");
-    return false;
+    return !IsTrackedLclVar(lclNum) || IsLclVarEscaping(lclNum);
+}
+
+//------------------------------------------------------------------------
+// IsTrackedLclVar: Returns true iff the local variable is an object
+//                  reference that existed when the analysis was run
+inline bool ObjectAllocator::IsTrackedLclVar(unsigned int lclNum)
+{
+    return (lclNum < BitVecTraits::GetSize(&m_bitVecTraits)) && (comp->lvaTable[lclNum].TypeGet() == TYP_REF);
+}
+
+//------------------------------------------------------------------------
+// IsLclVarEscaping: Returns true iff the analysis has so far determined
+//                   that the local variable may escape
+inline bool ObjectAllocator::IsLclVarEscaping(unsigned int lclNum)
+{
+    return BitVecOps::IsMember(&m_bitVecTraits, m_EscapingPointers, lclNum);
+}
+
+//------------------------------------------------------------------------
+// MarkLclVarAsEscaping: Record that the local variable may escape
+inline void ObjectAllocator::MarkLclVarAsEscaping(unsigned int lclNum)
+{
+    BitVecOps::AddElemD(&m_bitVecTraits, m_EscapingPointers, lclNum);
 }
 
 //===============================================================================
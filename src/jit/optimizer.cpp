@@ -835,6 +835,13 @@ bool Compiler::optCheckIterInLoopTest(
     {
         optLoopTable[loopInd].lpFlags |= LPFLG_ARRLEN_LIMIT;
     }
+    else if ((limitOp->gtOper == GT_ADD) && (limitOp->gtGetOp1()->gtOper == GT_ARR_LENGTH) &&
+             (limitOp->gtGetOp2()->gtOper == GT_CNS_INT) && (limitOp->gtGetOp2()->gtIntCon.gtIconVal <= 0) &&
+             (limitOp->gtGetOp2()->gtIntCon.gtIconVal >= -MAX_ARR_INDEX_OFFSET))
+    {
+        // "a.len - cns", which morph has turned into "a.len + (-cns)".
+        optLoopTable[loopInd].lpFlags |= LPFLG_ARRLEN_LIMIT;
+    }
     else
     {
         return false;
@@ -3501,6 +3508,865 @@ bool Compiler::optComputeLoopRep(int        constInit,
     return false;
 }
 
+//------------------------------------------------------------------------
+// optIsSingleBlockCountedLoop: Check whether a loop is a single block of the form
+//    "do { ...; i += inc; } while (i < limit)" that can be rewritten in place.
+//
+// Arguments:
+//    lnum - The loop to check
+//
+// Return Value:
+//    true if the loop is a single block that branches back to itself, the loop head falls into
+//    it and is its only other predecessor, the block doesn't delimit any other loop, and the
+//    iterator is an int local that is compared with a signed "<" in the last statement.
+//
+bool Compiler::optIsSingleBlockCountedLoop(unsigned lnum)
+{
+    LoopDsc* loop = &optLoopTable[lnum];
+
+    const unsigned requiredFlags = LPFLG_DO_WHILE | LPFLG_ONE_EXIT | LPFLG_ITER;
+    if (((loop->lpFlags & requiredFlags) != requiredFlags) || ((loop->lpFlags & LPFLG_REMOVED) != 0))
+    {
+        return false;
+    }
+
+    BasicBlock* head  = loop->lpHead;
+    BasicBlock* block = loop->lpTop;
+
+    if ((loop->lpFirst != block) || (loop->lpEntry != block) || (loop->lpBottom != block) ||
+        (loop->lpExit != block) || (head->bbNext != block) || (block->bbJumpKind != BBJ_COND) ||
+        (block->bbJumpDest != block) || (loop->lpChild != BasicBlock::NOT_IN_LOOP) ||
+        !BasicBlock::sameEHRegion(head, block) || (block->bbNext == nullptr) ||
+        ((head->bbJumpKind != BBJ_NONE) && (head->bbJumpKind != BBJ_COND)) || (head->bbJumpDest == block))
+    {
+        return false;
+    }
+
+    if (!fgComputePredsDone)
+    {
+        return false;
+    }
+
+    for (flowList* pred = block->bbPreds; pred != nullptr; pred = pred->flNext)
+    {
+        if ((pred->flBlock != head) && (pred->flBlock != block))
+        {
+            return false;
+        }
+    }
+
+    for (unsigned i = 0; i < optLoopCount; i++)
+    {
+        if ((i != lnum) && ((optLoopTable[i].lpFlags & LPFLG_REMOVED) == 0) &&
+            ((optLoopTable[i].lpFirst == block) || (optLoopTable[i].lpTop == block) ||
+             (optLoopTable[i].lpEntry == block) || (optLoopTable[i].lpBottom == block) ||
+             (optLoopTable[i].lpExit == block)))
+        {
+            return false;
+        }
+    }
+
+    unsigned lvar = loop->lpIterVar();
+    if ((loop->lpTestOper() != GT_LT) || loop->lpIsReversed() || (loop->lpIterOper() != GT_ADD) ||
+        (loop->lpIterOperType() != TYP_INT) || (lvaTable[lvar].TypeGet() != TYP_INT) ||
+        ((loop->lpTestTree->gtFlags & GTF_UNSIGNED) != 0) || lvaTable[lvar].lvAddrExposed ||
+        lvaTable[lvar].lvIsStructField)
+    {
+        return false;
+    }
+
+    GenTreeStmt* test = block->lastStmt();
+    if ((test == nullptr) || (test == block->firstStmt()) || (test->gtStmtExpr->OperGet() != GT_JTRUE) ||
+        (test->gtStmtExpr->gtGetOp1() != loop->lpTestTree))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------
+// optPartialUnrollLoop: Unroll a counted loop whose trip count is not known at compile time,
+//    keeping the original loop to run the iterations left over.
+//
+// Arguments:
+//    lnum          - The loop to unroll
+//    unrollLimitSz - The estimated code size that may be added by the extra copies of the loop body
+//
+// Return Value:
+//    true if the loop was unrolled (and the flow graph needs to be updated), false otherwise.
+//
+// Notes:
+//    Only single block loops of the form "for (i = init; i < a.Length; i += inc) { ... }",
+//    whose zero trip test was duplicated into the head, are handled. With an unroll factor
+//    of F the loop becomes:
+//
+//        head:    if (i >= a.Length) goto exit                   (unchanged)
+//        guard:   if (i >= a.Length - (F-1)*inc) goto rem
+//        body:    F copies of { ...; i += inc; }
+//                 if (i < a.Length - (F-1)*inc) goto body
+//        remTest: if (i >= a.Length) goto exit
+//        rem:     ...; i += inc; if (i < a.Length) goto rem      (the original loop)
+//        exit:
+//
+//    The test in the head proves that "a" is not null, so the copies of the body don't need
+//    the loop test in between them. The unrolled loop takes over the loop table entry; like
+//    the slow path of a cloned loop, the remainder loop is not recorded in the loop table.
+//
+bool Compiler::optPartialUnrollLoop(unsigned lnum, int unrollLimitSz)
+{
+    LoopDsc* loop = &optLoopTable[lnum];
+
+    if (((loop->lpFlags & LPFLG_ARRLEN_LIMIT) == 0) || !optIsSingleBlockCountedLoop(lnum))
+    {
+        return false;
+    }
+
+    BasicBlock* head  = loop->lpHead;
+    BasicBlock* block = loop->lpTop;
+
+    // The head must end with the duplicated loop test, which jumps around the loop.
+    GenTreeStmt* headTest = head->lastStmt();
+    if ((head->bbJumpKind != BBJ_COND) || (head->bbJumpDest != block->bbNext) || (headTest == nullptr) ||
+        ((headTest->gtFlags & GTF_STMT_CMPADD) == 0) || (headTest->gtStmtExpr->OperGet() != GT_JTRUE))
+    {
+        return false;
+    }
+
+    // Only a positive increment is handled, so "a.Length - (F-1)*inc" can't overflow.
+    unsigned lvar = loop->lpIterVar();
+    int      inc  = loop->lpIterConst();
+    if ((inc <= 0) || (inc > 16))
+    {
+        return false;
+    }
+
+    ArrIndex arrIndex(getAllocator());
+    if (!loop->lpArrLenLimit(this, &arrIndex) || (arrIndex.rank != 0))
+    {
+        return false;
+    }
+
+    unsigned arrLcl = arrIndex.arrLcl;
+    if (lvaTable[arrLcl].lvAddrExposed || optIsVarAssigned(block, block, nullptr, arrLcl))
+    {
+        return false;
+    }
+
+    // The head's test has to check the same array, it is what proves that the array isn't null.
+    bool       headTestsArray = false;
+    GenTreePtr headRelop      = headTest->gtStmtExpr->gtGetOp1();
+    if (headRelop->OperIsCompare())
+    {
+        for (unsigned i = 0; i < 2; i++)
+        {
+            GenTreePtr operand = (i == 0) ? headRelop->gtGetOp1() : headRelop->gtGetOp2();
+
+            // The limit may be "a.len + (-cns)", see optCheckIterInLoopTest.
+            if ((operand->OperGet() == GT_ADD) && operand->gtGetOp2()->IsCnsIntOrI())
+            {
+                operand = operand->gtGetOp1();
+            }
+            if ((operand->OperGet() == GT_ARR_LENGTH) && (operand->gtArrLen.ArrRef()->OperGet() == GT_LCL_VAR) &&
+                (operand->gtArrLen.ArrRef()->gtLclVarCommon.gtLclNum == arrLcl))
+            {
+                headTestsArray = true;
+            }
+        }
+    }
+
+    if (!headTestsArray)
+    {
+        return false;
+    }
+
+    GenTreeStmt* test = block->lastStmt();
+
+    // Estimate the size of one iteration, and make sure that every statement can be cloned.
+    ClrSafeInt<unsigned> bodyCostSz(0);
+    for (GenTreeStmt* stmt = block->firstStmt(); stmt != nullptr; stmt = stmt->gtNextStmt)
+    {
+        if (gtCloneExpr(stmt->gtStmtExpr) == nullptr)
+        {
+            return false;
+        }
+
+        gtSetStmtInfo(stmt);
+        if (stmt != test)
+        {
+            bodyCostSz += stmt->gtCostSz;
+        }
+    }
+
+    // Unroll by 4 if it fits in the budget, or else by 2.
+    unsigned unrollFactor = 4;
+    while (unrollFactor > 1)
+    {
+        ClrSafeInt<unsigned> unrollCostSz = bodyCostSz * ClrSafeInt<unsigned>(unrollFactor - 1);
+        if (!unrollCostSz.IsOverflow() && (unrollCostSz.Value() <= (unsigned)unrollLimitSz))
+        {
+            break;
+        }
+        unrollFactor /= 2;
+    }
+
+    if (unrollFactor < 2)
+    {
+        return false;
+    }
+
+    BasicBlock* exit      = block->bbNext;
+    unsigned    parent    = loop->lpParent;
+    int         guardDist = (int)(unrollFactor - 1) * inc;
+
+    JITDUMP("\nPartially unrolling loop L%02u BB%02u by %u over V%02u (bodyCostSz = %u)\n", lnum, block->bbNum,
+            unrollFactor, lvar, bodyCostSz.Value());
+
+    // Create the unrolled loop from a copy of the original loop block.
+    BasicBlock* guard    = fgNewBBafter(BBJ_COND, head, /*extendRegion*/ true);
+    BasicBlock* unrolled = fgNewBBafter(BBJ_COND, guard, /*extendRegion*/ true);
+    BasicBlock* remTest  = fgNewBBafter(BBJ_COND, unrolled, /*extendRegion*/ true);
+
+    bool cloned = BasicBlock::CloneBlockState(this, unrolled, block, (unsigned)-1, 0);
+    noway_assert(cloned);
+    unrolled->bbJumpDest = unrolled;
+
+    fgRemoveStmt(unrolled, unrolled->lastStmt());
+    for (unsigned copy = 1; copy < unrollFactor; copy++)
+    {
+        for (GenTreeStmt* stmt = block->firstStmt(); stmt != test; stmt = stmt->gtNextStmt)
+        {
+            fgInsertStmtAtEnd(unrolled, fgNewStmtFromTree(gtCloneExpr(stmt->gtStmtExpr)));
+        }
+    }
+
+    GenTreePtr limit = loop->lpLimit();
+
+    // guard: if (i >= a.Length - (F-1)*inc) goto rem
+    GenTreePtr cond = gtNewOperNode(GT_GE, TYP_INT, gtNewLclvNode(lvar, TYP_INT),
+                                    gtNewOperNode(GT_SUB, TYP_INT, gtCloneExpr(limit), gtNewIconNode(guardDist)));
+    GenTreePtr stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(guard, stmt);
+    fgMorphBlockStmt(guard, stmt->AsStmt() DEBUGARG("Partial unroll guard"));
+    guard->bbJumpDest = block;
+    guard->inheritWeight(head);
+    guard->bbNatLoopNum = parent;
+
+    // body: if (i < a.Length - (F-1)*inc) goto body
+    cond = gtNewOperNode(GT_LT, TYP_INT, gtNewLclvNode(lvar, TYP_INT),
+                         gtNewOperNode(GT_SUB, TYP_INT, gtCloneExpr(limit), gtNewIconNode(guardDist)));
+    stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(unrolled, stmt);
+    fgMorphBlockStmt(unrolled, stmt->AsStmt() DEBUGARG("Partial unroll test"));
+    unrolled->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL;
+
+    // remTest: if (i >= a.Length) goto exit
+    cond = gtNewOperNode(GT_GE, TYP_INT, gtNewLclvNode(lvar, TYP_INT), gtCloneExpr(limit));
+    stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(remTest, stmt);
+    fgMorphBlockStmt(remTest, stmt->AsStmt() DEBUGARG("Partial unroll remainder test"));
+    remTest->bbJumpDest = exit;
+    remTest->inheritWeight(head);
+    remTest->bbNatLoopNum = parent;
+    exit->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL;
+
+    // The original loop now only runs the iterations left over by the unrolled loop.
+    block->inheritWeight(head);
+    block->bbNatLoopNum = parent;
+
+    // The unrolled loop takes over the loop table entry. It is no longer a simple counted loop.
+    loop->lpHead   = guard;
+    loop->lpFirst  = unrolled;
+    loop->lpTop    = unrolled;
+    loop->lpEntry  = unrolled;
+    loop->lpBottom = unrolled;
+    loop->lpExit   = unrolled;
+    loop->lpFlags &= ~(LPFLG_ITER | LPFLG_CONST | LPFLG_VAR_INIT | LPFLG_CONST_INIT | LPFLG_VAR_LIMIT |
+                       LPFLG_CONST_LIMIT | LPFLG_ARRLEN_LIMIT | LPFLG_SIMD_LIMIT | LPFLG_HAS_PREHEAD);
+    loop->lpFlags |= LPFLG_DONT_UNROLL;
+
+#ifdef DEBUG
+    if (verbose)
+    {
+        printf("Partially unrolled loop:\n");
+        fgDumpTrees(guard, block);
+    }
+#endif
+
+    return true;
+}
+
+#ifdef FEATURE_SIMD
+//------------------------------------------------------------------------
+// optVectorizeLoops: Rewrite simple counted loops over arrays of primitives so that
+//    each iteration processes a whole SIMD vector of elements.
+//
+// Notes:
+//    This runs right after loop cloning, and only loops whose array accesses no longer
+//    have bounds checks are considered. The cloning conditions are what prove that the
+//    vector accesses are within the bounds of their arrays.
+//
+void Compiler::optVectorizeLoops()
+{
+#ifdef DEBUG
+    if (verbose)
+    {
+        printf("*************** In optVectorizeLoops()\n");
+    }
+#endif
+
+    if (!featureSIMD || (compCodeOpt() == SMALL_CODE) || (optLoopCount == 0))
+    {
+        return;
+    }
+
+#ifdef DEBUG
+    if (JitConfig.JitNoVectorize())
+    {
+        return;
+    }
+#endif
+
+    bool change = false;
+    for (unsigned lnum = 0; lnum < optLoopCount; lnum++)
+    {
+        if (optVectorizeLoop(lnum))
+        {
+            change = true;
+        }
+    }
+
+    if (change)
+    {
+        fgUpdateChangedFlowGraph();
+    }
+
+#ifdef DEBUG
+    fgDebugCheckBBlist(true);
+#endif
+}
+
+//------------------------------------------------------------------------
+// optVectorizeArrElem: Check whether a tree loads or stores "a[i]", where "a" is an
+//    array local and "i" is the loop iterator, and the bounds check has been removed.
+//
+// Arguments:
+//    tree    - The tree to check
+//    ivLcl   - The loop iterator
+//    pArrLcl - [out] The array local
+//
+// Return Value:
+//    The GT_IND of the array element, or nullptr if the tree doesn't match.
+//
+// Notes:
+//    A bounds check removed by optRemoveRangeCheck leaves a comma with a nothing node
+//    behind, these are skipped. The address must have the shape that fgMorphArrayIndex
+//    produces, and that the SIMD array intrinsics use for their loads and stores.
+//
+GenTreePtr Compiler::optVectorizeArrElem(GenTreePtr tree, unsigned ivLcl, unsigned* pArrLcl)
+{
+    while ((tree->OperGet() == GT_COMMA) && tree->gtGetOp1()->IsNothingNode())
+    {
+        tree = tree->gtGetOp2();
+    }
+
+    if ((tree->OperGet() != GT_IND) || varTypeIsStruct(tree) || ((tree->gtFlags & GTF_IND_VOLATILE) != 0))
+    {
+        return nullptr;
+    }
+
+    GenTreePtr sibo = tree->gtGetOp1();
+    if ((sibo->OperGet() != GT_ADD) || (sibo->gtGetOp2()->OperGet() != GT_CNS_INT) ||
+        (sibo->gtGetOp2()->gtIntCon.gtIconVal != (ssize_t)offsetof(CORINFO_Array, u1Elems)))
+    {
+        return nullptr;
+    }
+
+    GenTreePtr sib = sibo->gtGetOp1();
+    if ((sib->OperGet() != GT_ADD) || (sib->gtGetOp1()->OperGet() != GT_LCL_VAR) ||
+        (sib->gtGetOp2()->OperGet() != GT_LSH))
+    {
+        return nullptr;
+    }
+
+    GenTreePtr base  = sib->gtGetOp1();
+    GenTreePtr scale = sib->gtGetOp2()->gtGetOp2();
+    GenTreePtr index = sib->gtGetOp2()->gtGetOp1();
+    if ((base->TypeGet() != TYP_REF) || (scale->OperGet() != GT_CNS_INT) ||
+        (((ssize_t)1 << scale->gtIntCon.gtIconVal) != (ssize_t)genTypeSize(tree->TypeGet())))
+    {
+        return nullptr;
+    }
+
+#ifdef _TARGET_64BIT_
+    if ((index->OperGet() != GT_CAST) || index->gtOverflow())
+    {
+        return nullptr;
+    }
+    index = index->gtGetOp1();
+#endif
+
+    if ((index->OperGet() != GT_LCL_VAR) || (index->gtLclVarCommon.gtLclNum != ivLcl))
+    {
+        return nullptr;
+    }
+
+    unsigned arrLcl = base->gtLclVarCommon.gtLclNum;
+    if (lvaTable[arrLcl].lvAddrExposed)
+    {
+        return nullptr;
+    }
+
+    *pArrLcl = arrLcl;
+    return tree;
+}
+
+//------------------------------------------------------------------------
+// optVectorizeTree: Check whether an expression computed for each element of a loop
+//    can be computed with SIMD operations instead, and optionally build the SIMD tree.
+//
+// Arguments:
+//    lnum     - The loop being vectorized
+//    tree     - The scalar expression
+//    baseType - The element type of the vectors
+//    preBlock - The block that loop invariant vectors are created in, or nullptr to only
+//               check the expression
+//
+// Return Value:
+//    nullptr if the expression can't be vectorized. Otherwise, "tree" when only checking,
+//    or the new SIMD tree.
+//
+// Notes:
+//    The expression may use array elements "a[i]", loop invariant locals and constants
+//    (which are broadcast into a temp in "preBlock"), and the element-wise arithmetic and
+//    bitwise operators that have a SIMD intrinsic for "baseType".
+//
+GenTreePtr Compiler::optVectorizeTree(unsigned lnum, GenTreePtr tree, var_types baseType, BasicBlock* preBlock)
+{
+    LoopDsc*  loop     = &optLoopTable[lnum];
+    unsigned  ivLcl    = loop->lpIterVar();
+    unsigned  simdSize = getSIMDVectorRegisterByteLength();
+    var_types simdType = getSIMDVectorType();
+
+    if (tree->TypeGet() != baseType)
+    {
+        return nullptr;
+    }
+
+    unsigned arrLcl = BAD_VAR_NUM;
+    if (optVectorizeArrElem(tree, ivLcl, &arrLcl) != nullptr)
+    {
+        if (preBlock == nullptr)
+        {
+            return tree;
+        }
+
+        GenTreePtr load = gtNewSIMDNode(simdType, gtNewLclvNode(arrLcl, TYP_REF), gtNewLclvNode(ivLcl, TYP_INT),
+                                        SIMDIntrinsicInitArray, baseType, simdSize);
+        load->gtFlags |= GTF_GLOB_REF;
+        return load;
+    }
+
+    SIMDIntrinsicID simdIntrinsicID = SIMDIntrinsicInvalid;
+    switch (tree->OperGet())
+    {
+        case GT_CNS_INT:
+        case GT_CNS_DBL:
+            break;
+
+        case GT_LCL_VAR:
+        {
+            unsigned lclNum = tree->gtLclVarCommon.gtLclNum;
+            if ((lclNum == ivLcl) || (lvaTable[lclNum].TypeGet() != baseType) || lvaTable[lclNum].lvAddrExposed ||
+                optIsVarAssigned(loop->lpFirst, loop->lpBottom, nullptr, lclNum))
+            {
+                return nullptr;
+            }
+        }
+        break;
+
+        case GT_ADD:
+            simdIntrinsicID = SIMDIntrinsicAdd;
+            break;
+
+        case GT_SUB:
+            simdIntrinsicID = SIMDIntrinsicSub;
+            break;
+
+        case GT_MUL:
+            // There is no multiply of long vectors.
+            if (!varTypeIsLong(baseType))
+            {
+                simdIntrinsicID = SIMDIntrinsicMul;
+            }
+            break;
+
+        case GT_DIV:
+            if (varTypeIsFloating(baseType))
+            {
+                simdIntrinsicID = SIMDIntrinsicDiv;
+            }
+            break;
+
+        case GT_AND:
+            simdIntrinsicID = SIMDIntrinsicBitwiseAnd;
+            break;
+
+        case GT_OR:
+            simdIntrinsicID = SIMDIntrinsicBitwiseOr;
+            break;
+
+        case GT_XOR:
+            simdIntrinsicID = SIMDIntrinsicBitwiseXor;
+            break;
+
+        default:
+            return nullptr;
+    }
+
+    if (tree->OperIsLeaf())
+    {
+        if (preBlock == nullptr)
+        {
+            return tree;
+        }
+
+        // Broadcast the loop invariant value once, before the loop.
+        unsigned   tmpNum = lvaGrabTemp(false DEBUGARG("Vectorized loop invariant"));
+        GenTreePtr init   = gtNewSIMDNode(simdType, gtCloneExpr(tree), SIMDIntrinsicInit, baseType, simdSize);
+        GenTreePtr stmt   = fgNewStmtFromTree(gtNewTempAssign(tmpNum, init));
+        lvaTable[tmpNum].lvBaseType = baseType;
+        fgInsertStmtAtEnd(preBlock, stmt);
+        fgMorphBlockStmt(preBlock, stmt->AsStmt() DEBUGARG("Vectorized loop invariant"));
+        return gtNewLclvNode(tmpNum, simdType);
+    }
+
+    if ((simdIntrinsicID == SIMDIntrinsicInvalid) || tree->gtOverflowEx())
+    {
+        return nullptr;
+    }
+
+    GenTreePtr op1 = optVectorizeTree(lnum, tree->gtGetOp1(), baseType, preBlock);
+    GenTreePtr op2 = (op1 == nullptr) ? nullptr : optVectorizeTree(lnum, tree->gtGetOp2(), baseType, preBlock);
+    if ((op2 == nullptr) || (preBlock == nullptr))
+    {
+        return op2;
+    }
+
+    return gtNewSIMDNode(simdType, op1, op2, simdIntrinsicID, baseType, simdSize);
+}
+
+//------------------------------------------------------------------------
+// optVectorizeLoop: Vectorize a loop that applies an element-wise operation to arrays,
+//    or sums up an element-wise expression, keeping the original loop for the tail.
+//
+// Arguments:
+//    lnum - The loop to vectorize
+//
+// Return Value:
+//    true if the loop was vectorized (and the flow graph needs to be updated), false otherwise.
+//
+// Notes:
+//    Only single block loops of the form "for (i = init; i < limit; i++) { ... }" whose
+//    limit is a constant or an array length are handled. Every statement of the body,
+//    other than the increment and the test, has to be either "a[i] = expr" or "s = s + expr",
+//    where "expr" is accepted by optVectorizeTree. Sums are only vectorized for integral types,
+//    reordering a floating point sum would change its result. With VL elements per vector
+//    the loop becomes:
+//
+//        guard:   broadcast invariants, zero the accumulators
+//                 if (i > limit - VL) goto remTest
+//        vector:  { a[i..i+VL-1] = vexpr; vacc += vexpr; }
+//                 i += VL
+//                 if (i <= limit - VL) goto vector
+//        reduce:  s = s + vacc[0] + ... + vacc[VL-1]
+//        remTest: if (i >= limit) goto exit
+//        rem:     ...; i++; if (i < limit) goto rem           (the original loop)
+//        exit:
+//
+//    All accesses in the body use the same index, so the iterations of the original loop
+//    are independent of each other, whether or not the arrays alias. The vector loop takes
+//    over the loop table entry, as optPartialUnrollLoop does.
+//
+bool Compiler::optVectorizeLoop(unsigned lnum)
+{
+    LoopDsc* loop = &optLoopTable[lnum];
+
+    if (((loop->lpFlags & (LPFLG_CONST_LIMIT | LPFLG_ARRLEN_LIMIT)) == 0) || !optIsSingleBlockCountedLoop(lnum) ||
+        (loop->lpIterConst() != 1))
+    {
+        return false;
+    }
+
+    BasicBlock*  head  = loop->lpHead;
+    BasicBlock*  block = loop->lpTop;
+    GenTreeStmt* test  = block->lastStmt();
+    unsigned     ivLcl = loop->lpIterVar();
+
+    // The increment has to be right before the test, so that every other statement uses the same index.
+    GenTreeStmt* incr = test->gtPrevStmt;
+    if ((incr == block->firstStmt()) || (incr->gtStmtExpr != loop->lpIterTree) || block->isRunRarely())
+    {
+        return false;
+    }
+
+    // Check that each statement is either an element-wise store or a sum, and that they all agree on the
+    // element type.
+    const unsigned maxStmts  = 8;
+    var_types      elemType  = TYP_UNDEF;
+    unsigned       stmtCount = 0;
+    for (GenTreeStmt* stmt = block->firstStmt(); stmt != incr; stmt = stmt->gtNextStmt)
+    {
+        GenTreePtr asg = stmt->gtStmtExpr;
+        while ((asg->OperGet() == GT_COMMA) && asg->gtGetOp1()->IsNothingNode())
+        {
+            asg = asg->gtGetOp2();
+        }
+
+        if ((asg->OperGet() != GT_ASG) || (++stmtCount > maxStmts))
+        {
+            return false;
+        }
+
+        GenTreePtr dst = asg->gtGetOp1();
+        GenTreePtr src = asg->gtGetOp2();
+        var_types  type;
+        unsigned   lclNum = BAD_VAR_NUM;
+
+        if (dst->OperGet() == GT_LCL_VAR)
+        {
+            lclNum = dst->gtLclVarCommon.gtLclNum;
+            type   = lvaTable[lclNum].TypeGet();
+            if ((lclNum == ivLcl) || !varTypeIsIntegral(type) || varTypeIsSmall(type) ||
+                lvaTable[lclNum].lvAddrExposed || (src->OperGet() != GT_ADD) || src->gtOverflow())
+            {
+                return false;
+            }
+
+            GenTreePtr sumOp1 = src->gtGetOp1();
+            GenTreePtr sumOp2 = src->gtGetOp2();
+            if ((sumOp1->OperGet() == GT_LCL_VAR) && (sumOp1->gtLclVarCommon.gtLclNum == lclNum))
+            {
+                src = sumOp2;
+            }
+            else if ((sumOp2->OperGet() == GT_LCL_VAR) && (sumOp2->gtLclVarCommon.gtLclNum == lclNum))
+            {
+                src = sumOp1;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            dst = optVectorizeArrElem(dst, ivLcl, &lclNum);
+            if (dst == nullptr)
+            {
+                return false;
+            }
+            type = dst->TypeGet();
+        }
+
+        if (elemType == TYP_UNDEF)
+        {
+            elemType = type;
+        }
+
+        if ((type != elemType) || (optVectorizeTree(lnum, src, elemType, nullptr) == nullptr))
+        {
+            return false;
+        }
+    }
+
+    switch (elemType)
+    {
+        case TYP_INT:
+        case TYP_FLOAT:
+        case TYP_DOUBLE:
+            break;
+
+#ifdef _TARGET_64BIT_
+        case TYP_LONG:
+            break;
+#endif
+
+        default:
+            return false;
+    }
+
+    unsigned  simdSize  = getSIMDVectorRegisterByteLength();
+    var_types simdType  = getSIMDVectorType();
+    int       vecLength = (int)(simdSize / genTypeSize(elemType));
+
+    if (((loop->lpFlags & LPFLG_CONST_LIMIT) != 0) && (loop->lpConstLimit() < vecLength))
+    {
+        return false;
+    }
+
+    BasicBlock* exit   = block->bbNext;
+    unsigned    parent = loop->lpParent;
+    GenTreePtr  limit  = loop->lpLimit();
+
+    JITDUMP("\nVectorizing loop L%02u BB%02u over V%02u, %d %s elements at a time\n", lnum, block->bbNum, ivLcl,
+            vecLength, varTypeName(elemType));
+
+    // The vector loop and the accumulators live in floating point registers, even for integral elements.
+    compFloatingPointUsed = true;
+
+    BasicBlock* guard  = fgNewBBafter(BBJ_COND, head, /*extendRegion*/ true);
+    BasicBlock* vector = fgNewBBafter(BBJ_COND, guard, /*extendRegion*/ true);
+    BasicBlock* reduce = nullptr;
+
+    vector->bbJumpDest = vector;
+    vector->bbFlags |= BBF_LOOP_HEAD | BBF_JMP_TARGET | BBF_HAS_LABEL;
+    vector->inheritWeight(block);
+    vector->bbNatLoopNum = lnum;
+
+    for (GenTreeStmt* stmt = block->firstStmt(); stmt != incr; stmt = stmt->gtNextStmt)
+    {
+        GenTreePtr asg = stmt->gtStmtExpr;
+        while ((asg->OperGet() == GT_COMMA) && asg->gtGetOp1()->IsNothingNode())
+        {
+            asg = asg->gtGetOp2();
+        }
+
+        GenTreePtr dst = asg->gtGetOp1();
+        GenTreePtr src = asg->gtGetOp2();
+        GenTreePtr vecAsg;
+
+        if (dst->OperGet() == GT_LCL_VAR)
+        {
+            unsigned   sumLcl = dst->gtLclVarCommon.gtLclNum;
+            GenTreePtr sumOp1 = src->gtGetOp1();
+            if ((sumOp1->OperGet() == GT_LCL_VAR) && (sumOp1->gtLclVarCommon.gtLclNum == sumLcl))
+            {
+                src = src->gtGetOp2();
+            }
+            else
+            {
+                src = sumOp1;
+            }
+
+            // guard: vacc = 0
+            unsigned   accNum   = lvaGrabTemp(false DEBUGARG("Vectorized loop accumulator"));
+            GenTreePtr zeroCns  = gtNewZeroConNode(elemType);
+            GenTreePtr zero     = gtNewSIMDNode(simdType, zeroCns, SIMDIntrinsicInit, elemType, simdSize);
+            GenTreePtr initStmt = fgNewStmtFromTree(gtNewTempAssign(accNum, zero));
+            lvaTable[accNum].lvBaseType = elemType;
+            fgInsertStmtAtEnd(guard, initStmt);
+            fgMorphBlockStmt(guard, initStmt->AsStmt() DEBUGARG("Vectorized loop accumulator"));
+
+            // vector: vacc = vacc + vexpr
+            GenTreePtr vec = optVectorizeTree(lnum, src, elemType, guard);
+            vecAsg = gtNewTempAssign(accNum, gtNewSIMDNode(simdType, gtNewLclvNode(accNum, simdType), vec,
+                                                           SIMDIntrinsicAdd, elemType, simdSize));
+
+            // reduce: s = s + vacc[0] + ... + vacc[VL-1]
+            if (reduce == nullptr)
+            {
+                reduce = fgNewBBafter(BBJ_NONE, vector, /*extendRegion*/ true);
+                reduce->inheritWeight(head);
+                reduce->bbNatLoopNum = parent;
+            }
+
+            GenTreePtr sum = gtNewLclvNode(sumLcl, elemType);
+            for (int lane = 0; lane < vecLength; lane++)
+            {
+                GenTreePtr elem = gtNewSIMDNode(elemType, gtNewLclvNode(accNum, simdType), gtNewIconNode(lane),
+                                                SIMDIntrinsicGetItem, elemType, simdSize);
+                sum = gtNewOperNode(GT_ADD, elemType, sum, elem);
+            }
+
+            GenTreePtr sumStmt = fgNewStmtFromTree(gtNewAssignNode(gtNewLclvNode(sumLcl, elemType), sum));
+            fgInsertStmtAtEnd(reduce, sumStmt);
+            fgMorphBlockStmt(reduce, sumStmt->AsStmt() DEBUGARG("Vectorized loop reduction"));
+        }
+        else
+        {
+            // vector: a[i..i+VL-1] = vexpr
+            unsigned arrLcl = BAD_VAR_NUM;
+            dst             = optVectorizeArrElem(dst, ivLcl, &arrLcl);
+            noway_assert(dst != nullptr);
+
+            GenTreePtr vec  = optVectorizeTree(lnum, src, elemType, guard);
+            GenTreePtr addr = new (this, GT_LEA) GenTreeAddrMode(TYP_BYREF, gtNewLclvNode(arrLcl, TYP_REF),
+                                                                 gtNewLclvNode(ivLcl, TYP_INT), genTypeSize(elemType),
+                                                                 offsetof(CORINFO_Array, u1Elems));
+            GenTreePtr blk = new (this, GT_BLK) GenTreeBlk(GT_BLK, simdType, addr, simdSize);
+            blk->gtFlags |= GTF_GLOB_REF;
+            vecAsg = gtNewBlkOpNode(blk, vec, simdSize, false, true);
+            vecAsg->gtFlags |= ((vec->gtFlags | addr->gtFlags) & GTF_ALL_EFFECT);
+        }
+
+        noway_assert(vecAsg != nullptr);
+        GenTreePtr vecStmt = fgNewStmtFromTree(vecAsg);
+        fgInsertStmtAtEnd(vector, vecStmt);
+        fgMorphBlockStmt(vector, vecStmt->AsStmt() DEBUGARG("Vectorized loop body"));
+    }
+
+    BasicBlock* remTest = fgNewBBafter(BBJ_COND, (reduce != nullptr) ? reduce : vector, /*extendRegion*/ true);
+
+    // guard: if (i > limit - VL) goto remTest
+    GenTreePtr cond = gtNewOperNode(GT_GT, TYP_INT, gtNewLclvNode(ivLcl, TYP_INT),
+                                    gtNewOperNode(GT_SUB, TYP_INT, gtCloneExpr(limit), gtNewIconNode(vecLength)));
+    GenTreePtr stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(guard, stmt);
+    fgMorphBlockStmt(guard, stmt->AsStmt() DEBUGARG("Vectorized loop guard"));
+    guard->bbJumpDest = remTest;
+    guard->inheritWeight(head);
+    guard->bbNatLoopNum = parent;
+
+    // vector: i += VL; if (i <= limit - VL) goto vector
+    stmt = fgNewStmtFromTree(gtNewAssignNode(gtNewLclvNode(ivLcl, TYP_INT),
+                                             gtNewOperNode(GT_ADD, TYP_INT, gtNewLclvNode(ivLcl, TYP_INT),
+                                                           gtNewIconNode(vecLength))));
+    fgInsertStmtAtEnd(vector, stmt);
+    fgMorphBlockStmt(vector, stmt->AsStmt() DEBUGARG("Vectorized loop increment"));
+
+    cond = gtNewOperNode(GT_LE, TYP_INT, gtNewLclvNode(ivLcl, TYP_INT),
+                         gtNewOperNode(GT_SUB, TYP_INT, gtCloneExpr(limit), gtNewIconNode(vecLength)));
+    stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(vector, stmt);
+    fgMorphBlockStmt(vector, stmt->AsStmt() DEBUGARG("Vectorized loop test"));
+
+    // remTest: if (i >= limit) goto exit
+    cond = gtNewOperNode(GT_GE, TYP_INT, gtNewLclvNode(ivLcl, TYP_INT), gtCloneExpr(limit));
+    stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(remTest, stmt);
+    fgMorphBlockStmt(remTest, stmt->AsStmt() DEBUGARG("Vectorized loop remainder test"));
+    remTest->bbJumpDest = exit;
+    remTest->inheritWeight(head);
+    remTest->bbNatLoopNum = parent;
+    exit->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL;
+
+    // The original loop now only runs the iterations left over by the vector loop.
+    block->inheritWeight(head);
+    block->bbNatLoopNum = parent;
+
+    // The vector loop takes over the loop table entry. It is no longer a simple counted loop.
+    loop->lpHead   = guard;
+    loop->lpFirst  = vector;
+    loop->lpTop    = vector;
+    loop->lpEntry  = vector;
+    loop->lpBottom = vector;
+    loop->lpExit   = vector;
+    loop->lpFlags &= ~(LPFLG_ITER | LPFLG_CONST | LPFLG_VAR_INIT | LPFLG_CONST_INIT | LPFLG_VAR_LIMIT |
+                       LPFLG_CONST_LIMIT | LPFLG_ARRLEN_LIMIT | LPFLG_SIMD_LIMIT | LPFLG_HAS_PREHEAD);
+    loop->lpFlags |= LPFLG_DONT_UNROLL;
+
+#ifdef DEBUG
+    if (verbose)
+    {
+        printf("Vectorized loop:\n");
+        fgDumpTrees(guard, block);
+    }
+#endif
+
+    return true;
+}
+#endif // FEATURE_SIMD
+
 /*****************************************************************************
  *
  *  Look for loop unrolling candidates and unroll them
@@ -3628,6 +4494,11 @@ void Compiler::optUnrollLoops()
 
         if ((loopFlags & requiredFlags) != requiredFlags)
         {
+            // Not a candidate for a full unroll, but it may still be worth unrolling partially.
+            if (optPartialUnrollLoop(lnum, unrollLimitSz))
+            {
+                change = true;
+            }
             continue;
         }
 
@@ -4661,6 +5532,7 @@ bool Compiler::optDeriveLoopCloningConditions(unsigned loopNum, LoopCloneContext
 
         // Limit Conditions
         LC_Ident ident;
+        int      identConst = 0; // the limit is "ident + identConst"
         if (loop->lpFlags & LPFLG_CONST_LIMIT)
         {
             int limit = loop->lpConstLimit();
@@ -4688,7 +5560,16 @@ bool Compiler::optDeriveLoopCloningConditions(unsigned loopNum, LoopCloneContext
                 JITDUMP("> ArrLen not matching");
                 return false;
             }
-            ident = LC_Ident(LC_Array(LC_Array::Jagged, index, LC_Array::ArrLen));
+            for (unsigned dim = 0; dim < index->rank; ++dim)
+            {
+                if (index->indOffs[dim] != 0)
+                {
+                    JITDUMP("> ArrLen index has an offset");
+                    return false;
+                }
+            }
+            ident      = LC_Ident(LC_Array(LC_Array::Jagged, index, LC_Array::ArrLen));
+            identConst = loop->lpArrLenLimitConst();
 
             // Ensure that this array must be dereference-able, before executing the actual condition.
             LC_Array array(LC_Array::Jagged, index, LC_Array::None);
@@ -4707,12 +5588,14 @@ bool Compiler::optDeriveLoopCloningConditions(unsigned loopNum, LoopCloneContext
             {
                 case LcOptInfo::LcJaggedArray:
                 {
-                    // limit <= arrLen
+                    // limit <= arrLen, or limit <= arrLen - k for an access like a[i + k]. The index is
+                    // never more than limit - 1 + k, and never less than init + k since init >= 0.
                     LcJaggedArrayOptInfo* arrIndexInfo = optInfo->AsLcJaggedArrayOptInfo();
                     LC_Array arrLen(LC_Array::Jagged, &arrIndexInfo->arrIndex, arrIndexInfo->dim, LC_Array::ArrLen);
                     LC_Ident arrLenIdent = LC_Ident(arrLen);
+                    int      indexOff    = arrIndexInfo->arrIndex.indOffs[arrIndexInfo->dim];
 
-                    LC_Condition cond(GT_LE, LC_Expr(ident), LC_Expr(arrLenIdent));
+                    LC_Condition cond(GT_LE, LC_Expr(ident, identConst), LC_Expr(arrLenIdent, -indexOff));
                     context->EnsureConditions(loopNum)->Push(cond);
 
                     // Ensure that this array must be dereference-able, before executing the actual condition.
@@ -4724,7 +5607,7 @@ bool Compiler::optDeriveLoopCloningConditions(unsigned loopNum, LoopCloneContext
                 {
                     // limit <= mdArrLen
                     LcMdArrayOptInfo* mdArrInfo = optInfo->AsLcMdArrayOptInfo();
-                    LC_Condition      cond(GT_LE, LC_Expr(ident),
+                    LC_Condition      cond(GT_LE, LC_Expr(ident, identConst),
                                       LC_Expr(LC_Ident(LC_Array(LC_Array::MdArray,
                                                                 mdArrInfo->GetArrIndexForDim(getAllocator()),
                                                                 mdArrInfo->dim, LC_Array::None))));
@@ -4995,6 +5878,7 @@ void Compiler::optPerformStaticOptimizations(unsigned loopNum, LoopCloneContext*
                 LcJaggedArrayOptInfo* arrIndexInfo = optInfo->AsLcJaggedArrayOptInfo();
                 compCurBB                          = arrIndexInfo->arrIndex.useBlock;
                 optRemoveRangeCheck(arrIndexInfo->arrIndex.bndsChks[arrIndexInfo->dim], arrIndexInfo->stmt);
+                INDEBUG(optBndsChksRemovedByCloning++);
                 DBEXEC(dynamicPath, optDebugLogLoopCloning(arrIndexInfo->arrIndex.useBlock, arrIndexInfo->stmt));
             }
             break;
@@ -6561,6 +7445,10 @@ void Compiler::optHoistThisLoop(unsigned lnum, LoopHoistContext* hoistCtxt)
 
     // Ensure the per-loop sets/tables are empty.
     hoistCtxt->m_curLoopVnInvariantCache.RemoveAll();
+    hoistCtxt->m_curLoopNonNullVNs.RemoveAll();
+
+    // The head dominates the entry, so any object it dereferences is known to be non-null in the loop.
+    optHoistRecordNonNullRefs(head, hoistCtxt);
 
 #ifdef DEBUG
     if (verbose)
@@ -6934,9 +7822,16 @@ bool Compiler::optHoistLoopExprsForTree(GenTreePtr        tree,
                 // first possible global side effect (and we assume we're after that if we're not in the first block).
                 // TODO-CQ: this is when we might do loop cloning.
                 //
+                // An array length or field load whose object was already dereferenced in the loop head
+                // cannot fault, so it may still be hoisted.
                 if ((tree->gtFlags & GTF_EXCEPT) != 0)
                 {
-                    treeIsHoistable = false;
+                    GenTreePtr ref = optHoistNullCheckedRef(tree);
+                    if ((ref == nullptr) || ((tree->gtGetOp1()->gtFlags & GTF_EXCEPT) != 0) ||
+                        !hoistCtxt->m_curLoopNonNullVNs.Lookup(ref->gtVNPair.GetLiberal()))
+                    {
+                        treeIsHoistable = false;
+                    }
                 }
             }
         }
@@ -7037,6 +7932,81 @@ bool Compiler::optHoistLoopExprsForTree(GenTreePtr        tree,
     return treeIsInvariant;
 }
 
+//------------------------------------------------------------------------
+// optHoistNullCheckedRef: Find the object reference whose null check is the only
+//    exception that the indirection "tree" itself can raise.
+//
+// Arguments:
+//    tree - The tree to examine
+//
+// Return Value:
+//    The array reference of a GT_ARR_LENGTH, or the object reference of a GT_IND
+//    at a constant offset small enough to be covered by the implicit null check;
+//    nullptr for anything else.
+//
+GenTreePtr Compiler::optHoistNullCheckedRef(GenTreePtr tree)
+{
+    if (tree->OperGet() == GT_ARR_LENGTH)
+    {
+        return tree->gtArrLen.ArrRef();
+    }
+
+    if ((tree->OperGet() != GT_IND) || ((tree->gtFlags & GTF_IND_ARR_INDEX) != 0))
+    {
+        return nullptr;
+    }
+
+    GenTreePtr addr   = tree->gtOp.gtOp1;
+    ssize_t    offset = 0;
+    while ((addr->OperGet() == GT_ADD) && (addr->TypeGet() == TYP_BYREF))
+    {
+        if (addr->gtGetOp2()->IsCnsIntOrI())
+        {
+            offset += addr->gtGetOp2()->gtIntCon.gtIconVal;
+            addr = addr->gtGetOp1();
+        }
+        else if (addr->gtGetOp1()->IsCnsIntOrI())
+        {
+            offset += addr->gtGetOp1()->gtIntCon.gtIconVal;
+            addr = addr->gtGetOp2();
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    if (fgIsBigOffset(offset) || (addr->TypeGet() != TYP_REF))
+    {
+        return nullptr;
+    }
+
+    return addr;
+}
+
+//------------------------------------------------------------------------
+// optHoistRecordNonNullRefs: Record the value numbers of the object references
+//    dereferenced in "blk" as known to be non-null in the current loop.
+//
+// Arguments:
+//    blk       - A block that dominates the entry of the current loop
+//    hoistCtxt - The hoisting context whose m_curLoopNonNullVNs is updated
+//
+void Compiler::optHoistRecordNonNullRefs(BasicBlock* blk, LoopHoistContext* hoistCtxt)
+{
+    for (GenTreeStmt* stmt = blk->FirstNonPhiDef(); stmt != nullptr; stmt = stmt->gtNextStmt)
+    {
+        for (GenTreePtr node = stmt->gtStmtList; node != nullptr; node = node->gtNext)
+        {
+            GenTreePtr ref = optHoistNullCheckedRef(node);
+            if ((ref != nullptr) && (ref->gtVNPair.GetLiberal() != ValueNumStore::NoVN))
+            {
+                hoistCtxt->m_curLoopNonNullVNs.Set(ref->gtVNPair.GetLiberal(), true);
+            }
+        }
+    }
+}
+
 void Compiler::optHoistCandidate(GenTreePtr tree, unsigned lnum, LoopHoistContext* hoistCtxt)
 {
     if (lnum == BasicBlock::NOT_IN_LOOP)
@@ -8058,6 +9028,40 @@ void Compiler::optRemoveRangeCheck(GenTreePtr tree, GenTreePtr stmt)
 #endif
 }
 
+#ifdef DEBUG
+//------------------------------------------------------------------------------
+// optDumpBndsChkReport: Report, under JitDump, how many bounds checks remain in
+//    the method and how many were removed by each optimization.
+//
+void Compiler::optDumpBndsChkReport()
+{
+    if (!verbose)
+    {
+        return;
+    }
+
+    unsigned remaining = 0;
+    for (BasicBlock* block = fgFirstBB; block != nullptr; block = block->bbNext)
+    {
+        for (GenTreeStmt* stmt = block->firstStmt(); stmt != nullptr; stmt = stmt->gtNextStmt)
+        {
+            for (GenTreePtr tree = stmt->gtStmtList; tree != nullptr; tree = tree->gtNext)
+            {
+                if (tree->OperIsBoundsCheck())
+                {
+                    remaining++;
+                }
+            }
+        }
+    }
+
+    printf("\nBounds checks in %s: %u remaining, %u removed by loop cloning, %u removed by assertion prop, %u "
+           "removed by range check\n",
+           info.compFullName, remaining, optBndsChksRemovedByCloning, optBndsChksRemovedByAssertionProp,
+           optBndsChksRemovedByRangeCheck);
+}
+#endif // DEBUG
+
 /*****************************************************************************
  * Return the scale in an array reference, given a pointer to the
  * multiplication node.
@@ -8385,7 +9389,21 @@ bool Compiler::optExtractArrIndex(GenTreePtr tree, ArrIndex* result, unsigned lh
         return false;
     }
     GenTreeBoundsChk* arrBndsChk = before->AsBoundsChk();
-    if (arrBndsChk->gtIndex->gtOper != GT_LCL_VAR)
+
+    // The index is either a local, or a local plus a small non-negative constant, like a[i + 1].
+    GenTreePtr indexLcl = arrBndsChk->gtIndex;
+    int        indexOff = 0;
+    if ((indexLcl->gtOper == GT_ADD) && (indexLcl->gtGetOp2()->gtOper == GT_CNS_INT))
+    {
+        ssize_t offset = indexLcl->gtGetOp2()->gtIntCon.gtIconVal;
+        if ((offset < 0) || (offset > MAX_ARR_INDEX_OFFSET))
+        {
+            return false;
+        }
+        indexOff = (int)offset;
+        indexLcl = indexLcl->gtGetOp1();
+    }
+    if (indexLcl->gtOper != GT_LCL_VAR)
     {
         return false;
     }
@@ -8408,7 +9426,7 @@ bool Compiler::optExtractArrIndex(GenTreePtr tree, ArrIndex* result, unsigned lh
         return false;
     }
 
-    unsigned indLcl = arrBndsChk->gtIndex->gtLclVarCommon.gtLclNum;
+    unsigned indLcl = indexLcl->gtLclVarCommon.gtLclNum;
 
     GenTreePtr after = tree->gtGetOp2();
 
@@ -8467,6 +9485,16 @@ bool Compiler::optExtractArrIndex(GenTreePtr tree, ArrIndex* result, unsigned lh
 #else
     GenTreePtr indexVar = index;
 #endif
+    if (indexOff != 0)
+    {
+        // The address must use the same "local + constant" as the bounds check.
+        if ((indexVar->gtOper != GT_ADD) || (indexVar->gtGetOp2()->gtOper != GT_CNS_INT) ||
+            (indexVar->gtGetOp2()->gtIntCon.gtIconVal != indexOff))
+        {
+            return false;
+        }
+        indexVar = indexVar->gtGetOp1();
+    }
     if (indexVar->gtOper != GT_LCL_VAR || indexVar->gtLclVarCommon.gtLclNum != indLcl)
     {
         return false;
@@ -8476,6 +9504,7 @@ bool Compiler::optExtractArrIndex(GenTreePtr tree, ArrIndex* result, unsigned lh
         result->arrLcl = arrLcl;
     }
     result->indLcls.Push(indLcl);
+    result->indOffs.Push(indexOff);
     result->bndsChks.Push(tree);
     result->useBlock = compCurBB;
     result->rank++;
@@ -8636,6 +9665,13 @@ Compiler::fgWalkResult Compiler::optCanOptimizeByLoopCloning(GenTreePtr tree, Lo
                         JITDUMP("V%02d is assigned in loop\n", arrIndex.indLcls[dim2]);
                         return WALK_SKIP_SUBTREES;
                     }
+
+                    // The cloning conditions dereference the outer dimensions using just the index locals.
+                    if (arrIndex.indOffs[dim2] != 0)
+                    {
+                        JITDUMP("V%02d has an offset on dim %d\n", arrIndex.indLcls[dim2], dim2);
+                        return WALK_SKIP_SUBTREES;
+                    }
                 }
 #ifdef DEBUG
                 if (verbose)
@@ -252,6 +252,7 @@ void RangeCheck::OptimizeRangeCheck(BasicBlock* block, GenTreePtr stmt, GenTreeP
         {
             JITDUMP("Removing range check\n");
             m_pCompiler->optRemoveRangeCheck(treeParent, stmt);
+            INDEBUG(m_pCompiler->optBndsChksRemovedByRangeCheck++);
             return;
         }
     }
@@ -293,6 +294,7 @@ void RangeCheck::OptimizeRangeCheck(BasicBlock* block, GenTreePtr stmt, GenTreeP
     {
         JITDUMP("[RangeCheck::OptimizeRangeCheck] Between bounds\n");
         m_pCompiler->optRemoveRangeCheck(treeParent, stmt);
+        INDEBUG(m_pCompiler->optBndsChksRemovedByRangeCheck++);
     }
     return;
 }
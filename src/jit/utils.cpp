@@ -1511,6 +1511,8 @@ void HelperCallProperties::init()
             case CORINFO_HELP_JIT_PINVOKE_BEGIN:
             case CORINFO_HELP_JIT_PINVOKE_END:
             case CORINFO_HELP_GETCURRENTMANAGEDTHREADID:
+            case CORINFO_HELP_LOOP_BACKEDGE_THRESHOLD:
+            case CORINFO_HELP_CLASSPROFILE:
 
                 noThrow = true;
                 break;
@@ -1494,6 +1494,22 @@ WaitForMultipleObjectsEx(
              IN DWORD dwMilliseconds,
              IN BOOL bAlertable);
 
+// Maximum number of handles PAL_WaitForAnyObjectEx can wait on
+#define PAL_MAXIMUM_WAIT_OBJECTS_EX 1024
+
+// Waits for any of up to PAL_MAXIMUM_WAIT_OBJECTS_EX handles. Returns WAIT_OBJECT_0 or
+// WAIT_ABANDONED_0 with the index of the signaled handle in *lpdwIndex, or WAIT_TIMEOUT,
+// WAIT_IO_COMPLETION or WAIT_FAILED like WaitForMultipleObjectsEx.
+PALIMPORT
+DWORD
+PALAPI
+PAL_WaitForAnyObjectEx(
+             IN DWORD nCount,
+             IN CONST HANDLE *lpHandles,
+             IN DWORD dwMilliseconds,
+             IN BOOL bAlertable,
+             OUT LPDWORD lpdwIndex);
+
 #define DUPLICATE_CLOSE_SOURCE      0x00000001
 #define DUPLICATE_SAME_ACCESS       0x00000002
 
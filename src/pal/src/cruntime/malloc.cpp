@@ -106,6 +106,14 @@ CorUnix::InternalMalloc(
     return pvMem;
 }
 
+void
+CorUnix::InternalFree(
+    void *pvMem
+    )
+{
+    free(pvMem);
+}
+
 char *
 __cdecl
 PAL__strdup(
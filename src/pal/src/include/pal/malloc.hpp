@@ -68,6 +68,11 @@ namespace CorUnix{
         size_t szSize
         );
 
+    void
+    InternalFree(
+        void *pvMem
+        );
+
     // Define common code for "new" style allocators below.
 #define INTERNAL_NEW_COMMON()                    \
         T *pMem = (T*)InternalMalloc(sizeof(T)); \
@@ -25,6 +25,7 @@ Abstract:
 #include "mutex.hpp"
 #include "shm.hpp"
 #include "list.h"
+#include "pal/malloc.hpp"
 
 #include <pthread.h>
 
@@ -41,7 +42,8 @@ namespace CorUnix
         BOOL bWaitAll,
         DWORD dwMilliseconds,
         BOOL bAlertable,
-        BOOL bPrioritize = FALSE);
+        BOOL bPrioritize = FALSE,
+        LPDWORD lpdwIndex = NULL);
     
     PAL_ERROR InternalSleepEx(
         CPalThread * pthrCurrent,
@@ -73,11 +75,24 @@ namespace CorUnix
         LONG lObjCount;
         LONG lSharedObjCount;
         CPalThread * pthrOwner;        
-        PWaitingThreadsListNode rgpWTLNodes[MAXIMUM_WAIT_OBJECTS];
+        LONG lMaxObjCount;
+        // Points to rgpWTLNodesInline, or to a larger heap array once the thread
+        // has waited on more than MAXIMUM_WAIT_OBJECTS objects (see PAL_WaitForAnyObjectEx)
+        PWaitingThreadsListNode * rgpWTLNodes;
+        PWaitingThreadsListNode rgpWTLNodesInline[MAXIMUM_WAIT_OBJECTS];
         
         _ThreadWaitInfo() : wtWaitType(SingleObject), wdWaitDomain(LocalWait), 
                             lObjCount(0), lSharedObjCount(0), 
-                            pthrOwner(NULL) {}
+                            pthrOwner(NULL), lMaxObjCount(MAXIMUM_WAIT_OBJECTS),
+                            rgpWTLNodes(rgpWTLNodesInline) {}
+
+        ~_ThreadWaitInfo()
+        {
+            if (rgpWTLNodes != rgpWTLNodesInline)
+            {
+                InternalFree(rgpWTLNodes);
+            }
+        }
     } ThreadWaitInfo;
 
     typedef struct _ThreadNativeWaitData 
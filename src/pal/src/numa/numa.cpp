@@ -835,18 +835,20 @@ VirtualAllocExNuma(
 #if HAVE_NUMA_H
             if (result != NULL && g_numaAvailable)
             {
-                int nodeMaskLength = (g_highestNumaNode + 1 + sizeof(unsigned long) - 1) / sizeof(unsigned long);
+                const int BitsPerNodeMaskWord = 8 * sizeof(unsigned long);
+                int nodeMaskLength = (g_highestNumaNode + 1 + BitsPerNodeMaskWord - 1) / BitsPerNodeMaskWord;
                 unsigned long *nodeMask = new unsigned long[nodeMaskLength];
 
-                memset(nodeMask, 0, nodeMaskLength);
+                memset(nodeMask, 0, nodeMaskLength * sizeof(unsigned long));
 
-                int index = nndPreferred / sizeof(unsigned long);
-                int mask = ((unsigned long)1) << (nndPreferred & (sizeof(unsigned long) - 1));
+                int index = nndPreferred / BitsPerNodeMaskWord;
+                unsigned long mask = ((unsigned long)1) << (nndPreferred % BitsPerNodeMaskWord);
                 nodeMask[index] = mask;
 
-                int st = mbind(result, dwSize, MPOL_PREFERRED, nodeMask, g_highestNumaNode, 0);
+                // maxnode is the number of bits in the mask plus one, the kernel ignores the last one
+                int st = mbind(result, dwSize, MPOL_PREFERRED, nodeMask, g_highestNumaNode + 2, 0);
 
-                free(nodeMask);
+                delete[] nodeMask;
                 _ASSERTE(st == 0);
                 // If the mbind fails, we still return the allocated memory since the nndPreferred is just a hint
             }
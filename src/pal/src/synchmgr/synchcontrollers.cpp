@@ -313,11 +313,37 @@ namespace CorUnix
             goto RWT_exit;        
         }
 
-        if (ptwiWaitInfo->lObjCount >= MAXIMUM_WAIT_OBJECTS)
+        if (ptwiWaitInfo->lObjCount >= ptwiWaitInfo->lMaxObjCount)
         {
-            ASSERT("Too many objects");
-            palErr = ERROR_INTERNAL_ERROR; 
-            goto RWT_exit;
+            // Only PAL_WaitForAnyObjectEx waits on more than MAXIMUM_WAIT_OBJECTS
+            // objects; grow the node array geometrically up to its limit
+            LONG lNewMaxObjCount = ptwiWaitInfo->lMaxObjCount * 2;
+            PWaitingThreadsListNode * rgpNewWTLNodes;
+
+            if (lNewMaxObjCount > PAL_MAXIMUM_WAIT_OBJECTS_EX)
+            {
+                ASSERT("Too many objects");
+                palErr = ERROR_INTERNAL_ERROR; 
+                goto RWT_exit;
+            }
+
+            rgpNewWTLNodes = (PWaitingThreadsListNode *)InternalMalloc(
+                lNewMaxObjCount * sizeof(PWaitingThreadsListNode));
+            if (NULL == rgpNewWTLNodes)
+            {
+                ERROR("Out of memory\n");
+                palErr = ERROR_NOT_ENOUGH_MEMORY;
+                goto RWT_exit;
+            }
+
+            memcpy(rgpNewWTLNodes, ptwiWaitInfo->rgpWTLNodes,
+                   ptwiWaitInfo->lObjCount * sizeof(PWaitingThreadsListNode));
+            if (ptwiWaitInfo->rgpWTLNodes != ptwiWaitInfo->rgpWTLNodesInline)
+            {
+                InternalFree(ptwiWaitInfo->rgpWTLNodes);
+            }
+            ptwiWaitInfo->rgpWTLNodes = rgpNewWTLNodes;
+            ptwiWaitInfo->lMaxObjCount = lNewMaxObjCount;
         }       
 
         if (0 == ptwiWaitInfo->lObjCount)
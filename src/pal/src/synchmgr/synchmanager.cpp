@@ -732,24 +732,46 @@ namespace CorUnix
             CSynchWaitController * pWaitCtrlrs[MAXIMUM_WAIT_OBJECTS];
             CSynchStateController * pStateCtrlrs[MAXIMUM_WAIT_OBJECTS];
         } Ctrlrs;
+        // Waits on more than MAXIMUM_WAIT_OBJECTS objects (PAL_WaitForAnyObjectEx)
+        // use a heap array instead of the stack one
+        CSynchWaitController ** ppWaitCtrlrs = Ctrlrs.pWaitCtrlrs;
+        CSynchStateController ** ppStateCtrlrs = Ctrlrs.pStateCtrlrs;
 
-        if ((dwObjectCount <= 0) || (dwObjectCount > MAXIMUM_WAIT_OBJECTS))
+        if ((dwObjectCount <= 0) || (dwObjectCount > PAL_MAXIMUM_WAIT_OBJECTS_EX))
         {
             palErr = ERROR_INVALID_PARAMETER;
             goto GSCFO_exit;
         }
 
+        if (dwObjectCount > MAXIMUM_WAIT_OBJECTS)
+        {
+            if (CSynchControllerBase::WaitController == ctCtrlrType)
+            {
+                ppWaitCtrlrs = InternalNewArray<CSynchWaitController *>(dwObjectCount);
+            }
+            else
+            {
+                ppStateCtrlrs = InternalNewArray<CSynchStateController *>(dwObjectCount);
+            }
+
+            if (NULL == ppWaitCtrlrs || NULL == ppStateCtrlrs)
+            {
+                palErr = ERROR_NOT_ENOUGH_MEMORY;
+                goto GSCFO_exit;
+            }
+        }
+
         if (CSynchControllerBase::WaitController == ctCtrlrType)
         {
             uCount = (unsigned int)m_cacheWaitCtrlrs.Get(pthrCurrent,
                                                          dwObjectCount,
-                                                         Ctrlrs.pWaitCtrlrs);
+                                                         ppWaitCtrlrs);
         }
         else
         {
             uCount = (unsigned int)m_cacheStateCtrlrs.Get(pthrCurrent,
                                                           dwObjectCount,
-                                                          Ctrlrs.pStateCtrlrs);
+                                                          ppStateCtrlrs);
         }
 
         if (uCount < dwObjectCount)
@@ -811,21 +833,21 @@ namespace CorUnix
 
             if (CSynchControllerBase::WaitController == ctCtrlrType)
             {
-                Ctrlrs.pWaitCtrlrs[uIdx]->Init(pthrCurrent,
-                                            ctCtrlrType,
-                                            odObjectDomain,
-                                            potObjectType,
-                                            psdSynchData,
-                                            wdWaitDomain);
+                ppWaitCtrlrs[uIdx]->Init(pthrCurrent,
+                                         ctCtrlrType,
+                                         odObjectDomain,
+                                         potObjectType,
+                                         psdSynchData,
+                                         wdWaitDomain);
             }
             else
             {
-                Ctrlrs.pStateCtrlrs[uIdx]->Init(pthrCurrent,
-                                             ctCtrlrType,
-                                             odObjectDomain,
-                                             potObjectType,
-                                             psdSynchData,
-                                             wdWaitDomain);
+                ppStateCtrlrs[uIdx]->Init(pthrCurrent,
+                                          ctCtrlrType,
+                                          odObjectDomain,
+                                          potObjectType,
+                                          psdSynchData,
+                                          wdWaitDomain);
             }
 
             if (CSynchControllerBase::WaitController == ctCtrlrType &&
@@ -851,7 +873,7 @@ namespace CorUnix
                     break;
                 }
 
-                Ctrlrs.pWaitCtrlrs[uIdx]->SetProcessData(rgObjects[uIdx], pProcLocData);
+                ppWaitCtrlrs[uIdx]->SetProcessData(rgObjects[uIdx], pProcLocData);
                 pDataLock->ReleaseLock(pthrCurrent, false);
             }
         }
@@ -881,7 +903,7 @@ namespace CorUnix
                 // return the given pointer incremented by the size of a
                 // generic pointer on the specific platform
                 ppvControllers[uIdx] = reinterpret_cast<void *>(
-                    static_cast<ISynchWaitController *>(Ctrlrs.pWaitCtrlrs[uIdx]));
+                    static_cast<ISynchWaitController *>(ppWaitCtrlrs[uIdx]));
             }
         }
         else
@@ -890,7 +912,7 @@ namespace CorUnix
             {
                 // See comment above
                 ppvControllers[uIdx] = reinterpret_cast<void *>(
-                    static_cast<ISynchStateController *>(Ctrlrs.pStateCtrlrs[uIdx]));
+                    static_cast<ISynchStateController *>(ppStateCtrlrs[uIdx]));
             }
         }
 
@@ -903,13 +925,13 @@ namespace CorUnix
             // Release already initialized wait controllers
             for (uIdx=0; uIdx<uErrCleanupIdxFirstNotInitializedCtrlr; uIdx++)
             {
-                Ctrlrs.pWaitCtrlrs[uIdx]->Release();
+                ppWaitCtrlrs[uIdx]->Release();
             }
 
             // Return to the cache not yet initialized wait controllers
             for (uIdx=uErrCleanupIdxFirstNotInitializedCtrlr; uIdx<uErrCleanupIdxLastCtrlr; uIdx++)
             {
-                m_cacheWaitCtrlrs.Add(pthrCurrent, Ctrlrs.pWaitCtrlrs[uIdx]);
+                m_cacheWaitCtrlrs.Add(pthrCurrent, ppWaitCtrlrs[uIdx]);
             }
         }
         else
@@ -917,13 +939,13 @@ namespace CorUnix
             // Release already initialized state controllers
             for (uIdx=0; uIdx<uErrCleanupIdxFirstNotInitializedCtrlr; uIdx++)
             {
-                Ctrlrs.pStateCtrlrs[uIdx]->Release();
+                ppStateCtrlrs[uIdx]->Release();
             }
 
             // Return to the cache not yet initialized state controllers
             for (uIdx=uErrCleanupIdxFirstNotInitializedCtrlr; uIdx<uErrCleanupIdxLastCtrlr; uIdx++)
             {
-                m_cacheStateCtrlrs.Add(pthrCurrent, Ctrlrs.pStateCtrlrs[uIdx]);
+                m_cacheStateCtrlrs.Add(pthrCurrent, ppStateCtrlrs[uIdx]);
             }
         }
 
@@ -932,6 +954,14 @@ namespace CorUnix
         {
             ReleaseLocalSynchLock(pthrCurrent);
         }
+        if (ppWaitCtrlrs != Ctrlrs.pWaitCtrlrs)
+        {
+            InternalDeleteArray(ppWaitCtrlrs);
+        }
+        if (ppStateCtrlrs != Ctrlrs.pStateCtrlrs)
+        {
+            InternalDeleteArray(ppStateCtrlrs);
+        }
         return palErr;
     }
 
@@ -193,6 +193,49 @@ WaitForMultipleObjectsEx(IN DWORD nCount,
     return dwRet;
 }
 
+/*++
+Function:
+  PAL_WaitForAnyObjectEx
+
+Like WaitForMultipleObjectsEx with bWaitAll == FALSE, but accepts up to
+PAL_MAXIMUM_WAIT_OBJECTS_EX handles. Since WAIT_OBJECT_0 + nCount would
+overlap the other return codes for that many handles, the index of the
+signaled or abandoned object is returned in *lpdwIndex instead.
+--*/
+DWORD
+PALAPI
+PAL_WaitForAnyObjectEx(IN DWORD nCount,
+                       IN CONST HANDLE *lpHandles,
+                       IN DWORD dwMilliseconds,
+                       IN BOOL bAlertable,
+                       OUT LPDWORD lpdwIndex)
+{
+    DWORD dwRet;
+
+    PERF_ENTRY(PAL_WaitForAnyObjectEx);
+    ENTRY("PAL_WaitForAnyObjectEx(nCount=%d, lpHandles=%p,"
+          " dwMilliseconds=%u, bAlertable=%d, lpdwIndex=%p)\n",
+          nCount, lpHandles, dwMilliseconds, bAlertable, lpdwIndex);
+
+    CPalThread * pThread = InternalGetCurrentThread();
+
+    if (NULL == lpdwIndex)
+    {
+        ERROR("lpdwIndex is NULL\n");
+        pThread->SetLastError(ERROR_INVALID_PARAMETER);
+        dwRet = WAIT_FAILED;
+    }
+    else
+    {
+        dwRet = InternalWaitForMultipleObjectsEx(pThread, nCount, lpHandles, FALSE,
+                                                 dwMilliseconds, bAlertable, FALSE, lpdwIndex);
+    }
+
+    LOGEXIT("PAL_WaitForAnyObjectEx returns DWORD %u\n", dwRet);
+    PERF_EXIT(PAL_WaitForAnyObjectEx);
+    return dwRet;
+}
+
 /*++
 Function:
   Sleep
@@ -315,7 +358,8 @@ DWORD CorUnix::InternalWaitForMultipleObjectsEx(
     BOOL bWaitAll,
     DWORD dwMilliseconds,
     BOOL bAlertable,
-    BOOL bPrioritize)
+    BOOL bPrioritize,
+    LPDWORD lpdwIndex)
 {
     DWORD dwRet = WAIT_FAILED;
     PAL_ERROR palErr = NO_ERROR;
@@ -328,13 +372,17 @@ DWORD CorUnix::InternalWaitForMultipleObjectsEx(
     ISynchWaitController  * pISyncStackArray[MAXIMUM_STACK_WAITOBJ_ARRAY_SIZE] = { NULL };
     IPalObject           ** ppIPalObjs = pIPalObjStackArray;
     ISynchWaitController ** ppISyncWaitCtrlrs = pISyncStackArray;
+    // Callers that take the index separately can wait on more objects
+    DWORD dwMaxCount = (NULL != lpdwIndex) ? PAL_MAXIMUM_WAIT_OBJECTS_EX : MAXIMUM_WAIT_OBJECTS;
   
-    if ((nCount == 0) || (nCount > MAXIMUM_WAIT_OBJECTS))
+    _ASSERTE(NULL == lpdwIndex || !bWaitAll);
+
+    if ((nCount == 0) || (nCount > dwMaxCount))
     {
         ppIPalObjs = NULL;        // make delete at the end safe
         ppISyncWaitCtrlrs = NULL; // make delete at the end safe       
         ERROR("Invalid object count=%d [range: 1 to %d]\n", 
-               nCount, MAXIMUM_WAIT_OBJECTS)
+               nCount, dwMaxCount)
         pThread->SetLastError(ERROR_INVALID_PARAMETER);
         goto WFMOExIntExit;
     }
@@ -649,7 +697,15 @@ WFMOExIntReleaseControllers:
             dwRet = WAIT_FAILED;
             goto WFMOExIntCleanup;
         }
-        dwRet += iSignaledObjIndex;
+
+        if (NULL != lpdwIndex)
+        {
+            *lpdwIndex = iSignaledObjIndex;
+        }
+        else
+        {
+            dwRet += iSignaledObjIndex;
+        }
     }
 
 WFMOExIntCleanup:
@@ -0,0 +1,96 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: test1.cpp
+**
+** Purpose: Positive test for PAL_WaitForAnyObjectEx. Waits on more
+**          than MAXIMUM_WAIT_OBJECTS events, makes sure the index of
+**          the signaled event is returned, that the wait times out
+**          when no event is signaled and that handle counts above
+**          PAL_MAXIMUM_WAIT_OBJECTS_EX are rejected.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define NUM_EVENTS (MAXIMUM_WAIT_OBJECTS * 3)
+
+HANDLE hEvents[NUM_EVENTS];
+
+void CloseEvents()
+{
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        if (hEvents[i] != NULL)
+        {
+            CloseHandle(hEvents[i]);
+        }
+    }
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    DWORD dwRet;
+    DWORD dwIndex;
+    DWORD dwSignaled[] = { 0, MAXIMUM_WAIT_OBJECTS + 1, NUM_EVENTS - 1 };
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        hEvents[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (hEvents[i] == NULL)
+        {
+            CloseEvents();
+            Fail("CreateEvent failed for event %d. GetLastError returned %u.\n",
+                 i, GetLastError());
+        }
+    }
+
+    /* Nothing signaled: the wait must time out */
+    dwRet = PAL_WaitForAnyObjectEx(NUM_EVENTS, hEvents, 0, FALSE, &dwIndex);
+    if (dwRet != WAIT_TIMEOUT)
+    {
+        CloseEvents();
+        Fail("PAL_WaitForAnyObjectEx returned %u instead of WAIT_TIMEOUT.\n", dwRet);
+    }
+
+    for (int i = 0; i < (int)(sizeof(dwSignaled) / sizeof(dwSignaled[0])); i++)
+    {
+        if (!SetEvent(hEvents[dwSignaled[i]]))
+        {
+            CloseEvents();
+            Fail("SetEvent failed for event %u. GetLastError returned %u.\n",
+                 dwSignaled[i], GetLastError());
+        }
+
+        dwIndex = (DWORD)-1;
+        dwRet = PAL_WaitForAnyObjectEx(NUM_EVENTS, hEvents, 5000, FALSE, &dwIndex);
+        if (dwRet != WAIT_OBJECT_0 || dwIndex != dwSignaled[i])
+        {
+            CloseEvents();
+            Fail("PAL_WaitForAnyObjectEx returned %u with index %u, expected "
+                 "WAIT_OBJECT_0 with index %u.\n", dwRet, dwIndex, dwSignaled[i]);
+        }
+    }
+
+    /* More handles than the API supports must be rejected */
+    dwRet = PAL_WaitForAnyObjectEx(PAL_MAXIMUM_WAIT_OBJECTS_EX + 1, hEvents, 0, FALSE, &dwIndex);
+    if (dwRet != WAIT_FAILED || GetLastError() != ERROR_INVALID_PARAMETER)
+    {
+        CloseEvents();
+        Fail("PAL_WaitForAnyObjectEx returned %u for too many handles, "
+             "expected WAIT_FAILED with ERROR_INVALID_PARAMETER.\n", dwRet);
+    }
+
+    CloseEvents();
+
+    PAL_Terminate();
+    return PASS;
+}
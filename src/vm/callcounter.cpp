@@ -16,13 +16,27 @@
 
 #ifdef FEATURE_TIERED_COMPILATION
 
-CallCounter::CallCounter()
+CallCounter::CallCounter() :
+    m_pTable(NULL)
 {
     LIMITED_METHOD_CONTRACT;
 
     m_lock.Init(LOCK_TYPE_DEFAULT);
 }
 
+CallCounter::~CallCounter()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    CallCounterTable* pTable = m_pTable;
+    while (pTable != NULL)
+    {
+        CallCounterTable* pPrevious = pTable->pPrevious;
+        delete[] (BYTE*)pTable;
+        pTable = pPrevious;
+    }
+}
+
 // This is called by the prestub each time the method is invoked in a particular
 // AppDomain (the AppDomain for which AppDomain.GetCallCounter() == this). These
 // calls continue until we backpatch the prestub to avoid future calls. This allows
@@ -38,44 +52,153 @@ BOOL CallCounter::OnMethodCalled(MethodDesc* pMethodDesc)
 
     _ASSERTE(pMethodDesc->IsEligibleForTieredCompilation());
 
-    // PERF: This as a simple to implement, but not so performant, call counter
-    // Currently this is only called until we reach a fixed call count and then
-    // disabled. Its likely we'll want to improve this at some point but
-    // its not as bad as you might expect. Allocating a counter inline in the
-    // MethodDesc or at some location computable from the MethodDesc should
-    // eliminate 1 pointer per-method (the MethodDesc* key) and the CPU
-    // overhead to acquire the lock/search the dictionary. Depending on where it
-    // is we may also be able to reduce it to 1 byte counter without wasting the
-    // following bytes for alignment. Further work to inline the OnMethodCalled
-    // callback directly into the jitted code would eliminate CPU overhead of 
-    // leaving the prestub unpatched, but may not be good overall as it increases
-    // the size of the jitted code.
-
-
-    TieredCompilationManager* pCallCounterSink = NULL;
-    int callCount;
+    // PERF: Allocating a counter inline in the MethodDesc or at some location
+    // computable from the MethodDesc would eliminate 1 pointer per-method (the
+    // MethodDesc* key) and the CPU overhead to probe the table. Further work to
+    // inline the OnMethodCalled callback directly into the jitted code would
+    // eliminate CPU overhead of leaving the prestub unpatched, but may not be good
+    // overall as it increases the size of the jitted code.
+    //
+    // Calls are counted with interlocked increments but the table is lock-free, so
+    // when it is grown concurrently (see GrowTable) increments made in the old table
+    // can be lost and the same count can be observed by more than one caller. Counts
+    // may therefore be skipped or repeated, the only guarantee is that some caller
+    // observes a count at or past the threshold, and TieredCompilationManager
+    // tolerates being notified of the threshold more than once.
+    CallCounterEntry* pEntry = FindOrAddEntry(pMethodDesc);
+    int callCount = InterlockedIncrement(&pEntry->callCount);
+
+    return GetAppDomain()->GetTieredCompilationManager()->OnMethodCalled(pMethodDesc, callCount,
+        pEntry->firstCallTickCount);
+}
+
+// Returns the slot counting calls to pMethodDesc, claiming a new slot if the
+// method has not been seen before. Only takes a lock when the table must grow.
+CallCounterEntry* CallCounter::FindOrAddEntry(MethodDesc* pMethodDesc)
+{
+    STANDARD_VM_CONTRACT;
+
+    COUNT_T hash = Hash(pMethodDesc);
+
+    CallCounterTable* pTable = VolatileLoad(&m_pTable);
+    if (pTable == NULL)
+    {
+        pTable = GrowTable(NULL);
+    }
+
+    while (true)
     {
-        //Be careful if you convert to something fully lock/interlocked-free that
-        //you correctly handle what happens when some N simultaneous calls don't
-        //all increment the counter. The slight drift is probably neglible for tuning
-        //but TieredCompilationManager::OnMethodCalled() doesn't expect multiple calls
-        //each claiming to be exactly the threshhold call count needed to trigger
-        //optimization.
-        SpinLockHolder holder(&m_lock);
-        CallCounterEntry* pEntry = const_cast<CallCounterEntry*>(m_methodToCallCount.LookupPtr(pMethodDesc));
-        if (pEntry == NULL)
+        COUNT_T mask = pTable->capacity - 1;
+        COUNT_T maxCount = (pTable->capacity / 4) * s_maxLoadQuarters;
+        COUNT_T index = hash & mask;
+        for (COUNT_T probes = 0; probes < pTable->capacity; probes++)
         {
-            callCount = 1;
-            m_methodToCallCount.Add(CallCounterEntry(pMethodDesc, callCount));
+            CallCounterEntry* pEntry = &pTable->entries[index];
+            const MethodDesc* pKey = pEntry->pMethod;
+            if (pKey == pMethodDesc)
+            {
+                return pEntry;
+            }
+            if (pKey == NULL)
+            {
+                if ((COUNT_T)pTable->count >= maxCount)
+                {
+                    break;
+                }
+                pKey = InterlockedCompareExchangeT(&pEntry->pMethod, (const MethodDesc*)pMethodDesc, (const MethodDesc*)NULL);
+                if (pKey == NULL)
+                {
+                    // Other threads may already be counting calls in the slot, the tick count is
+                    // published last and readers treat 0 as unknown
+                    DWORD tickCount = GetTickCount();
+                    pEntry->firstCallTickCount = (tickCount != 0) ? tickCount : 1;
+                    InterlockedIncrement(&pTable->count);
+                    return pEntry;
+                }
+                if (pKey == pMethodDesc)
+                {
+                    return pEntry;
+                }
+            }
+            index = (index + 1) & mask;
         }
-        else
+
+        pTable = GrowTable(pTable);
+    }
+}
+
+// Replaces pTable with a table twice as large holding the same counts and returns
+// the new current table. If another thread has already replaced pTable the current
+// table is returned instead.
+//
+// Threads still probing pTable may claim slots or increment counts in it after its
+// contents have been copied. Those calls are lost, which only delays promotion of
+// the affected methods by a few calls.
+CallCounterTable* CallCounter::GrowTable(CallCounterTable* pTable)
+{
+    STANDARD_VM_CONTRACT;
+
+    SpinLockHolder holder(&m_lock);
+    if (m_pTable != pTable)
+    {
+        return m_pTable;
+    }
+
+    CallCounterTable* pNewTable;
+    if (pTable == NULL)
+    {
+        pNewTable = AllocateTable(s_initialCapacity);
+    }
+    else
+    {
+        pNewTable = AllocateTable(pTable->capacity * 2);
+        COUNT_T mask = pNewTable->capacity - 1;
+        for (COUNT_T i = 0; i < pTable->capacity; i++)
         {
-            pEntry->callCount++;
-            callCount = pEntry->callCount;
+            const MethodDesc* pKey = pTable->entries[i].pMethod;
+            if (pKey == NULL)
+            {
+                continue;
+            }
+
+            COUNT_T index = Hash(pKey) & mask;
+            while (pNewTable->entries[index].pMethod != NULL)
+            {
+                index = (index + 1) & mask;
+            }
+            pNewTable->entries[index].pMethod = pKey;
+            pNewTable->entries[index].callCount = pTable->entries[i].callCount;
+            pNewTable->entries[index].firstCallTickCount = pTable->entries[i].firstCallTickCount;
+            pNewTable->count++;
         }
+        pNewTable->pPrevious = pTable;
+    }
+
+    LOG((LF_TIEREDCOMPILATION, LL_INFO1000, "CallCounter::GrowTable capacity=%u count=%u\n",
+        pNewTable->capacity, pNewTable->count));
+
+    VolatileStore(&m_pTable, pNewTable);
+    return pNewTable;
+}
+
+//static
+CallCounterTable* CallCounter::AllocateTable(COUNT_T capacity)
+{
+    STANDARD_VM_CONTRACT;
+
+    _ASSERTE((capacity & (capacity - 1)) == 0);
+
+    S_SIZE_T cbTable = S_SIZE_T(offsetof(CallCounterTable, entries)) +
+        S_SIZE_T(capacity) * S_SIZE_T(sizeof(CallCounterEntry));
+    if (cbTable.IsOverflow())
+    {
+        ThrowOutOfMemory();
     }
 
-    return GetAppDomain()->GetTieredCompilationManager()->OnMethodCalled(pMethodDesc, callCount);
+    CallCounterTable* pTable = (CallCounterTable*)new BYTE[cbTable.Value()];
+    memset(pTable, 0, cbTable.Value());
+    pTable->capacity = capacity;
+    return pTable;
 }
 
 #endif // FEATURE_TIERED_COMPILATION
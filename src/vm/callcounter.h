@@ -12,55 +12,39 @@
 
 #ifdef FEATURE_TIERED_COMPILATION
 
-// One entry in our dictionary mapping methods to the number of times they
-// have been invoked
+// One slot in the call counting table mapping methods to the number of times they
+// have been invoked. The slot is claimed by publishing pMethod with an interlocked
+// compare-exchange and is never released, after which callCount is only updated with
+// interlocked increments. firstCallTickCount is written once by the thread that claimed
+// the slot, after the slot is published, and is used to estimate how frequently the method
+// is called. It is never 0 once written, so 0 means it is not known yet.
 struct CallCounterEntry
 {
-    CallCounterEntry() {}
-    CallCounterEntry(const MethodDesc* m, const int c)
-        : pMethod(m), callCount(c) {}
-
-    const MethodDesc* pMethod;
-    int callCount;
+    const MethodDesc* volatile pMethod;
+    volatile LONG callCount;
+    volatile DWORD firstCallTickCount;
 };
 
-class CallCounterHashTraits : public DefaultSHashTraits<CallCounterEntry>
+// A fixed capacity, open addressing table of CallCounterEntry. Tables are only
+// ever replaced by larger ones, never freed while the owning CallCounter is alive,
+// because threads counting calls may still be probing a table after it has been
+// superseded.
+struct CallCounterTable
 {
-public:
-    typedef typename DefaultSHashTraits<CallCounterEntry>::element_t element_t;
-    typedef typename DefaultSHashTraits<CallCounterEntry>::count_t count_t;
-
-    typedef const MethodDesc* key_t;
-
-    static key_t GetKey(element_t e)
-    {
-        LIMITED_METHOD_CONTRACT;
-        return e.pMethod;
-    }
-    static BOOL Equals(key_t k1, key_t k2)
-    {
-        LIMITED_METHOD_CONTRACT;
-        return k1 == k2;
-    }
-    static count_t Hash(key_t k)
-    {
-        LIMITED_METHOD_CONTRACT;
-        return (count_t)(size_t)k;
-    }
-
-    static const element_t Null() { LIMITED_METHOD_CONTRACT; return element_t(NULL, 0); }
-    static const element_t Deleted() { LIMITED_METHOD_CONTRACT; return element_t((const MethodDesc*)-1, 0); }
-    static bool IsNull(const element_t &e) { LIMITED_METHOD_CONTRACT; return e.pMethod == NULL; }
-    static bool IsDeleted(const element_t &e) { return e.pMethod == (const MethodDesc*)-1; }
+    CallCounterTable* pPrevious;    // the table this one replaced, freed with the CallCounter
+    COUNT_T capacity;               // always a power of 2
+    volatile LONG count;            // number of slots claimed
+    CallCounterEntry entries[1];    // really entries[capacity]
 };
 
-typedef SHash<NoRemoveSHashTraits<CallCounterHashTraits>> CallCounterHash;
-
-
 // This is a per-appdomain cache of call counts for all code in that AppDomain.
 // Each method invocation should trigger a call to OnMethodCalled (until it is disabled per-method)
 // and the CallCounter will forward the call to the TieredCompilationManager including the
 // current call count.
+//
+// Counting does not take a lock. Many threads calling many different tier0 methods
+// during startup would otherwise serialize on a single per-AppDomain lock. m_lock
+// is only taken to grow the table, which happens O(log(methods)) times.
 class CallCounter
 {
 public:
@@ -68,15 +52,34 @@ public:
     CallCounter() {}
 #else
     CallCounter();
+    ~CallCounter();
 #endif
 
     BOOL OnMethodCalled(MethodDesc* pMethodDesc);
 
 private:
 
-    // fields protected by lock
+    CallCounterEntry* FindOrAddEntry(MethodDesc* pMethodDesc);
+    CallCounterTable* GrowTable(CallCounterTable* pTable);
+
+    static CallCounterTable* AllocateTable(COUNT_T capacity);
+
+    static COUNT_T Hash(const MethodDesc* pMethodDesc)
+    {
+        LIMITED_METHOD_CONTRACT;
+        // MethodDescs are at least 8 byte aligned, discard the low bits before mixing
+        return (COUNT_T)(((size_t)pMethodDesc >> 3) * 2654435761U);
+    }
+
+    static const COUNT_T s_initialCapacity = 256;
+
+    // The table is grown once it is this full, measured in 1/4ths, to keep probe
+    // sequences short.
+    static const COUNT_T s_maxLoadQuarters = 3;
+
+    // m_pTable is read with VolatileLoad without the lock, it is only written with m_lock held
+    CallCounterTable* m_pTable;
     SpinLock m_lock;
-    CallCounterHash m_methodToCallCount;
 };
 
 #endif // FEATURE_TIERED_COMPILATION
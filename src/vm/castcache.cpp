@@ -0,0 +1,107 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+// ===========================================================================
+// File: CastCache.cpp
+//
+// ===========================================================================
+
+
+
+#include "common.h"
+#include "castcache.h"
+
+CastCacheEntry* CastCache::s_pEntries = NULL;
+DWORD CastCache::s_mask = 0;
+bool CastCache::s_fTrackStats = false;
+
+LONG CastCache::s_hitCount = 0;
+LONG CastCache::s_missCount = 0;
+LONG CastCache::s_insertCount = 0;
+
+void CastCache::Initialize()
+{
+    STANDARD_VM_CONTRACT;
+
+    // Round the configured size down to a power of 2. A size below 2 disables the cache,
+    // in which case s_mask stays 0 and no entries are ever allocated.
+    DWORD size = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_CastCacheSize);
+    if (size >= 2)
+    {
+        DWORD log2Size = 0;
+        while ((size >> (log2Size + 1)) != 0)
+            log2Size++;
+        s_mask = (1 << log2Size) - 1;
+    }
+
+    s_fTrackStats = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_CastCacheTrackStats) != 0;
+}
+
+void CastCache::TrySet(MethodTable* pSourceMT, TypeHandle targetType, BOOL fCanCast)
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        PRECONDITION(CheckPointer(pSourceMT));
+        PRECONDITION(!targetType.IsNull());
+    } CONTRACTL_END;
+
+    if (s_mask == 0)
+        return;
+
+    // Casts of proxies, COM objects and ICastable implementations depend on the instance
+    if (pSourceMT->IsTransparentProxy() || pSourceMT->IsComObjectType() || pSourceMT->IsICastable())
+        return;
+
+    // Entries are never removed, so they must not outlive either type
+    if (pSourceMT->Collectible() || targetType.GetLoaderAllocator()->IsCollectible())
+        return;
+
+    CastCacheEntry* pEntries = VolatileLoad(&s_pEntries);
+    if (pEntries == NULL)
+    {
+        pEntries = new (nothrow) CastCacheEntry[s_mask + 1];
+        if (pEntries == NULL)
+            return;
+        memset(pEntries, 0, sizeof(CastCacheEntry) * (s_mask + 1));
+
+        CastCacheEntry* pExisting = InterlockedCompareExchangeT(&s_pEntries, pEntries, (CastCacheEntry*)NULL);
+        if (pExisting != NULL)
+        {
+            delete [] pEntries;
+            pEntries = pExisting;
+        }
+    }
+
+    CastCacheEntry* pEntry = &pEntries[GetIndex(pSourceMT, targetType.AsTAddr())];
+
+    LONG version = VolatileLoad(&pEntry->version);
+    if ((version & 1) != 0 ||
+        FastInterlockCompareExchange(&pEntry->version, version + 1, version) != version)
+    {
+        // Another thread is updating this entry
+        return;
+    }
+
+    pEntry->pSourceMT = pSourceMT;
+    pEntry->targetType = targetType.AsTAddr();
+    pEntry->canCast = fCanCast ? 1 : 0;
+    VolatileStore(&pEntry->version, version + 2);
+
+    if (s_fTrackStats)
+        FastInterlockIncrement(&s_insertCount);
+}
+
+void CastCache::WriteStatsToSTRESSLOG()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (!s_fTrackStats)
+        return;
+
+    LONG lookups = s_hitCount + s_missCount;
+    STRESS_LOG5(LF_ALL, LL_ALWAYS, "CastCache: %d lookups, %d hits (%d%%), %d misses, %d insertions\n",
+                lookups, s_hitCount, (lookups == 0) ? 0 : (int)((s_hitCount * 100LL) / lookups),
+                s_missCount, s_insertCount);
+}
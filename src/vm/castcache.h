@@ -0,0 +1,100 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+// ===========================================================================
+// File: CastCache.h
+//
+// ===========================================================================
+
+
+#ifndef CAST_CACHE_H
+#define CAST_CACHE_H
+
+// One slot of the cast cache. version is odd while a writer owns the slot and is
+// bumped by two for every completed update, so a reader that observes the same even
+// version before and after reading the other fields has read a consistent entry.
+struct CastCacheEntry
+{
+    LONG version;
+    LONG canCast;
+    MethodTable* pSourceMT;
+    TADDR targetType;
+};
+
+// A process wide, fixed size, direct mapped cache of cast results keyed by the
+// MethodTable of the object being cast and the target type. The frameless casting
+// helpers consult it when the structural NoGC checks are inconclusive (variance,
+// type equivalence, arrays), which would otherwise send them to a framed helper
+// and TypeHandle::CanCastTo. The framed helpers populate it with their results.
+//
+// Lookups take no locks. Insertions claim a slot with an interlocked compare-exchange
+// of its version and simply give up when another thread owns it; losing an insertion
+// only costs a later miss. Entries are overwritten on collision and never removed, so
+// types whose result may change or whose MethodTable may be freed are never cached.
+class CastCache
+{
+public:
+    static void Initialize();
+
+    // Returns CanCast or CannotCast if the result of casting an object with
+    // MethodTable pSourceMT to targetType is cached, MaybeCast otherwise.
+    static TypeHandle::CastResult TryGet(MethodTable* pSourceMT, TypeHandle targetType)
+    {
+        CONTRACTL {
+            NOTHROW;
+            GC_NOTRIGGER;
+            MODE_ANY;
+            SO_TOLERANT;
+        } CONTRACTL_END;
+
+        CastCacheEntry* pEntries = VolatileLoad(&s_pEntries);
+        if (pEntries == NULL)
+            return TypeHandle::MaybeCast;
+
+        CastCacheEntry* pEntry = &pEntries[GetIndex(pSourceMT, targetType.AsTAddr())];
+
+        LONG version = VolatileLoad(&pEntry->version);
+        if ((version & 1) == 0 &&
+            VolatileLoad(&pEntry->pSourceMT) == pSourceMT &&
+            VolatileLoad(&pEntry->targetType) == targetType.AsTAddr())
+        {
+            LONG canCast = VolatileLoad(&pEntry->canCast);
+            if (VolatileLoad(&pEntry->version) == version)
+            {
+                if (s_fTrackStats)
+                    FastInterlockIncrement(&s_hitCount);
+                return canCast ? TypeHandle::CanCast : TypeHandle::CannotCast;
+            }
+        }
+
+        if (s_fTrackStats)
+            FastInterlockIncrement(&s_missCount);
+        return TypeHandle::MaybeCast;
+    }
+
+    // Records the result of casting an object with MethodTable pSourceMT to
+    // targetType, if that result can be cached.
+    static void TrySet(MethodTable* pSourceMT, TypeHandle targetType, BOOL fCanCast);
+
+    // Dumps the hit rate counters, enabled with CastCacheTrackStats, at shutdown
+    static void WriteStatsToSTRESSLOG();
+
+private:
+    static DWORD GetIndex(MethodTable* pSourceMT, TADDR targetType)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        size_t hash = (((size_t)pSourceMT >> 3) * 0x9E3779B1) ^ (targetType >> 3);
+        return (DWORD)(hash ^ (hash >> 16)) & s_mask;
+    }
+
+    static CastCacheEntry* s_pEntries;  // allocated on first insertion
+    static DWORD s_mask;                // number of entries - 1, the number of entries is a power of 2
+    static bool s_fTrackStats;
+
+    static LONG s_hitCount;
+    static LONG s_missCount;
+    static LONG s_insertCount;
+};
+
+#endif // CAST_CACHE_H
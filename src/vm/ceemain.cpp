@@ -166,6 +166,7 @@
 #include "stackprobe.h"
 #include "posterror.h"
 #include "virtualcallstub.h"
+#include "castcache.h"
 #include "strongnameinternal.h"
 #include "syncclean.hpp"
 #include "typeparse.h"
@@ -1941,6 +1942,7 @@ part2:
                     FcallTimeHist[8], FcallTimeHist[9], FcallTimeHist[10]));
 
                 WriteJitHelperCountToSTRESSLOG();
+                CastCache::WriteStatsToSTRESSLOG();
 
                 STRESS_LOG0(LF_STARTUP, LL_INFO10, "EEShutdown shutting down logging");
 
@@ -533,17 +533,22 @@ static size_t GetRestrictedPhysicalMemoryLimit()
 // Get the physical memory that this process can use.
 // Return:
 //  non zero if it has succeeded, 0 if it has failed
-uint64_t GCToOSInterface::GetPhysicalMemoryLimit()
+uint64_t GCToOSInterface::GetPhysicalMemoryLimit(bool* is_restricted)
 {
     LIMITED_METHOD_CONTRACT;
 
+    MEMORYSTATUSEX memStatus;
+    ::GetProcessMemoryLoad(&memStatus);
+
+    // The restricted limit is capped at the amount of physical memory, and on
+    // Unix it is the amount of physical memory when there is no restriction.
     size_t restricted_limit = GetRestrictedPhysicalMemoryLimit();
+    if (is_restricted)
+        *is_restricted = (restricted_limit != 0) && (restricted_limit < memStatus.ullTotalPhys);
+
     if (restricted_limit != 0)
         return restricted_limit;
 
-    MEMORYSTATUSEX memStatus;
-    ::GetProcessMemoryLoad(&memStatus);
-
     return memStatus.ullTotalPhys;
 }
 
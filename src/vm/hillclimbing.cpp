@@ -375,7 +375,8 @@ GVAL_IMPL(int, HillClimbingLogFirstIndex);
 GVAL_IMPL(int, HillClimbingLogSize);
 
 
-void HillClimbing::LogTransition(int threadCount, double throughput, HillClimbingStateTransition transition)
+static void AddHillClimbingLogEntry(
+    int threadCount, double throughput, int historyCount, HillClimbingStateTransition transition)
 {
     LIMITED_METHOD_CONTRACT;
 
@@ -394,7 +395,7 @@ void HillClimbing::LogTransition(int threadCount, double throughput, HillClimbin
     entry->Transition = transition;
     entry->NewControlSetting = threadCount;
 
-    entry->LastHistoryCount = (int)(min(m_totalSamples, m_samplesToMeasure) / m_wavePeriod) * m_wavePeriod;
+    entry->LastHistoryCount = historyCount;
     entry->LastHistoryMean = (float) throughput;
 
     HillClimbingLogSize++;
@@ -408,6 +409,17 @@ void HillClimbing::LogTransition(int threadCount, double throughput, HillClimbin
 #endif //DACCESS_COMPILE
 }
 
+void HillClimbing::LogTransition(int threadCount, double throughput, HillClimbingStateTransition transition)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    AddHillClimbingLogEntry(
+        threadCount,
+        throughput,
+        (int)(min(m_totalSamples, m_samplesToMeasure) / m_wavePeriod) * m_wavePeriod,
+        transition);
+}
+
 Complex HillClimbing::GetWaveComponent(double* samples, int sampleCount, double period)
 {
     LIMITED_METHOD_CONTRACT;
@@ -437,3 +449,134 @@ Complex HillClimbing::GetWaveComponent(double* samples, int sampleCount, double
     return Complex(q1 - q2 * cosine, q2 * sine) / (double)sampleCount;
 }
 
+
+void QueueLatencyInjection::Initialize()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    m_targetLatency = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_InjectionTargetLatency);
+    m_idleDelay = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_InjectionIdleDelay);
+    m_maxChangePerSample = max((int)CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_InjectionMaxChangePerSample), 1);
+    m_threadsPerProcessor = max((int)CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_InjectionThreadsPerProcessor), 1);
+    m_injectionStep = 1;
+    m_backoffDelay = MinBackoffDelayMs;
+    m_latencyAtLastInjection = 0;
+    m_lastChangeTime = 0;
+    m_isIdle = false;
+    m_idleStartTime = 0;
+}
+
+int QueueLatencyInjection::Update(const Sample& sample)
+{
+    LIMITED_METHOD_CONTRACT;
+
+#ifdef DACCESS_COMPILE
+    return 1;
+#else
+
+    DWORD currentTime = GetTickCount();
+    int newThreadCount = sample.currentThreadCount;
+    HillClimbingStateTransition transition = Undefined;
+
+    //
+    // Give the last change a chance to take effect before judging it; otherwise the workers we just
+    // added would still look like missing capacity.  Past the rapid injection limit, wait out the backoff.
+    //
+    int rapidInjectionLimit = max(sample.minThreadCount, sample.processorCount * m_threadsPerProcessor);
+    DWORD changeDelay = (sample.currentThreadCount >= rapidInjectionLimit) ? m_backoffDelay : m_targetLatency;
+    if (currentTime - m_lastChangeTime < changeDelay)
+        return sample.currentThreadCount;
+
+    if (sample.requestsPending && sample.queueLatency > m_targetLatency)
+    {
+        //
+        // Work has waited too long.  Add at least as many threads as there are blocked workers, and
+        // double the step for each consecutive sample that is still over the target, so a burst is
+        // absorbed within a few samples rather than one thread at a time.
+        //
+        newThreadCount += LimitInjection(sample, min(max(m_injectionStep, sample.numBlocked), m_maxChangePerSample));
+        m_injectionStep = min(m_injectionStep * 2, m_maxChangePerSample);
+        transition = QueueLatency;
+        m_isIdle = false;
+    }
+    else if (sample.requestsPending && sample.numWorking >= sample.currentThreadCount && sample.numBlocked > 0)
+    {
+        //
+        // Work is still being picked up, but only because some workers are running while others are
+        // blocked.  Replacing the blocked ones uses the idle processors without oversubscribing them.
+        //
+        newThreadCount += LimitInjection(sample, min(sample.numBlocked, m_maxChangePerSample));
+        m_injectionStep = 1;
+        transition = BlockedWorkers;
+        m_isIdle = false;
+    }
+    else
+    {
+        m_injectionStep = 1;
+        m_backoffDelay = MinBackoffDelayMs;
+
+        if (!sample.requestsPending && sample.numWorking < sample.currentThreadCount)
+        {
+            //
+            // Nothing is queued and some threads have nothing to do.  Once that has lasted for the idle
+            // delay, give back half of the spare threads; the excess workers retire in ShouldWorkerKeepRunning.
+            //
+            if (!m_isIdle)
+            {
+                m_isIdle = true;
+                m_idleStartTime = currentTime;
+            }
+            else if (currentTime - m_idleStartTime >= m_idleDelay)
+            {
+                int spareThreads = sample.currentThreadCount - max(sample.numWorking, 1);
+                newThreadCount -= max(spareThreads / 2, 1);
+                transition = Idle;
+                m_idleStartTime = currentTime;
+            }
+        }
+        else
+        {
+            m_isIdle = false;
+        }
+    }
+
+    newThreadCount = min(newThreadCount, sample.maxThreadCount);
+    newThreadCount = max(newThreadCount, sample.minThreadCount);
+
+    if (newThreadCount != sample.currentThreadCount)
+    {
+        m_lastChangeTime = currentTime;
+        AddHillClimbingLogEntry(newThreadCount, 0, 0, transition);
+    }
+
+    return newThreadCount;
+
+#endif //DACCESS_COMPILE
+}
+
+//
+// Limits the number of threads added in one sample.  Up to the rapid injection limit, a number of threads
+// proportional to the processor count, a burst is absorbed as quickly as Update asks for.  Past it, workers
+// that stay blocked (sync-over-async, for instance) could otherwise grow the pool by thousands of threads, so
+// threads are added one at a time and the delay between them doubles whenever the last one did not reduce the
+// queue latency.
+//
+int QueueLatencyInjection::LimitInjection(const Sample& sample, int change)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    int rapidInjectionLimit = max(sample.minThreadCount, sample.processorCount * m_threadsPerProcessor);
+    if (sample.currentThreadCount < rapidInjectionLimit)
+    {
+        m_latencyAtLastInjection = sample.queueLatency;
+        return min(change, rapidInjectionLimit - sample.currentThreadCount);
+    }
+
+    if (sample.queueLatency >= m_latencyAtLastInjection)
+        m_backoffDelay = min(m_backoffDelay * 2, MaxBackoffDelayMs);
+    else
+        m_backoffDelay = MinBackoffDelayMs;
+
+    m_latencyAtLastInjection = sample.queueLatency;
+    return min(change, 1);
+}
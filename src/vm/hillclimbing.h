@@ -29,6 +29,9 @@ enum HillClimbingStateTransition
     Stabilizing,
     Starvation, //used by ThreadpoolMgr
     ThreadTimedOut, //used by ThreadpoolMgr
+    QueueLatency, //used by QueueLatencyInjection
+    BlockedWorkers, //used by QueueLatencyInjection
+    Idle, //used by QueueLatencyInjection
     Undefined,
 };
 
@@ -78,6 +81,52 @@ public:
     void ForceChange(int newThreadCount, HillClimbingStateTransition transition);
 };
 
+//
+// QueueLatencyInjection replaces HillClimbing when ThreadPool_EnableLatencyInjection is set.  Instead of
+// measuring throughput it looks at how long pending work has gone without being picked up and at how many
+// busy workers seem to be blocked rather than running, so it can add threads within a sample or two of a
+// burst, and give them back once the pool has been idle for a while.
+//
+class QueueLatencyInjection
+{
+public:
+    struct Sample
+    {
+        int currentThreadCount;     // the current MaxWorking
+        int minThreadCount;
+        int maxThreadCount;
+        int numWorking;             // workers that are busy with work
+        int numBlocked;             // busy workers that do not appear to be using a processor
+        int processorCount;
+        bool requestsPending;
+        DWORD queueLatency;         // milliseconds pending work has gone without a dequeue
+    };
+
+private:
+    DWORD m_targetLatency;
+    DWORD m_idleDelay;
+    int m_maxChangePerSample;
+    int m_threadsPerProcessor;
+
+    int m_injectionStep;            // doubles for each consecutive sample over the target latency
+    DWORD m_backoffDelay;           // time between changes once the pool is past the rapid injection limit
+    DWORD m_latencyAtLastInjection;
+    DWORD m_lastChangeTime;
+    bool m_isIdle;
+    DWORD m_idleStartTime;
+
+    // Past the rapid injection limit threads are added no faster than starvation injection adds them (see
+    // GATE_THREAD_DELAY), and slower still for as long as the added threads don't bring the latency down.
+    static const DWORD MinBackoffDelayMs = 500;
+    static const DWORD MaxBackoffDelayMs = 8000;
+
+    int LimitInjection(const Sample& sample, int change);
+
+public:
+    void Initialize();
+    int Update(const Sample& sample);
+};
+
 #define HillClimbingLogCapacity 200
 
 struct HillClimbingLogEntry
@@ -47,6 +47,7 @@
 #include "debuginfostore.h"
 #include "safemath.h"
 #include "threadstatics.h"
+#include "castcache.h"
 
 #ifdef FEATURE_PREJIT
 #include "compile.h"
@@ -2239,7 +2240,7 @@ TypeHandle::CastResult ArrayObjSupportsBizarreInterfaceNoGC(Object *pObject, Met
     return TypeDesc::CanCastParamNoGC(pArray->GetArrayElementTypeHandle(), pInterfaceMT->GetInstantiation()[0]);
 }
 
-TypeHandle::CastResult STDCALL ObjIsInstanceOfNoGC(Object *pObject, TypeHandle toTypeHnd)
+static TypeHandle::CastResult ObjIsInstanceOfNoGCWorker(Object *pObject, TypeHandle toTypeHnd)
 {
     CONTRACTL {
         NOTHROW;
@@ -2292,6 +2293,27 @@ TypeHandle::CastResult STDCALL ObjIsInstanceOfNoGC(Object *pObject, TypeHandle t
     return pMT->CanCastToClassOrInterfaceNoGC(toTypeHnd.AsMethodTable());
 }
 
+TypeHandle::CastResult STDCALL ObjIsInstanceOfNoGC(Object *pObject, TypeHandle toTypeHnd)
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_COOPERATIVE;
+        SO_TOLERANT;
+        PRECONDITION(CheckPointer(pObject));
+    } CONTRACTL_END;
+
+    TypeHandle::CastResult result = ObjIsInstanceOfNoGCWorker(pObject, toTypeHnd);
+
+    // The structural checks are conservative on variance, type equivalence and types that
+    // are not fully loaded yet. Before giving up on them, see whether the slow path has
+    // already determined the answer.
+    if (result == TypeHandle::MaybeCast)
+        result = CastCache::TryGet(pObject->GetMethodTable(), toTypeHnd);
+
+    return result;
+}
+
 BOOL ObjIsInstanceOf(Object *pObject, TypeHandle toTypeHnd, BOOL throwCastException)
 {
     CONTRACTL {
@@ -2361,6 +2383,10 @@ BOOL ObjIsInstanceOf(Object *pObject, TypeHandle toTypeHnd, BOOL throwCastExcept
     }
 #endif // FEATURE_ICASTABLE
 
+    // Remember the result for the frameless helpers. CastCache::TrySet ignores proxies,
+    // COM objects and ICastable implementations since their results depend on the instance.
+    CastCache::TrySet(obj->GetMethodTable(), toTypeHnd, fCast);
+
     if (!fCast && throwCastException) 
     {
         COMPlusThrowInvalidCastException(&obj, toTypeHnd);
@@ -2530,6 +2556,9 @@ HCIMPL2(Object *, JIT_ChkCastArray, CORINFO_CLASS_HANDLE type, Object *pObject)
     TypeHandle::CastResult result = refObj->GetMethodTable()->IsArray() ? 
         ArrayIsInstanceOfNoGC(pObject, TypeHandle(type)) : TypeHandle::CannotCast;
 
+    if (result == TypeHandle::MaybeCast)
+        result = CastCache::TryGet(refObj->GetMethodTable(), TypeHandle(type));
+
     if (result == TypeHandle::CanCast)
     {
         return pObject;
@@ -2567,7 +2596,11 @@ HCIMPL2(Object *, JIT_IsInstanceOfArray, CORINFO_CLASS_HANDLE type, Object *pObj
     }
     else
     {
-        switch (ArrayIsInstanceOfNoGC(pObject, TypeHandle(type))) {
+        TypeHandle::CastResult result = ArrayIsInstanceOfNoGC(pObject, TypeHandle(type));
+        if (result == TypeHandle::MaybeCast)
+            result = CastCache::TryGet(pMT, TypeHandle(type));
+
+        switch (result) {
         case TypeHandle::CanCast:
             return pObject;
         case TypeHandle::CannotCast:
@@ -2643,17 +2676,20 @@ NOINLINE HCIMPL2(Object *, JITutil_IsInstanceOfInterface, MethodTable *pInterfac
 {
     FCALL_CONTRACT;
 
-    if (obj->GetMethodTable()->IsArray())
-    {
-        switch (ArrayObjSupportsBizarreInterfaceNoGC(obj, pInterfaceMT)) {
-        case TypeHandle::CanCast:
-            return obj;
-        case TypeHandle::CannotCast:
-            return NULL;
-        default:
-            // fall through to the slow helper
-            break;
-        }
+    TypeHandle::CastResult result = obj->GetMethodTable()->IsArray() ?
+        ArrayObjSupportsBizarreInterfaceNoGC(obj, pInterfaceMT) : TypeHandle::MaybeCast;
+
+    if (result == TypeHandle::MaybeCast)
+        result = CastCache::TryGet(obj->GetMethodTable(), TypeHandle(pInterfaceMT));
+
+    switch (result) {
+    case TypeHandle::CanCast:
+        return obj;
+    case TypeHandle::CannotCast:
+        return NULL;
+    default:
+        // fall through to the slow helper
+        break;
     }
 
     ENDFORBIDGC();
@@ -2666,12 +2702,15 @@ NOINLINE HCIMPL2(Object *, JITutil_ChkCastInterface, MethodTable *pInterfaceMT,
 {
     FCALL_CONTRACT;
 
-    if (obj->GetMethodTable()->IsArray())
+    TypeHandle::CastResult result = obj->GetMethodTable()->IsArray() ?
+        ArrayObjSupportsBizarreInterfaceNoGC(obj, pInterfaceMT) : TypeHandle::MaybeCast;
+
+    if (result == TypeHandle::MaybeCast)
+        result = CastCache::TryGet(obj->GetMethodTable(), TypeHandle(pInterfaceMT));
+
+    if (result == TypeHandle::CanCast)
     {
-        if (ArrayObjSupportsBizarreInterfaceNoGC(obj, pInterfaceMT) == TypeHandle::CanCast)
-        {
-            return obj;
-        }
+        return obj;
     }
 
     ENDFORBIDGC();
@@ -5699,6 +5738,50 @@ HCIMPL0(void, JIT_DebugLogLoopCloning)
 }
 HCIMPLEND
 
+#ifdef FEATURE_TIERED_COMPILATION
+// Called from tier0 code each time a single invocation of the method has taken
+// a JIT determined number of loop back-edges. Methods that are rarely called but
+// spend their time in long running loops would otherwise never reach the call
+// count threshold for tier1 promotion.
+HCIMPL1(void, JIT_LoopBackEdgeThreshold, CORINFO_METHOD_HANDLE methHnd_)
+{
+    FCALL_CONTRACT;
+
+    MethodDesc* pMD = GetMethod(methHnd_);
+
+    // Tier0 frames keep calling here for as long as their loops run, but the
+    // method only needs to be queued for promotion once
+    if (pMD->IsLoopPromotionRequested())
+    {
+        return;
+    }
+
+    HELPER_METHOD_FRAME_BEGIN_0();
+    {
+        GCX_PREEMP();
+        GetAppDomain()->GetTieredCompilationManager()->OnLoopBackEdgeThreshold(pMD);
+    }
+    HELPER_METHOD_FRAME_END();
+}
+HCIMPLEND
+
+// Called from tier0 code before a virtual or interface call to record the class
+// of the 'this' object. Tier1 code uses the profile to guard a direct call to
+// the method the likely class would dispatch to. This runs on every call so it
+// must stay cheap: it doesn't set up a frame and never triggers a GC. A null
+// object is ignored, the call itself throws the NullReferenceException.
+HCIMPL2(void, JIT_ClassProfile, Object* obj, void* cell)
+{
+    FCALL_CONTRACT;
+
+    if (obj != NULL)
+    {
+        TieredCompilationManager::RecordClass((TieredCompilationManager::ClassProfileCell*)cell, obj->GetMethodTable());
+    }
+}
+HCIMPLEND
+#endif // FEATURE_TIERED_COMPILATION
+
 //========================================================================
 //
 //      INTEROP HELPERS
@@ -5852,6 +5935,8 @@ void InitJITHelpers2()
 
     InitJitHelperLogging();
 
+    CastCache::Initialize();
+
     g_pJitGenericHandleCacheCrst.Init(CrstJitGenericHandleCache, CRST_UNSAFE_COOPGC);
 
     // Allocate and initialize the table
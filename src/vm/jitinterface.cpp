@@ -2010,6 +2010,37 @@ CEEInfo::getClassSize(
     return result;
 }
 
+//---------------------------------------------------------------------------------------
+// 
+unsigned 
+CEEInfo::getHeapClassSize(
+    CORINFO_CLASS_HANDLE clsHnd)
+{
+    CONTRACTL {
+        SO_TOLERANT;
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_PREEMPTIVE;
+    } CONTRACTL_END;
+
+    unsigned result = 0;
+
+    JIT_TO_EE_TRANSITION_LEAF();
+
+    TypeHandle VMClsHnd(clsHnd);
+    MethodTable* pMT = VMClsHnd.GetMethodTable();
+    _ASSERTE(pMT);
+    _ASSERTE(!pMT->IsValueType());
+    _ASSERTE(!pMT->HasComponentSize());
+
+    // Account for the method table pointer, the object header is not included
+    result = pMT->GetNumInstanceFieldBytes() + sizeof(MethodTable*);
+
+    EE_TO_JIT_TRANSITION_LEAF();
+
+    return result;
+}
+
 unsigned CEEInfo::getClassAlignmentRequirement(CORINFO_CLASS_HANDLE type, BOOL fDoubleAlignHint)
 {
     CONTRACTL {
@@ -8966,6 +8997,51 @@ CORINFO_METHOD_HANDLE CEEInfo::resolveVirtualMethod(CORINFO_METHOD_HANDLE method
     return result;
 }
 
+/*********************************************************************/
+CORINFO_CLASS_HANDLE CEEInfo::getLikelyClass(
+    CORINFO_METHOD_HANDLE method,
+    unsigned ilOffset,
+    unsigned* pLikelihood,
+    void** pCell)
+{
+    CONTRACTL {
+        SO_TOLERANT;
+        THROWS;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+    } CONTRACTL_END;
+
+    CORINFO_CLASS_HANDLE result = NULL;
+
+    *pLikelihood = 0;
+    if (pCell != NULL)
+    {
+        *pCell = NULL;
+    }
+
+    JIT_TO_EE_TRANSITION();
+
+#ifdef FEATURE_TIERED_COMPILATION
+    MethodDesc* pMD = GetMethod(method);
+    TieredCompilationManager* pManager = GetAppDomain()->GetTieredCompilationManager();
+
+    if (pCell != NULL)
+    {
+        *pCell = pManager->GetClassProfileCell(pMD, ilOffset);
+    }
+    else
+    {
+        DWORD likelihood = 0;
+        result = (CORINFO_CLASS_HANDLE)pManager->GetLikelyClass(pMD, ilOffset, &likelihood);
+        *pLikelihood = likelihood;
+    }
+#endif // FEATURE_TIERED_COMPILATION
+
+    EE_TO_JIT_TRANSITION();
+
+    return result;
+}
+
 /*********************************************************************/
 CORINFO_METHOD_HANDLE CEEInfo::getUnboxedEntry(
     CORINFO_METHOD_HANDLE ftn,
@@ -484,6 +484,7 @@ public:
     BOOL isStructRequiringStackAllocRetBuf(CORINFO_CLASS_HANDLE cls);
 
     unsigned getClassSize (CORINFO_CLASS_HANDLE cls);
+    unsigned getHeapClassSize (CORINFO_CLASS_HANDLE cls);
     unsigned getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint);
     static unsigned getClassAlignmentRequirementStatic(TypeHandle clsHnd);
 
@@ -774,6 +775,13 @@ public:
         CORINFO_CONTEXT_HANDLE ownerType
         );
 
+    CORINFO_CLASS_HANDLE getLikelyClass(
+        CORINFO_METHOD_HANDLE method,
+        unsigned ilOffset,
+        unsigned* pLikelihood,
+        void** pCell
+    );
+
     CORINFO_METHOD_HANDLE getUnboxedEntry(
         CORINFO_METHOD_HANDLE ftn,
         bool* requiresInstMethodTableArg
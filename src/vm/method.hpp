@@ -1255,6 +1255,20 @@ public:
             !CORDisableJITOptimizations(GetModule()->GetDebuggerInfoBits()) &&
             !CORProfilerDisableTieredCompilation();
     }
+
+    // Set once tier0 code with a hot loop has asked for the method to be promoted,
+    // see TieredCompilationManager::OnLoopBackEdgeThreshold
+    BOOL IsLoopPromotionRequested()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return (VolatileLoadWithoutBarrier(&m_bFlags2) & enum_flag2_IsLoopPromotionRequested) != 0;
+    }
+
+    void SetLoopPromotionRequested()
+    {
+        WRAPPER_NO_CONTRACT;
+        InterlockedUpdateFlags2(enum_flag2_IsLoopPromotionRequested, TRUE);
+    }
 #endif
 
     // Returns a code version that represents the first (default)
@@ -1698,7 +1712,8 @@ protected:
 
         enum_flag2_IsJitIntrinsic           = 0x10,   // Jit may expand method as an intrinsic
 
-        // unused                           = 0x20,
+        enum_flag2_IsLoopPromotionRequested = 0x20,   // A tier0 loop has queued the method for tier1 promotion
+
         // unused                           = 0x40,
         // unused                           = 0x80, 
     };
@@ -518,6 +518,8 @@ SyncBlockCache::SyncBlockCache()
       m_ActiveCount(0),
       m_SyncBlocks(0),
       m_FreeSyncBlock(0),
+      m_InflationCount(0),
+      m_DeflationCount(0),
       m_FreeSyncTableIndex(1),
       m_FreeSyncTableList(0),
       m_SyncTableSize(SYNC_TABLE_INITIAL_SIZE),
@@ -926,6 +928,8 @@ void SyncBlockCache::Start()
     }
     CONTRACTL_END;
 
+    AwareLock::InitializePerformanceFrequency();
+
     DWORD* bm = new DWORD [BitMapSize(SYNC_TABLE_INITIAL_SIZE+1)];
 
     memset (bm, 0, BitMapSize (SYNC_TABLE_INITIAL_SIZE+1)*sizeof(DWORD));
@@ -1055,6 +1059,7 @@ SyncBlock *SyncBlockCache::GetNextFreeSyncBlock()
     SLink           *plst = m_FreeBlockList;
 
     m_ActiveCount++;
+    m_InflationCount++;
 
     if (plst)
     {
@@ -1420,7 +1425,7 @@ void SyncBlockCache::GCWeakPtrScan(HANDLESCANPROC scanProc, uintptr_t lp1, uintp
                                         clear_card = FALSE;
 
                                         GCWeakPtrScanElement ((int)nb, scanProc,
-                                                              lp1, lp2, fSetSyncBlockCleanup);
+                                                              lp1, lp2, FALSE, fSetSyncBlockCleanup);
                                     }
                                 }
                             }
@@ -1469,9 +1474,11 @@ void SyncBlockCache::GCWeakPtrScan(HANDLESCANPROC scanProc, uintptr_t lp1, uintp
     }
     else
     {
+        // Sync blocks that only hold a hash code are reclaimed during full GCs only, so that a sync block that
+        // is used again soon after being released is not repeatedly reclaimed and recreated.
         for (DWORD nb = 1; nb < m_FreeSyncTableIndex; nb++)
         {
-            GCWeakPtrScanElement (nb, scanProc, lp1, lp2, fSetSyncBlockCleanup);
+            GCWeakPtrScanElement (nb, scanProc, lp1, lp2, TRUE, fSetSyncBlockCleanup);
         }
 
 
@@ -1504,10 +1511,11 @@ void SyncBlockCache::GCWeakPtrScan(HANDLESCANPROC scanProc, uintptr_t lp1, uintp
 }
 
 /* Scan the weak pointers in the SyncBlockEntry and report them to the GC.  If the
-   reference is dead, then return TRUE */
+   reference is dead, then return TRUE.  If deflate is TRUE, a sync block that only
+   holds a hash code is reclaimed and the hash code is moved back into the header. */
 
 BOOL SyncBlockCache::GCWeakPtrScanElement (int nb, HANDLESCANPROC scanProc, LPARAM lp1, LPARAM lp2,
-                                           BOOL& cleanup)
+                                           BOOL deflate, BOOL& cleanup)
 {
     CONTRACTL
     {
@@ -1556,7 +1564,13 @@ BOOL SyncBlockCache::GCWeakPtrScanElement (int nb, HANDLESCANPROC scanProc, LPAR
 
         (*scanProc) (keyv, NULL, lp1, lp2);
         SyncBlock   *pSB = SyncTableEntry::GetSyncTableEntry()[nb].m_SyncBlock;
-        if ((*keyv == 0 ) || (pSB && pSB->IsIDisposable()))
+        DWORD       hashCode = 0;
+        if (deflate && (*keyv != 0) && pSB && pSB->IsDeflatable())
+        {
+            hashCode = pSB->GetHashCode();
+        }
+
+        if ((*keyv == 0 ) || (pSB && (pSB->IsIDisposable() || hashCode != 0)))
         {
 #ifdef VERIFY_HEAP
             if (g_pConfig->GetHeapVerifyLevel () & EEConfig::HEAPVERIFY_SYNCBLK)
@@ -1571,6 +1585,12 @@ BOOL SyncBlockCache::GCWeakPtrScanElement (int nb, HANDLESCANPROC scanProc, LPAR
                 GCDeleteSyncBlock(pSB);
                 //clean the object syncblock header
                 ((Object*)(*keyv))->GetHeader()->GCResetIndex();
+
+                if (hashCode != 0)
+                {
+                    ((Object*)(*keyv))->GetHeader()->GCSetHashCode(hashCode);
+                    m_DeflationCount++;
+                }
             }
             else if (pSB)
             {
@@ -1659,6 +1679,8 @@ void SyncBlockCache::GCDone(BOOL demoting, int max_gen)
                 break;
         }
     }
+
+    FireEtwGCSyncBlockStats(m_ActiveCount, m_InflationCount, m_DeflationCount, GetClrInstanceId());
 }
 
 
@@ -1945,15 +1967,26 @@ AwareLock::EnterHelperResult ObjHeader::EnterObjMonitorHelperSpin(Thread* pCurTh
                 return result;
             }
 
+            // Spin only for as long as spinning has recently paid off for this lock. Spinning that stops for other
+            // reasons says nothing about how long the lock is typically held, so it does not update the limit.
+            const DWORD lockSpinCount = min(spinCount, awareLock->GetSpinLimit());
+            bool recordSpinOutcome = true;
+
             ++spinIteration;
-            if (spinIteration < spinCount)
+            if (spinIteration < lockSpinCount)
             {
                 while (true)
                 {
+                    if (awareLock->IsHeldTooLongToSpin())
+                    {
+                        recordSpinOutcome = false;
+                        break;
+                    }
+
                     AwareLock::SpinWait(normalizationInfo, spinIteration);
 
                     ++spinIteration;
-                    if (spinIteration >= spinCount)
+                    if (spinIteration >= lockSpinCount)
                     {
                         // The last lock attempt for this spin will be done after the loop
                         break;
@@ -1962,10 +1995,12 @@ AwareLock::EnterHelperResult ObjHeader::EnterObjMonitorHelperSpin(Thread* pCurTh
                     result = awareLock->TryEnterInsideSpinLoopHelper(pCurThread);
                     if (result == AwareLock::EnterHelperResult_Entered)
                     {
+                        awareLock->RecordSpinSuccess(spinIteration);
                         return AwareLock::EnterHelperResult_Entered;
                     }
                     if (result == AwareLock::EnterHelperResult_UseSlowPath)
                     {
+                        recordSpinOutcome = false;
                         break;
                     }
                 }
@@ -1973,8 +2008,17 @@ AwareLock::EnterHelperResult ObjHeader::EnterObjMonitorHelperSpin(Thread* pCurTh
 
             if (awareLock->TryEnterAfterSpinLoopHelper(pCurThread))
             {
+                if (recordSpinOutcome)
+                {
+                    awareLock->RecordSpinSuccess(spinIteration);
+                }
                 return AwareLock::EnterHelperResult_Entered;
             }
+
+            if (recordSpinOutcome)
+            {
+                awareLock->RecordSpinFailure();
+            }
             break;
         }
 
@@ -2909,6 +2953,20 @@ void ObjHeader::PulseAll()
 //
 // ***************************************************************************
 
+LONGLONG AwareLock::s_performanceFrequency;
+
+void AwareLock::InitializePerformanceFrequency()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    LARGE_INTEGER frequency;
+    if (!QueryPerformanceFrequency(&frequency) || frequency.QuadPart == 0)
+    {
+        frequency.QuadPart = 1;
+    }
+    s_performanceFrequency = frequency.QuadPart;
+}
+
 void AwareLock::AllocLockSemEvent()
 {
     CONTRACTL
@@ -3118,6 +3176,10 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
     // Fire a contention start event for a managed contention
     FireEtwContentionStart_V1(ETW::ContentionLog::ContentionStructs::ManagedContention, GetClrInstanceId());
 
+    // The contention stop event reports how long this thread was kept from the lock
+    LARGE_INTEGER contentionStartTicks;
+    QueryPerformanceCounter(&contentionStartTicks);
+
     LogContention();
 
     OBJECTREF obj = GetOwningObject();
@@ -3248,7 +3310,18 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
     DecrementTransientPrecious();
 
     // Fire a contention end event for a managed contention
-    FireEtwContentionStop(ETW::ContentionLog::ContentionStructs::ManagedContention, GetClrInstanceId());
+    if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ContentionStop_V1))
+    {
+        LARGE_INTEGER contentionEndTicks;
+        QueryPerformanceCounter(&contentionEndTicks);
+        LONGLONG durationTicks = contentionEndTicks.QuadPart - contentionStartTicks.QuadPart;
+        double durationNs = (double)durationTicks * 1000000000.0 / s_performanceFrequency;
+
+        FireEtwContentionStop_V1(
+            ETW::ContentionLog::ContentionStructs::ManagedContention,
+            GetClrInstanceId(),
+            durationNs);
+    }
 
     if (ret == WAIT_TIMEOUT)
     {
@@ -440,6 +440,23 @@ private:
 
     static const DWORD WaiterStarvationDurationMsBeforeStoppingPreemptingWaiters = 100;
 
+    // Number of spin iterations a thread may spend trying to acquire this lock before waiting. Starts at the global
+    // monitor spin count and adapts to how spinning has recently worked out for this lock, see RecordSpinSuccess() and
+    // RecordSpinFailure().
+    DWORD m_spinLimit;
+
+    static const DWORD MinimumSpinLimit = 4;
+
+    // The holding thread that spinners have been waiting on and the time at which they first saw it holding the lock,
+    // see IsHeldTooLongToSpin(). The thread is only compared, never dereferenced, since it may have exited.
+    TADDR m_spinObservedHoldingThread;
+    DWORD m_spinObservedHoldStartTimeMs;
+
+    static const DWORD HoldDurationMsBeforeStoppingSpinning = 2;
+
+    // Frequency of the performance counter used to time contention, initialized by SyncBlockCache::Start()
+    static LONGLONG s_performanceFrequency;
+
     // Only SyncBlocks can create AwareLocks.  Hence this private constructor.
     AwareLock(DWORD indx)
         : m_Recursion(0),
@@ -449,7 +466,10 @@ private:
 #endif // DACCESS_COMPILE          
           m_TransientPrecious(0),
           m_dwSyncIndex(indx),
-          m_waiterStarvationStartTimeMs(0)
+          m_waiterStarvationStartTimeMs(0),
+          m_spinLimit(g_SpinConstants.dwMonitorSpinCount),
+          m_spinObservedHoldingThread(NULL),
+          m_spinObservedHoldStartTimeMs(0)
     {
         LIMITED_METHOD_CONTRACT;
     }
@@ -514,6 +534,20 @@ private:
     void RecordWaiterStarvationStartTime();
     bool ShouldStopPreemptingWaiters() const;
 
+public:
+    DWORD GetSpinLimit() const
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_spinLimit;
+    }
+
+    void RecordSpinSuccess(DWORD spinIteration);
+    void RecordSpinFailure();
+    bool IsHeldTooLongToSpin();
+    void ResetSpinObservedHoldingThread();
+
+    static void InitializePerformanceFrequency();
+
 private: // friend access is required for this unsafe function
     void InitializeToLockedWithNoWaiters(ULONG recursionLevel, PTR_Thread holdingThread)
     {
@@ -908,6 +942,18 @@ class SyncBlock
     {
         WRAPPER_NO_CONTRACT;
         return (!IsPrecious() &&
+                m_dwHashCode == 0 &&
+                m_Monitor.IsUnlockedWithNoWaiters() &&
+                m_Monitor.m_TransientPrecious == 0);
+    }
+
+    // True if the only state held by the syncblock is a hash code, so that the syncblock
+    // can be disposed of once the hash code is moved back into the object header.
+    BOOL IsDeflatable()
+    {
+        WRAPPER_NO_CONTRACT;
+        return (!IsPrecious() &&
+                m_dwHashCode != 0 &&
                 m_Monitor.IsUnlockedWithNoWaiters() &&
                 m_Monitor.m_TransientPrecious == 0);
     }
@@ -1005,8 +1051,10 @@ class SyncBlock
         DWORD result = FastInterlockCompareExchange((LONG*)&m_dwHashCode, hashCode, 0);
         if (result == 0)
         {
-            // the sync block now holds a hash code, which we can't afford to lose.
-            SetPrecious();
+            // the sync block now holds a hash code, which we can't afford to lose. The sync block
+            // is not made precious for it though: once it is otherwise unused, the GC moves the hash
+            // code back into the object header (see SyncBlockCache::GCWeakPtrScanElement).
+            _ASSERTE((hashCode & ~MASK_HASHCODE) == 0);
             return hashCode;
         }
         else
@@ -1198,6 +1246,8 @@ class SyncBlockCache
     DWORD       m_ActiveCount;          // number active
     SyncBlockArray *m_SyncBlocks;       // Array of new SyncBlocks.
     DWORD       m_FreeSyncBlock;        // Next Free Syncblock in the array 
+    ULONGLONG   m_InflationCount;       // number of sync blocks handed out, ever
+    ULONGLONG   m_DeflationCount;       // number of sync blocks reclaimed by moving their hash code to the header
 
         // The next variables deal with SyncTableEntries.  Instead of having the object-header
         // point directly at SyncBlocks, the object points a a syncTableEntry, which points at
@@ -1216,7 +1266,8 @@ class SyncBlockCache
     BOOL        m_bSyncBlockCleanupInProgress;  // A flag indicating if sync block cleanup is in progress.    
     DWORD*      m_EphemeralBitmap;      // card table for ephemeral scanning
 
-    BOOL        GCWeakPtrScanElement(int elindex, HANDLESCANPROC scanProc, LPARAM lp1, LPARAM lp2, BOOL& cleanup);
+    BOOL        GCWeakPtrScanElement(int elindex, HANDLESCANPROC scanProc, LPARAM lp1, LPARAM lp2, BOOL deflate,
+                                     BOOL& cleanup);
 
     void SetCard (size_t card);
     void ClearCard (size_t card);
@@ -1295,6 +1346,18 @@ class SyncBlockCache
         return m_ActiveCount;
     }
 
+    ULONGLONG GetInflationCount()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_InflationCount;
+    }
+
+    ULONGLONG GetDeflationCount()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_DeflationCount;
+    }
+
     // Encapsulate a CrstHolder, so that clients of our lock don't have to know
     // the details of our implementation.
     class LockHolder : public CrstHolder
@@ -1430,6 +1493,16 @@ class ObjHeader
         m_SyncBlockValue.RawValue() &=~(BIT_SBLK_IS_HASH_OR_SYNCBLKINDEX | BIT_SBLK_IS_HASHCODE | MASK_SYNCBLOCKINDEX);
     }
 
+    // Used only by GC, after GCResetIndex, to put the hash code of a reclaimed sync block back into the header
+    void GCSetHashCode(DWORD hashCode)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        _ASSERTE((hashCode & ~MASK_HASHCODE) == 0);
+        _ASSERTE((m_SyncBlockValue.RawValue() & (BIT_SBLK_IS_HASH_OR_SYNCBLKINDEX | MASK_HASHCODE)) == 0);
+        m_SyncBlockValue.RawValue() |= BIT_SBLK_IS_HASH_OR_SYNCBLKINDEX | BIT_SBLK_IS_HASHCODE | hashCode;
+    }
+
     void SetAppDomainIndex(ADIndex);
     void ResetAppDomainIndex(ADIndex);
     void ResetAppDomainIndexNoFailure(ADIndex);
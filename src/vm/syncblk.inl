@@ -458,6 +458,56 @@ FORCEINLINE bool AwareLock::ShouldStopPreemptingWaiters() const
         GetTickCount() - waiterStarvationStartTimeMs >= WaiterStarvationDurationMsBeforeStoppingPreemptingWaiters;
 }
 
+FORCEINLINE void AwareLock::RecordSpinSuccess(DWORD spinIteration)
+{
+    WRAPPER_NO_CONTRACT;
+
+    // The lock was acquired after spinning for spinIteration iterations. Move the limit a quarter of the way towards twice
+    // that, so that the next spinner is likely to get the lock too, and so that the limit grows back when spinning keeps
+    // succeeding near the limit. Updates are racy, which is fine for a heuristic.
+    DWORD targetSpinLimit = min(spinIteration * 2 + MinimumSpinLimit, g_SpinConstants.dwMonitorSpinCount);
+    DWORD spinLimit = m_spinLimit;
+    m_spinLimit = (spinLimit * 3 + targetSpinLimit + 3) / 4;
+    ResetSpinObservedHoldingThread();
+}
+
+FORCEINLINE void AwareLock::RecordSpinFailure()
+{
+    WRAPPER_NO_CONTRACT;
+
+    // Spinning did not acquire the lock and the thread is going to wait, so spinning was wasted. Spin less next time, but
+    // keep spinning a little so that the limit can grow back once the lock is held for shorter durations.
+    DWORD spinLimit = m_spinLimit;
+    m_spinLimit = max(spinLimit - spinLimit / 4, min(MinimumSpinLimit, g_SpinConstants.dwMonitorSpinCount));
+    ResetSpinObservedHoldingThread();
+}
+
+FORCEINLINE void AwareLock::ResetSpinObservedHoldingThread()
+{
+    LIMITED_METHOD_CONTRACT;
+    m_spinObservedHoldingThread = NULL;
+}
+
+FORCEINLINE bool AwareLock::IsHeldTooLongToSpin()
+{
+    WRAPPER_NO_CONTRACT;
+
+    // A thread that keeps the lock for much longer than a spin lasts, for instance because it is sleeping, waiting or
+    // blocked on another lock, is not going to release it while this thread spins. Spinners track how long the current
+    // holder has held the lock as they observe it; the holding thread is only compared. Updates are racy, which is fine
+    // for a heuristic.
+    TADDR holdingThread = dac_cast<TADDR>(VolatileLoadWithoutBarrier(&m_HoldingThread));
+    DWORD currentTimeMs = GetTickCount();
+    if (holdingThread != m_spinObservedHoldingThread)
+    {
+        m_spinObservedHoldStartTimeMs = currentTimeMs;
+        m_spinObservedHoldingThread = holdingThread;
+        return false;
+    }
+
+    return currentTimeMs - m_spinObservedHoldStartTimeMs >= HoldDurationMsBeforeStoppingSpinning;
+}
+
 FORCEINLINE void AwareLock::SpinWait(const YieldProcessorNormalizationInfo &normalizationInfo, DWORD spinIteration)
 {
     WRAPPER_NO_CONTRACT;
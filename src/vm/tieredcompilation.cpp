@@ -42,24 +42,45 @@
 // 
 // a) .ctor and Init(...) -  called once during AppDomain initialization
 // b) OnMethodCalled(...) -  called when a method is being invoked. When a method
-//                           has been called enough times this is currently the only
-//                           trigger that initiates re-compilation.
-// c) Shutdown() -           called during AppDomain::Exit() to begin the process
+//                           has been called enough times this initiates re-compilation.
+// c) OnLoopBackEdgeThreshold(...) - called from tier0 code that has taken enough loop
+//                           back-edges in a single invocation. This also initiates
+//                           re-compilation so methods with long running loops don't
+//                           need to be called often to be optimized.
+// d) Shutdown() -           called during AppDomain::Exit() to begin the process
 //                           of stopping tiered compilation. After this point no more
 //                           background optimization work will be initiated but in-progress
 //                           work still needs to complete.
-// d) ShutdownAllDomains() - Called from EEShutdownHelper to block until all async work is
+// e) ShutdownAllDomains() - Called from EEShutdownHelper to block until all async work is
 //                           complete. We must do this before we shutdown the JIT.
+// f) GetClassProfileCell(...) / GetLikelyClass(...) - called by the JIT when it compiles
+//                           virtual calls in tier0 and tier1 code respectively. Tier0 code
+//                           records the classes it sees as 'this' at each call site and tier1
+//                           code guards a direct call to the method the likely class uses.
 //
 // # Overall workflow
 //
 // Methods initially call into OnMethodCalled() and once the call count exceeds
-// a fixed limit we queue work on to our internal list of methods needing to
-// be recompiled (m_methodsToOptimize). If there is currently no thread
-// servicing our queue asynchronously then we use the runtime threadpool
-// QueueUserWorkItem to recruit one. During the callback for each threadpool work
+// a fixed limit we push the method on to a lock-free list of pending promotions
+// (m_pPendingPromotions). The background thread drains that list in batches,
+// creating a tier1 code version for each method and adding it to our internal
+// queue of methods needing to be recompiled (m_pMethodsToOptimize). This keeps the
+// code version table lock and m_lock off the path of the application threads that
+// happen to reach the call count threshold. The queue is ordered by the rate at
+// which each method was called while it was being counted so the hottest methods
+// get tier1 code first. If there is currently no thread servicing our queue
+// asynchronously then we use the runtime threadpool QueueUserWorkItem to recruit one.
+// While the backlog is deeper than the number of threads servicing it and the
+// machine has idle processors we recruit additional threads, up to
+// m_maxOptimizationThreads. During the callback for each threadpool work
 // item we handle as many methods as possible in a fixed period of time, then
-// queue another threadpool work item if m_methodsToOptimize hasn't been drained.
+// queue another threadpool work item if m_pMethodsToOptimize hasn't been drained.
+//
+// The TieredCompilationBacklog event reports the depth of the queue, the number
+// of threads servicing it and the number of methods optimized so far. It is fired
+// when batches of methods are queued, at most once every m_backlogEventIntervalMs,
+// and when the queue drains, which is enough to observe how long the process takes
+// to reach steady state.
 //
 // The background thread enters at StaticOptimizeMethodsCallback(), enters the
 // appdomain, and then begins calling OptimizeMethod on each method in the
@@ -79,13 +100,32 @@
 
 // Called at AppDomain construction
 TieredCompilationManager::TieredCompilationManager() :
+    m_pMethodsToOptimize(NULL),
+    m_countMethodsToOptimize(0),
+    m_capacityMethodsToOptimize(0),
+    m_pPendingPromotions(NULL),
     m_isAppDomainShuttingDown(FALSE),
     m_countOptimizationThreadsRunning(0),
+    m_maxOptimizationThreads(1),
+    m_countMethodsOptimized(0),
     m_callCountOptimizationThreshhold(30),
-    m_optimizationQuantumMs(50)
+    m_optimizationQuantumMs(50),
+    m_backlogEventIntervalMs(100),
+    m_lastBacklogEventTickCount(0),
+    m_pClassProfileCells(NULL),
+    m_countClassProfileCells(0),
+    m_capacityClassProfileCells(0)
 {
     LIMITED_METHOD_CONTRACT;
     m_lock.Init(LOCK_TYPE_DEFAULT);
+    m_classProfileLock.Init(LOCK_TYPE_DEFAULT);
+}
+
+TieredCompilationManager::~TieredCompilationManager()
+{
+    LIMITED_METHOD_CONTRACT;
+    delete[] m_pMethodsToOptimize;
+    delete[] m_pClassProfileCells;
 }
 
 // Called at AppDomain Init
@@ -100,8 +140,17 @@ void TieredCompilationManager::Init(ADID appDomainId)
     }
     CONTRACTL_END;
 
+    DWORD maxOptimizationThreads = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_TC_BackgroundWorkerMax);
+    if (maxOptimizationThreads == 0)
+    {
+        // Leave a processor for the application, which is still running tier0 code
+        int cpuCount = GetCurrentProcessCpuCount();
+        maxOptimizationThreads = cpuCount > 1 ? cpuCount - 1 : 1;
+    }
+
     SpinLockHolder holder(&m_lock);
     m_domainId = appDomainId;
+    m_maxOptimizationThreads = maxOptimizationThreads;
     m_asyncWorkDoneEvent.CreateManualEventNoThrow(TRUE);
 }
 
@@ -111,7 +160,9 @@ void TieredCompilationManager::Init(ADID appDomainId)
 //
 // currentCallCount is pre-incremented, that is to say the value is 1 on first call for a given
 //      method.
-BOOL TieredCompilationManager::OnMethodCalled(MethodDesc* pMethodDesc, DWORD currentCallCount)
+// firstCallTickCount is the tick count at which the first call was counted, it is used to
+//      prioritize methods that are called frequently. 0 means it is not known yet.
+BOOL TieredCompilationManager::OnMethodCalled(MethodDesc* pMethodDesc, DWORD currentCallCount, DWORD firstCallTickCount)
 {
     STANDARD_VM_CONTRACT;
 
@@ -123,11 +174,322 @@ BOOL TieredCompilationManager::OnMethodCalled(MethodDesc* pMethodDesc, DWORD cur
     {
         return TRUE; // stop notifications for this method
     }
-    AsyncPromoteMethodToTier1(pMethodDesc);
+
+    // Without the first call tick count assume the calls were spread over a second
+    DWORD elapsedMs = (firstCallTickCount != 0) ? GetTickCount() - firstCallTickCount : 1000;
+    DWORD callRate = (DWORD)(((ULONGLONG)currentCallCount * 1000) / max(elapsedMs, (DWORD)1));
+    QueuePendingPromotion(pMethodDesc, callRate);
     return TRUE;
 }
 
-void TieredCompilationManager::AsyncPromoteMethodToTier1(MethodDesc* pMethodDesc)
+// Called from tier0 code (see JIT_LoopBackEdgeThreshold) when a single invocation of
+// the method has taken enough loop back-edges. The invocation that is running keeps
+// executing tier0 code, but once the tier1 code is activated the next invocation will
+// run it. Transitioning the running invocation (on-stack replacement) isn't supported.
+//
+// The tier0 code calls the helper periodically for as long as the loop runs, the method
+// is flagged here so that the helper only reports it once.
+void TieredCompilationManager::OnLoopBackEdgeThreshold(MethodDesc* pMethodDesc)
+{
+    STANDARD_VM_CONTRACT;
+
+    _ASSERTE(pMethodDesc->IsEligibleForTieredCompilation());
+
+    LOG((LF_TIEREDCOMPILATION, LL_INFO10000, "TieredCompilationManager::OnLoopBackEdgeThreshold Method=0x%pM (%s::%s)\n",
+        pMethodDesc, pMethodDesc->m_pszDebugClassName, pMethodDesc->m_pszDebugMethodName));
+
+    if (pMethodDesc->IsLoopPromotionRequested())
+    {
+        return;
+    }
+    pMethodDesc->SetLoopPromotionRequested();
+
+    // The method is running hot right now, put it ahead of call counted methods
+    QueuePendingPromotion(pMethodDesc, MAXDWORD);
+}
+
+// Called by the JIT when it compiles a virtual call at ilOffset in tier0 code for
+// pMethodDesc. Returns the cell the tier0 code should record the class of 'this'
+// in, see JIT_ClassProfile, or NULL if the call site should not be profiled.
+//
+// Cells live as long as the loader allocator of the method and are never freed,
+// so methods that can be unloaded aren't profiled.
+TieredCompilationManager::ClassProfileCell* TieredCompilationManager::GetClassProfileCell(MethodDesc* pMethodDesc, DWORD ilOffset)
+{
+    STANDARD_VM_CONTRACT;
+
+    if (!pMethodDesc->IsEligibleForTieredCompilation() || pMethodDesc->GetLoaderAllocator()->IsCollectible())
+    {
+        return NULL;
+    }
+
+    {
+        SpinLockHolder holder(&m_classProfileLock);
+        ClassProfileCell* pCell = FindClassProfileCell(pMethodDesc, ilOffset);
+        if (pCell != NULL)
+        {
+            return pCell;
+        }
+    }
+
+    // Allocate outside of m_classProfileLock, the loader heap takes a lock of its own.
+    // If another thread jitting the same method races with us one of the cells is
+    // wasted, that is rare enough not to matter.
+    ClassProfileCell* pNewCell = (ClassProfileCell*)(void*)pMethodDesc->GetLoaderAllocator()->GetLowFrequencyHeap()->
+        AllocMem_NoThrow(S_SIZE_T(sizeof(ClassProfileCell)));
+    if (pNewCell == NULL)
+    {
+        return NULL;
+    }
+    pNewCell->pMethodDesc = pMethodDesc;
+    pNewCell->ilOffset = ilOffset;
+    pNewCell->pLikelyMT = NULL;
+    pNewCell->likelyCount = 0;
+    pNewCell->totalCount = 0;
+
+    SpinLockHolder holder(&m_classProfileLock);
+    ClassProfileCell* pCell = FindClassProfileCell(pMethodDesc, ilOffset);
+    if (pCell != NULL)
+    {
+        return pCell;
+    }
+    if (!AddClassProfileCell(pNewCell))
+    {
+        return NULL;
+    }
+    return pNewCell;
+}
+
+// Called by the JIT when it compiles tier1 code for pMethodDesc. Returns the class
+// most often seen as 'this' by the virtual call at ilOffset in the tier0 code, and
+// in pLikelihood a conservative estimate of the percentage of calls made on it.
+// Returns NULL if the call site wasn't profiled or hasn't been run often enough.
+MethodTable* TieredCompilationManager::GetLikelyClass(MethodDesc* pMethodDesc, DWORD ilOffset, DWORD* pLikelihood)
+{
+    STANDARD_VM_CONTRACT;
+
+    ClassProfileCell* pCell;
+    {
+        SpinLockHolder holder(&m_classProfileLock);
+        pCell = FindClassProfileCell(pMethodDesc, ilOffset);
+    }
+    if (pCell == NULL)
+    {
+        return NULL;
+    }
+
+    // Tier0 code may still be updating the cell, take a snapshot
+    MethodTable* pMT = VolatileLoadWithoutBarrier(&pCell->pLikelyMT);
+    LONG likelyCount = VolatileLoadWithoutBarrier(&pCell->likelyCount);
+    LONG totalCount = VolatileLoadWithoutBarrier(&pCell->totalCount);
+    if (pMT == NULL || likelyCount <= 0 || totalCount < ClassProfileMinSamples)
+    {
+        return NULL;
+    }
+
+    // The tier1 code embeds the class handle, which must outlive it
+    if (pMT->Collectible())
+    {
+        return NULL;
+    }
+
+    *pLikelihood = (DWORD)((100 * (LONGLONG)min(likelyCount, totalCount)) / totalCount);
+    return pMT;
+}
+
+// Looks up the class profile cell for a call site. Called with m_classProfileLock held.
+TieredCompilationManager::ClassProfileCell* TieredCompilationManager::FindClassProfileCell(MethodDesc* pMethodDesc, DWORD ilOffset)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (m_countClassProfileCells == 0)
+    {
+        return NULL;
+    }
+
+    COUNT_T mask = m_capacityClassProfileCells - 1;
+    COUNT_T index = (COUNT_T)(((size_t)pMethodDesc >> 3) ^ (ilOffset * 0x9E3779B1)) & mask;
+    for (ClassProfileCell* pCell = m_pClassProfileCells[index]; pCell != NULL; pCell = m_pClassProfileCells[index])
+    {
+        if (pCell->pMethodDesc == pMethodDesc && pCell->ilOffset == ilOffset)
+        {
+            return pCell;
+        }
+        index = (index + 1) & mask;
+    }
+    return NULL;
+}
+
+// Adds a cell that isn't in the table yet, growing the table so it is never more
+// than half full. Called with m_classProfileLock held.
+BOOL TieredCompilationManager::AddClassProfileCell(ClassProfileCell* pNewCell)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if ((m_countClassProfileCells + 1) * 2 > m_capacityClassProfileCells)
+    {
+        COUNT_T newCapacity = max(m_capacityClassProfileCells * 2, (COUNT_T)256);
+        ClassProfileCell** pNewCells = new (nothrow) ClassProfileCell*[newCapacity];
+        if (pNewCells == NULL)
+        {
+            return FALSE;
+        }
+        memset(pNewCells, 0, newCapacity * sizeof(ClassProfileCell*));
+
+        ClassProfileCell** pOldCells = m_pClassProfileCells;
+        COUNT_T oldCapacity = m_capacityClassProfileCells;
+        m_pClassProfileCells = pNewCells;
+        m_capacityClassProfileCells = newCapacity;
+        m_countClassProfileCells = 0;
+        for (COUNT_T i = 0; i < oldCapacity; i++)
+        {
+            if (pOldCells[i] != NULL)
+            {
+                AddClassProfileCell(pOldCells[i]);
+            }
+        }
+        delete[] pOldCells;
+    }
+
+    COUNT_T mask = m_capacityClassProfileCells - 1;
+    COUNT_T index = (COUNT_T)(((size_t)pNewCell->pMethodDesc >> 3) ^ (pNewCell->ilOffset * 0x9E3779B1)) & mask;
+    while (m_pClassProfileCells[index] != NULL)
+    {
+        index = (index + 1) & mask;
+    }
+    m_pClassProfileCells[index] = pNewCell;
+    m_countClassProfileCells++;
+    return TRUE;
+}
+
+// Records that pMethodDesc should be promoted to tier1 without taking any lock
+// in the common case. The background thread creates the tier1 code version and
+// queues it for optimization (see PromotePendingMethods). Only the thread that
+// pushes onto an empty list needs to make sure a background thread is running.
+//
+// It is harmless if the same method is queued more than once, duplicates are
+// discarded when the tier1 code version is created.
+void TieredCompilationManager::QueuePendingPromotion(MethodDesc* pMethodDesc, DWORD callRate)
+{
+    STANDARD_VM_CONTRACT;
+
+    if (m_isAppDomainShuttingDown)
+    {
+        return;
+    }
+
+    PendingPromotion* pPromotion = new (nothrow) PendingPromotion();
+    if (pPromotion == NULL)
+    {
+        STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::QueuePendingPromotion: "
+            "OOM allocating pending promotion, method=%pM\n", pMethodDesc);
+        return;
+    }
+    pPromotion->pMethodDesc = pMethodDesc;
+    pPromotion->callRate = callRate;
+
+    PendingPromotion* pHead;
+    do
+    {
+        pHead = VolatileLoad(&m_pPendingPromotions);
+        pPromotion->pNext = pHead;
+    } while (InterlockedCompareExchangeT(&m_pPendingPromotions, pPromotion, pHead) != pHead);
+
+    LOG((LF_TIEREDCOMPILATION, LL_INFO10000, "TieredCompilationManager::QueuePendingPromotion Method=0x%pM (%s::%s) queued, call rate=%u/s\n",
+        pMethodDesc, pMethodDesc->m_pszDebugClassName, pMethodDesc->m_pszDebugMethodName, callRate));
+
+    if (pHead == NULL)
+    {
+        EnsureOptimizationThreadRunning();
+    }
+}
+
+// Drains the pending promotion list, creating tier1 code versions for the whole
+// batch and adding them to m_pMethodsToOptimize with a single acquisition of m_lock.
+// Returns TRUE if any methods were queued.
+// Called on a background thread without m_lock held.
+BOOL TieredCompilationManager::PromotePendingMethods()
+{
+    STANDARD_VM_CONTRACT;
+
+    PendingPromotion* pPromotion = InterlockedExchangeT(&m_pPendingPromotions, NULL);
+    if (pPromotion == NULL)
+    {
+        return FALSE;
+    }
+
+    COUNT_T pendingCount = 0;
+    for (PendingPromotion* pCur = pPromotion; pCur != NULL; pCur = pCur->pNext)
+    {
+        pendingCount++;
+    }
+
+    // If this allocation fails the batch goes unoptimized, the same as if each
+    // method had failed to allocate its own queue entry
+    OptimizationRequest* pBatch = new (nothrow) OptimizationRequest[pendingCount];
+    if (pBatch == NULL)
+    {
+        STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::PromotePendingMethods: "
+            "OOM allocating batch of %u methods\n", pendingCount);
+    }
+
+    COUNT_T batchCount = 0;
+    while (pPromotion != NULL)
+    {
+        NativeCodeVersion t1NativeCodeVersion;
+        if (pBatch != NULL && CreateTier1CodeVersion(pPromotion->pMethodDesc, &t1NativeCodeVersion))
+        {
+            pBatch[batchCount].nativeCodeVersion = t1NativeCodeVersion;
+            pBatch[batchCount].callRate = pPromotion->callRate;
+            batchCount++;
+        }
+
+        PendingPromotion* pNext = pPromotion->pNext;
+        delete pPromotion;
+        pPromotion = pNext;
+    }
+
+    DWORD backlogDepth;
+    DWORD workerThreadCount;
+    BOOL fireBacklogEvent = FALSE;
+    {
+        SpinLockHolder holder(&m_lock);
+        for (COUNT_T i = 0; i < batchCount; i++)
+        {
+            if (!EnqueueMethodToOptimize(pBatch[i].nativeCodeVersion, pBatch[i].callRate))
+            {
+                STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::PromotePendingMethods: "
+                    "OOM growing the optimization queue, %u methods dropped\n", batchCount - i);
+                break;
+            }
+        }
+        backlogDepth = m_countMethodsToOptimize;
+        workerThreadCount = m_countOptimizationThreadsRunning;
+
+        // Batches are queued many times a second while the application warms up
+        ULONGLONG currentTickCount = CLRGetTickCount64();
+        if (currentTickCount >= m_lastBacklogEventTickCount + m_backlogEventIntervalMs)
+        {
+            m_lastBacklogEventTickCount = currentTickCount;
+            fireBacklogEvent = TRUE;
+        }
+    }
+    delete[] pBatch;
+
+    LOG((LF_TIEREDCOMPILATION, LL_INFO1000, "TieredCompilationManager::PromotePendingMethods queued a batch of %u methods, backlog=%u\n",
+        batchCount, backlogDepth));
+    if (fireBacklogEvent)
+    {
+        FireEtwTieredCompilationBacklog(backlogDepth, workerThreadCount, m_countMethodsOptimized, GetClrInstanceId());
+    }
+
+    return batchCount > 0;
+}
+
+// Adds an inactive native code entry in the versioning table to track the tier1
+// compilation of pMethodDesc. Returns FALSE if the method has already been
+// promoted or the entry could not be created.
+BOOL TieredCompilationManager::CreateTier1CodeVersion(MethodDesc* pMethodDesc, NativeCodeVersion* pNativeCodeVersion)
 {
     STANDARD_VM_CONTRACT;
 
@@ -148,9 +510,9 @@ void TieredCompilationManager::AsyncPromoteMethodToTier1(MethodDesc* pMethodDesc
             if (cur->GetOptimizationTier() == NativeCodeVersion::OptimizationTier1)
             {
                 // we've already promoted
-                LOG((LF_TIEREDCOMPILATION, LL_INFO100000, "TieredCompilationManager::AsyncPromoteMethodToTier1 Method=0x%pM (%s::%s) ignoring already promoted method\n",
+                LOG((LF_TIEREDCOMPILATION, LL_INFO100000, "TieredCompilationManager::CreateTier1CodeVersion Method=0x%pM (%s::%s) ignoring already promoted method\n",
                     pMethodDesc, pMethodDesc->m_pszDebugClassName, pMethodDesc->m_pszDebugMethodName));
-                return;
+                return FALSE;
             }
         }
 
@@ -159,42 +521,70 @@ void TieredCompilationManager::AsyncPromoteMethodToTier1(MethodDesc* pMethodDesc
         {
             // optimization didn't work for some reason (presumably OOM)
             // just give up and continue on
-            STRESS_LOG2(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::AsyncPromoteMethodToTier1: "
+            STRESS_LOG2(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::CreateTier1CodeVersion: "
                 "AddNativeCodeVersion failed hr=0x%x, method=%pM\n",
                 hr, pMethodDesc);
-            return;
+            return FALSE;
         }
         t1NativeCodeVersion.SetOptimizationTier(NativeCodeVersion::OptimizationTier1);
     }
 
+    *pNativeCodeVersion = t1NativeCodeVersion;
+    return TRUE;
+}
+
+// Synchronously creates the tier1 code version for pMethodDesc and queues it for
+// background optimization.
+void TieredCompilationManager::AsyncPromoteMethodToTier1(MethodDesc* pMethodDesc)
+{
+    STANDARD_VM_CONTRACT;
+
+    NativeCodeVersion t1NativeCodeVersion;
+    if (!CreateTier1CodeVersion(pMethodDesc, &t1NativeCodeVersion))
+    {
+        return;
+    }
+
     // Insert the method into the optimization queue and trigger a thread to service
-    // the queue if needed.
-    //
-    // Terminal exceptions escape as exceptions, but all other errors should gracefully
-    // return to the caller. Non-terminal error conditions should be rare (ie OOM,
-    // OS failure to create thread) and we consider it reasonable for some methods
-    // to go unoptimized or have their optimization arbitrarily delayed under these
-    // circumstances. Note an error here could affect concurrent threads running this
-    // code. Those threads will observe m_countOptimizationThreadsRunning > 0 and return,
-    // then QueueUserWorkItem fails on this thread lowering the count and leaves them 
-    // unserviced. Synchronous retries appear unlikely to offer any material improvement 
-    // and complicating the code to narrow an already rare error case isn't desirable.
-    {
-        SListElem<NativeCodeVersion>* pMethodListItem = new (nothrow) SListElem<NativeCodeVersion>(t1NativeCodeVersion);
+    // the queue if needed. Calls to this method aren't counted so there is no call
+    // rate to prioritize it by.
+    {
         SpinLockHolder holder(&m_lock);
-        if (pMethodListItem != NULL)
+        if (!EnqueueMethodToOptimize(t1NativeCodeVersion, 0))
         {
-            m_methodsToOptimize.InsertTail(pMethodListItem);
+            STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::AsyncPromoteMethodToTier1: "
+                "OOM growing the optimization queue, method=%pM\n", pMethodDesc);
+            return;
         }
 
         LOG((LF_TIEREDCOMPILATION, LL_INFO10000, "TieredCompilationManager::AsyncPromoteMethodToTier1 Method=0x%pM (%s::%s), code version id=0x%x queued\n",
             pMethodDesc, pMethodDesc->m_pszDebugClassName, pMethodDesc->m_pszDebugMethodName,
             t1NativeCodeVersion.GetVersionId()));
+    }
+
+    EnsureOptimizationThreadRunning();
+}
+
+// Recruits a threadpool thread to service the optimization queue if none is running,
+// or if the backlog justifies another one (see ShouldAddOptimizationThread).
+//
+// Terminal exceptions escape as exceptions, but all other errors should gracefully
+// return to the caller. Non-terminal error conditions should be rare (ie OOM,
+// OS failure to create thread) and we consider it reasonable for some methods
+// to go unoptimized or have their optimization arbitrarily delayed under these
+// circumstances. Note an error here could affect concurrent threads running this
+// code. Those threads will observe m_countOptimizationThreadsRunning > 0 and return,
+// then QueueUserWorkItem fails on this thread lowering the count and leaves them
+// unserviced. Synchronous retries appear unlikely to offer any material improvement
+// and complicating the code to narrow an already rare error case isn't desirable.
+void TieredCompilationManager::EnsureOptimizationThreadRunning()
+{
+    STANDARD_VM_CONTRACT;
 
-        if (0 == m_countOptimizationThreadsRunning && !m_isAppDomainShuttingDown)
+    {
+        SpinLockHolder holder(&m_lock);
+        if (ShouldAddOptimizationThread())
         {
-            // Our current policy throttles at 1 thread, but in the future we
-            // could experiment with more parallelism.
             IncrementWorkerThreadCount();
         }
         else
@@ -209,24 +599,53 @@ void TieredCompilationManager::AsyncPromoteMethodToTier1(MethodDesc* pMethodDesc
         {
             SpinLockHolder holder(&m_lock);
             DecrementWorkerThreadCount();
-            STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::OnMethodCalled: "
-                "ThreadpoolMgr::QueueUserWorkItem returned FALSE (no thread will run), method=%pM\n",
-                pMethodDesc);
+            STRESS_LOG0(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::EnsureOptimizationThreadRunning: "
+                "ThreadpoolMgr::QueueUserWorkItem returned FALSE (no thread will run)\n");
         }
     }
     EX_CATCH
     {
         SpinLockHolder holder(&m_lock);
         DecrementWorkerThreadCount();
-        STRESS_LOG2(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::OnMethodCalled: "
-            "Exception queuing work item to threadpool, hr=0x%x, method=%pM\n",
-            GET_EXCEPTION()->GetHR(), pMethodDesc);
+        STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::EnsureOptimizationThreadRunning: "
+            "Exception queuing work item to threadpool, hr=0x%x\n",
+            GET_EXCEPTION()->GetHR());
     }
     EX_END_CATCH(RethrowTerminalExceptions);
 
     return;
 }
 
+// Decides whether another thread should be recruited to service the optimization
+// queue. There is always at least one thread while there is work. Beyond that we only
+// add threads that would each have a method to compile, up to m_maxOptimizationThreads,
+// and only while the process leaves processors idle so background compilation doesn't
+// compete with the application. Busy optimization threads count towards the measured
+// utilization, so the number of threads levels off on its own.
+// This should be called with m_lock already held.
+BOOL TieredCompilationManager::ShouldAddOptimizationThread()
+{
+    STANDARD_VM_CONTRACT;
+
+    if (m_isAppDomainShuttingDown)
+    {
+        return FALSE;
+    }
+    if (m_countOptimizationThreadsRunning == 0)
+    {
+        return TRUE;
+    }
+    if (m_countOptimizationThreadsRunning >= m_maxOptimizationThreads ||
+        m_countMethodsToOptimize <= m_countOptimizationThreadsRunning)
+    {
+        return FALSE;
+    }
+
+    LONG cpuUtilization = min(max(ThreadpoolMgr::GetCPUUtilization(), (LONG)0), (LONG)100);
+    DWORD idleProcessors = (DWORD)(GetCurrentProcessCpuCount() * (100 - cpuUtilization) / 100);
+    return m_countOptimizationThreadsRunning < idleProcessors;
+}
+
 // static
 // called from EEShutDownHelper
 void TieredCompilationManager::ShutdownAllDomains()
@@ -296,6 +715,8 @@ void TieredCompilationManager::OptimizeMethodsCallback()
 
     ULONGLONG startTickCount = CLRGetTickCount64();
     NativeCodeVersion nativeCodeVersion;
+    BOOL fQueueDrained = FALSE;
+    DWORD workerThreadCount = 0;
     EX_TRY
     {
         GCX_COOP();
@@ -304,18 +725,34 @@ void TieredCompilationManager::OptimizeMethodsCallback()
             GCX_PREEMP();
             while (true)
             {
+                if (PromotePendingMethods())
                 {
+                    // A new batch may justify recruiting more threads
+                    EnsureOptimizationThreadRunning();
+                }
+                {
+                    // Methods pushed on to m_pPendingPromotions after it was drained
+                    // above must not be stranded. The thread pushing on to an empty
+                    // list checks m_countOptimizationThreadsRunning under m_lock, so
+                    // checking the list under m_lock here guarantees one of us sees
+                    // the other.
                     SpinLockHolder holder(&m_lock); 
                     nativeCodeVersion = GetNextMethodToOptimize();
-                    if (nativeCodeVersion.IsNull() ||
-                        m_isAppDomainShuttingDown)
+                    if (m_isAppDomainShuttingDown ||
+                        (nativeCodeVersion.IsNull() && VolatileLoad(&m_pPendingPromotions) == NULL))
                     {
                         DecrementWorkerThreadCount();
+                        fQueueDrained = !m_isAppDomainShuttingDown;
+                        workerThreadCount = m_countOptimizationThreadsRunning;
                         break;
                     }
                     
                 }
-                OptimizeMethod(nativeCodeVersion);
+                if (!nativeCodeVersion.IsNull())
+                {
+                    OptimizeMethod(nativeCodeVersion);
+                    FastInterlockIncrement((LONG*)&m_countMethodsOptimized);
+                }
 
                 // If we have been running for too long return the thread to the threadpool and queue another event
                 // This gives the threadpool a chance to service other requests on this thread before returning to
@@ -343,6 +780,11 @@ void TieredCompilationManager::OptimizeMethodsCallback()
             GET_EXCEPTION()->GetHR(), nativeCodeVersion.GetMethodDesc());
     }
     EX_END_CATCH(RethrowTerminalExceptions);
+
+    if (fQueueDrained)
+    {
+        FireEtwTieredCompilationBacklog(0, workerThreadCount, m_countMethodsOptimized, GetClrInstanceId());
+    }
 }
 
 // Jit compiles and installs new optimized code for a method.
@@ -437,21 +879,86 @@ void TieredCompilationManager::ActivateCodeVersion(NativeCodeVersion nativeCodeV
     }
 }
 
-// Dequeues the next method in the optmization queue.
+// Adds a method to the optimization queue, ordered by callRate.
+// This should be called with m_lock already held. Returns FALSE if
+// the queue could not be grown.
+BOOL TieredCompilationManager::EnqueueMethodToOptimize(NativeCodeVersion nativeCodeVersion, DWORD callRate)
+{
+    STANDARD_VM_CONTRACT;
+
+    if (m_countMethodsToOptimize == m_capacityMethodsToOptimize)
+    {
+        COUNT_T newCapacity = max(m_capacityMethodsToOptimize * 2, (COUNT_T)64);
+        OptimizationRequest* pNewMethodsToOptimize = new (nothrow) OptimizationRequest[newCapacity];
+        if (pNewMethodsToOptimize == NULL)
+        {
+            return FALSE;
+        }
+        for (COUNT_T i = 0; i < m_countMethodsToOptimize; i++)
+        {
+            pNewMethodsToOptimize[i] = m_pMethodsToOptimize[i];
+        }
+        delete[] m_pMethodsToOptimize;
+        m_pMethodsToOptimize = pNewMethodsToOptimize;
+        m_capacityMethodsToOptimize = newCapacity;
+    }
+
+    // Sift the new request up from the end of the heap
+    COUNT_T index = m_countMethodsToOptimize++;
+    while (index > 0)
+    {
+        COUNT_T parent = (index - 1) / 2;
+        if (m_pMethodsToOptimize[parent].callRate >= callRate)
+        {
+            break;
+        }
+        m_pMethodsToOptimize[index] = m_pMethodsToOptimize[parent];
+        index = parent;
+    }
+    m_pMethodsToOptimize[index].nativeCodeVersion = nativeCodeVersion;
+    m_pMethodsToOptimize[index].callRate = callRate;
+    return TRUE;
+}
+
+// Dequeues the most frequently called method in the optmization queue.
 // This should be called with m_lock already held and runs
 // on the background thread.
 NativeCodeVersion TieredCompilationManager::GetNextMethodToOptimize()
 {
     STANDARD_VM_CONTRACT;
 
-    SListElem<NativeCodeVersion>* pElem = m_methodsToOptimize.RemoveHead();
-    if (pElem != NULL)
+    if (m_countMethodsToOptimize == 0)
     {
-        NativeCodeVersion nativeCodeVersion = pElem->GetValue();
-        delete pElem;
-        return nativeCodeVersion;
+        return NativeCodeVersion();
     }
-    return NativeCodeVersion();
+
+    NativeCodeVersion nativeCodeVersion = m_pMethodsToOptimize[0].nativeCodeVersion;
+
+    // Sift the last request down from the root of the heap
+    OptimizationRequest last = m_pMethodsToOptimize[--m_countMethodsToOptimize];
+    COUNT_T index = 0;
+    while (true)
+    {
+        COUNT_T child = index * 2 + 1;
+        if (child >= m_countMethodsToOptimize)
+        {
+            break;
+        }
+        if (child + 1 < m_countMethodsToOptimize &&
+            m_pMethodsToOptimize[child + 1].callRate > m_pMethodsToOptimize[child].callRate)
+        {
+            child++;
+        }
+        if (last.callRate >= m_pMethodsToOptimize[child].callRate)
+        {
+            break;
+        }
+        m_pMethodsToOptimize[index] = m_pMethodsToOptimize[child];
+        index = child;
+    }
+    m_pMethodsToOptimize[index] = last;
+
+    return nativeCodeVersion;
 }
 
 void TieredCompilationManager::IncrementWorkerThreadCount()
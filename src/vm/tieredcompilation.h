@@ -22,17 +22,88 @@ public:
     TieredCompilationManager() {}
 #else
     TieredCompilationManager();
+    ~TieredCompilationManager();
 #endif
 
     void Init(ADID appDomainId);
-    BOOL OnMethodCalled(MethodDesc* pMethodDesc, DWORD currentCallCount);
+    BOOL OnMethodCalled(MethodDesc* pMethodDesc, DWORD currentCallCount, DWORD firstCallTickCount);
+    void OnLoopBackEdgeThreshold(MethodDesc* pMethodDesc);
     void AsyncPromoteMethodToTier1(MethodDesc* pMethodDesc);
     static void ShutdownAllDomains();
     void Shutdown(BOOL fBlockUntilAsyncWorkIsComplete);
     static CORJIT_FLAGS GetJitFlags(NativeCodeVersion nativeCodeVersion);
 
+    // Profile of the classes seen as 'this' by one virtual call site in tier0
+    // code. Tier0 code updates it through JIT_ClassProfile without any
+    // synchronization, so lost updates are possible and the counts are only
+    // estimates.
+    struct ClassProfileCell
+    {
+        MethodDesc* pMethodDesc;
+        DWORD ilOffset;
+        MethodTable* pLikelyMT;     // majority vote candidate
+        LONG likelyCount;           // votes for pLikelyMT not yet cancelled by other classes
+        LONG totalCount;            // number of samples, stops at ClassProfileMaxSamples
+    };
+
+    // Boyer-Moore majority vote. pLikelyMT is the majority class if there is one,
+    // and is seen on at least likelyCount / totalCount of the calls.
+    static void RecordClass(ClassProfileCell* pCell, MethodTable* pMT)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        if (pCell->totalCount >= ClassProfileMaxSamples)
+        {
+            return;
+        }
+
+        pCell->totalCount++;
+        if (pCell->pLikelyMT == pMT)
+        {
+            pCell->likelyCount++;
+        }
+        else if (pCell->likelyCount <= 0)
+        {
+            pCell->pLikelyMT = pMT;
+            pCell->likelyCount = 1;
+        }
+        else
+        {
+            pCell->likelyCount--;
+        }
+    }
+
+    ClassProfileCell* GetClassProfileCell(MethodDesc* pMethodDesc, DWORD ilOffset);
+    MethodTable* GetLikelyClass(MethodDesc* pMethodDesc, DWORD ilOffset, DWORD* pLikelihood);
+
 private:
 
+    static const LONG ClassProfileMaxSamples = 4096;
+    static const LONG ClassProfileMinSamples = 16;
+
+    // A method that reached the call count threshold and is waiting for the
+    // background worker to create its tier1 code version
+    struct PendingPromotion
+    {
+        PendingPromotion* pNext;
+        MethodDesc* pMethodDesc;
+        DWORD callRate;
+    };
+
+    // An entry in the m_pMethodsToOptimize heap
+    struct OptimizationRequest
+    {
+        NativeCodeVersion nativeCodeVersion;
+        DWORD callRate;     // calls per second observed while counting, higher is optimized first
+    };
+
+    void QueuePendingPromotion(MethodDesc* pMethodDesc, DWORD callRate);
+    BOOL PromotePendingMethods();
+    BOOL CreateTier1CodeVersion(MethodDesc* pMethodDesc, NativeCodeVersion* pNativeCodeVersion);
+    void EnsureOptimizationThreadRunning();
+    BOOL ShouldAddOptimizationThread();
+    BOOL EnqueueMethodToOptimize(NativeCodeVersion nativeCodeVersion, DWORD callRate);
+
     static DWORD StaticOptimizeMethodsCallback(void* args);
     void OptimizeMethodsCallback();
     void OptimizeMethod(NativeCodeVersion nativeCodeVersion);
@@ -43,14 +114,29 @@ private:
     void IncrementWorkerThreadCount();
     void DecrementWorkerThreadCount();
 
+    ClassProfileCell* FindClassProfileCell(MethodDesc* pMethodDesc, DWORD ilOffset);
+    BOOL AddClassProfileCell(ClassProfileCell* pCell);
+
     SpinLock m_lock;
-    SList<SListElem<NativeCodeVersion>> m_methodsToOptimize;
+    OptimizationRequest* m_pMethodsToOptimize; // binary max-heap ordered by callRate
+    COUNT_T m_countMethodsToOptimize;
+    COUNT_T m_capacityMethodsToOptimize;
+    PendingPromotion* m_pPendingPromotions; // lock-free stack, not protected by m_lock
     ADID m_domainId;
     BOOL m_isAppDomainShuttingDown;
     DWORD m_countOptimizationThreadsRunning;
+    DWORD m_maxOptimizationThreads;
+    DWORD m_countMethodsOptimized;
     DWORD m_callCountOptimizationThreshhold;
     DWORD m_optimizationQuantumMs;
+    DWORD m_backlogEventIntervalMs;
+    ULONGLONG m_lastBacklogEventTickCount;
     CLREvent m_asyncWorkDoneEvent;
+
+    SpinLock m_classProfileLock;
+    ClassProfileCell** m_pClassProfileCells;   // open addressed hash table keyed by method and IL offset
+    COUNT_T m_countClassProfileCells;
+    COUNT_T m_capacityClassProfileCells;     // zero or a power of two
 };
 
 #endif // FEATURE_TIERED_COMPILATION
@@ -32,10 +32,12 @@ UINT32 g_site_counter = 0;              //# of call sites
 UINT32 g_site_write = 0;                //# of call site backpatch writes
 UINT32 g_site_write_poly = 0;           //# of call site backpatch writes to point to resolve stubs
 UINT32 g_site_write_mono = 0;           //# of call site backpatch writes to point to dispatch stubs
+UINT32 g_site_write_poly_inline = 0;    //# of call site backpatch writes that grew a polymorphic inline cache
 
 UINT32 g_stub_lookup_counter = 0;       //# of lookup stubs
 UINT32 g_stub_mono_counter = 0;         //# of dispatch stubs
 UINT32 g_stub_poly_counter = 0;         //# of resolve stubs
+UINT32 g_stub_poly_inline_counter = 0;  //# of per-call-site dispatch stubs chained into polymorphic inline caches
 UINT32 g_stub_space = 0;                //# of bytes of stubs
 
 UINT32 g_reclaim_counter = 0;           //# of times a ReclaimAll was performed
@@ -105,6 +107,10 @@ UINT32 STUB_COLLIDE_WRITE_PCT = 100;
 UINT32 STUB_COLLIDE_MONO_PCT  =   0;
 #endif // STUB_LOGGING
 
+// Maximum number of dispatch stubs that may be chained at a single call site, see
+// code:VirtualCallStubManager::GrowPolyInlineCache
+UINT32 g_polyInlineCacheSize = CALL_STUB_POLY_INLINE_CACHE_SIZE;
+
 FastTable* BucketTable::dead = NULL;    //linked list of the abandoned buckets
 
 DispatchCache *g_resolveCache = NULL;    //cache of dispatch stubs for in line lookup by resolve stubs.
@@ -226,6 +232,8 @@ void VirtualCallStubManager::LoggingDump()
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "site_write_poly", g_site_write_poly);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
+        sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "site_write_poly_inline", g_site_write_poly_inline);
+        WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
 
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), "\r\n%-30s %d\r\n", "reclaim_counter", g_reclaim_counter);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
@@ -239,6 +247,8 @@ void VirtualCallStubManager::LoggingDump()
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "stub_poly_counter", g_stub_poly_counter);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
+        sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "stub_poly_inline_counter", g_stub_poly_inline_counter);
+        WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "stub_space", g_stub_space);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
 
@@ -872,6 +882,10 @@ void VirtualCallStubManager::InitStatic()
     g_resetCacheIncr       = (INT32) CLRConfig::GetConfigValue(CLRConfig::INTERNAL_VirtualCallStubResetCacheIncr);
 #endif // STUB_LOGGING
 
+    g_polyInlineCacheSize = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_VirtualCallStubPolyInlineCacheSize);
+    if (g_polyInlineCacheSize > CALL_STUB_POLY_INLINE_CACHE_MAX_SIZE)
+        g_polyInlineCacheSize = CALL_STUB_POLY_INLINE_CACHE_MAX_SIZE;
+
 #ifndef STUB_DISPATCH_PORTABLE
     DispatchHolder::InitializeStatic();
     ResolveHolder::InitializeStatic();
@@ -1440,8 +1454,7 @@ size_t VirtualCallStubManager::GetTokenFromStubQuick(VirtualCallStubManager * pM
     if (kind == SK_DISPATCH)
     {
         _ASSERTE(pMgr->isDispatchingStub(stub));
-        DispatchStub  * dispatchStub  = (DispatchStub *) PCODEToPINSTR(stub);
-        ResolveHolder * resolveHolder = ResolveHolder::FromFailEntry(dispatchStub->failTarget());
+        ResolveHolder * resolveHolder = ResolveHolder::FromFailEntry(pMgr->GetDispatchChainFailEntry(stub));
         _ASSERTE(pMgr->isResolvingStub(resolveHolder->stub()->resolveEntryPoint()));
         return resolveHolder->stub()->token();
     }
@@ -1959,8 +1972,18 @@ PCODE VirtualCallStubManager::ResolveWorker(StubCallSite* pCallSite,
             // we'll insert the new value into the cache for the next time.
             // Note that if we decide to skip creating a DispatchStub beacuise we are calling
             // from a shared to unshared domain the we also will insert into the cache.
+            //
+            // A dispatching call site that missed gets a per-call-site dispatch stub for this type
+            // chained in front of its current one instead, so that a site alternating between a few
+            // types keeps hitting an inline MT check rather than the shared resolve cache (and this
+            // worker whenever that cache misses). The resolve cache entry is then unnecessary.
+            BOOL bPolyInlineCached = FALSE;
+            if (stubKind == SK_DISPATCH && bCreateDispatchStub)
+            {
+                bPolyInlineCached = GrowPolyInlineCache(pCallSite, objectType, token, target);
+            }
 
-            if (insertKind == DispatchCache::IK_NONE)
+            if (insertKind == DispatchCache::IK_NONE && !bPolyInlineCached)
             {
                 if (stubKind == SK_DISPATCH)
                 {
@@ -2532,6 +2555,29 @@ VirtualCallStubManager::TraceResolver(
 
 #ifndef DACCESS_COMPILE 
 
+//----------------------------------------------------------------------------
+/* Follow the failure path of a dispatch stub, past any per-call-site dispatch stubs chained
+in front of it, to the fail entry of the resolve stub the chain ends in.
+*/
+PCODE VirtualCallStubManager::GetDispatchChainFailEntry(PCODE dispatchStub)
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+        FORBID_FAULT;
+        PRECONDITION(isDispatchingStub(dispatchStub));
+    } CONTRACTL_END
+
+    PCODE failEntry = DispatchHolder::FromDispatchEntry(dispatchStub)->stub()->failTarget();
+    while (isDispatchingStub(failEntry))
+    {
+        failEntry = DispatchHolder::FromDispatchEntry(failEntry)->stub()->failTarget();
+    }
+
+    _ASSERTE(isResolvingStub(failEntry));
+    return failEntry;
+}
+
 //----------------------------------------------------------------------------
 /* Change the call site.  It is failing the expected MT test in the dispatcher stub
 too often.
@@ -2554,8 +2600,9 @@ void VirtualCallStubManager::BackPatchWorker(StubCallSite* pCallSite)
         //yes, patch it to point to the resolve stub
         //We can ignore the races now since we now know that the call site does go thru our
         //stub mechanisms, hence no matter who wins the race, we are correct.
-        //We find the correct resolve stub by following the failure path in the dispatcher stub itself
-        PCODE failEntry    = dispatchStub->failTarget();
+        //We find the correct resolve stub by following the failure path in the dispatcher stub itself,
+        //walking past any per-call-site dispatch stubs chained in front of it.
+        PCODE failEntry    = GetDispatchChainFailEntry(callSiteTarget);
         ResolveStub* resolveStub  = ResolveHolder::FromFailEntry(failEntry)->stub();
         PCODE resolveEntry = resolveStub->resolveEntryPoint();
         BackPatchSite(pCallSite, resolveEntry);
@@ -2572,6 +2619,60 @@ void VirtualCallStubManager::BackPatchWorker(StubCallSite* pCallSite)
     }
 }
 
+//----------------------------------------------------------------------------
+/* The call site is wired to a dispatch stub whose expected MT did not match pMT. If the
+site's chain of dispatch stubs has room, prepend a per-call-site dispatch stub for pMT whose
+failure target is the current chain, and point the call site at it. Such stubs are never
+placed in the dispatchers table since no other call site may share them. Once the chain is
+full, misses fall through to the resolve stub's fail entry as before and the shared miss
+counter eventually backpatches the site to the resolve stub.
+Returns TRUE if the call site now checks pMT inline.
+*/
+BOOL VirtualCallStubManager::GrowPolyInlineCache(StubCallSite* pCallSite,
+                                                 MethodTable*  pMT,
+                                                 DispatchToken token,
+                                                 PCODE         target)
+{
+    CONTRACTL {
+        THROWS;
+        GC_TRIGGERS;
+        INJECT_FAULT(COMPlusThrowOM(););
+        PRECONDITION(CheckPointer(pCallSite));
+        PRECONDITION(CheckPointer(pMT));
+        PRECONDITION(target != NULL);
+    } CONTRACTL_END;
+
+    if (g_polyInlineCacheSize < 2)
+        return FALSE;
+
+    // The site may have been backpatched to the resolve stub since the caller looked at it
+    PCODE head = pCallSite->GetSiteTarget();
+    if (!isDispatchingStub(head))
+        return FALSE;
+
+    UINT32 depth = 0;
+    for (PCODE cur = head; isDispatchingStub(cur); )
+    {
+        DispatchStub * dispatchStub = DispatchHolder::FromDispatchEntry(cur)->stub();
+
+        // Another thread already added this type, or the chain is full
+        if ((dispatchStub->expectedMT() == (size_t)pMT) || (++depth >= g_polyInlineCacheSize))
+            return FALSE;
+
+        cur = dispatchStub->failTarget();
+    }
+
+    DispatchHolder * pDispatchHolder = GenerateDispatchStub(target, head, pMT, token.To_SIZE_T());
+    stats.stub_poly_inline_counter++;
+
+    LOG((LF_STUBS, LL_INFO10000, "GrowPolyInlineCache call-site" FMT_ADDR "depth %d dispatchStub" FMT_ADDR "\n",
+         DBG_ADDR(pCallSite->GetReturnAddress()), depth + 1, DBG_ADDR(pDispatchHolder->stub())));
+
+    BackPatchSite(pCallSite, pDispatchHolder->stub()->entryPoint());
+
+    return (pCallSite->GetSiteTarget() == pDispatchHolder->stub()->entryPoint());
+}
+
 //----------------------------------------------------------------------------
 /* consider changing the call site to point to stub, if appropriate do it
 */
@@ -2599,6 +2700,7 @@ void VirtualCallStubManager::BackPatchSite(StubCallSite* pCallSite, PCODE stub)
     //  prior           new
     //  lookup          dispatching or resolving
     //  dispatching     resolving
+    //  dispatching     dispatching chained in front of prior (polymorphic inline cache)
     if (isResolvingStub(prior))
         return;
 
@@ -2606,7 +2708,11 @@ void VirtualCallStubManager::BackPatchSite(StubCallSite* pCallSite, PCODE stub)
     {
         if(isDispatchingStub(prior))
         {
-            return;
+            // Losing a race with another thread growing the same site leaves prior unchanged
+            if (DispatchHolder::FromDispatchEntry(stub)->stub()->failTarget() != prior)
+                return;
+
+            stats.site_write_poly_inline++;
         }
         else
         {
@@ -2998,6 +3104,8 @@ void VirtualCallStubManager::LogStats()
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "site_write_poly", stats.site_write_poly);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
+        sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "site_write_poly_inline", stats.site_write_poly_inline);
+        WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
 
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), "\r\nstub data\r\n");
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
@@ -3008,6 +3116,8 @@ void VirtualCallStubManager::LogStats()
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "stub_poly_counter", stats.stub_poly_counter);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
+        sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "stub_poly_inline_counter", stats.stub_poly_inline_counter);
+        WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
         sprintf_s(szPrintStr, COUNTOF(szPrintStr), OUTPUT_FORMAT_INT, "stub_space", stats.stub_space);
         WriteFile (g_hStubLogFile, szPrintStr, (DWORD) strlen(szPrintStr), &dwWriteByte, NULL);
 
@@ -3035,9 +3145,11 @@ void VirtualCallStubManager::LogStats()
     g_stub_lookup_counter += stats.stub_lookup_counter;
     g_stub_poly_counter += stats.stub_poly_counter;
     g_stub_mono_counter += stats.stub_mono_counter;
+    g_stub_poly_inline_counter += stats.stub_poly_inline_counter;
     g_site_write += stats.site_write;
     g_site_write_poly += stats.site_write_poly;
     g_site_write_mono += stats.site_write_mono;
+    g_site_write_poly_inline += stats.site_write_poly_inline;
     g_worker_call += stats.worker_call;
     g_worker_call_no_patch += stats.worker_call_no_patch;
     g_worker_collide_to_mono += stats.worker_collide_to_mono;
@@ -3049,9 +3161,11 @@ void VirtualCallStubManager::LogStats()
     stats.stub_lookup_counter = 0;
     stats.stub_poly_counter = 0;
     stats.stub_mono_counter = 0;
+    stats.stub_poly_inline_counter = 0;
     stats.site_write = 0;
     stats.site_write_poly = 0;
     stats.site_write_mono = 0;
+    stats.site_write_poly_inline = 0;
     stats.worker_call = 0;
     stats.worker_call_no_patch = 0;
     stats.worker_collide_to_mono = 0;
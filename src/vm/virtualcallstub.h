@@ -208,6 +208,10 @@ typedef VPTR(class VirtualCallStubManager) PTR_VirtualCallStubManager;
 //     * After code:STUB_MISS_COUNT_VALUE misses, we update the call site's cell to point directly at the
 //         resolve stub (thus avoiding the overhead of the quick check that always seems to be failing and
 //         the miss count update).
+//     * A miss that has to come back into code:VirtualCallStubManager.ResolveWorker while the cell still
+//         points at a dispatch stub instead chains a new, per-call-site dispatch stub for the missing type in
+//         front of the current one (see code:VirtualCallStubManager.GrowPolyInlineCache), up to
+//         code:g_polyInlineCacheSize stubs. Only misses of the whole chain reach the resolve stub.
 //         
 // QUESTION: What is the lifetimes of the various stubs and hash table entries?
 // 
@@ -566,6 +570,12 @@ public:
     //Change the callsite to point to stub
     void BackPatchSite(StubCallSite* pCallSite, PCODE stub);
 
+    //Follow the failure path of a (possibly chained) dispatch stub to its resolve stub's fail entry
+    PCODE GetDispatchChainFailEntry(PCODE dispatchStub);
+
+    //Chain a per-call-site dispatch stub for pMT in front of the callsite's dispatch stub
+    BOOL GrowPolyInlineCache(StubCallSite* pCallSite, MethodTable* pMT, DispatchToken token, PCODE target);
+
 public:
     /* the following two public functions are to support tracing or stepping thru
     stubs via the debugger. */
@@ -758,9 +768,11 @@ public:
         UINT32 stub_lookup_counter;     //# of lookup stubs
         UINT32 stub_poly_counter;       //# of resolve stubs
         UINT32 stub_mono_counter;       //# of dispatch stubs
+        UINT32 stub_poly_inline_counter;//# of per-call-site dispatch stubs chained into polymorphic inline caches
         UINT32 site_write;              //# of call site backpatch writes
         UINT32 site_write_poly;         //# of call site backpatch writes to point to resolve stubs
         UINT32 site_write_mono;         //# of call site backpatch writes to point to dispatch stubs
+        UINT32 site_write_poly_inline;  //# of call site backpatch writes that grew a polymorphic inline cache
         UINT32 worker_call;             //# of calls into ResolveWorker
         UINT32 worker_call_no_patch;    //# of times call_worker resulted in no patch
         UINT32 worker_collide_to_mono;  //# of times we converted a poly stub to a mono stub instead of writing the cache entry
@@ -959,6 +971,11 @@ extern UINT32 STUB_COLLIDE_MONO_PCT;
 #define STUB_COLLIDE_MONO_PCT     0
 #endif // !STUB_LOGGING
 
+//default and upper bound for the number of dispatch stubs chained at a single call site
+#define CALL_STUB_POLY_INLINE_CACHE_SIZE     4
+#define CALL_STUB_POLY_INLINE_CACHE_MAX_SIZE 8
+extern UINT32 g_polyInlineCacheSize;
+
 //size and mask of the cache used by resolve stubs
 // CALL_STUB_CACHE_SIZE must be equal to 2^CALL_STUB_CACHE_NUM_BITS
 #define CALL_STUB_CACHE_NUM_BITS 12 //10
@@ -95,6 +95,7 @@ SVAL_IMPL(LONG,ThreadpoolMgr,cpuUtilization);
 LONG    ThreadpoolMgr::cpuUtilizationAverage = 0;
 
 HillClimbing ThreadpoolMgr::HillClimbingInstance;
+QueueLatencyInjection ThreadpoolMgr::LatencyInjectionInstance;
 
 // Cacheline aligned, 3 hot variables updated in a group
 DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) LONG ThreadpoolMgr::PriorCompletedWorkRequests = 0;
@@ -105,6 +106,7 @@ LARGE_INTEGER ThreadpoolMgr::CurrentSampleStartTime;
 
 unsigned int ThreadpoolMgr::WorkerThreadSpinLimit;
 bool ThreadpoolMgr::IsHillClimbingDisabled;
+bool ThreadpoolMgr::IsLatencyInjectionEnabled;
 int ThreadpoolMgr::ThreadAdjustmentInterval;
 
 #define INVALID_HANDLE ((HANDLE) -1)
@@ -126,7 +128,7 @@ DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) int ThreadpoolMgr::offset_counter = 0;
 SPTR_IMPL(WorkRequest,ThreadpoolMgr,WorkRequestHead);        // Head of work request queue
 SPTR_IMPL(WorkRequest,ThreadpoolMgr,WorkRequestTail);        // Head of work request queue
 
-SVAL_IMPL(ThreadpoolMgr::LIST_ENTRY,ThreadpoolMgr,TimerQueue);  // queue of timers
+SVAL_IMPL(LONG,ThreadpoolMgr,NumTimers);                         // number of active timers
 
 //unsigned int ThreadpoolMgr::LastCpuSamplingTime=0;      //  last time cpu utilization was sampled by gate thread
 unsigned int ThreadpoolMgr::LastCPThreadCreation=0;     //  last time a completion port thread was created
@@ -145,8 +147,12 @@ CrstStatic ThreadpoolMgr::TimerQueueCriticalSection;
 HANDLE ThreadpoolMgr::TimerThread=NULL;
 Thread *ThreadpoolMgr::pTimerThread=NULL;
 
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::TimerWheel[ThreadpoolMgr::TimerWheelLevels][ThreadpoolMgr::TimerWheelSlots];
+DWORD ThreadpoolMgr::TimerWheelOccupied[ThreadpoolMgr::TimerWheelLevels];
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::TimerWheelOverflow;
+
 // Cacheline aligned, hot variable
-DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) DWORD ThreadpoolMgr::LastTickCount;
+DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) DWORD ThreadpoolMgr::TimerWheelTime;
 
 #ifdef _DEBUG
 DWORD ThreadpoolMgr::TickCountAdjustment=0;
@@ -357,6 +363,7 @@ BOOL ThreadpoolMgr::Initialize()
     {
         WorkerThreadSpinLimit = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_UnfairSemaphoreSpinLimit);
         IsHillClimbingDisabled = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_HillClimbing_Disable) != 0;
+        IsLatencyInjectionEnabled = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableLatencyInjection) != 0;
         ThreadAdjustmentInterval = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_HillClimbing_SampleIntervalLow);
         
         pADTPCount->InitResources();
@@ -367,8 +374,16 @@ BOOL ThreadpoolMgr::Initialize()
         // initialize WaitThreadsHead
         InitializeListHead(&WaitThreadsHead);
 
-        // initialize TimerQueue
-        InitializeListHead(&TimerQueue);
+        // initialize the timer wheel
+        for (int level = 0; level < TimerWheelLevels; level++)
+        {
+            for (int slot = 0; slot < TimerWheelSlots; slot++)
+            {
+                InitializeListHead(&TimerWheel[level][slot]);
+            }
+            TimerWheelOccupied[level] = 0;
+        }
+        InitializeListHead(&TimerWheelOverflow);
 
         RetiredCPWakeupEvent = new CLREvent();
         RetiredCPWakeupEvent->CreateAutoEvent(FALSE);
@@ -461,6 +476,7 @@ BOOL ThreadpoolMgr::Initialize()
 #endif // !FEATURE_PAL    
 
     HillClimbingInstance.Initialize();
+    LatencyInjectionInstance.Initialize();
 
     bRet = TRUE;
 end:
@@ -908,8 +924,8 @@ DangerousNonHostedSpinLock ThreadpoolMgr::ThreadAdjustmentLock;
 
 
 //
-// This method must only be called if ShouldAdjustMaxWorkersActive has returned true, *and*
-// ThreadAdjustmentLock is held.
+// This method must only be called if ShouldAdjustMaxWorkersActive has returned true (or by the gate thread
+// when latency injection is enabled), *and* ThreadAdjustmentLock is held.
 //
 void ThreadpoolMgr::AdjustMaxWorkersActive()
 {
@@ -947,11 +963,44 @@ void ThreadpoolMgr::AdjustMaxWorkersActive()
     {
         ThreadCounter::Counts currentCounts = WorkerCounter.GetCleanCounts();
 
-        int newMax = HillClimbingInstance.Update(
-            currentCounts.MaxWorking, 
-            elapsed, 
-            numCompletions,
-            &ThreadAdjustmentInterval);
+        int newMax;
+        if (IsLatencyInjectionEnabled)
+        {
+            QueueLatencyInjection::Sample sample;
+            sample.currentThreadCount = currentCounts.MaxWorking;
+            sample.minThreadCount = MinLimitTotalWorkerThreads;
+            sample.maxThreadCount = MaxLimitTotalWorkerThreads;
+            sample.requestsPending = PerAppDomainTPCountList::AreRequestsPendingInAnyAppDomains();
+            sample.queueLatency = sample.requestsPending ? (currentTicks - VolatileLoad(&LastDequeueTime)) : 0;
+
+            // Worker tracking knows which threads are inside a work item; otherwise count every thread that
+            // is not parked waiting for work.
+            if (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableWorkerTracking))
+            {
+                WorkingThreadCounts workingCounts;
+                workingCounts.asLong = VolatileLoad(&g_workingThreadCounts.asLong);
+                sample.numWorking = workingCounts.currentWorking;
+            }
+            else
+            {
+                sample.numWorking = currentCounts.NumWorking;
+            }
+
+            // Busy workers beyond what the processors are actually doing must be waiting on something
+            int numBusyProcessors = (int)(cpuUtilization * NumberOfProcessors / 100);
+            sample.numBlocked = max(sample.numWorking - numBusyProcessors, 0);
+            sample.processorCount = NumberOfProcessors;
+
+            newMax = LatencyInjectionInstance.Update(sample);
+        }
+        else
+        {
+            newMax = HillClimbingInstance.Update(
+                currentCounts.MaxWorking, 
+                elapsed, 
+                numCompletions,
+                &ThreadAdjustmentInterval);
+        }
 
         while (newMax != currentCounts.MaxWorking)
         {
@@ -1455,9 +1504,18 @@ bool ThreadpoolMgr::ShouldGateThreadKeepRunning()
         bool needGateThreadForWorkerTracking = 
             0 != CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableWorkerTracking);
 
+        //
+        // The latency injection policy gives idle threads back from the gate thread, so keep running until
+        // it has brought the pool back down to the minimum.
+        //
+        bool needGateThreadForLatencyInjection =
+            IsLatencyInjectionEnabled &&
+            WorkerCounter.GetCleanCounts().MaxWorking > MinLimitTotalWorkerThreads;
+
         if (!(needGateThreadForCompletionPort || 
               needGateThreadForWorkerThreads ||
-              needGateThreadForWorkerTracking))
+              needGateThreadForWorkerTracking ||
+              needGateThreadForLatencyInjection))
         {
             //
             // It looks like we shouldn't be running.  But another thread may now tell us to run.  If so, they will set GateThreadStatus
@@ -2620,6 +2678,7 @@ DWORD WINAPI ThreadpoolMgr::WaitThreadStart(LPVOID lpArgs)
         for (;;)
         {
             DWORD status;
+            DWORD signaledIndex = 0;
             DWORD timeout = 0;
 
             if (threadCB->NumActiveWaits == 0)
@@ -2658,18 +2717,33 @@ DWORD WINAPI ThreadpoolMgr::WaitThreadStart(LPVOID lpArgs)
                 // compute minimum timeout. this call also updates the remainingTime field for each wait
                 timeout = MinimumRemainingWait(threadCB->waitPointer,threadCB->NumActiveWaits);
 
+#ifdef FEATURE_PAL
+                // A wait thread can hold more than MAXIMUM_WAIT_OBJECTS handles on Unix, so the
+                // signaled index comes back separately instead of being added to WAIT_OBJECT_0
+                status = PAL_WaitForAnyObjectEx(    threadCB->NumActiveWaits,
+                                                    threadCB->waitHandle,
+                                                    timeout,
+                                                    TRUE,                       // alertable
+                                                    &signaledIndex);
+#else // !FEATURE_PAL
                 status = WaitForMultipleObjectsEx(  threadCB->NumActiveWaits,
                                                     threadCB->waitHandle,
                                                     FALSE,                      // waitall
                                                     timeout,
                                                     TRUE  );                    // alertable
 
+                if (status >= WAIT_OBJECT_0 && status < (DWORD)(WAIT_OBJECT_0 + threadCB->NumActiveWaits))
+                {
+                    signaledIndex = status - WAIT_OBJECT_0;
+                    status = WAIT_OBJECT_0;
+                }
+#endif // !FEATURE_PAL
+
                 _ASSERTE( (status == WAIT_TIMEOUT) ||
                           (status == WAIT_IO_COMPLETION) ||
                           //It could be that there are no waiters at this point,
                           //as the APC to deregister the wait may have run.
                           (status == WAIT_OBJECT_0) ||
-                          (status >= WAIT_OBJECT_0 && status < (DWORD)(WAIT_OBJECT_0 + threadCB->NumActiveWaits))  ||
                           (status == WAIT_FAILED));
 
                 //It could be that the last waiter also got deregistered.
@@ -2705,9 +2779,9 @@ DWORD WINAPI ThreadpoolMgr::WaitThreadStart(LPVOID lpArgs)
                     } while ((PVOID) waitInfo != waitInfoHead);
                 }
             }
-            else if (status >= WAIT_OBJECT_0 && status < (DWORD)(WAIT_OBJECT_0 + threadCB->NumActiveWaits))
+            else if (status == WAIT_OBJECT_0 && signaledIndex < (DWORD)threadCB->NumActiveWaits)
             {
-                unsigned index = status - WAIT_OBJECT_0;
+                unsigned index = signaledIndex;
                 WaitInfo* waitInfo = (WaitInfo*) (threadCB->waitPointer[index]).Flink;
                 PVOID waitInfoHead = &(threadCB->waitPointer[index]);
                 BOOL isAutoReset;
@@ -4346,6 +4420,16 @@ DWORD WINAPI ThreadpoolMgr::GateThreadStart(LPVOID lpArgs)
         }
 #endif // !FEATURE_PAL
 
+        if (IsLatencyInjectionEnabled)
+        {
+            //
+            // Workers only sample the latency policy when they finish work items, so while all of them are
+            // blocked the gate thread has to do it.
+            //
+            DangerousNonHostedSpinLockHolder tal(&ThreadAdjustmentLock);
+            AdjustMaxWorkersActive();
+        }
+
         if (0 == CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_DisableStarvationDetection))
         {
             if (PerAppDomainTPCountList::AreRequestsPendingInAnyAppDomains() && SufficientDelaySinceLastDequeue())
@@ -4590,7 +4674,7 @@ DWORD WINAPI ThreadpoolMgr::TimerThreadStart(LPVOID p)
     pTimerThread = pThread;
     // Timer threads never die
 
-    LastTickCount = GetTickCount();
+    TimerWheelTime = GetTickCount();
 
 #ifdef FEATURE_COMINTEROP
     if (pThread->SetApartment(Thread::AS_InMTA, TRUE) != Thread::AS_InMTA)
@@ -4701,21 +4785,202 @@ void ThreadpoolMgr::InsertNewTimer(TimerInfo* pArg)
     else
     {
         timerInfo->FiringTime += currentTime;
+        timerInfo->StartTime = currentTime;
 
         timerInfo->state = (TIMER_REGISTERED | TIMER_ACTIVE);
         timerInfo->refCount = 1;
 
-        // insert the timer in the queue
-        InsertTailList(&TimerQueue,(&timerInfo->link));
+        InsertTimerIntoWheel(timerInfo);
     }
 
     return;
 }
 
+// Executed by the timer thread
+// adds an active timer to the timer wheel
+void ThreadpoolMgr::InsertTimerIntoWheel(TimerInfo* timerInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    _ASSERTE(timerInfo->state & TIMER_ACTIVE);
+
+    if (NumTimers == 0)
+    {
+        // The timer thread sleeps without a timeout while there are no timers, so the wheel
+        // may be far behind; nothing is in it, so it can simply jump to the current time.
+        TimerWheelTime = GetTickCount();
+    }
+
+    PlaceTimerInWheel(timerInfo);
+    NumTimers++;
+}
+
+// Executed by the timer thread
+// links a timer into the wheel slot for its firing time, relative to the next tick the wheel
+// will process. A timer that is already due goes into the slot for that tick.
+void ThreadpoolMgr::PlaceTimerInWheel(TimerInfo* timerInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    // Due times use the full DWORD range, so whether the timer has expired is decided relative to
+    // the tick its due time was measured from, as TimeExpired does. The start never lies more than
+    // a wheel turn away from TimerWheelTime: the wheel may lag the current time by a little, and
+    // every placement that finds the wheel past the start moves the start up to it.
+    DWORD dueTime = timerInfo->FiringTime - timerInfo->StartTime;
+    LONG elapsed = (LONG)(TimerWheelTime - timerInfo->StartTime);
+    ULONGLONG delta;
+    if (elapsed < 0)
+    {
+        delta = (ULONGLONG)dueTime + (DWORD)(-elapsed);
+    }
+    else if ((DWORD)elapsed >= dueTime)
+    {
+        delta = 0;
+    }
+    else
+    {
+        delta = dueTime - (DWORD)elapsed;
+        timerInfo->StartTime = TimerWheelTime;
+    }
+
+    DWORD firingTime = TimerWheelTime + (DWORD)delta;
+    LIST_ENTRY* slot = &TimerWheelOverflow;
+
+    for (int level = 0; level < TimerWheelLevels; level++)
+    {
+        int shift = level * TimerWheelSlotBits;
+        if (delta < ((ULONGLONG)TimerWheelSlots << shift))
+        {
+            int index = (firingTime >> shift) & (TimerWheelSlots - 1);
+            slot = &TimerWheel[level][index];
+            TimerWheelOccupied[level] |= ((DWORD)1 << index);
+            break;
+        }
+    }
+
+    InsertTailList(slot, (&timerInfo->link));
+}
+
+// Executed by the timer thread
+// before the timers in the level 0 slot for "tick" are fired, moves the timers of every higher level
+// slot whose turn starts at "tick" down the wheel (and the overflow timers when the whole wheel
+// turns over). Each timer ends up in the slot matching how far it is from "tick".
+void ThreadpoolMgr::CascadeTimerWheel(DWORD tick)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    _ASSERTE(tick == TimerWheelTime);
+
+    // Find the highest level whose turn starts at this tick; all levels below it start a turn too.
+    int topLevel = 0;
+    while ((topLevel < TimerWheelLevels) && ((tick & (((DWORD)1 << ((topLevel + 1) * TimerWheelSlotBits)) - 1)) == 0))
+    {
+        topLevel++;
+    }
+
+    if (topLevel == 0)
+    {
+        return;
+    }
+
+    LIST_ENTRY pending;
+    InitializeListHead(&pending);
+
+    if (topLevel == TimerWheelLevels)
+    {
+        topLevel = TimerWheelLevels - 1;
+        while (!IsListEmpty(&TimerWheelOverflow))
+        {
+            LIST_ENTRY* entry;
+            RemoveHeadList(&TimerWheelOverflow, entry);
+            InsertTailList(&pending, entry);
+        }
+    }
+
+    // Cascade from the top down, so that timers moved out of a higher level are cascaded
+    // again if they land in a lower level slot whose turn also starts now.
+    for (int level = topLevel; level >= 1; level--)
+    {
+        int index = (tick >> (level * TimerWheelSlotBits)) & (TimerWheelSlots - 1);
+        LIST_ENTRY* slot = &TimerWheel[level][index];
+
+        while (!IsListEmpty(slot))
+        {
+            LIST_ENTRY* entry;
+            RemoveHeadList(slot, entry);
+            InsertTailList(&pending, entry);
+        }
+        TimerWheelOccupied[level] &= ~((DWORD)1 << index);
+
+        while (!IsListEmpty(&pending))
+        {
+            LIST_ENTRY* entry;
+            RemoveHeadList(&pending, entry);
+            PlaceTimerInWheel((TimerInfo*) entry);
+        }
+    }
+}
+
+// Executed by the timer thread
+// returns how long the timer thread can sleep before the wheel has work to do: either a level 0
+// slot with timers to fire, or a higher level slot (or the overflow list) to cascade.
+DWORD ThreadpoolMgr::NextTimerWheelInterval(DWORD currentTime)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    // The slot search below relies on a level's occupancy bits exactly filling a DWORD.
+    static_assert_no_msg(TimerWheelSlots == sizeof(DWORD) * 8);
+
+    DWORD nextFiringInterval = (DWORD) -1;
+
+    for (int level = 0; level < TimerWheelLevels; level++)
+    {
+        int shift = level * TimerWheelSlotBits;
+        DWORD levelMask = ((DWORD)1 << shift) - 1;
+
+        // The tick at which the next turn of the level below starts, and this level's slot for it.
+        DWORD turnStart = (TimerWheelTime + levelMask) & ~levelMask;
+        int currentIndex = (turnStart >> shift) & (TimerWheelSlots - 1);
+
+        while (TimerWheelOccupied[level] != 0)
+        {
+            // Look for the first occupied slot at or after currentIndex, wrapping around.
+            DWORD rotated = _rotr(TimerWheelOccupied[level], currentIndex);
+            DWORD distance;
+            BitScanForward(&distance, rotated);
+
+            int index = (currentIndex + distance) & (TimerWheelSlots - 1);
+            if (IsListEmpty(&TimerWheel[level][index]))
+            {
+                // All the timers in this slot were deactivated; forget about it.
+                TimerWheelOccupied[level] &= ~((DWORD)1 << index);
+                continue;
+            }
+
+            DWORD tick = turnStart + (distance << shift);
+            DWORD firingInterval = ((LONG)(tick - currentTime) > 0) ? (tick - currentTime) : 0;
+            if (firingInterval < nextFiringInterval)
+                nextFiringInterval = firingInterval;
+            break;
+        }
+    }
+
+    if (!IsListEmpty(&TimerWheelOverflow))
+    {
+        DWORD levelMask = ((DWORD)1 << (TimerWheelLevels * TimerWheelSlotBits)) - 1;
+        DWORD tick = (TimerWheelTime + levelMask) & ~levelMask;
+        DWORD firingInterval = ((LONG)(tick - currentTime) > 0) ? (tick - currentTime) : 0;
+        if (firingInterval < nextFiringInterval)
+            nextFiringInterval = firingInterval;
+    }
+
+    return nextFiringInterval;
+}
+
 
 // executed by the Timer thread
-// sweeps through the list of timers, readjusting the firing times, queueing APCs for
-// those that have expired, and returns the next firing time interval
+// advances the timer wheel to the current time, cascading timers down the wheel and queueing
+// APCs for those that have expired, and returns the next firing time interval
 DWORD ThreadpoolMgr::FireTimers()
 {
     CONTRACTL
@@ -4727,20 +4992,26 @@ DWORD ThreadpoolMgr::FireTimers()
     CONTRACTL_END;
 
     DWORD currentTime = GetTickCount();
-    DWORD nextFiringInterval = (DWORD) -1;
     TimerInfo* timerInfo = NULL;
-    
-    EX_TRY 
+
+    if (NumTimers == 0)
+    {
+        TimerWheelTime = currentTime;
+    }
+
+    EX_TRY
     {
-        for (LIST_ENTRY* node = (LIST_ENTRY*) TimerQueue.Flink;
-             node != &TimerQueue;
-            )
+        while ((LONG)(currentTime - TimerWheelTime) >= 0)
         {
-            timerInfo = (TimerInfo*) node;
-            node = (LIST_ENTRY*) node->Flink;
+            CascadeTimerWheel(TimerWheelTime);
 
-            if (TimeExpired(LastTickCount, currentTime, timerInfo->FiringTime))
+            int index = TimerWheelTime & (TimerWheelSlots - 1);
+            LIST_ENTRY* slot = &TimerWheel[0][index];
+
+            while (!IsListEmpty(slot))
             {
+                timerInfo = (TimerInfo*) slot->Flink;
+
                 if (timerInfo->Period == 0 || timerInfo->Period == (ULONG) -1)
                 {
                     DeactivateTimer(timerInfo);
@@ -4755,41 +5026,55 @@ DWORD ThreadpoolMgr::FireTimers()
                 if (timerInfo->Period != 0 && timerInfo->Period != (ULONG)-1)
                 {
                     ULONG nextFiringTime = timerInfo->FiringTime + timerInfo->Period;
-                    DWORD firingInterval;
                     if (TimeExpired(timerInfo->FiringTime, currentTime, nextFiringTime))
                     {
                         // Enough time has elapsed to fire the timer yet again. The timer is not able to keep up with the short
                         // period, have it fire 1 ms from now to avoid spinning without a delay.
+                        timerInfo->StartTime = currentTime;
                         timerInfo->FiringTime = currentTime + 1;
-                        firingInterval = 1;
                     }
                     else
                     {
+                        timerInfo->StartTime = timerInfo->FiringTime;
                         timerInfo->FiringTime = nextFiringTime;
-                        firingInterval = TimeInterval(nextFiringTime, currentTime);
                     }
 
-                    if (firingInterval < nextFiringInterval)
-                        nextFiringInterval = firingInterval;
+                    // The new firing time is after the tick being processed, so this never
+                    // puts the timer back into the slot we are draining.
+                    RemoveEntryList(&timerInfo->link);
+                    PlaceTimerInWheel(timerInfo);
                 }
             }
-            else
+            TimerWheelOccupied[0] &= ~((DWORD)1 << index);
+
+            // Skip over the ticks up to the next one with a slot to fire or cascade; nothing
+            // happens in between, so catching up after a long sleep takes a few steps at most.
+            DWORD interval = NextTimerWheelInterval(TimerWheelTime);
+            DWORD remaining = currentTime - TimerWheelTime;
+            if (interval == 0)
             {
-                DWORD firingInterval = TimeInterval(timerInfo->FiringTime, currentTime);
-                if (firingInterval < nextFiringInterval)
-                    nextFiringInterval = firingInterval;
+                interval = 1;
             }
+            else if (interval > remaining)
+            {
+                interval = remaining + 1;
+            }
+            TimerWheelTime += interval;
         }
-    } 
-    EX_CATCH 
+    }
+    EX_CATCH
     {
         // If QueueUserWorkItem throws OOM, swallow the exception and retry on
         // the next call to FireTimers(), otherwise retrhow.
         Exception *ex = GET_EXCEPTION();
-        // undo the call to DeactivateTimer()
         InterlockedDecrement(&timerInfo->refCount);
-        timerInfo->state = timerInfo->state & TIMER_ACTIVE;
-        InsertTailList(&TimerQueue, (&timerInfo->link));
+        if (!(timerInfo->state & TIMER_ACTIVE))
+        {
+            // undo the call to DeactivateTimer(). The wheel has not moved past this tick, so the
+            // timer goes back into the slot being drained.
+            timerInfo->state |= TIMER_ACTIVE;
+            InsertTimerIntoWheel(timerInfo);
+        }
         if (ex->GetHR() != E_OUTOFMEMORY)
         {
            EX_RETHROW;
@@ -4797,9 +5082,7 @@ DWORD ThreadpoolMgr::FireTimers()
     }
     EX_END_CATCH(RethrowTerminalExceptions);
 
-    LastTickCount = currentTime;
-
-    return nextFiringInterval;
+    return NextTimerWheelInterval(currentTime);
 }
 
 DWORD WINAPI ThreadpoolMgr::AsyncTimerCallbackCompletion(PVOID pArgs)
@@ -4844,13 +5127,15 @@ DWORD WINAPI ThreadpoolMgr::AsyncTimerCallbackCompletion(PVOID pArgs)
 }
 
 
-// removes the timer from the timer queue, thereby cancelling it
+// removes the timer from the timer wheel, thereby cancelling it
 // there may still be pending callbacks that haven't completed
 void ThreadpoolMgr::DeactivateTimer(TimerInfo* timerInfo)
 {
     LIMITED_METHOD_CONTRACT;
 
+    // The slot's occupancy bit is left set; the wheel clears it when it next looks at the slot.
     RemoveEntryList((LIST_ENTRY*) timerInfo);
+    NumTimers--;
 
     // This timer info could go into another linked list of timer infos
     // waiting to be released. Reinitialize the list pointers
@@ -5127,6 +5412,7 @@ void ThreadpoolMgr::UpdateTimer(TimerUpdateInfo* pArgs)
     }
 
     DWORD currentTime = GetTickCount();
+    timerInfo->StartTime = currentTime;
     timerInfo->FiringTime = currentTime + updateInfo->DueTime;
 
     delete updateInfo;
@@ -5136,9 +5422,13 @@ void ThreadpoolMgr::UpdateTimer(TimerUpdateInfo* pArgs)
         // timer not active (probably a one shot timer that has expired), so activate it
         timerInfo->state |= TIMER_ACTIVE;
         _ASSERTE(timerInfo->refCount >= 1);
-        // insert the timer in the queue
-        InsertTailList(&TimerQueue,(&timerInfo->link));
-
+        InsertTimerIntoWheel(timerInfo);
+    }
+    else
+    {
+        // move the timer to the slot for its new firing time
+        RemoveEntryList(&timerInfo->link);
+        PlaceTimerInWheel(timerInfo);
     }
 
     return;
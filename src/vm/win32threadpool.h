@@ -26,7 +26,13 @@ Revision History:
 #include "nativeoverlapped.h"
 #include "hillclimbing.h"
 
+#ifdef FEATURE_PAL
+// The PAL wait threads use PAL_WaitForAnyObjectEx, which is not bound by MAXIMUM_WAIT_OBJECTS,
+// so fewer wait threads are needed for apps with many registered waits
+#define MAX_WAITHANDLES PAL_MAXIMUM_WAIT_OBJECTS_EX
+#else // !FEATURE_PAL
 #define MAX_WAITHANDLES 64
+#endif // !FEATURE_PAL
 
 #define MAX_CACHED_EVENTS 40        // upper limit on number of wait events cached 
 
@@ -342,6 +348,13 @@ public:
                 || Function == ThreadpoolMgr::CallbackForContinueDrainageOfCompletionPortQueue
                 || Function == ThreadpoolMgr::WaitIOCompletionCallback);
     }
+
+    // Process CPU utilization in percent, as last sampled by the gate thread
+    static FORCEINLINE LONG GetCPUUtilization()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return cpuUtilization;
+    }
 #endif
 
 private:
@@ -568,6 +581,7 @@ private:
     typedef struct {
         LIST_ENTRY  link;           // doubly linked list of timers
         ULONG FiringTime;           // TickCount of when to fire next
+        ULONG StartTime;            // TickCount FiringTime was measured from
         WAITORTIMERCALLBACK Function;             // Function to call when timer fires
         PVOID Context;              // Context to pass to function when timer fires
         ULONG Period;
@@ -861,7 +875,7 @@ public:
         {
             ThreadCounter::Counts counts = WorkerCounter.GetCleanCounts();
             if (counts.NumActive <= counts.MaxWorking)
-                return !IsHillClimbingDisabled;
+                return IsLatencyInjectionEnabled || !IsHillClimbingDisabled;
         }
 
         return false;
@@ -969,6 +983,10 @@ private:
     static DWORD WINAPI TimerThreadStart(LPVOID args);
     static void TimerThreadFire(); // helper method used by TimerThreadStart
     static void WINAPI InsertNewTimer(TimerInfo* pArg);
+    static void InsertTimerIntoWheel(TimerInfo* timerInfo);
+    static void PlaceTimerInWheel(TimerInfo* timerInfo);
+    static void CascadeTimerWheel(DWORD tick);
+    static DWORD NextTimerWheelInterval(DWORD currentTime);
     static DWORD FireTimers();
     static DWORD WINAPI AsyncTimerCallbackCompletion(PVOID pArgs);
     static void DeactivateTimer(TimerInfo* timerInfo);
@@ -1017,6 +1035,7 @@ private:
     DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) static unsigned int LastDequeueTime;      // used to determine if work items are getting thread starved
     
     static HillClimbing HillClimbingInstance;
+    static QueueLatencyInjection LatencyInjectionInstance;
 
     DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) static LONG PriorCompletedWorkRequests;
     static DWORD PriorCompletedWorkRequestsTime;
@@ -1026,6 +1045,7 @@ private:
 
     static unsigned int WorkerThreadSpinLimit;
     static bool IsHillClimbingDisabled;
+    static bool IsLatencyInjectionEnabled;
     static int ThreadAdjustmentInterval;
 
     SPTR_DECL(WorkRequest,WorkRequestHead);             // Head of work request queue
@@ -1072,10 +1092,21 @@ private:
 
     static TimerInfo *TimerInfosToBeRecycled;           // list of delegate infos associated with deleted timers
     static CrstStatic TimerQueueCriticalSection;        // critical section to synchronize timer queue access
-    SVAL_DECL(LIST_ENTRY,TimerQueue);                   // queue of timers
     static HANDLE TimerThread;                          // Currently we only have one timer thread
     static Thread*  pTimerThread;
-    DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) static DWORD LastTickCount;      // the count just before timer thread goes to sleep
+
+    // Active timers live in a hierarchical timing wheel that is only touched by the timer thread
+    // (new timers and updates reach it by APC). Level 0 has one slot per tick; each slot of level n
+    // covers a full turn of level n-1, and is cascaded down into level n-1 when that turn starts.
+    // Timers due further out than the top level covers wait in TimerWheelOverflow.
+    static const int TimerWheelSlotBits = 5;
+    static const int TimerWheelSlots = 1 << TimerWheelSlotBits;
+    static const int TimerWheelLevels = 5;
+    static LIST_ENTRY TimerWheel[TimerWheelLevels][TimerWheelSlots];
+    static DWORD TimerWheelOccupied[TimerWheelLevels];  // bit per slot that may hold timers
+    static LIST_ENTRY TimerWheelOverflow;
+    SVAL_DECL(LONG,NumTimers);                          // number of active timers
+    DECLSPEC_ALIGN(MAX_CACHE_LINE_SIZE) static DWORD TimerWheelTime;     // the next tick the wheel has to process
 
     static BOOL InitCompletionPortThreadpool;           // flag indicating whether completion port threadpool has been initialized
     static HANDLE GlobalCompletionPort;                 // used for binding io completions on file handles
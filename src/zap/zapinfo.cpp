@@ -3300,6 +3300,18 @@ unsigned ZapInfo::getClassSize(CORINFO_CLASS_HANDLE cls)
     return size;
 }
 
+unsigned ZapInfo::getHeapClassSize(CORINFO_CLASS_HANDLE cls)
+{
+#ifdef FEATURE_READYTORUN_COMPILER
+    // The size of a class from outside the version bubble can change without this
+    // code being recompiled, and there is no fixup to check it, so don't stack allocate.
+    if (IsReadyToRunCompilation())
+        return 0;
+#endif
+
+    return m_pEEJitInfo->getHeapClassSize(cls);
+}
+
 unsigned ZapInfo::getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint)
 {
     return m_pEEJitInfo->getClassAlignmentRequirement(cls, fDoubleAlignHint);
@@ -3728,6 +3740,21 @@ CORINFO_METHOD_HANDLE ZapInfo::resolveVirtualMethod(
     return m_pEEJitInfo->resolveVirtualMethod(virtualMethod, implementingClass, ownerType);
 }
 
+CORINFO_CLASS_HANDLE ZapInfo::getLikelyClass(
+    CORINFO_METHOD_HANDLE method,
+    unsigned ilOffset,
+    unsigned* pLikelihood,
+    void** pCell)
+{
+    // Prejitted code is never instrumented and there is no profile to use.
+    *pLikelihood = 0;
+    if (pCell != NULL)
+    {
+        *pCell = NULL;
+    }
+    return NULL;
+}
+
 CORINFO_METHOD_HANDLE ZapInfo::getUnboxedEntry(
     CORINFO_METHOD_HANDLE ftn,
     bool* requiresInstMethodTableArg)
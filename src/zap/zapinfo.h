@@ -525,6 +525,7 @@ public:
     size_t getClassModuleIdForStatics(CORINFO_CLASS_HANDLE cls, CORINFO_MODULE_HANDLE *pModule, void **ppIndirection);
 
     unsigned getClassSize(CORINFO_CLASS_HANDLE cls);
+    unsigned getHeapClassSize(CORINFO_CLASS_HANDLE cls);
     unsigned getClassAlignmentRequirement(CORINFO_CLASS_HANDLE cls, BOOL fDoubleAlignHint);
 
     CORINFO_FIELD_HANDLE getFieldInClass(CORINFO_CLASS_HANDLE clsHnd, INT num);
@@ -680,6 +681,12 @@ public:
         CORINFO_CLASS_HANDLE implementingClass,
         CORINFO_CONTEXT_HANDLE ownerType);
 
+    CORINFO_CLASS_HANDLE getLikelyClass(
+        CORINFO_METHOD_HANDLE method,
+        unsigned ilOffset,
+        unsigned* pLikelihood,
+        void** pCell);
+
     CORINFO_METHOD_HANDLE getUnboxedEntry(
         CORINFO_METHOD_HANDLE ftn,
         bool* requiresInstMethodTableArg);
@@ -0,0 +1,214 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Background GCs over a large object graph that is allocated by a single thread, so that it
+// lives on one Server GC heap and that heap's BGC thread hands marking work to the others.
+// The graph is rewired while each BGC runs, and part of it is only reachable through a
+// ConditionalWeakTable, which is marked after the BGC threads have stopped sharing work.
+// After every BGC the whole graph is walked and checked, so an object that was swept while
+// still reachable shows up as a missing node or a corrupted field.
+
+using System;
+using System.Runtime;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+public static class MarkStealSkewedGraph
+{
+    const int Fanout = 4;
+    const int Depth = 9;
+    const int PayloadEvery = 16;
+    const int Rounds = 20;
+    const int SwapsPerRound = 2000;
+
+    class Node
+    {
+        public int Id;
+        public long Check;
+        public Node[] Children;
+    }
+
+    class Payload
+    {
+        public int Id;
+        public int[] Data;
+    }
+
+    static readonly ConditionalWeakTable<Node, Payload> s_payloads = new ConditionalWeakTable<Node, Payload>();
+    static volatile bool s_stop;
+    static int s_nodeCount;
+
+    static long CheckOf(int id)
+    {
+        return (id * 2654435761L) ^ 0x5555AAAA;
+    }
+
+    static Node Build(int depth)
+    {
+        Node node = new Node();
+        node.Id = s_nodeCount++;
+        node.Check = CheckOf(node.Id);
+
+        if ((node.Id % PayloadEvery) == 0)
+        {
+            Payload payload = new Payload();
+            payload.Id = node.Id;
+            payload.Data = new int[] { node.Id, ~node.Id, node.Id * 3 };
+            s_payloads.Add(node, payload);
+        }
+
+        if (depth < Depth)
+        {
+            node.Children = new Node[Fanout];
+            for (int i = 0; i < Fanout; i++)
+            {
+                node.Children[i] = Build(depth + 1);
+            }
+        }
+        return node;
+    }
+
+    // Walks down from the root to a random node at the given depth.
+    static Node Walk(Node root, int depth, Random random)
+    {
+        Node node = root;
+        for (int d = 0; d < depth; d++)
+        {
+            node = node.Children[random.Next(Fanout)];
+        }
+        return node;
+    }
+
+    // Swaps two subtrees whose roots are at the same depth, which keeps the graph a tree of the
+    // same shape while moving references that the BGC may already have scanned.
+    static void Rewire(Node root, Random random)
+    {
+        for (int i = 0; i < SwapsPerRound; i++)
+        {
+            int depth = random.Next(1, Depth - 1);
+            Node a = Walk(root, depth, random);
+            Node b = Walk(root, depth, random);
+            int ia = random.Next(Fanout);
+            int ib = random.Next(Fanout);
+            Node t = a.Children[ia];
+            a.Children[ia] = b.Children[ib];
+            b.Children[ib] = t;
+        }
+    }
+
+    static bool Verify(Node root, int round)
+    {
+        bool[] seen = new bool[s_nodeCount];
+        int count = 0;
+        Node[] stack = new Node[Fanout * (Depth + 1)];
+        int tos = 0;
+        stack[tos++] = root;
+
+        while (tos > 0)
+        {
+            Node node = stack[--tos];
+            if ((node.Id < 0) || (node.Id >= s_nodeCount) || seen[node.Id] || (node.Check != CheckOf(node.Id)))
+            {
+                Console.WriteLine("Round {0}: corrupted node {1}", round, node.Id);
+                return false;
+            }
+            seen[node.Id] = true;
+            count++;
+
+            Payload payload;
+            if ((node.Id % PayloadEvery) == 0)
+            {
+                if (!s_payloads.TryGetValue(node, out payload) || (payload.Id != node.Id) ||
+                    (payload.Data.Length != 3) || (payload.Data[0] != node.Id) || (payload.Data[1] != ~node.Id) ||
+                    (payload.Data[2] != node.Id * 3))
+                {
+                    Console.WriteLine("Round {0}: missing or corrupted payload of node {1}", round, node.Id);
+                    return false;
+                }
+            }
+
+            if (node.Children != null)
+            {
+                if (node.Children.Length != Fanout)
+                {
+                    Console.WriteLine("Round {0}: corrupted children of node {1}", round, node.Id);
+                    return false;
+                }
+                for (int i = 0; i < Fanout; i++)
+                {
+                    stack[tos++] = node.Children[i];
+                }
+            }
+        }
+
+        if (count != s_nodeCount)
+        {
+            Console.WriteLine("Round {0}: reached {1} nodes instead of {2}", round, count, s_nodeCount);
+            return false;
+        }
+        return true;
+    }
+
+    // Allocates short lived objects on other threads, and so on other heaps, so that
+    // ephemeral GCs run during the BGCs.
+    static void Churn()
+    {
+        object[] keep = new object[64];
+        int i = 0;
+        while (!s_stop)
+        {
+            keep[i++ % keep.Length] = new byte[(i % 1024) + 24];
+        }
+    }
+
+    public static int Main()
+    {
+        Console.WriteLine("Server GC: {0}, latency mode: {1}", GCSettings.IsServerGC, GCSettings.LatencyMode);
+
+        Node root = Build(0);
+        Random random = new Random(42);
+
+        Thread[] churners = new Thread[Math.Min(Environment.ProcessorCount, 4)];
+        for (int i = 0; i < churners.Length; i++)
+        {
+            churners[i] = new Thread(Churn);
+            churners[i].Start();
+        }
+
+        bool passed = true;
+        for (int round = 0; (round < Rounds) && passed; round++)
+        {
+            int gen2Count = GC.CollectionCount(2);
+            GC.Collect(2, GCCollectionMode.Forced, false);
+
+            // Rewire the graph while the BGC is marking it, then wait for the BGC to finish.
+            Rewire(root, random);
+            for (int wait = 0; (GC.CollectionCount(2) == gen2Count) && (wait < 1000); wait++)
+            {
+                Rewire(root, random);
+                Thread.Sleep(10);
+            }
+
+            passed = Verify(root, round);
+        }
+
+        s_stop = true;
+        foreach (Thread churner in churners)
+        {
+            churner.Join();
+        }
+
+        // One more blocking GC on top, so that a graph damaged by the last BGC is swept and walked.
+        GC.Collect();
+        passed = passed && Verify(root, Rounds);
+
+        if (!passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,128 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Objects that don't escape are allocated in a catch handler, a filter and a finally that
+// run once per iteration of a loop, and the object allocated in the previous iteration is
+// kept in a local. An object allocated on the stack in one of these would be the same
+// object in every iteration, so the previous object would be overwritten by the current one.
+// Run with COMPlus_JitObjectStackAllocation=1.
+
+using System;
+using System.Runtime.CompilerServices;
+
+public class AllocationInHandlers
+{
+    const int Iterations = 10;
+
+    class Box
+    {
+        public int Value;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void Throw(int i)
+    {
+        throw new InvalidOperationException(i.ToString());
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int InCatch()
+    {
+        Box previous = null;
+        int failures = 0;
+        for (int i = 0; i < Iterations; i++)
+        {
+            try
+            {
+                Throw(i);
+            }
+            catch (InvalidOperationException)
+            {
+                Box current = new Box();
+                current.Value = i;
+                if ((previous != null) && ((previous == current) || (previous.Value != i - 1)))
+                {
+                    failures++;
+                }
+                previous = current;
+            }
+        }
+        return failures;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int InFilter()
+    {
+        Box previous = null;
+        Box current = null;
+        int failures = 0;
+        for (int i = 0; i < Iterations; i++)
+        {
+            try
+            {
+                Throw(i);
+            }
+            catch (InvalidOperationException) when ((current = new Box()).Value == 0)
+            {
+                current.Value = i;
+                if ((previous != null) && ((previous == current) || (previous.Value != i - 1)))
+                {
+                    failures++;
+                }
+                previous = current;
+            }
+        }
+        return failures;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int InFinally()
+    {
+        Box previous = null;
+        int failures = 0;
+        for (int i = 0; i < Iterations; i++)
+        {
+            try
+            {
+                failures += (i < 0) ? 1 : 0;
+            }
+            finally
+            {
+                Box current = new Box();
+                current.Value = i;
+                if ((previous != null) && ((previous == current) || (previous.Value != i - 1)))
+                {
+                    failures++;
+                }
+                previous = current;
+            }
+        }
+        return failures;
+    }
+
+    static bool Check(string name, int failures)
+    {
+        if (failures != 0)
+        {
+            Console.WriteLine("FAILED: {0} reused the object of a previous iteration {1} times", name, failures);
+            return false;
+        }
+        return true;
+    }
+
+    public static int Main()
+    {
+        bool passed = Check("InCatch", InCatch());
+        passed &= Check("InFilter", InFilter());
+        passed &= Check("InFinally", InFinally());
+
+        if (!passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,176 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Loops bounded by "a.Length - k" that access a[i + k]. The JIT records such a limit as an
+// array length limit and clones the loop, so each kernel is checked against an unoptimized
+// reference for short and long arrays, for arrays too short for the loop to run, and for
+// arguments that make the slow path run and throw from the element that is out of range.
+
+using System;
+using System.Runtime.CompilerServices;
+
+public class ArrayLengthMinusConstLimit
+{
+    static bool s_passed = true;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Diff(int[] a)
+    {
+        int sum = 0;
+        for (int i = 0; i < a.Length - 1; i++)
+        {
+            sum += a[i + 1] - a[i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static int DiffReference(int[] a)
+    {
+        int sum = 0;
+        for (int i = 0; i < a.Length - 1; i++)
+        {
+            sum += a[i + 1] - a[i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void Window(int[] a, int[] b)
+    {
+        for (int i = 0; i < a.Length - 3; i++)
+        {
+            b[i] = a[i] + a[i + 1] + a[i + 2] + a[i + 3];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static void WindowReference(int[] a, int[] b)
+    {
+        for (int i = 0; i < a.Length - 3; i++)
+        {
+            b[i] = a[i] + a[i + 1] + a[i + 2] + a[i + 3];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Jagged(int[][] a, int j)
+    {
+        int sum = 0;
+        for (int i = 0; i < a[j].Length - 2; i++)
+        {
+            sum += a[j][i + 2] * 3 + a[j][i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static int JaggedReference(int[][] a, int j)
+    {
+        int sum = 0;
+        for (int i = 0; i < a[j].Length - 2; i++)
+        {
+            sum += a[j][i + 2] * 3 + a[j][i];
+        }
+        return sum;
+    }
+
+    static void Check(string name, int length, int expected, int actual)
+    {
+        if (expected != actual)
+        {
+            Console.WriteLine("FAILED: {0} length={1} expected {2}, got {3}", name, length, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static int[] MakeInts(int length, int seed)
+    {
+        int[] a = new int[length];
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = (i + seed) * 0x3B9ACA07 ^ seed;
+        }
+        return a;
+    }
+
+    static void Verify(int length)
+    {
+        int[] a = MakeInts(length, length);
+        Check("Diff", length, DiffReference(a), Diff(a));
+
+        int[] expected = new int[length];
+        int[] b = new int[length];
+        WindowReference(a, expected);
+        Window(a, b);
+        for (int i = 0; i < length; i++)
+        {
+            Check("Window element " + i, length, expected[i], b[i]);
+        }
+
+        int[][] jagged = { MakeInts(3, 1), a };
+        Check("Jagged", length, JaggedReference(jagged, 1), Jagged(jagged, 1));
+    }
+
+    static void VerifyThrows()
+    {
+        // The destination is too short for the fast path, so the slow path runs until b[4] is stored.
+        int[] a = MakeInts(10, 5);
+        int[] b = new int[4];
+        try
+        {
+            Window(a, b);
+            Console.WriteLine("FAILED: Window expected IndexOutOfRangeException");
+            s_passed = false;
+        }
+        catch (IndexOutOfRangeException)
+        {
+            int[] full = new int[7];
+            WindowReference(a, full);
+            for (int i = 0; i < b.Length; i++)
+            {
+                Check("Window before the exception, element " + i, b.Length, full[i], b[i]);
+            }
+        }
+
+        try
+        {
+            Diff(null);
+            Console.WriteLine("FAILED: Diff expected NullReferenceException");
+            s_passed = false;
+        }
+        catch (NullReferenceException)
+        {
+        }
+
+        try
+        {
+            Jagged(new int[][] { a, null }, 1);
+            Console.WriteLine("FAILED: Jagged expected NullReferenceException");
+            s_passed = false;
+        }
+        catch (NullReferenceException)
+        {
+        }
+    }
+
+    public static int Main()
+    {
+        for (int length = 0; length <= 40; length++)
+        {
+            Verify(length);
+        }
+        Verify(1000);
+
+        VerifyThrows();
+
+        if (!s_passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,161 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Numeric array loops whose trip count depends on the array length. The JIT unrolls
+// these partially and runs the leftover iterations in a remainder loop, so every
+// kernel is checked against a simple reference for lengths around the unroll factor and
+// for a long array whose length isn't a multiple of it. Scale and Offset are field loads
+// that are invariant in the loops below and should be hoisted.
+
+using System;
+using System.Runtime.CompilerServices;
+
+public class PartialUnroll
+{
+    int Scale = 3;
+    int Offset = 7;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Sum(int[] a)
+    {
+        int sum = 0;
+        for (int i = 0; i < a.Length; i++)
+        {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int SumStep(int[] a, int start, int step)
+    {
+        int sum = 0;
+        for (int i = start; i < a.Length; i += step)
+        {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static double Dot(double[] a, double[] b)
+    {
+        double dot = 0;
+        for (int i = 0; i < a.Length; i++)
+        {
+            dot += a[i] * b[i];
+        }
+        return dot;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    void Transform(int[] src, int[] dst)
+    {
+        for (int i = 0; i < src.Length; i++)
+        {
+            dst[i] = src[i] * Scale + Offset;
+        }
+    }
+
+    static int[] MakeArray(int length)
+    {
+        int[] a = new int[length];
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = i * 7 - 3;
+        }
+        return a;
+    }
+
+    static bool Check(string name, long expected, long actual, int length)
+    {
+        if (expected != actual)
+        {
+            Console.WriteLine("FAILED: {0} length={1} expected {2}, got {3}", name, length, expected, actual);
+            return false;
+        }
+        return true;
+    }
+
+    bool Verify(int length)
+    {
+        bool passed = true;
+        int[] a = MakeArray(length);
+        double[] d = new double[length];
+
+        long expected = 0;
+        for (int i = 0; i < length; i++)
+        {
+            expected += a[i];
+            d[i] = a[i];
+        }
+
+        passed &= Check("Sum", expected, Sum(a), length);
+        passed &= Check("Dot", (long)DotReference(d), (long)Dot(d, d), length);
+
+        for (int step = 1; step <= 3; step++)
+        {
+            long expectedStep = 0;
+            for (int i = 1; i < length; i += step)
+            {
+                expectedStep += a[i];
+            }
+            passed &= Check("SumStep" + step, expectedStep, SumStep(a, 1, step), length);
+        }
+
+        int[] dst = new int[length];
+        Transform(a, dst);
+        for (int i = 0; i < length; i++)
+        {
+            passed &= Check("Transform", a[i] * Scale + Offset, dst[i], length);
+        }
+
+        return passed;
+    }
+
+    bool Verify()
+    {
+        bool passed = true;
+
+        for (int length = 0; length <= 19; length++)
+        {
+            passed &= Verify(length);
+        }
+        passed &= Verify(1003);
+
+        try
+        {
+            Sum(null);
+            Console.WriteLine("FAILED: expected NullReferenceException");
+            passed = false;
+        }
+        catch (NullReferenceException)
+        {
+        }
+
+        return passed;
+    }
+
+    static double DotReference(double[] a)
+    {
+        double dot = 0;
+        foreach (double x in a)
+        {
+            dot += x * x;
+        }
+        return dot;
+    }
+
+    public static int Main()
+    {
+        PartialUnroll test = new PartialUnroll();
+        if (!test.Verify())
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
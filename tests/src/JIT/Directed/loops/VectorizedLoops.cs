@@ -0,0 +1,318 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Counted array loops that the JIT rewrites to process a whole Vector<T> of elements per
+// iteration, running the leftover elements in the original loop. Each kernel is checked
+// against an unoptimized reference for lengths around multiples of the vector length, so
+// that the vector loop, the scalar tail and the case with no vector iterations are all
+// covered, with both array length and constant limits, and with source and destination
+// arrays that alias each other.
+
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+
+public class VectorizedLoops
+{
+    const int ConstLimit = 37;
+
+    static bool s_passed = true;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void Add(int[] a, int[] b, int[] c)
+    {
+        for (int i = 0; i < c.Length; i++)
+        {
+            c[i] = a[i] + b[i];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static void AddReference(int[] a, int[] b, int[] c)
+    {
+        for (int i = 0; i < c.Length; i++)
+        {
+            c[i] = a[i] + b[i];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void ScaleConst(double[] a, double[] c, double scale)
+    {
+        for (int i = 0; i < ConstLimit; i++)
+        {
+            c[i] = a[i] * scale - 1.5;
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static void ScaleConstReference(double[] a, double[] c, double scale)
+    {
+        for (int i = 0; i < ConstLimit; i++)
+        {
+            c[i] = a[i] * scale - 1.5;
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void Blend(float[] a, float[] b, float[] c)
+    {
+        for (int i = 0; i < a.Length; i++)
+        {
+            c[i] = a[i] * 2.0f + b[i];
+            b[i] = c[i] - a[i];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static void BlendReference(float[] a, float[] b, float[] c)
+    {
+        for (int i = 0; i < a.Length; i++)
+        {
+            c[i] = a[i] * 2.0f + b[i];
+            b[i] = c[i] - a[i];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Sum(int[] a, int x)
+    {
+        int sum = 0;
+        for (int i = 0; i < a.Length; i++)
+        {
+            sum += a[i] ^ x;
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static int SumReference(int[] a, int x)
+    {
+        int sum = 0;
+        for (int i = 0; i < a.Length; i++)
+        {
+            sum += a[i] ^ x;
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int DotConst(int[] a, int[] b)
+    {
+        int dot = 0;
+        for (int i = 0; i < ConstLimit; i++)
+        {
+            dot += a[i] * b[i];
+        }
+        return dot;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static int DotConstReference(int[] a, int[] b)
+    {
+        int dot = 0;
+        for (int i = 0; i < ConstLimit; i++)
+        {
+            dot += a[i] * b[i];
+        }
+        return dot;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static long SumLong(long[] a, long[] b, long[] c)
+    {
+        long sum = 7;
+        for (int i = 0; i < a.Length; i++)
+        {
+            c[i] = a[i] - b[i];
+            sum += c[i];
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining | MethodImplOptions.NoOptimization)]
+    static long SumLongReference(long[] a, long[] b, long[] c)
+    {
+        long sum = 7;
+        for (int i = 0; i < a.Length; i++)
+        {
+            c[i] = a[i] - b[i];
+            sum += c[i];
+        }
+        return sum;
+    }
+
+    static void Check<T>(string name, T[] expected, T[] actual, int length)
+    {
+        for (int i = 0; i < expected.Length; i++)
+        {
+            if (!expected[i].Equals(actual[i]))
+            {
+                Console.WriteLine("FAILED: {0} length={1} element {2}: expected {3}, got {4}",
+                                  name, length, i, expected[i], actual[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void Check(string name, long expected, long actual, int length)
+    {
+        if (expected != actual)
+        {
+            Console.WriteLine("FAILED: {0} length={1} expected {2}, got {3}", name, length, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static int[] MakeInts(int length, int seed)
+    {
+        int[] a = new int[length];
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = (i + seed) * 0x3B9ACA07 ^ seed;
+        }
+        return a;
+    }
+
+    static void VerifyInts(int length)
+    {
+        int[] a = MakeInts(length, 1);
+        int[] b = MakeInts(length, 2);
+        int[] c = new int[length];
+        int[] expected = new int[length];
+
+        AddReference(a, b, expected);
+        Add(a, b, c);
+        Check("Add", expected, c, length);
+
+        // The destination is also a source
+        int[] aliased = (int[])a.Clone();
+        AddReference(a, b, expected);
+        Add(aliased, b, aliased);
+        Check("Add (c == a)", expected, aliased, length);
+
+        aliased = (int[])a.Clone();
+        AddReference(a, a, expected);
+        Add(aliased, aliased, aliased);
+        Check("Add (c == a == b)", expected, aliased, length);
+
+        Check("Sum", SumReference(a, 0x55), Sum(a, 0x55), length);
+    }
+
+    static void VerifyFloats(int length)
+    {
+        float[] a = new float[length];
+        float[] b = new float[length];
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = i * 0.25f;
+            b[i] = 100 - i;
+        }
+
+        float[] expectedB = (float[])b.Clone();
+        float[] expectedC = new float[length];
+        BlendReference(a, expectedB, expectedC);
+        float[] c = new float[length];
+        Blend(a, b, c);
+        Check("Blend c", expectedC, c, length);
+        Check("Blend b", expectedB, b, length);
+
+        // c aliases b, so the second statement reads what the first one just stored
+        expectedB = (float[])a.Clone();
+        BlendReference(a, expectedB, expectedB);
+        b = (float[])a.Clone();
+        Blend(a, b, b);
+        Check("Blend (c == b)", expectedB, b, length);
+    }
+
+    static void VerifyLongs(int length)
+    {
+        long[] a = new long[length];
+        long[] b = new long[length];
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = ((long)i << 33) + i;
+            b[i] = -3 * i;
+        }
+
+        long[] expected = new long[length];
+        long expectedSum = SumLongReference(a, b, expected);
+        long[] c = new long[length];
+        Check("SumLong", expectedSum, SumLong(a, b, c), length);
+        Check("SumLong c", expected, c, length);
+
+        expected = (long[])a.Clone();
+        expectedSum = SumLongReference(expected, b, expected);
+        c = (long[])a.Clone();
+        Check("SumLong (c == a)", expectedSum, SumLong(c, b, c), length);
+        Check("SumLong (c == a) c", expected, c, length);
+    }
+
+    static void VerifyConstLimit()
+    {
+        int[] a = MakeInts(ConstLimit + 3, 3);
+        int[] b = MakeInts(ConstLimit + 3, 4);
+        Check("DotConst", DotConstReference(a, b), DotConst(a, b), ConstLimit);
+
+        double[] d = new double[ConstLimit];
+        for (int i = 0; i < ConstLimit; i++)
+        {
+            d[i] = i - 10;
+        }
+
+        double[] expected = new double[ConstLimit];
+        ScaleConstReference(d, expected, 3.0);
+        double[] c = new double[ConstLimit];
+        ScaleConst(d, c, 3.0);
+        Check("ScaleConst", expected, c, ConstLimit);
+
+        double[] twice = (double[])expected.Clone();
+        ScaleConstReference(twice, twice, 3.0);
+        ScaleConst(c, c, 3.0);
+        Check("ScaleConst (c == a)", twice, c, ConstLimit);
+
+        // Too short for the constant limit: the exception must be thrown by the element that is out of range
+        c = new double[ConstLimit - 1];
+        try
+        {
+            ScaleConst(d, c, 3.0);
+            Console.WriteLine("FAILED: expected IndexOutOfRangeException");
+            s_passed = false;
+        }
+        catch (IndexOutOfRangeException)
+        {
+            for (int i = 0; i < c.Length; i++)
+            {
+                if (c[i] != expected[i])
+                {
+                    Console.WriteLine("FAILED: ScaleConst element {0} before the exception", i);
+                    s_passed = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    public static int Main()
+    {
+        int maxLength = 4 * Vector<byte>.Count + 3;
+        for (int length = 0; length <= maxLength; length++)
+        {
+            VerifyInts(length);
+            VerifyFloats(length);
+            VerifyLongs(length);
+        }
+
+        VerifyConstLimit();
+
+        if (!s_passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,166 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the AES and PCLMULQDQ hardware intrinsics the JIT expands. The AES round
+// instructions are checked through identities between them, KeygenAssist and
+// CarrylessMultiply against a scalar computation of their result, also with a control value
+// that is not a constant, for all 256 values.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+public static unsafe class AesSmoke
+{
+    static bool s_passed = true;
+
+    static readonly ulong[] QA = { 0x8000000000000003UL, 0x0123456789ABCDEFUL };
+    static readonly ulong[] QB = { 0xFFFFFFFFFFFFFFFFUL, 0x00000000F00D0001UL };
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static byte NotConstant(int value)
+    {
+        return (byte)value;
+    }
+
+    static Vector128<byte> Load(byte[] values)
+    {
+        fixed (byte* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<ulong> Load(ulong[] values)
+    {
+        fixed (ulong* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static byte[] ToArray(Vector128<byte> value)
+    {
+        byte[] result = new byte[16];
+        fixed (byte* p = result)
+        {
+            Sse2.Store(p, value);
+        }
+        return result;
+    }
+
+    static void Check(string name, Vector128<byte> actual, Vector128<byte> expected)
+    {
+        Check(name, ToArray(actual), ToArray(expected));
+    }
+
+    static void Check(string name, Vector128<byte> actual, uint[] expected)
+    {
+        uint[] values = new uint[4];
+        fixed (uint* p = values)
+        {
+            Sse2.Store((byte*)p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<ulong> actual, ulong[] expected)
+    {
+        ulong[] values = new ulong[2];
+        fixed (ulong* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check<T>(string name, T[] values, T[] expected)
+    {
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (!values[i].Equals(expected[i]))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected[i], values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    // Carryless multiply of two 64-bit values, as the low and high halves of the product.
+    static ulong[] CarrylessMultiply(ulong left, ulong right)
+    {
+        ulong low = 0;
+        ulong high = 0;
+        for (int i = 0; i < 64; i++)
+        {
+            if (((right >> i) & 1) != 0)
+            {
+                low ^= left << i;
+                high ^= (i == 0) ? 0 : left >> (64 - i);
+            }
+        }
+        return new ulong[] { low, high };
+    }
+
+    static void TestAes()
+    {
+        byte[] bytes = new byte[16];
+        byte[] keyBytes = new byte[16];
+        for (int i = 0; i < bytes.Length; i++)
+        {
+            bytes[i] = (byte)(i * 29 + 3);
+            keyBytes[i] = (byte)(0xA5 ^ (i * 7));
+        }
+        Vector128<byte> state = Load(bytes);
+        Vector128<byte> key = Load(keyBytes);
+        Vector128<byte> zero = Sse2.SetZeroVector128<byte>();
+
+        // Encrypt is ShiftRows, SubBytes and MixColumns followed by the round key xor; EncryptLast
+        // skips MixColumns. Decrypt and DecryptLast apply the inverses in the reverse order.
+        Check("Encrypt", Aes.Encrypt(state, key), Sse2.Xor(Aes.Encrypt(state, zero), key));
+        Check("DecryptLast", Aes.DecryptLast(Aes.InverseMixColumns(Aes.Encrypt(state, zero)), zero), state);
+        Check("Decrypt", Aes.Decrypt(Aes.EncryptLast(state, zero), zero), Aes.InverseMixColumns(state));
+        Check("EncryptLast", Aes.EncryptLast(Aes.DecryptLast(state, zero), key), Sse2.Xor(state, key));
+
+        // S-box(0) is 0x63, so for a zero key the round constant is all that differs between dwords.
+        Check("KeygenAssist", Aes.KeygenAssist(zero, 0x36),
+              new uint[] { 0x63636363, 0x63636355, 0x63636363, 0x63636355 });
+        for (int control = 0; control <= 255; control++)
+        {
+            uint rotated = 0x63636363U ^ (uint)control;
+            Check("KeygenAssist " + control, Aes.KeygenAssist(zero, NotConstant(control)),
+                  new uint[] { 0x63636363, rotated, 0x63636363, rotated });
+        }
+    }
+
+    static void TestPclmulqdq()
+    {
+        Vector128<ulong> a = Load(QA);
+        Vector128<ulong> b = Load(QB);
+
+        Check("CarrylessMultiply", Pclmulqdq.CarrylessMultiply(a, b, 0x01), CarrylessMultiply(QA[1], QB[0]));
+        for (int control = 0; control <= 255; control++)
+        {
+            Check("CarrylessMultiply " + control, Pclmulqdq.CarrylessMultiply(a, b, NotConstant(control)),
+                  CarrylessMultiply(QA[control & 1], QB[(control >> 4) & 1]));
+        }
+    }
+
+    public static bool Run()
+    {
+        if (Aes.IsSupported)
+        {
+            TestAes();
+        }
+
+        if (Pclmulqdq.IsSupported)
+        {
+            TestPclmulqdq();
+        }
+
+        return s_passed;
+    }
+}
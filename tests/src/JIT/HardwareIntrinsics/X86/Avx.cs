@@ -0,0 +1,307 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the AVX and AVX2 hardware intrinsics the JIT expands: each one is checked
+// against a scalar computation of its result. Blend and Shuffle are also checked with a
+// control value that is not a constant, for all 256 values.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+public static unsafe class AvxSmoke
+{
+    static bool s_passed = true;
+
+    static readonly float[] FA = { 1, -2, 3.5f, 16, 0.25f, -100, 7, 9 };
+    static readonly float[] FB = { 4, -2, -1, 2, 8, -50, 7, -9 };
+    static readonly double[] DA = { 1.5, -3, 64, -0.125 };
+    static readonly double[] DB = { 2, -3, 8, 0.5 };
+    static readonly int[] IA = { 1, -2, int.MaxValue, -8, 100, 0, -100000, 42 };
+    static readonly int[] IB = { 3, -2, 1, 5, -100, 0, 100000, 41 };
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static byte NotConstant(int value)
+    {
+        return (byte)value;
+    }
+
+    static int Bits(float value)
+    {
+        return *(int*)&value;
+    }
+
+    static long Bits(double value)
+    {
+        return *(long*)&value;
+    }
+
+    static Vector256<float> Load(float[] values)
+    {
+        fixed (float* p = values)
+        {
+            return Avx.LoadVector256(p);
+        }
+    }
+
+    static Vector256<double> Load(double[] values)
+    {
+        fixed (double* p = values)
+        {
+            return Avx.LoadVector256(p);
+        }
+    }
+
+    static Vector256<int> Load(int[] values)
+    {
+        fixed (int* p = values)
+        {
+            return Avx.LoadVector256(p);
+        }
+    }
+
+    static Vector256<short> Load(short[] values)
+    {
+        fixed (short* p = values)
+        {
+            return Avx.LoadVector256(p);
+        }
+    }
+
+    static Vector256<sbyte> Load(sbyte[] values)
+    {
+        fixed (sbyte* p = values)
+        {
+            return Avx.LoadVector256(p);
+        }
+    }
+
+    static Vector128<int> Load128(int[] values)
+    {
+        fixed (int* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static void Check(string name, Vector256<float> actual, Func<int, float> expected)
+    {
+        float[] values = new float[8];
+        fixed (float* p = values)
+        {
+            Avx.Store(p, actual);
+        }
+        Check(name, Array.ConvertAll(values, Bits), i => Bits(expected(i)));
+    }
+
+    static void Check(string name, Vector256<double> actual, Func<int, double> expected)
+    {
+        double[] values = new double[4];
+        fixed (double* p = values)
+        {
+            Avx.Store(p, actual);
+        }
+        Check(name, Array.ConvertAll(values, Bits), i => Bits(expected(i)));
+    }
+
+    static void Check(string name, Vector256<int> actual, Func<int, int> expected)
+    {
+        int[] values = new int[8];
+        fixed (int* p = values)
+        {
+            Avx.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector256<short> actual, Func<int, short> expected)
+    {
+        short[] values = new short[16];
+        fixed (short* p = values)
+        {
+            Avx.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector256<sbyte> actual, Func<int, sbyte> expected)
+    {
+        sbyte[] values = new sbyte[32];
+        fixed (sbyte* p = values)
+        {
+            Avx.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<int> actual, Func<int, int> expected)
+    {
+        int[] values = new int[4];
+        fixed (int* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check<T>(string name, T[] values, Func<int, T> expected)
+    {
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (!values[i].Equals(expected(i)))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected(i), values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void Check(string name, int actual, int expected)
+    {
+        if (actual != expected)
+        {
+            Console.WriteLine("FAILED: {0}: expected {1}, got {2}", name, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static float ShuffleFloat(int control, int i)
+    {
+        // Each 128-bit lane is shuffled on its own, with the same control value.
+        int lane = i & ~3;
+        int index = (control >> (2 * (i & 3))) & 3;
+        return ((i & 3) < 2) ? FA[lane + index] : FB[lane + index];
+    }
+
+    static double ShuffleDouble(int control, int i)
+    {
+        int lane = i & ~1;
+        int index = (control >> i) & 1;
+        return ((i & 1) == 0) ? DA[lane + index] : DB[lane + index];
+    }
+
+    static void TestAvx()
+    {
+        Vector256<float> a = Load(FA);
+        Vector256<float> b = Load(FB);
+        Vector256<double> da = Load(DA);
+        Vector256<double> db = Load(DB);
+
+        Check("Add", Avx.Add(a, b), i => FA[i] + FB[i]);
+        Check("Subtract", Avx.Subtract(a, b), i => FA[i] - FB[i]);
+        Check("Multiply", Avx.Multiply(a, b), i => FA[i] * FB[i]);
+        Check("Divide", Avx.Divide(a, b), i => FA[i] / FB[i]);
+        Check("Max", Avx.Max(a, b), i => Math.Max(FA[i], FB[i]));
+        Check("Min", Avx.Min(a, b), i => Math.Min(FA[i], FB[i]));
+        Check("Sqrt", Avx.Sqrt(Avx.Multiply(a, a)), i => Math.Abs(FA[i]));
+        Check("And", Avx.And(a, b), i => { int r = Bits(FA[i]) & Bits(FB[i]); return *(float*)&r; });
+        Check("AndNot", Avx.AndNot(a, b), i => { int r = ~Bits(FA[i]) & Bits(FB[i]); return *(float*)&r; });
+        Check("Or", Avx.Or(a, b), i => { int r = Bits(FA[i]) | Bits(FB[i]); return *(float*)&r; });
+        Check("Xor", Avx.Xor(a, b), i => { int r = Bits(FA[i]) ^ Bits(FB[i]); return *(float*)&r; });
+        Check("MoveMask", Avx.MoveMask(a), 0x22);
+        Check("SetZeroVector256", Avx.SetZeroVector256<float>(), i => 0.0f);
+
+        Check("Add double", Avx.Add(da, db), i => DA[i] + DB[i]);
+        Check("Divide double", Avx.Divide(da, db), i => DA[i] / DB[i]);
+        Check("Sqrt double", Avx.Sqrt(Avx.Multiply(da, da)), i => Math.Abs(DA[i]));
+        Check("MoveMask double", Avx.MoveMask(da), 0xA);
+
+        Check("Blend", Avx.Blend(a, b, 0x96), i => (((0x96 >> i) & 1) != 0) ? FB[i] : FA[i]);
+        Check("Shuffle", Avx.Shuffle(a, b, 0x4E), i => ShuffleFloat(0x4E, i));
+        for (int control = 0; control <= 255; control++)
+        {
+            byte c = NotConstant(control);
+            Check("Blend " + control, Avx.Blend(a, b, c), i => (((control >> i) & 1) != 0) ? FB[i] : FA[i]);
+            Check("Blend double " + control, Avx.Blend(da, db, c), i => (((control >> i) & 1) != 0) ? DB[i] : DA[i]);
+            Check("Shuffle " + control, Avx.Shuffle(a, b, c), i => ShuffleFloat(control, i));
+            Check("Shuffle double " + control, Avx.Shuffle(da, db, c), i => ShuffleDouble(control, i));
+        }
+
+        float* buffer = stackalloc float[16];
+        float* aligned = (float*)(((ulong)buffer + 31) & ~31UL);
+        Avx.StoreAligned(aligned, a);
+        Check("StoreAligned", Avx.LoadAlignedVector256(aligned), i => FA[i]);
+    }
+
+    static void TestAvx2()
+    {
+        Vector256<int> a = Load(IA);
+        Vector256<int> b = Load(IB);
+
+        Check("Add int", Avx2.Add(a, b), i => IA[i] + IB[i]);
+        Check("Subtract int", Avx2.Subtract(a, b), i => IA[i] - IB[i]);
+        Check("And int", Avx2.And(a, b), i => IA[i] & IB[i]);
+        Check("AndNot int", Avx2.AndNot(a, b), i => ~IA[i] & IB[i]);
+        Check("Or int", Avx2.Or(a, b), i => IA[i] | IB[i]);
+        Check("Xor int", Avx2.Xor(a, b), i => IA[i] ^ IB[i]);
+        Check("CompareEqual int", Avx2.CompareEqual(a, b), i => (IA[i] == IB[i]) ? -1 : 0);
+        Check("CompareGreaterThan int", Avx2.CompareGreaterThan(a, b), i => (IA[i] > IB[i]) ? -1 : 0);
+        Check("Max int", Avx2.Max(a, b), i => Math.Max(IA[i], IB[i]));
+        Check("Min int", Avx2.Min(a, b), i => Math.Min(IA[i], IB[i]));
+        Check("MultiplyLow int", Avx2.MultiplyLow(a, b), i => IA[i] * IB[i]);
+
+        short[] sa = new short[16];
+        short[] sb = new short[16];
+        sbyte[] bytes = new sbyte[32];
+        sbyte[] indices = new sbyte[32];
+        for (int i = 0; i < sa.Length; i++)
+        {
+            sa[i] = (short)(i * 1001 - 7000);
+            sb[i] = (short)(-i * 333);
+        }
+        for (int i = 0; i < bytes.Length; i++)
+        {
+            bytes[i] = (sbyte)(i * 7 - 100);
+            indices[i] = (sbyte)(((i % 5) == 0) ? -1 : (i * 3) & 15);
+        }
+
+        Check("MultiplyLow short", Avx2.MultiplyLow(Load(sa), Load(sb)), i => (short)(sa[i] * sb[i]));
+        Check("MoveMask", Avx2.MoveMask(Load(bytes)), MoveMask(bytes));
+        Check("Shuffle sbyte", Avx2.Shuffle(Load(bytes), Load(indices)),
+              i => (indices[i] < 0) ? (sbyte)0 : bytes[(i & ~15) + (indices[i] & 15)]);
+
+        Check("Blend int", Avx2.Blend(a, b, 0x3C), i => (((0x3C >> i) & 1) != 0) ? IB[i] : IA[i]);
+        Check("Shuffle int", Avx2.Shuffle(a, 0x1B), i => IA[(i & ~3) + 3 - (i & 3)]);
+        Vector128<int> a128 = Load128(IA);
+        Vector128<int> b128 = Load128(IB);
+        for (int control = 0; control <= 255; control++)
+        {
+            byte c = NotConstant(control);
+            Check("Blend int " + control, Avx2.Blend(a, b, c), i => (((control >> i) & 1) != 0) ? IB[i] : IA[i]);
+            Check("Blend int 128 " + control, Avx2.Blend(a128, b128, c),
+                  i => (((control >> i) & 1) != 0) ? IB[i] : IA[i]);
+            Check("Blend short " + control, Avx2.Blend(Load(sa), Load(sb), c),
+                  i => (((control >> (i & 7)) & 1) != 0) ? sb[i] : sa[i]);
+            Check("Shuffle int " + control, Avx2.Shuffle(a, c),
+                  i => IA[(i & ~3) + ((control >> (2 * (i & 3))) & 3)]);
+        }
+    }
+
+    static int MoveMask(sbyte[] values)
+    {
+        int mask = 0;
+        for (int i = 0; i < values.Length; i++)
+        {
+            mask |= (values[i] < 0) ? (1 << i) : 0;
+        }
+        return mask;
+    }
+
+    public static bool Run()
+    {
+        if (Avx.IsSupported)
+        {
+            TestAvx();
+        }
+
+        if (Avx2.IsSupported)
+        {
+            TestAvx2();
+        }
+
+        return s_passed;
+    }
+}
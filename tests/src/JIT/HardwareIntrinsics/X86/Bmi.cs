@@ -0,0 +1,127 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the BMI1 and BMI2 hardware intrinsics the JIT expands: each one is checked
+// against a scalar computation of its result. The 64-bit overloads are only checked in a
+// 64-bit process, they throw PlatformNotSupportedException on x86.
+
+using System;
+using System.Runtime.Intrinsics.X86;
+
+public static class BmiSmoke
+{
+    static bool s_passed = true;
+
+    static readonly uint[] Values = { 0, 1, 0x80000000, 0xFFFFFFFF, 0x00F0F000, 0x12345678, 0x00010000 };
+    static readonly ulong[] LongValues = { 0, 1, 0x8000000000000000, 0xFFFFFFFFFFFFFFFF, 0x0000F0F000000000 };
+
+    static void Check(string name, ulong value, ulong actual, ulong expected)
+    {
+        if (actual != expected)
+        {
+            Console.WriteLine("FAILED: {0}({1:X}): expected {2:X}, got {3:X}", name, value, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static uint TrailingZeroCount(ulong value, int size)
+    {
+        uint count = 0;
+        while ((count < size) && (((value >> (int)count) & 1) == 0))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    static ulong ParallelBitDeposit(ulong value, ulong mask)
+    {
+        ulong result = 0;
+        for (int i = 0; mask != 0; mask &= mask - 1)
+        {
+            ulong bit = mask & (~mask + 1);
+            result |= (((value >> i++) & 1) != 0) ? bit : 0;
+        }
+        return result;
+    }
+
+    static ulong ParallelBitExtract(ulong value, ulong mask)
+    {
+        ulong result = 0;
+        for (int i = 0; mask != 0; mask &= mask - 1)
+        {
+            ulong bit = mask & (~mask + 1);
+            result |= ((value & bit) != 0) ? (1UL << i) : 0;
+            i++;
+        }
+        return result;
+    }
+
+    static void TestBmi1()
+    {
+        foreach (uint value in Values)
+        {
+            Check("AndNot", value, Bmi1.AndNot(value, 0x0FF00FF0), ~value & 0x0FF00FF0);
+            Check("ExtractLowestSetBit", value, Bmi1.ExtractLowestSetBit(value), value & (~value + 1));
+            Check("GetMaskUpToLowestSetBit", value, Bmi1.GetMaskUpToLowestSetBit(value), value ^ (value - 1));
+            Check("ResetLowestSetBit", value, Bmi1.ResetLowestSetBit(value), value & (value - 1));
+            Check("TrailingZeroCount", value, Bmi1.TrailingZeroCount(value), TrailingZeroCount(value, 32));
+        }
+
+        if (Environment.Is64BitProcess)
+        {
+            foreach (ulong value in LongValues)
+            {
+                Check("AndNot long", value, Bmi1.AndNot(value, 0x0FF00FF00FF00FF0), ~value & 0x0FF00FF00FF00FF0);
+                Check("ExtractLowestSetBit long", value, Bmi1.ExtractLowestSetBit(value), value & (~value + 1));
+                Check("GetMaskUpToLowestSetBit long", value, Bmi1.GetMaskUpToLowestSetBit(value), value ^ (value - 1));
+                Check("ResetLowestSetBit long", value, Bmi1.ResetLowestSetBit(value), value & (value - 1));
+                Check("TrailingZeroCount long", value, Bmi1.TrailingZeroCount(value), TrailingZeroCount(value, 64));
+            }
+        }
+    }
+
+    static void TestBmi2()
+    {
+        foreach (uint value in Values)
+        {
+            foreach (uint mask in Values)
+            {
+                Check("ParallelBitDeposit", value, Bmi2.ParallelBitDeposit(value, mask),
+                      ParallelBitDeposit(value, mask));
+                Check("ParallelBitExtract", value, Bmi2.ParallelBitExtract(value, mask),
+                      ParallelBitExtract(value, mask));
+            }
+        }
+
+        if (Environment.Is64BitProcess)
+        {
+            foreach (ulong value in LongValues)
+            {
+                foreach (ulong mask in LongValues)
+                {
+                    Check("ParallelBitDeposit long", value, Bmi2.ParallelBitDeposit(value, mask),
+                          ParallelBitDeposit(value, mask));
+                    Check("ParallelBitExtract long", value, Bmi2.ParallelBitExtract(value, mask),
+                          ParallelBitExtract(value, mask));
+                }
+            }
+        }
+    }
+
+    public static bool Run()
+    {
+        if (Bmi1.IsSupported)
+        {
+            TestBmi1();
+        }
+
+        if (Bmi2.IsSupported)
+        {
+            TestBmi2();
+        }
+
+        return s_passed;
+    }
+}
@@ -0,0 +1,102 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the FMA hardware intrinsics the JIT expands: each one is checked against a
+// scalar computation of its result, for the 128-bit and 256-bit overloads. The inputs are
+// chosen so that the products are exact and fusing does not change the result.
+
+using System;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+public static unsafe class FmaSmoke
+{
+    static bool s_passed = true;
+
+    static readonly float[] FA = { 1.5f, -2, 3, 0.25f, 8, -0.5f, 100, 7 };
+    static readonly float[] FB = { 2, 4, -1.5f, 8, 0.125f, 6, -3, 0 };
+    static readonly float[] FC = { 10, -1, 0.5f, -2, 3, 1, 300, -7 };
+    static readonly double[] DA = { 1.5, -2, 3, 0.25 };
+    static readonly double[] DB = { 2, 4, -1.5, 1024 };
+    static readonly double[] DC = { 10, -1, 0.5, -256 };
+
+    static void Check(string name, float[] values, Func<int, float> expected)
+    {
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (values[i] != expected(i))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected(i), values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void Check(string name, double[] values, Func<int, double> expected)
+    {
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (values[i] != expected(i))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected(i), values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void Test128()
+    {
+        float[] result = new float[4];
+        fixed (float* a = FA, b = FB, c = FC, r = result)
+        {
+            Sse.Store(r, Fma.MultiplyAdd(Sse.LoadVector128(a), Sse.LoadVector128(b), Sse.LoadVector128(c)));
+            Check("MultiplyAdd", result, i => FA[i] * FB[i] + FC[i]);
+            Sse.Store(r, Fma.MultiplySubtract(Sse.LoadVector128(a), Sse.LoadVector128(b), Sse.LoadVector128(c)));
+            Check("MultiplySubtract", result, i => FA[i] * FB[i] - FC[i]);
+        }
+
+        double[] doubles = new double[2];
+        fixed (double* a = DA, b = DB, c = DC, r = doubles)
+        {
+            Sse2.Store(r, Fma.MultiplyAdd(Sse2.LoadVector128(a), Sse2.LoadVector128(b), Sse2.LoadVector128(c)));
+            Check("MultiplyAdd double", doubles, i => DA[i] * DB[i] + DC[i]);
+            Sse2.Store(r, Fma.MultiplySubtract(Sse2.LoadVector128(a), Sse2.LoadVector128(b), Sse2.LoadVector128(c)));
+            Check("MultiplySubtract double", doubles, i => DA[i] * DB[i] - DC[i]);
+        }
+    }
+
+    static void Test256()
+    {
+        float[] result = new float[8];
+        fixed (float* a = FA, b = FB, c = FC, r = result)
+        {
+            Avx.Store(r, Fma.MultiplyAdd(Avx.LoadVector256(a), Avx.LoadVector256(b), Avx.LoadVector256(c)));
+            Check("MultiplyAdd 256", result, i => FA[i] * FB[i] + FC[i]);
+            Avx.Store(r, Fma.MultiplySubtract(Avx.LoadVector256(a), Avx.LoadVector256(b), Avx.LoadVector256(c)));
+            Check("MultiplySubtract 256", result, i => FA[i] * FB[i] - FC[i]);
+        }
+
+        double[] doubles = new double[4];
+        fixed (double* a = DA, b = DB, c = DC, r = doubles)
+        {
+            Avx.Store(r, Fma.MultiplyAdd(Avx.LoadVector256(a), Avx.LoadVector256(b), Avx.LoadVector256(c)));
+            Check("MultiplyAdd double 256", doubles, i => DA[i] * DB[i] + DC[i]);
+            Avx.Store(r, Fma.MultiplySubtract(Avx.LoadVector256(a), Avx.LoadVector256(b), Avx.LoadVector256(c)));
+            Check("MultiplySubtract double 256", doubles, i => DA[i] * DB[i] - DC[i]);
+        }
+    }
+
+    public static bool Run()
+    {
+        if (Fma.IsSupported)
+        {
+            Test128();
+            Test256();
+        }
+
+        return s_passed;
+    }
+}
@@ -0,0 +1,44 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Runs the smoke tests of each x86 ISA class. An ISA that the hardware supports but the JIT
+// doesn't report as supported is only skipped by its smoke test, so SSE and SSE2, which every
+// x64 processor has, must be supported in a 64-bit process. The SSE3 through SSE4.2 classes
+// are only partially implemented and are supported with COMPlus_EnableIncompleteISAClass=1
+// on checked runtimes.
+
+using System;
+using System.Runtime.Intrinsics.X86;
+
+public static class HardwareIntrinsics
+{
+    public static int Main()
+    {
+        bool passed = true;
+
+#if X64
+        if (!Sse.IsSupported || !Sse2.IsSupported)
+        {
+            Console.WriteLine("FAILED: SSE and SSE2 are not supported on x64");
+            passed = false;
+        }
+#endif
+
+        passed &= SseSmoke.Run();
+        passed &= Sse2Smoke.Run();
+        passed &= SseExtensionsSmoke.Run();
+        passed &= AvxSmoke.Run();
+        passed &= AesSmoke.Run();
+        passed &= BmiSmoke.Run();
+        passed &= FmaSmoke.Run();
+
+        if (!passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
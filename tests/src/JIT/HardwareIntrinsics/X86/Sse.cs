@@ -0,0 +1,142 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the SSE hardware intrinsics the JIT expands: each one is checked against
+// a scalar computation of its result. Shuffle is also checked with a control value that is
+// not a constant, for all 256 values.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+public static unsafe class SseSmoke
+{
+    static bool s_passed = true;
+
+    static readonly float[] A = { 1.0f, -2.0f, 3.5f, 16.0f };
+    static readonly float[] B = { 4.0f, -2.0f, -1.0f, 2.0f };
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static byte NotConstant(int value)
+    {
+        return (byte)value;
+    }
+
+    static int Bits(float value)
+    {
+        return *(int*)&value;
+    }
+
+    static float FromBits(int value)
+    {
+        return *(float*)&value;
+    }
+
+    static float Mask(bool value)
+    {
+        return FromBits(value ? -1 : 0);
+    }
+
+    static Vector128<float> Load(float[] values)
+    {
+        fixed (float* p = values)
+        {
+            return Sse.LoadVector128(p);
+        }
+    }
+
+    static float[] ToArray(Vector128<float> value)
+    {
+        float[] result = new float[4];
+        fixed (float* p = result)
+        {
+            Sse.Store(p, value);
+        }
+        return result;
+    }
+
+    static void Check(string name, Vector128<float> actual, Func<int, float> expected)
+    {
+        float[] values = ToArray(actual);
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (Bits(values[i]) != Bits(expected(i)))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected(i), values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void Check(string name, int actual, int expected)
+    {
+        if (actual != expected)
+        {
+            Console.WriteLine("FAILED: {0}: expected {1}, got {2}", name, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static float Shuffle(int control, int i)
+    {
+        int index = (control >> (2 * i)) & 3;
+        return (i < 2) ? A[index] : B[index];
+    }
+
+    static void Test()
+    {
+        Vector128<float> a = Load(A);
+        Vector128<float> b = Load(B);
+
+        Check("Add", Sse.Add(a, b), i => A[i] + B[i]);
+        Check("Subtract", Sse.Subtract(a, b), i => A[i] - B[i]);
+        Check("Multiply", Sse.Multiply(a, b), i => A[i] * B[i]);
+        Check("Divide", Sse.Divide(a, b), i => A[i] / B[i]);
+        Check("Max", Sse.Max(a, b), i => Math.Max(A[i], B[i]));
+        Check("Min", Sse.Min(a, b), i => Math.Min(A[i], B[i]));
+        Check("Sqrt", Sse.Sqrt(Sse.Multiply(a, a)), i => Math.Abs(A[i]));
+
+        Check("And", Sse.And(a, b), i => FromBits(Bits(A[i]) & Bits(B[i])));
+        Check("AndNot", Sse.AndNot(a, b), i => FromBits(~Bits(A[i]) & Bits(B[i])));
+        Check("Or", Sse.Or(a, b), i => FromBits(Bits(A[i]) | Bits(B[i])));
+        Check("Xor", Sse.Xor(a, b), i => FromBits(Bits(A[i]) ^ Bits(B[i])));
+
+        Check("CompareEqual", Sse.CompareEqual(a, b), i => Mask(A[i] == B[i]));
+        Check("CompareNotEqual", Sse.CompareNotEqual(a, b), i => Mask(A[i] != B[i]));
+        Check("CompareGreaterThan", Sse.CompareGreaterThan(a, b), i => Mask(A[i] > B[i]));
+        Check("CompareGreaterThanOrEqual", Sse.CompareGreaterThanOrEqual(a, b), i => Mask(A[i] >= B[i]));
+        Check("CompareLessThan", Sse.CompareLessThan(a, b), i => Mask(A[i] < B[i]));
+        Check("CompareLessThanOrEqual", Sse.CompareLessThanOrEqual(a, b), i => Mask(A[i] <= B[i]));
+
+        Check("MoveMask", Sse.MoveMask(a), 0x2);
+        Check("SetZeroVector128", Sse.SetZeroVector128(), i => 0.0f);
+        Check("UnpackHigh", Sse.UnpackHigh(a, b), i => ((i & 1) == 0) ? A[2 + i / 2] : B[2 + i / 2]);
+        Check("UnpackLow", Sse.UnpackLow(a, b), i => ((i & 1) == 0) ? A[i / 2] : B[i / 2]);
+
+        Check("Shuffle", Sse.Shuffle(a, b, 0x1B), i => Shuffle(0x1B, i));
+        for (int control = 0; control <= 255; control++)
+        {
+            Check("Shuffle " + control, Sse.Shuffle(a, b, NotConstant(control)), i => Shuffle(control, i));
+        }
+
+        float* buffer = stackalloc float[8];
+        float* aligned = (float*)(((ulong)buffer + 15) & ~15UL);
+        Sse.StoreAligned(aligned, a);
+        Check("StoreAligned", Sse.LoadAlignedVector128(aligned), i => A[i]);
+        Sse.Store(buffer + 1, b);
+        Check("Store", Sse.LoadVector128(buffer + 1), i => B[i]);
+    }
+
+    public static bool Run()
+    {
+        if (Sse.IsSupported)
+        {
+            Test();
+        }
+
+        return s_passed;
+    }
+}
@@ -0,0 +1,288 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the SSE2 hardware intrinsics the JIT expands: each one is checked against
+// a scalar computation of its result, for the integral and the double overloads. Shuffle is
+// also checked with a control value that is not a constant, for all 256 values.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+public static unsafe class Sse2Smoke
+{
+    static bool s_passed = true;
+
+    static readonly int[] IA = { 1, -2, int.MaxValue, -8 };
+    static readonly int[] IB = { 3, -2, 1, 5 };
+    static readonly uint[] UA = { 0xFFFFFFFF, 7, 0x80000000, 9 };
+    static readonly uint[] UB = { 0xFFFFFFFF, 11, 3, 13 };
+    static readonly short[] SA = { 1, -2, 300, -400, short.MaxValue, 6, -7, 8 };
+    static readonly short[] SB = { 5, -2, 200, 500, 2, -6, 7, short.MinValue };
+    static readonly double[] DA = { 1.5, -3.0 };
+    static readonly double[] DB = { 2.0, -3.0 };
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static byte NotConstant(int value)
+    {
+        return (byte)value;
+    }
+
+    static long Bits(double value)
+    {
+        return *(long*)&value;
+    }
+
+    static double FromBits(long value)
+    {
+        return *(double*)&value;
+    }
+
+    static Vector128<int> Load(int[] values)
+    {
+        fixed (int* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<uint> Load(uint[] values)
+    {
+        fixed (uint* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<short> Load(short[] values)
+    {
+        fixed (short* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<byte> Load(byte[] values)
+    {
+        fixed (byte* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<double> Load(double[] values)
+    {
+        fixed (double* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<float> Load(float[] values)
+    {
+        fixed (float* p = values)
+        {
+            return Sse.LoadVector128(p);
+        }
+    }
+
+    static void Check(string name, Vector128<int> actual, Func<int, int> expected)
+    {
+        int[] values = new int[4];
+        fixed (int* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<short> actual, Func<int, short> expected)
+    {
+        short[] values = new short[8];
+        fixed (short* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<byte> actual, Func<int, byte> expected)
+    {
+        byte[] values = new byte[16];
+        fixed (byte* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<ulong> actual, Func<int, ulong> expected)
+    {
+        ulong[] values = new ulong[2];
+        fixed (ulong* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<double> actual, Func<int, double> expected)
+    {
+        double[] values = new double[2];
+        fixed (double* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, Array.ConvertAll(values, Bits), i => Bits(expected(i)));
+    }
+
+    static void Check(string name, Vector128<float> actual, Func<int, float> expected)
+    {
+        float[] values = new float[4];
+        fixed (float* p = values)
+        {
+            Sse.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check<T>(string name, T[] values, Func<int, T> expected)
+    {
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (!values[i].Equals(expected(i)))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected(i), values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void Check(string name, int actual, int expected)
+    {
+        if (actual != expected)
+        {
+            Console.WriteLine("FAILED: {0}: expected {1}, got {2}", name, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static void TestIntegral()
+    {
+        Vector128<int> a = Load(IA);
+        Vector128<int> b = Load(IB);
+
+        Check("Add", Sse2.Add(a, b), i => IA[i] + IB[i]);
+        Check("Subtract", Sse2.Subtract(a, b), i => IA[i] - IB[i]);
+        Check("And", Sse2.And(a, b), i => IA[i] & IB[i]);
+        Check("AndNot", Sse2.AndNot(a, b), i => ~IA[i] & IB[i]);
+        Check("Or", Sse2.Or(a, b), i => IA[i] | IB[i]);
+        Check("Xor", Sse2.Xor(a, b), i => IA[i] ^ IB[i]);
+        Check("CompareEqual", Sse2.CompareEqual(a, b), i => (IA[i] == IB[i]) ? -1 : 0);
+        Check("CompareGreaterThan", Sse2.CompareGreaterThan(a, b), i => (IA[i] > IB[i]) ? -1 : 0);
+        Check("CompareLessThan", Sse2.CompareLessThan(a, b), i => (IA[i] < IB[i]) ? -1 : 0);
+        Check("UnpackHigh", Sse2.UnpackHigh(a, b), i => ((i & 1) == 0) ? IA[2 + i / 2] : IB[2 + i / 2]);
+        Check("UnpackLow", Sse2.UnpackLow(a, b), i => ((i & 1) == 0) ? IA[i / 2] : IB[i / 2]);
+        Check("SetZeroVector128", Sse2.SetZeroVector128<int>(), i => 0);
+
+        Check("Multiply", Sse2.Multiply(Load(UA), Load(UB)), i => (ulong)UA[2 * i] * UB[2 * i]);
+
+        Vector128<short> sa = Load(SA);
+        Vector128<short> sb = Load(SB);
+        Check("MultiplyLow", Sse2.MultiplyLow(sa, sb), i => (short)(SA[i] * SB[i]));
+        Check("Max short", Sse2.Max(sa, sb), i => Math.Max(SA[i], SB[i]));
+        Check("Min short", Sse2.Min(sa, sb), i => Math.Min(SA[i], SB[i]));
+
+        byte[] bytes = new byte[16];
+        for (int i = 0; i < bytes.Length; i++)
+        {
+            bytes[i] = (byte)(i * 37);
+        }
+        Vector128<byte> ba = Load(bytes);
+        Vector128<byte> bb = Sse2.Xor(ba, Load(new byte[] { 0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF, 0,
+                                                            0xFF, 0, 0xFF, 0, 0xFF, 0, 0xFF, 0 }));
+        Check("Max byte", Sse2.Max(ba, bb), i => Math.Max(bytes[i], (byte)(bytes[i] ^ (((i & 1) == 0) ? 0xFF : 0))));
+        Check("Min byte", Sse2.Min(ba, bb), i => Math.Min(bytes[i], (byte)(bytes[i] ^ (((i & 1) == 0) ? 0xFF : 0))));
+
+        int expectedMask = 0;
+        for (int i = 0; i < bytes.Length; i++)
+        {
+            expectedMask |= ((bytes[i] & 0x80) != 0) ? (1 << i) : 0;
+        }
+        Check("MoveMask byte", Sse2.MoveMask(ba), expectedMask);
+
+        Check("Shuffle int", Sse2.Shuffle(a, 0x1B), i => IA[3 - i]);
+        for (int control = 0; control <= 255; control++)
+        {
+            Check("Shuffle int " + control, Sse2.Shuffle(a, NotConstant(control)), i => IA[(control >> (2 * i)) & 3]);
+        }
+    }
+
+    static void TestDouble()
+    {
+        Vector128<double> a = Load(DA);
+        Vector128<double> b = Load(DB);
+
+        Check("Add double", Sse2.Add(a, b), i => DA[i] + DB[i]);
+        Check("Subtract double", Sse2.Subtract(a, b), i => DA[i] - DB[i]);
+        Check("Multiply double", Sse2.Multiply(a, b), i => DA[i] * DB[i]);
+        Check("Divide double", Sse2.Divide(a, b), i => DA[i] / DB[i]);
+        Check("Max double", Sse2.Max(a, b), i => Math.Max(DA[i], DB[i]));
+        Check("Min double", Sse2.Min(a, b), i => Math.Min(DA[i], DB[i]));
+        Check("Sqrt double", Sse2.Sqrt(Sse2.Multiply(a, a)), i => Math.Abs(DA[i]));
+        Check("And double", Sse2.And(a, b), i => FromBits(Bits(DA[i]) & Bits(DB[i])));
+        Check("AndNot double", Sse2.AndNot(a, b), i => FromBits(~Bits(DA[i]) & Bits(DB[i])));
+        Check("Or double", Sse2.Or(a, b), i => FromBits(Bits(DA[i]) | Bits(DB[i])));
+        Check("Xor double", Sse2.Xor(a, b), i => FromBits(Bits(DA[i]) ^ Bits(DB[i])));
+        Check("CompareEqual double", Sse2.CompareEqual(a, b), i => FromBits((DA[i] == DB[i]) ? -1 : 0));
+        Check("CompareGreaterThan double", Sse2.CompareGreaterThan(a, b), i => FromBits((DA[i] > DB[i]) ? -1 : 0));
+        Check("CompareLessThan double", Sse2.CompareLessThan(a, b), i => FromBits((DA[i] < DB[i]) ? -1 : 0));
+        Check("UnpackHigh double", Sse2.UnpackHigh(a, b), i => (i == 0) ? DA[1] : DB[1]);
+        Check("UnpackLow double", Sse2.UnpackLow(a, b), i => (i == 0) ? DA[0] : DB[0]);
+        Check("MoveMask double", Sse2.MoveMask(a), 0x2);
+
+        Check("Shuffle double", Sse2.Shuffle(a, b, 1), i => (i == 0) ? DA[1] : DB[0]);
+        for (int control = 0; control <= 255; control++)
+        {
+            Check("Shuffle double " + control, Sse2.Shuffle(a, b, NotConstant(control)),
+                  i => (i == 0) ? DA[control & 1] : DB[(control >> 1) & 1]);
+        }
+
+        double* buffer = stackalloc double[4];
+        double* aligned = (double*)(((ulong)buffer + 15) & ~15UL);
+        Sse2.StoreAligned(aligned, a);
+        Check("StoreAligned double", Sse2.LoadAlignedVector128(aligned), i => DA[i]);
+    }
+
+    static void TestConversions()
+    {
+        float[] floats = { 1.75f, -2.5f, 100.25f, -0.5f };
+        Vector128<float> f = Load(floats);
+        Vector128<int> a = Load(IA);
+        Vector128<double> d = Load(DA);
+
+        Check("ConvertToVector128Double float", Sse2.ConvertToVector128Double(f), i => (double)floats[i]);
+        Check("ConvertToVector128Double int", Sse2.ConvertToVector128Double(a), i => (double)IA[i]);
+        Check("ConvertToVector128Int32WithTruncation float", Sse2.ConvertToVector128Int32WithTruncation(f),
+              i => (int)floats[i]);
+        Check("ConvertToVector128Int32WithTruncation double", Sse2.ConvertToVector128Int32WithTruncation(d),
+              i => (i < 2) ? (int)DA[i] : 0);
+        Check("ConvertToVector128Single int", Sse2.ConvertToVector128Single(a), i => (float)IA[i]);
+        Check("ConvertToVector128Single double", Sse2.ConvertToVector128Single(d), i => (i < 2) ? (float)DA[i] : 0.0f);
+    }
+
+    public static bool Run()
+    {
+        if (Sse2.IsSupported)
+        {
+            TestIntegral();
+            TestDouble();
+            TestConversions();
+        }
+
+        return s_passed;
+    }
+}
@@ -0,0 +1,255 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Smoke test for the SSE3, SSSE3, SSE4.1 and SSE4.2 hardware intrinsics the JIT expands:
+// each one is checked against a scalar computation of its result. Blend is also checked
+// with a control value that is not a constant, for all 256 values.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+public static unsafe class SseExtensionsSmoke
+{
+    static bool s_passed = true;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static byte NotConstant(int value)
+    {
+        return (byte)value;
+    }
+
+    static Vector128<float> Load(float[] values)
+    {
+        fixed (float* p = values)
+        {
+            return Sse.LoadVector128(p);
+        }
+    }
+
+    static Vector128<double> Load(double[] values)
+    {
+        fixed (double* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<sbyte> Load(sbyte[] values)
+    {
+        fixed (sbyte* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<short> Load(short[] values)
+    {
+        fixed (short* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<int> Load(int[] values)
+    {
+        fixed (int* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static Vector128<long> Load(long[] values)
+    {
+        fixed (long* p = values)
+        {
+            return Sse2.LoadVector128(p);
+        }
+    }
+
+    static void Check(string name, Vector128<float> actual, Func<int, float> expected)
+    {
+        float[] values = new float[4];
+        fixed (float* p = values)
+        {
+            Sse.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<double> actual, Func<int, double> expected)
+    {
+        double[] values = new double[2];
+        fixed (double* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<byte> actual, Func<int, byte> expected)
+    {
+        byte[] values = new byte[16];
+        fixed (byte* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<sbyte> actual, Func<int, sbyte> expected)
+    {
+        sbyte[] values = new sbyte[16];
+        fixed (sbyte* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<short> actual, Func<int, short> expected)
+    {
+        short[] values = new short[8];
+        fixed (short* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<int> actual, Func<int, int> expected)
+    {
+        int[] values = new int[4];
+        fixed (int* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check(string name, Vector128<long> actual, Func<int, long> expected)
+    {
+        long[] values = new long[2];
+        fixed (long* p = values)
+        {
+            Sse2.Store(p, actual);
+        }
+        Check(name, values, expected);
+    }
+
+    static void Check<T>(string name, T[] values, Func<int, T> expected)
+    {
+        for (int i = 0; i < values.Length; i++)
+        {
+            if (!values[i].Equals(expected(i)))
+            {
+                Console.WriteLine("FAILED: {0} element {1}: expected {2}, got {3}", name, i, expected(i), values[i]);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void TestSse3()
+    {
+        float[] fa = { 1, 2, 3, 4 };
+        float[] fb = { 10, 20, 30, 40 };
+        Check("HorizontalAdd float", Sse3.HorizontalAdd(Load(fa), Load(fb)),
+              i => (i < 2) ? fa[2 * i] + fa[2 * i + 1] : fb[2 * i - 4] + fb[2 * i - 3]);
+
+        double[] da = { 1.5, 2.5 };
+        double[] db = { -1, 8 };
+        Check("HorizontalAdd double", Sse3.HorizontalAdd(Load(da), Load(db)), i => (i == 0) ? 4.0 : 7.0);
+    }
+
+    static void TestSsse3()
+    {
+        sbyte[] values = new sbyte[16];
+        sbyte[] indices = new sbyte[16];
+        for (int i = 0; i < values.Length; i++)
+        {
+            values[i] = (sbyte)(i * 19 - 128);
+            indices[i] = (sbyte)(((i & 3) == 0) ? -1 : (15 - i) * 5);
+        }
+
+        Check("Abs", Ssse3.Abs(Load(values)), i => (byte)Math.Abs((int)values[i]));
+        Check("Shuffle", Ssse3.Shuffle(Load(values), Load(indices)),
+              i => (indices[i] < 0) ? (sbyte)0 : values[indices[i] & 15]);
+    }
+
+    static void TestSse41()
+    {
+        float[] fa = { 1, 2, 3, 4 };
+        float[] fb = { -1, -2, -3, -4 };
+        Check("Blend float", Sse41.Blend(Load(fa), Load(fb), 0x5), i => (((0x5 >> i) & 1) != 0) ? fb[i] : fa[i]);
+
+        double[] da = { 1, 2 };
+        double[] db = { -1, -2 };
+        short[] sa = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        short[] sb = { -1, -2, -3, -4, -5, -6, -7, -8 };
+        for (int control = 0; control <= 255; control++)
+        {
+            byte c = NotConstant(control);
+            Check("Blend float " + control, Sse41.Blend(Load(fa), Load(fb), c),
+                  i => (((control >> i) & 1) != 0) ? fb[i] : fa[i]);
+            Check("Blend double " + control, Sse41.Blend(Load(da), Load(db), c),
+                  i => (((control >> i) & 1) != 0) ? db[i] : da[i]);
+            Check("Blend short " + control, Sse41.Blend(Load(sa), Load(sb), c),
+                  i => (((control >> i) & 1) != 0) ? sb[i] : sa[i]);
+        }
+
+        long[] la = { long.MinValue, 5 };
+        long[] lb = { long.MinValue, 6 };
+        Check("CompareEqual long", Sse41.CompareEqual(Load(la), Load(lb)), i => (la[i] == lb[i]) ? -1L : 0L);
+
+        int[] ia = { int.MinValue, -1, 70000, 4 };
+        int[] ib = { 3, -2, 70001, 4 };
+        Check("Max int", Sse41.Max(Load(ia), Load(ib)), i => Math.Max(ia[i], ib[i]));
+        Check("Min int", Sse41.Min(Load(ia), Load(ib)), i => Math.Min(ia[i], ib[i]));
+        Check("MultiplyLow int", Sse41.MultiplyLow(Load(ia), Load(ib)), i => ia[i] * ib[i]);
+
+        sbyte[] ba = new sbyte[16];
+        sbyte[] bb = new sbyte[16];
+        for (int i = 0; i < ba.Length; i++)
+        {
+            ba[i] = (sbyte)(i * 23);
+            bb[i] = (sbyte)(-i * 11);
+        }
+        Check("Max sbyte", Sse41.Max(Load(ba), Load(bb)), i => Math.Max(ba[i], bb[i]));
+        Check("Min sbyte", Sse41.Min(Load(ba), Load(bb)), i => Math.Min(ba[i], bb[i]));
+    }
+
+    static void TestSse42()
+    {
+        long[] la = { long.MaxValue, -5 };
+        long[] lb = { long.MinValue, 6 };
+        Check("CompareGreaterThan long", Sse42.CompareGreaterThan(Load(la), Load(lb)), i => (la[i] > lb[i]) ? -1L : 0L);
+    }
+
+    public static bool Run()
+    {
+        if (Sse3.IsSupported)
+        {
+            TestSse3();
+        }
+
+        if (Ssse3.IsSupported)
+        {
+            TestSsse3();
+        }
+
+        if (Sse41.IsSupported)
+        {
+            TestSse41();
+        }
+
+        if (Sse42.IsSupported)
+        {
+            TestSse42();
+        }
+
+        return s_passed;
+    }
+}
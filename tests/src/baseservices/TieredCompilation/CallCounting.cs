@@ -0,0 +1,166 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Checks that call counting promotes every method called past the threshold to tier1 and no
+// method called fewer times. Threads call disjoint sets of generic instantiations over value
+// types at the same time, so the call counting table is filled and grown concurrently.
+// Tier1 code inlines ThrowIfNegative and tier0 code does not, so the stack trace of the
+// exception it throws tells which code ran.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+public struct C0 {} public struct C1 {} public struct C2 {} public struct C3 {}
+public struct C4 {} public struct C5 {} public struct C6 {} public struct C7 {}
+
+public struct T0 {} public struct T1 {} public struct T2 {} public struct T3 {}
+public struct Cold {}
+
+public struct Pair<A, B> {}
+
+public static class Work<T>
+{
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void ThrowIfNegative(int value)
+    {
+        if (value < 0)
+        {
+            throw new InvalidOperationException();
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)] public static int M0(int v) { ThrowIfNegative(v); return v + 1; }
+    [MethodImpl(MethodImplOptions.NoInlining)] public static int M1(int v) { ThrowIfNegative(v); return v + 2; }
+    [MethodImpl(MethodImplOptions.NoInlining)] public static int M2(int v) { ThrowIfNegative(v); return v + 3; }
+    [MethodImpl(MethodImplOptions.NoInlining)] public static int M3(int v) { ThrowIfNegative(v); return v + 4; }
+}
+
+public static class CallCounting
+{
+    // Tier0 code is counted for 30 calls
+    const int HotCalls = 100;
+    const int ColdCalls = 10;
+    const int MaxWaits = 40;
+
+    static bool s_passed = true;
+
+    static Func<int, int>[] GetMethods<T>()
+    {
+        return new Func<int, int>[]
+        {
+            Work<Pair<C0, T>>.M0, Work<Pair<C0, T>>.M1, Work<Pair<C0, T>>.M2, Work<Pair<C0, T>>.M3,
+            Work<Pair<C1, T>>.M0, Work<Pair<C1, T>>.M1, Work<Pair<C1, T>>.M2, Work<Pair<C1, T>>.M3,
+            Work<Pair<C2, T>>.M0, Work<Pair<C2, T>>.M1, Work<Pair<C2, T>>.M2, Work<Pair<C2, T>>.M3,
+            Work<Pair<C3, T>>.M0, Work<Pair<C3, T>>.M1, Work<Pair<C3, T>>.M2, Work<Pair<C3, T>>.M3,
+            Work<Pair<C4, T>>.M0, Work<Pair<C4, T>>.M1, Work<Pair<C4, T>>.M2, Work<Pair<C4, T>>.M3,
+            Work<Pair<C5, T>>.M0, Work<Pair<C5, T>>.M1, Work<Pair<C5, T>>.M2, Work<Pair<C5, T>>.M3,
+            Work<Pair<C6, T>>.M0, Work<Pair<C6, T>>.M1, Work<Pair<C6, T>>.M2, Work<Pair<C6, T>>.M3,
+            Work<Pair<C7, T>>.M0, Work<Pair<C7, T>>.M1, Work<Pair<C7, T>>.M2, Work<Pair<C7, T>>.M3,
+        };
+    }
+
+    // Calls each method the given number of times, from threadCount threads that each call a
+    // disjoint slice of the methods, and checks the results.
+    static void CallConcurrently(Func<int, int>[] methods, int threadCount, int calls)
+    {
+        var threads = new Thread[threadCount];
+        var start = new ManualResetEvent(false);
+        for (int t = 0; t < threadCount; t++)
+        {
+            int first = t;
+            threads[t] = new Thread(() =>
+            {
+                start.WaitOne();
+                for (int i = 0; i < calls; i++)
+                {
+                    for (int m = first; m < methods.Length; m += threadCount)
+                    {
+                        if (methods[m](i) != i + (m % 4) + 1)
+                        {
+                            Console.WriteLine("FAILED: method {0} returned a wrong result", m);
+                            s_passed = false;
+                        }
+                    }
+                }
+            });
+            threads[t].Start();
+        }
+
+        start.Set();
+        foreach (Thread thread in threads)
+        {
+            thread.Join();
+        }
+    }
+
+    // Returns true if the call threw from code that inlined ThrowIfNegative.
+    static bool IsOptimized(Func<int, int> method)
+    {
+        try
+        {
+            method(-1);
+        }
+        catch (InvalidOperationException e)
+        {
+            return !e.StackTrace.Contains("ThrowIfNegative");
+        }
+
+        Console.WriteLine("FAILED: expected InvalidOperationException");
+        s_passed = false;
+        return false;
+    }
+
+    public static int Main()
+    {
+        Func<int, int>[][] hot = new Func<int, int>[][]
+        {
+            GetMethods<T0>(), GetMethods<T1>(), GetMethods<T2>(), GetMethods<T3>(),
+        };
+        Func<int, int>[] cold = GetMethods<Cold>();
+
+        int threadCount = 1;
+        foreach (Func<int, int>[] methods in hot)
+        {
+            CallConcurrently(methods, Math.Min(threadCount, Environment.ProcessorCount), HotCalls);
+            threadCount *= 2;
+        }
+        CallConcurrently(cold, Math.Min(4, Environment.ProcessorCount), ColdCalls);
+
+        // Every hot method must get tier1 code once the background thread catches up.
+        for (int set = 0; set < hot.Length; set++)
+        {
+            for (int m = 0; m < hot[set].Length; m++)
+            {
+                int wait = 0;
+                while (!IsOptimized(hot[set][m]) && (wait++ < MaxWaits))
+                {
+                    Thread.Sleep(250);
+                }
+                if (wait > MaxWaits)
+                {
+                    Console.WriteLine("FAILED: method {0} of set {1} was not promoted", m, set);
+                    s_passed = false;
+                }
+            }
+        }
+
+        for (int m = 0; m < cold.Length; m++)
+        {
+            if (IsOptimized(cold[m]))
+            {
+                Console.WriteLine("FAILED: method {0} was promoted after {1} calls", m, ColdCalls);
+                s_passed = false;
+            }
+        }
+
+        if (!s_passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
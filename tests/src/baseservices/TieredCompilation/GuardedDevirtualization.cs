@@ -0,0 +1,241 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Tier0 code records the classes seen at interface call sites and tier1 code guards a direct
+// call to the method of the most likely class. Call sites are trained in tier0 code with one
+// class (monomorphic), two classes (bimorphic) and many classes (megamorphic), then run again
+// once the methods have had time to be promoted. Every class is passed to every call site in
+// both phases, so the guarded direct call, the fallback virtual call and unguarded calls all
+// have their results checked.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+public static class GuardedDevirtualization
+{
+    const int TrainingCalls = 200;
+    const int CheckCalls = 1000;
+
+    static bool s_passed = true;
+
+    class Ascending : IComparer<int>
+    {
+        public int Compare(int x, int y) { return x.CompareTo(y); }
+    }
+
+    class Descending : IComparer<int>
+    {
+        public int Compare(int x, int y) { return y.CompareTo(x); }
+    }
+
+    class ByLowBits : IComparer<int>
+    {
+        public int Compare(int x, int y) { return (x & 0xF).CompareTo(y & 0xF); }
+    }
+
+    class ByHighBits : IComparer<int>
+    {
+        public int Compare(int x, int y) { return (x >> 4).CompareTo(y >> 4); }
+    }
+
+    class Constant : IComparer<int>
+    {
+        public int Compare(int x, int y) { return 0; }
+    }
+
+    class Squares : IEnumerable<int>
+    {
+        int _count;
+
+        public Squares(int count) { _count = count; }
+
+        public IEnumerator<int> GetEnumerator()
+        {
+            for (int i = 0; i < _count; i++)
+            {
+                yield return i * i;
+            }
+        }
+
+        System.Collections.IEnumerator System.Collections.IEnumerable.GetEnumerator() { return GetEnumerator(); }
+    }
+
+    static readonly IComparer<int>[] s_comparers =
+    {
+        new Ascending(), new Descending(), new ByLowBits(), new ByHighBits(), new Constant()
+    };
+
+    static int ExpectedCompare(int kind, int x, int y)
+    {
+        switch (kind)
+        {
+            case 0: return Math.Sign(x - y);
+            case 1: return Math.Sign(y - x);
+            case 2: return Math.Sign((x & 0xF) - (y & 0xF));
+            case 3: return Math.Sign((x >> 4) - (y >> 4));
+            default: return 0;
+        }
+    }
+
+    static IEnumerable<int> MakeSequence(int kind, int count)
+    {
+        switch (kind)
+        {
+            case 0:
+            {
+                List<int> list = new List<int>();
+                for (int i = 0; i < count; i++)
+                {
+                    list.Add(i * i);
+                }
+                return list;
+            }
+            case 1:
+            {
+                int[] array = new int[count];
+                for (int i = 0; i < count; i++)
+                {
+                    array[i] = i * i;
+                }
+                return array;
+            }
+            default:
+                return new Squares(count);
+        }
+    }
+
+    static int ExpectedSum(int count)
+    {
+        int sum = 0;
+        for (int i = 0; i < count; i++)
+        {
+            sum += i * i;
+        }
+        return sum;
+    }
+
+    // Each call site is only ever trained with the classes of its own shape.
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int MonomorphicSum(IEnumerable<int> values)
+    {
+        int sum = 0;
+        foreach (int value in values)
+        {
+            sum += value;
+        }
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int MonomorphicCompare(IComparer<int> comparer, int x, int y)
+    {
+        return Math.Sign(comparer.Compare(x, y));
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int BimorphicCompare(IComparer<int> comparer, int x, int y)
+    {
+        return Math.Sign(comparer.Compare(x, y));
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int MegamorphicCompare(IComparer<int> comparer, int x, int y)
+    {
+        return Math.Sign(comparer.Compare(x, y));
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int MegamorphicSum(IEnumerable<int> values)
+    {
+        int sum = 0;
+        foreach (int value in values)
+        {
+            sum += value;
+        }
+        return sum;
+    }
+
+    static void CheckCompare(string name, Func<IComparer<int>, int, int, int> site, int kind, int x, int y)
+    {
+        int expected = ExpectedCompare(kind, x, y);
+        int actual = site(s_comparers[kind], x, y);
+        if (actual != expected)
+        {
+            Console.WriteLine("FAILED: {0} with {1}({2}, {3}): expected {4}, got {5}", name,
+                              s_comparers[kind].GetType().Name, x, y, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static void CheckSum(string name, Func<IEnumerable<int>, int> site, int kind, int count)
+    {
+        IEnumerable<int> values = MakeSequence(kind, count);
+        int expected = ExpectedSum(count);
+        int actual = site(values);
+        if (actual != expected)
+        {
+            Console.WriteLine("FAILED: {0} with {1} of {2}: expected {3}, got {4}", name, values.GetType().Name,
+                              count, expected, actual);
+            s_passed = false;
+        }
+    }
+
+    static void Train(Random random)
+    {
+        for (int i = 0; i < TrainingCalls; i++)
+        {
+            int x = random.Next(256);
+            int y = random.Next(256);
+            CheckSum("MonomorphicSum", MonomorphicSum, 0, i % 20);
+            CheckSum("MegamorphicSum", MegamorphicSum, i % 3, i % 20);
+            CheckCompare("MonomorphicCompare", MonomorphicCompare, 0, x, y);
+            // Three quarters of the calls on Ascending, so it is guarded and Descending falls back.
+            CheckCompare("BimorphicCompare", BimorphicCompare, ((i % 4) == 0) ? 1 : 0, x, y);
+            CheckCompare("MegamorphicCompare", MegamorphicCompare, i % s_comparers.Length, x, y);
+        }
+    }
+
+    static void CheckAllClasses(Random random)
+    {
+        for (int i = 0; i < CheckCalls; i++)
+        {
+            int x = random.Next(256);
+            int y = random.Next(256);
+            int kind = i % s_comparers.Length;
+            CheckCompare("MonomorphicCompare", MonomorphicCompare, kind, x, y);
+            CheckCompare("BimorphicCompare", BimorphicCompare, kind, x, y);
+            CheckCompare("MegamorphicCompare", MegamorphicCompare, kind, x, y);
+            CheckSum("MonomorphicSum", MonomorphicSum, i % 3, i % 20);
+            CheckSum("MegamorphicSum", MegamorphicSum, i % 3, i % 20);
+        }
+    }
+
+    public static int Main()
+    {
+        Random random = new Random(17);
+
+        Train(random);
+
+        // Give the background thread time to promote the call sites, then keep calling them
+        // with the training distribution so tier1 code runs with both the guard and fallback.
+        for (int wait = 0; wait < 10; wait++)
+        {
+            Thread.Sleep(100);
+            Train(random);
+        }
+
+        CheckAllClasses(random);
+
+        if (!s_passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
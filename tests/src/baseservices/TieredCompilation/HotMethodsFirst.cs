@@ -0,0 +1,165 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Methods waiting for tier1 code are optimized in the order of the rate at which they were
+// called while they were being counted. A backlog of methods called slowly, over a second,
+// is queued just before a few methods called in a tight loop. The hot methods must get
+// tier1 code before most of the backlog is optimized.
+//
+// Tier1 code inlines ThrowIfNegative and tier0 code does not, so the stack trace of the
+// exception it throws tells which code ran.
+
+using System;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+public struct A0 {} public struct A1 {} public struct A2 {} public struct A3 {}
+public struct A4 {} public struct A5 {} public struct A6 {} public struct A7 {}
+public struct Hot0 {} public struct Hot1 {} public struct Hot2 {} public struct Hot3 {}
+
+public struct Triple<A, B, C> {}
+
+public static class Work<T>
+{
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void ThrowIfNegative(int value)
+    {
+        if (value < 0)
+        {
+            throw new InvalidOperationException();
+        }
+    }
+
+    // Enough code for each tier1 compilation to take a while.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    public static int Run(int v)
+    {
+        ThrowIfNegative(v);
+        int a = v * 3 + 1;
+        int b = (a ^ (v << 2)) + 7;
+        int c = (b * a) - (v >> 1);
+        int d = (c % 13) + (a & b);
+        int e = (d * d) ^ (c | v);
+        int f = (e >> 3) + (d << 1) - b;
+        int g = (f * 5) ^ (e + a);
+        int h = (g % 29) + (f & c) - d;
+        return (a + b + c + d + e + f + g + h) & 0xFFFF;
+    }
+}
+
+public static class HotMethodsFirst
+{
+    // Tier0 code is counted for 30 calls
+    const int Calls = 30;
+    const int MaxWaitMs = 30000;
+
+    static readonly Type[] s_markers =
+    {
+        typeof(A0), typeof(A1), typeof(A2), typeof(A3), typeof(A4), typeof(A5), typeof(A6), typeof(A7)
+    };
+
+    static Func<int, int> GetMethod(Type type)
+    {
+        Type work = typeof(Work<>).MakeGenericType(type);
+        return (Func<int, int>)work.GetMethod("Run").CreateDelegate(typeof(Func<int, int>));
+    }
+
+    // Returns true if the call threw from code that inlined ThrowIfNegative.
+    static bool IsOptimized(Func<int, int> method)
+    {
+        try
+        {
+            method(-1);
+        }
+        catch (InvalidOperationException e)
+        {
+            return !e.StackTrace.Contains("ThrowIfNegative");
+        }
+        return false;
+    }
+
+    static int CountOptimized(Func<int, int>[] methods)
+    {
+        int count = 0;
+        foreach (Func<int, int> method in methods)
+        {
+            count += IsOptimized(method) ? 1 : 0;
+        }
+        return count;
+    }
+
+    public static int Main()
+    {
+        Func<int, int>[] cold = new Func<int, int>[s_markers.Length * s_markers.Length * s_markers.Length];
+        int n = 0;
+        foreach (Type a in s_markers)
+        {
+            foreach (Type b in s_markers)
+            {
+                foreach (Type c in s_markers)
+                {
+                    cold[n++] = GetMethod(typeof(Triple<,,>).MakeGenericType(a, b, c));
+                }
+            }
+        }
+        Func<int, int>[] hot = new Func<int, int>[]
+        {
+            GetMethod(typeof(Hot0)), GetMethod(typeof(Hot1)), GetMethod(typeof(Hot2)), GetMethod(typeof(Hot3))
+        };
+
+        // Start counting the backlog, and make its call rate low by finishing a second later.
+        int checksum = 0;
+        foreach (Func<int, int> method in cold)
+        {
+            checksum += method(1);
+        }
+        Thread.Sleep(1000);
+        foreach (Func<int, int> method in cold)
+        {
+            for (int i = 1; i < Calls; i++)
+            {
+                checksum += method(i);
+            }
+        }
+        foreach (Func<int, int> method in hot)
+        {
+            for (int i = 0; i < Calls; i++)
+            {
+                checksum += method(i);
+            }
+        }
+
+        int waitedMs = 0;
+        while ((CountOptimized(hot) < hot.Length) && (waitedMs < MaxWaitMs))
+        {
+            Thread.Sleep(1);
+            waitedMs++;
+        }
+        int coldOptimized = CountOptimized(cold);
+
+        Console.WriteLine("Checksum {0}, {1} of {2} backlog methods optimized with the hot methods", checksum,
+                          coldOptimized, cold.Length);
+
+        bool passed = true;
+        if (waitedMs >= MaxWaitMs)
+        {
+            Console.WriteLine("FAILED: the hot methods were not promoted");
+            passed = false;
+        }
+        else if (coldOptimized >= cold.Length / 2)
+        {
+            Console.WriteLine("FAILED: the hot methods were promoted after most of the backlog");
+            passed = false;
+        }
+
+        if (!passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,190 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Tier0 code counts the loop back-edges it takes and asks for tier1 code once a single
+// invocation has taken enough of them. A method that runs a long loop is called once and
+// must then be promoted, well before it has been called often enough to be promoted by call
+// counting. Tier1 code inlines ThrowIfNegative and tier0 code does not, so the stack trace
+// of the exception it throws tells which code ran. A method with a short loop that is called
+// the same number of times checks that the stack trace does tell them apart.
+//
+// Loops whose back-edge leaves a try/finally (a 'continue' inside the try) are also run long
+// enough for their counters to fire, in tier0 and in tier1 code.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+public static class LoopBackEdgePromotion
+{
+    // Tier0 code is counted for 30 calls, stay well below that
+    const int MaxProbes = 20;
+    const int LongLoop = 1000000;
+
+    static bool s_passed = true;
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    static void ThrowIfNegative(int value)
+    {
+        if (value < 0)
+        {
+            throw new InvalidOperationException();
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Hot(int count, int probe)
+    {
+        int sum = 0;
+        for (int i = 0; i < count; i++)
+        {
+            sum += i ^ (sum >> 3);
+        }
+        ThrowIfNegative(probe);
+        return sum;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int Cold(int count, int probe)
+    {
+        int sum = 0;
+        for (int i = 0; i < count; i++)
+        {
+            sum += i ^ (sum >> 3);
+        }
+        ThrowIfNegative(probe);
+        return sum;
+    }
+
+    // Returns true if the call threw from code that inlined ThrowIfNegative.
+    static bool IsOptimized(Func<int, int, int> method)
+    {
+        try
+        {
+            method(0, -1);
+        }
+        catch (InvalidOperationException e)
+        {
+            return !e.StackTrace.Contains("ThrowIfNegative");
+        }
+
+        Console.WriteLine("FAILED: expected InvalidOperationException");
+        s_passed = false;
+        return false;
+    }
+
+    // Runs the loop once, then checks whether it gets promoted within MaxProbes calls.
+    static bool IsPromoted(Func<int, int, int> method, int count)
+    {
+        method(count, 0);
+        for (int probe = 0; probe < MaxProbes; probe++)
+        {
+            if (IsOptimized(method))
+            {
+                return true;
+            }
+            Thread.Sleep(250);
+        }
+        return false;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ContinueThroughFinally(int count)
+    {
+        int i = 0;
+        int finallies = 0;
+        for (;;)
+        {
+            try
+            {
+                if (++i < count)
+                {
+                    continue;
+                }
+            }
+            finally
+            {
+                finallies++;
+            }
+            break;
+        }
+        return finallies;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ContinueThroughNestedFinally(int count)
+    {
+        int i = 0;
+        int finallies = 0;
+        for (;;)
+        {
+            try
+            {
+                try
+                {
+                    if (++i < count)
+                    {
+                        continue;
+                    }
+                }
+                finally
+                {
+                    finallies++;
+                }
+            }
+            finally
+            {
+                finallies++;
+            }
+            break;
+        }
+        return finallies;
+    }
+
+    static void CheckFinallyLoops()
+    {
+        for (int run = 0; run < 40; run++)
+        {
+            int count = (run == 0) ? LongLoop : 100000 + run;
+            int result = ContinueThroughFinally(count);
+            if (result != count)
+            {
+                Console.WriteLine("FAILED: ContinueThroughFinally({0}) returned {1}", count, result);
+                s_passed = false;
+            }
+
+            result = ContinueThroughNestedFinally(count);
+            if (result != count * 2)
+            {
+                Console.WriteLine("FAILED: ContinueThroughNestedFinally({0}) returned {1}", count, result);
+                s_passed = false;
+            }
+        }
+    }
+
+    public static int Main()
+    {
+        if (!IsPromoted(Hot, LongLoop))
+        {
+            Console.WriteLine("FAILED: method with a long loop was not promoted");
+            s_passed = false;
+        }
+
+        if (IsPromoted(Cold, 10))
+        {
+            Console.WriteLine("FAILED: method with a short loop was promoted, or tier0 code inlined");
+            s_passed = false;
+        }
+
+        CheckFinallyLoops();
+
+        if (!s_passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
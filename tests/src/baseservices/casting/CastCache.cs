@@ -0,0 +1,113 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Casts that the casting helpers cannot decide from the type hierarchy alone: variant
+// generic interfaces, arrays cast to variant interfaces, and casts to naked type
+// parameters. Their results are cached by the runtime, so each cast is repeated with a
+// source that can be cast alternating with one that cannot, and every result is checked.
+// A stale or wrong cache entry, or an entry used for the wrong pair of types, fails the
+// test. CastCacheDisabled runs the same casts with COMPlus_CastCacheSize=1, which turns
+// the cache off.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+public interface IProducer<out T> { T Produce(); }
+public interface IConsumer<in T> { void Consume(T value); }
+
+public class Animal {}
+public class Dog : Animal {}
+public class Cat : Animal {}
+
+public class DogProducer : IProducer<Dog> { public Dog Produce() { return null; } }
+public class CatProducer : IProducer<Cat> { public Cat Produce() { return null; } }
+public class AnimalConsumer : IConsumer<Animal> { public void Consume(Animal value) {} }
+
+public static class CastCache
+{
+    const int Repeats = 1000;
+
+    static bool s_passed = true;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsInstance<T>(object o) where T : class
+    {
+        return o is T;
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static T CastTo<T>(object o) where T : class
+    {
+        return (T)o;
+    }
+
+    // Repeats body over every source, whose expected results are in expected.
+    static void Check(string name, object[] sources, bool[] expected, Func<object, bool> body)
+    {
+        for (int i = 0; i < Repeats * sources.Length; i++)
+        {
+            int s = i % sources.Length;
+            if (body(sources[s]) != expected[s])
+            {
+                Console.WriteLine("FAILED: {0} for {1}: expected {2} on repeat {3}", name,
+                                  sources[s].GetType().Name, expected[s], i / sources.Length);
+                s_passed = false;
+                return;
+            }
+        }
+    }
+
+    static void CheckThrows<T>(object o) where T : class
+    {
+        try
+        {
+            CastTo<T>(o);
+            Console.WriteLine("FAILED: cast of {0} to {1} expected InvalidCastException", o.GetType().Name,
+                              typeof(T).Name);
+            s_passed = false;
+        }
+        catch (InvalidCastException)
+        {
+        }
+    }
+
+    public static int Main()
+    {
+        object[] producers = new object[] { new DogProducer(), new AnimalConsumer(), new CatProducer() };
+        object[] consumers = new object[] { new AnimalConsumer(), new DogProducer() };
+        object[] arrays = new object[] { new string[1], new int[1], new Dog[1] };
+        object[] lists = new object[] { new List<string>(), new List<int>(), new List<Dog>() };
+
+        Check("is IProducer<Animal>", producers, new bool[] { true, false, true },
+              o => IsInstance<IProducer<Animal>>(o));
+        Check("is IProducer<Dog>", producers, new bool[] { true, false, false },
+              o => IsInstance<IProducer<Dog>>(o));
+        Check("is IConsumer<Dog>", consumers, new bool[] { true, false },
+              o => IsInstance<IConsumer<Dog>>(o));
+        Check("is IReadOnlyList<object>", arrays, new bool[] { true, false, true },
+              o => IsInstance<IReadOnlyList<object>>(o));
+        Check("is IReadOnlyList<Animal>", arrays, new bool[] { false, false, true },
+              o => IsInstance<IReadOnlyList<Animal>>(o));
+        Check("is object[]", arrays, new bool[] { true, false, true },
+              o => IsInstance<object[]>(o));
+        Check("is IEnumerable<object>", lists, new bool[] { true, false, true },
+              o => IsInstance<IEnumerable<object>>(o));
+
+        // The casts that succeed are cached first, then a failing cast must still throw.
+        Check("cast to IProducer<Animal>", new object[] { producers[0], producers[2] }, new bool[] { true, true },
+              o => CastTo<IProducer<Animal>>(o) != null);
+        CheckThrows<IProducer<Animal>>(new AnimalConsumer());
+        CheckThrows<IProducer<Dog>>(new CatProducer());
+        CheckThrows<IEnumerable<object>>(new List<int>());
+
+        if (!s_passed)
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,112 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Locking an object that already has a hash code moves the hash code into a sync block. Once the
+// lock is released, a full GC reclaims such a sync block and moves the hash code back into the
+// object header. Makes sure hash codes survive that round trip and that the objects can still be
+// locked, waited on and hashed afterwards.
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Threading;
+
+public static class SyncBlockDeflation
+{
+    const int ObjectCount = 1000;
+    const int Iterations = 5;
+
+    static bool CheckHashCodes(object[] objects, int[] hashCodes, string when)
+    {
+        for (int i = 0; i < objects.Length; i++)
+        {
+            int hashCode = RuntimeHelpers.GetHashCode(objects[i]);
+            if (hashCode != hashCodes[i])
+            {
+                Console.WriteLine("Hash code of object {0} changed {1}: {2} instead of {3}",
+                                  i, when, hashCode, hashCodes[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    public static int Main()
+    {
+        object[] objects = new object[ObjectCount];
+        int[] hashCodes = new int[ObjectCount];
+
+        for (int i = 0; i < ObjectCount; i++)
+        {
+            objects[i] = new object();
+            hashCodes[i] = RuntimeHelpers.GetHashCode(objects[i]);
+        }
+
+        for (int iteration = 0; iteration < Iterations; iteration++)
+        {
+            // Inflate: the hash code and the lock no longer fit in the header together
+            for (int i = 0; i < ObjectCount; i++)
+            {
+                lock (objects[i])
+                {
+                    if (RuntimeHelpers.GetHashCode(objects[i]) != hashCodes[i])
+                    {
+                        Console.WriteLine("Hash code of object {0} changed while locked", i);
+                        return 101;
+                    }
+                }
+            }
+
+            if (!CheckHashCodes(objects, hashCodes, "after unlocking"))
+            {
+                return 101;
+            }
+
+            // Deflate: the idle sync blocks are reclaimed by a full GC
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            GC.Collect();
+
+            if (!CheckHashCodes(objects, hashCodes, "after a full GC"))
+            {
+                return 101;
+            }
+        }
+
+        // A sync block that is in use must not be reclaimed
+        object held = objects[0];
+        Monitor.Enter(held);
+        GC.Collect();
+        if (!Monitor.IsEntered(held) || RuntimeHelpers.GetHashCode(held) != hashCodes[0])
+        {
+            Console.WriteLine("Lock state or hash code of a held lock was lost in a GC");
+            return 101;
+        }
+
+        // Pulse and wait still work on an object whose sync block was reclaimed before
+        Thread pulser = new Thread(() =>
+        {
+            lock (held)
+            {
+                Monitor.Pulse(held);
+            }
+        });
+        pulser.Start();
+        if (!Monitor.Wait(held, TimeSpan.FromMinutes(1)))
+        {
+            Console.WriteLine("Wait timed out");
+            return 101;
+        }
+        Monitor.Exit(held);
+        pulser.Join();
+
+        GC.Collect();
+        if (!CheckHashCodes(objects, hashCodes, "after waiting"))
+        {
+            return 101;
+        }
+
+        Console.WriteLine("PASS");
+        return 100;
+    }
+}
@@ -0,0 +1,183 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Replays a load trace against the thread pool and reports how long work items waited in the queue.
+// This is a harness for comparing thread injection policies: run it once with the default hill
+// climbing and once with COMPlus_ThreadPool_EnableLatencyInjection=1 and compare the latencies.
+//
+// A trace is a text file with one work item per line:
+//
+//     <arrival ms> <cpu ms> <blocked ms>
+//
+// where the arrival time is relative to the start of the replay, the item spins for <cpu ms> and then
+// sleeps for <blocked ms>.  Fields may also be separated by commas, and lines starting with '#' are
+// ignored.  Without a trace file argument a built-in trace with a CPU bound phase, a burst of blocking
+// items and an idle gap is replayed.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Threading;
+
+public static class InjectionTraceReplay
+{
+    struct TraceItem
+    {
+        public int ArrivalMs;
+        public int CpuMs;
+        public int BlockedMs;
+    }
+
+    static Stopwatch s_clock;
+    static double[] s_queueLatencies;
+    static int s_running;
+    static int s_maxRunning;
+    static int s_remaining;
+    static ManualResetEvent s_done = new ManualResetEvent(false);
+
+    static List<TraceItem> BuiltInTrace()
+    {
+        List<TraceItem> trace = new List<TraceItem>();
+        int cpuCount = Environment.ProcessorCount;
+
+        // Steady CPU bound load: a short item per processor every 10ms
+        for (int t = 0; t < 500; t += 10)
+        {
+            for (int i = 0; i < cpuCount; i++)
+            {
+                trace.Add(new TraceItem { ArrivalMs = t, CpuMs = 2, BlockedMs = 0 });
+            }
+        }
+
+        // A burst of items that block, e.g. on synchronous I/O, arriving within 50ms
+        for (int i = 0; i < 200; i++)
+        {
+            trace.Add(new TraceItem { ArrivalMs = 500 + i / 4, CpuMs = 0, BlockedMs = 100 });
+        }
+
+        // An idle gap, then another CPU bound burst that should not need the extra threads
+        for (int i = 0; i < 4 * cpuCount; i++)
+        {
+            trace.Add(new TraceItem { ArrivalMs = 3000, CpuMs = 5, BlockedMs = 0 });
+        }
+
+        return trace;
+    }
+
+    static List<TraceItem> ReadTrace(string path)
+    {
+        List<TraceItem> trace = new List<TraceItem>();
+        foreach (string rawLine in File.ReadAllLines(path))
+        {
+            string line = rawLine.Trim();
+            if (line.Length == 0 || line.StartsWith("#"))
+            {
+                continue;
+            }
+
+            string[] fields = line.Split(new char[] { ' ', '\t', ',' }, StringSplitOptions.RemoveEmptyEntries);
+            if (fields.Length != 3)
+            {
+                throw new FormatException("Expected '<arrival ms> <cpu ms> <blocked ms>': " + line);
+            }
+
+            trace.Add(new TraceItem
+            {
+                ArrivalMs = int.Parse(fields[0]),
+                CpuMs = int.Parse(fields[1]),
+                BlockedMs = int.Parse(fields[2])
+            });
+        }
+
+        trace.Sort((a, b) => a.ArrivalMs.CompareTo(b.ArrivalMs));
+        return trace;
+    }
+
+    static void Spin(int milliseconds)
+    {
+        double end = s_clock.Elapsed.TotalMilliseconds + milliseconds;
+        while (s_clock.Elapsed.TotalMilliseconds < end)
+        {
+        }
+    }
+
+    static void RunItem(int index, TraceItem item)
+    {
+        s_queueLatencies[index] = s_clock.Elapsed.TotalMilliseconds - item.ArrivalMs;
+
+        int running = Interlocked.Increment(ref s_running);
+        int maxRunning;
+        while (running > (maxRunning = Volatile.Read(ref s_maxRunning)) &&
+               Interlocked.CompareExchange(ref s_maxRunning, running, maxRunning) != maxRunning)
+        {
+        }
+
+        Spin(item.CpuMs);
+        if (item.BlockedMs > 0)
+        {
+            Thread.Sleep(item.BlockedMs);
+        }
+
+        Interlocked.Decrement(ref s_running);
+        if (Interlocked.Decrement(ref s_remaining) == 0)
+        {
+            s_done.Set();
+        }
+    }
+
+    static double Percentile(double[] sorted, double percent)
+    {
+        int index = (int)Math.Ceiling(percent / 100.0 * sorted.Length) - 1;
+        return sorted[Math.Max(0, Math.Min(index, sorted.Length - 1))];
+    }
+
+    public static int Main(string[] args)
+    {
+        List<TraceItem> trace = (args.Length > 0) ? ReadTrace(args[0]) : BuiltInTrace();
+        if (trace.Count == 0)
+        {
+            Console.WriteLine("The trace is empty");
+            return 101;
+        }
+
+        s_queueLatencies = new double[trace.Count];
+        s_remaining = trace.Count;
+        s_clock = Stopwatch.StartNew();
+
+        // Queue every item at its arrival time.  Sleep is coarse, so items arriving close together are
+        // queued as a batch and their latency is measured from the arrival time recorded in the trace.
+        for (int i = 0; i < trace.Count; i++)
+        {
+            int wait = trace[i].ArrivalMs - (int)s_clock.ElapsedMilliseconds;
+            if (wait > 0)
+            {
+                Thread.Sleep(wait);
+            }
+
+            int index = i;
+            TraceItem item = trace[i];
+            ThreadPool.QueueUserWorkItem(_ => RunItem(index, item));
+        }
+
+        if (!s_done.WaitOne(TimeSpan.FromMinutes(5)))
+        {
+            Console.WriteLine("Timed out with {0} of {1} work items still pending", s_remaining, trace.Count);
+            return 101;
+        }
+
+        double[] sorted = (double[])s_queueLatencies.Clone();
+        Array.Sort(sorted);
+
+        Console.WriteLine("Work items:          {0}", trace.Count);
+        Console.WriteLine("Elapsed:             {0:F0} ms", s_clock.Elapsed.TotalMilliseconds);
+        Console.WriteLine("Max concurrent:      {0}", s_maxRunning);
+        Console.WriteLine("Queue latency p50:   {0:F1} ms", Percentile(sorted, 50));
+        Console.WriteLine("Queue latency p95:   {0:F1} ms", Percentile(sorted, 95));
+        Console.WriteLine("Queue latency p99:   {0:F1} ms", Percentile(sorted, 99));
+        Console.WriteLine("Queue latency max:   {0:F1} ms", sorted[sorted.Length - 1]);
+
+        return 100;
+    }
+}